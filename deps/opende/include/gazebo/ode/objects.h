@@ -115,6 +115,33 @@ ODE_API void dWorldSetIslandThreads (dWorldID, int num_island_threads);
  */
 ODE_API void dWorldSetQuickStepThreads (dWorldID, int num_quickstep_threads);
 
+/**
+ * @brief Get the number of values needed to store the warm start data of
+ * the joints of a world.
+ *
+ * Contact joints are not included, since they are recreated at every step.
+ * @ingroup world
+ * @sa dWorldGetWarmStart
+ */
+ODE_API int dWorldGetWarmStartSize (dWorldID);
+
+/**
+ * @brief Copy the constraint forces kept by the joints of a world to warm
+ * start the next quickstep iteration.
+ * @ingroup world
+ * @param data Receives dWorldGetWarmStartSize values.
+ */
+ODE_API void dWorldGetWarmStart (dWorldID, dReal *data);
+
+/**
+ * @brief Restore warm start data copied by dWorldGetWarmStart.
+ * @ingroup world
+ * @param data Values to restore.
+ * @param size Number of values, which must match dWorldGetWarmStartSize.
+ * @return 1 on success, 0 if the size does not match.
+ */
+ODE_API int dWorldSetWarmStart (dWorldID, const dReal *data, int size);
+
 /**
  * @brief Get the gravity vector for a given world.
  * @ingroup world
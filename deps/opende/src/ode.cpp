@@ -1806,6 +1806,43 @@ void dWorldSetQuickStepThreads (dWorldID w, int num_quickstep_threads)
   }
 }
 
+// each non-contact joint keeps 6 lambda and 6 lambda_erp values
+static const int dWarmStartValuesPerJoint = 12;
+
+int dWorldGetWarmStartSize (dWorldID w)
+{
+  dAASSERT (w);
+  int n = 0;
+  for (dxJoint *j=w->firstjoint; j; j=(dxJoint*)j->next) {
+    if (j->type() != dJointTypeContact) n++;
+  }
+  return n * dWarmStartValuesPerJoint;
+}
+
+void dWorldGetWarmStart (dWorldID w, dReal *data)
+{
+  dAASSERT (w && data);
+  for (dxJoint *j=w->firstjoint; j; j=(dxJoint*)j->next) {
+    if (j->type() == dJointTypeContact) continue;
+    memcpy (data, j->lambda, 6 * sizeof(dReal));
+    memcpy (data + 6, j->lambda_erp, 6 * sizeof(dReal));
+    data += dWarmStartValuesPerJoint;
+  }
+}
+
+int dWorldSetWarmStart (dWorldID w, const dReal *data, int size)
+{
+  dAASSERT (w && (data || size == 0));
+  if (size != dWorldGetWarmStartSize (w)) return 0;
+  for (dxJoint *j=w->firstjoint; j; j=(dxJoint*)j->next) {
+    if (j->type() == dJointTypeContact) continue;
+    memcpy (j->lambda, data, 6 * sizeof(dReal));
+    memcpy (j->lambda_erp, data + 6, 6 * sizeof(dReal));
+    data += dWarmStartValuesPerJoint;
+  }
+  return 1;
+}
+
 void dWorldGetGravity (dWorldID w, dVector3 g)
 {
   dAASSERT (w);
@@ -57,6 +57,7 @@
 
 #include "gazebo/msgs/msgs.hh"
 
+#include "gazebo/sensors/SensorManager.hh"
 #include "gazebo/sensors/SensorsIface.hh"
 
 #include "gazebo/physics/PhysicsFactory.hh"
@@ -112,6 +113,10 @@ namespace gazebo
 
     /// \brief Set whether to lockstep physics and rendering
     bool lockstep = false;
+
+    /// \brief Number of threads updating the sensors which do not render,
+    /// 0 to keep the default.
+    unsigned int sensorThreads = 0;
   };
 }
 
@@ -162,12 +167,17 @@ bool Server::ParseArgs(int _argc, char **_argv)
     ("help,h", "Produce this help message.")
     ("pause,u", "Start the server in a paused state.")
     ("lockstep", "Lockstep simulation so sensor update rates are respected.")
+    ("sensor_threads", po::value<unsigned int>(),
+     "Number of threads updating the sensors which do not render.")
     ("physics,e", po::value<std::string>(),
      "Specify a physics engine (ode|bullet|dart|simbody).")
     ("play,p", po::value<std::string>(), "Play a log file.")
     ("record,r", "Record state data.")
     ("record_encoding", po::value<std::string>()->default_value("zlib"),
      "Compression encoding format for log data (zlib|bz2|txt).")
+    ("record_format", po::value<std::string>()->default_value("xml"),
+     "Log file format (xml|binary). Binary logs are smaller and indexed "
+     "for fast seeking.")
     ("record_path", po::value<std::string>()->default_value(""),
      "Absolute path in which to store state data")
     ("record_period", po::value<double>()->default_value(-1),
@@ -276,6 +286,8 @@ bool Server::ParseArgs(int _argc, char **_argv)
       this->dataPtr->vm["record_path"].as<std::string>();
     this->dataPtr->params["record_encoding"] =
       this->dataPtr->vm["record_encoding"].as<std::string>();
+    this->dataPtr->params["record_format"] =
+      this->dataPtr->vm["record_format"].as<std::string>();
     if (this->dataPtr->vm.count("record_resources"))
       this->dataPtr->params["record_resources"] = "true";
   }
@@ -301,6 +313,12 @@ bool Server::ParseArgs(int _argc, char **_argv)
   }
   rendering::set_lockstep_enabled(this->dataPtr->lockstep);
 
+  if (this->dataPtr->vm.count("sensor_threads"))
+  {
+    this->dataPtr->sensorThreads =
+      this->dataPtr->vm["sensor_threads"].as<unsigned int>();
+  }
+
   if (!this->PreLoad())
   {
     gzerr << "Unable to load gazebo\n";
@@ -616,6 +634,11 @@ void Server::Run()
   sensors::run_once(true);
 
   // Run the sensor threads
+  if (this->dataPtr->sensorThreads > 0)
+  {
+    sensors::SensorManager::Instance()->SetUpdateThreads(
+        this->dataPtr->sensorThreads);
+  }
   sensors::run_threads();
 
   unsigned int iterations = 0;
@@ -691,6 +714,7 @@ void Server::ProcessParams()
       util::LogRecordParams params;
 
       params.encoding = this->dataPtr->params["record_encoding"];
+      params.format = this->dataPtr->params["record_format"];
       params.path = iter->second;
       params.period = this->dataPtr->vm["record_period"].as<double>();
       params.filter = this->dataPtr->vm["record_filter"].as<std::string>();
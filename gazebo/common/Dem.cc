@@ -265,6 +265,17 @@ void Dem::FillHeightMap(int _subSampling, unsigned int _vertSize,
     const ignition::math::Vector3d &_size,
     const ignition::math::Vector3d &_scale,
     bool _flipY, std::vector<float> &_heights)
+{
+  this->FillHeightMapRegion(_subSampling, _vertSize, _size, _scale, _flipY,
+      0, 0, _vertSize, _vertSize, 1, _heights);
+}
+
+//////////////////////////////////////////////////
+void Dem::FillHeightMapRegion(int _subSampling, unsigned int _vertSize,
+    const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, bool _flipY,
+    unsigned int _x, unsigned int _y, unsigned int _columns,
+    unsigned int _rows, unsigned int _stride, std::vector<float> &_heights)
 {
   if (_subSampling <= 0)
   {
@@ -272,12 +283,17 @@ void Dem::FillHeightMap(int _subSampling, unsigned int _vertSize,
     return;
   }
 
-  // Resize the vector to match the size of the vertices.
-  _heights.resize(_vertSize * _vertSize);
+  // Resize the vector to match the size of the region.
+  _heights.resize(_columns * _rows);
 
-  // Iterate over all the vertices
-  for (unsigned int y = 0; y < _vertSize; ++y)
+  // Iterate over the vertices of the region
+  for (unsigned int r = 0; r < _rows; ++r)
   {
+    // Row of the vertex in the full table, before flipping
+    unsigned int y = _y + r * _stride;
+    if (_flipY)
+      y = _vertSize - y - 1;
+
     double yf = y / static_cast<double>(_subSampling);
     unsigned int y1 = floor(yf);
     unsigned int y2 = ceil(yf);
@@ -285,9 +301,9 @@ void Dem::FillHeightMap(int _subSampling, unsigned int _vertSize,
       y2 = this->dataPtr->side - 1;
     double dy = yf - y1;
 
-    for (unsigned int x = 0; x < _vertSize; ++x)
+    for (unsigned int c = 0; c < _columns; ++c)
     {
-      double xf = x / static_cast<double>(_subSampling);
+      double xf = (_x + c * _stride) / static_cast<double>(_subSampling);
       unsigned int x1 = floor(xf);
       unsigned int x2 = ceil(xf);
       if (x2 >= this->dataPtr->side)
@@ -316,10 +332,7 @@ void Dem::FillHeightMap(int _subSampling, unsigned int _vertSize,
         h = this->dataPtr->minElevation;
 
       // Store the height for future use
-      if (!_flipY)
-        _heights[y * _vertSize + x] = h;
-      else
-        _heights[(_vertSize - y - 1) * _vertSize + x] = h;
+      _heights[r * _columns + c] = h;
     }
   }
 }
@@ -118,6 +118,15 @@ namespace gazebo
                   const bool _flipY,
                   std::vector<float> &_heights);
 
+      // Documentation inherited.
+      public: void FillHeightMapRegion(int _subSampling,
+                  unsigned int _vertSize,
+                  const ignition::math::Vector3d &_size,
+                  const ignition::math::Vector3d &_scale,
+                  bool _flipY, unsigned int _x, unsigned int _y,
+                  unsigned int _columns, unsigned int _rows,
+                  unsigned int _stride, std::vector<float> &_heights);
+
       /// \brief Get the georeferenced coordinates (lat, long) of a terrain's
       /// pixel in WGS84.
       /// \param[in] _x X coordinate of the terrain.
@@ -34,6 +34,27 @@
 using namespace gazebo;
 using namespace common;
 
+//////////////////////////////////////////////////
+void HeightmapData::FillHeightMapRegion(int _subSampling,
+    unsigned int _vertSize, const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, bool _flipY,
+    unsigned int _x, unsigned int _y, unsigned int _columns,
+    unsigned int _rows, unsigned int _stride, std::vector<float> &_heights)
+{
+  std::vector<float> all;
+  this->FillHeightMap(_subSampling, _vertSize, _size, _scale, _flipY, all);
+
+  _heights.resize(_columns * _rows);
+  for (unsigned int r = 0; r < _rows; ++r)
+  {
+    for (unsigned int c = 0; c < _columns; ++c)
+    {
+      unsigned int index = (_y + r * _stride) * _vertSize + _x + c * _stride;
+      _heights[r * _columns + c] = index < all.size() ? all[index] : 0.0f;
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 HeightmapData *HeightmapDataLoader::LoadImageAsTerrain(
     const std::string &_filename)
@@ -56,6 +56,30 @@ namespace gazebo
           const ignition::math::Vector3d &_scale, bool _flipY,
           std::vector<float> &_heights) = 0;
 
+      /// \brief Fill a rectangular region of the lookup table created by
+      /// FillHeightMap, keeping every _stride-th vertex. This lets large
+      /// terrains be sampled in tiles, or at a coarser resolution, without
+      /// building the full table. The default implementation builds the
+      /// full table and copies the region out of it.
+      /// \param[in] _subsampling Multiplier used to increase the resolution.
+      /// \param[in] _vertSize Number of points per row of the full table.
+      /// \param[in] _size Real dimmensions of the terrain.
+      /// \param[in] _scale Vector3 used to scale the height.
+      /// \param[in] _flipY If true, rows are in the inverted order used by
+      /// FillHeightMap.
+      /// \param[in] _x Column of the first vertex of the region.
+      /// \param[in] _y Row of the first vertex of the region.
+      /// \param[in] _columns Number of columns in the region.
+      /// \param[in] _rows Number of rows in the region.
+      /// \param[in] _stride Distance between two samples, in vertices.
+      /// \param[out] _heights Heights of the region, row by row.
+      public: virtual void FillHeightMapRegion(int _subSampling,
+          unsigned int _vertSize, const ignition::math::Vector3d &_size,
+          const ignition::math::Vector3d &_scale, bool _flipY,
+          unsigned int _x, unsigned int _y, unsigned int _columns,
+          unsigned int _rows, unsigned int _stride,
+          std::vector<float> &_heights);
+
       /// \brief Get the terrain's height.
       /// \return The terrain's height.
       public: virtual unsigned int GetHeight() const = 0;
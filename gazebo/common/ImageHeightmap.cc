@@ -36,6 +36,29 @@ int ImageHeightmap::Load(const std::string &_filename)
     return -1;
   }
 
+  const unsigned int width = this->img.GetWidth();
+  const unsigned int height = this->img.GetHeight();
+
+  // Bytes per row
+  const unsigned int pitch = this->img.GetPitch();
+
+  // Bytes per pixel
+  const unsigned int bpp = width > 0 ? pitch / width : 0;
+
+  unsigned char *data = nullptr;
+  unsigned int count;
+  this->img.GetData(&data, count);
+
+  this->raster.resize(width * height);
+  for (unsigned int y = 0; y < height; ++y)
+  {
+    const unsigned char *row = data + y * pitch;
+    for (unsigned int x = 0; x < width; ++x)
+      this->raster[y * width + x] = row[x * bpp];
+  }
+
+  delete [] data;
+
   return 0;
 }
 
@@ -45,27 +68,37 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
     const ignition::math::Vector3d &_scale, bool _flipY,
     std::vector<float> &_heights)
 {
-  // Resize the vector to match the size of the vertices.
-  _heights.resize(_vertSize * _vertSize);
+  this->FillHeightMapRegion(_subSampling, _vertSize, _size, _scale, _flipY,
+      0, 0, _vertSize, _vertSize, 1, _heights);
+}
+
+//////////////////////////////////////////////////
+void ImageHeightmap::FillHeightMapRegion(int _subSampling,
+    unsigned int _vertSize, const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, bool _flipY,
+    unsigned int _x, unsigned int _y, unsigned int _columns,
+    unsigned int _rows, unsigned int _stride, std::vector<float> &_heights)
+{
+  // Resize the vector to match the size of the region.
+  _heights.resize(_columns * _rows);
 
   int imgHeight = this->GetHeight();
   int imgWidth = this->GetWidth();
 
   GZ_ASSERT(imgWidth == imgHeight, "Heightmap image must be square");
 
-  // Bytes per row
-  unsigned int pitch = this->img.GetPitch();
-
-  // Bytes per pixel
-  unsigned int bpp = pitch / imgWidth;
+  GZ_ASSERT(this->raster.size() ==
+      static_cast<size_t>(imgWidth) * imgHeight, "Heightmap is not loaded");
+  const unsigned char *data = this->raster.data();
 
-  unsigned char *data = nullptr;
-  unsigned int count;
-  this->img.GetData(&data, count);
-
-  // Iterate over all the vertices
-  for (unsigned int y = 0; y < _vertSize; ++y)
+  // Iterate over the vertices of the region
+  for (unsigned int r = 0; r < _rows; ++r)
   {
+    // Row of the vertex in the full table, before flipping
+    unsigned int y = _y + r * _stride;
+    if (_flipY)
+      y = _vertSize - y - 1;
+
     // yf ranges between 0 and 4
     double yf = y / static_cast<double>(_subSampling);
     int y1 = floor(yf);
@@ -74,21 +107,21 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
       y2 = imgHeight-1;
     double dy = yf - y1;
 
-    for (unsigned int x = 0; x < _vertSize; ++x)
+    for (unsigned int c = 0; c < _columns; ++c)
     {
-      double xf = x / static_cast<double>(_subSampling);
+      double xf = (_x + c * _stride) / static_cast<double>(_subSampling);
       int x1 = floor(xf);
       int x2 = ceil(xf);
       if (x2 >= imgWidth)
         x2 = imgWidth-1;
       double dx = xf - x1;
 
-      double px1 = static_cast<int>(data[y1 * pitch + x1 * bpp]) / 255.0;
-      double px2 = static_cast<int>(data[y1 * pitch + x2 * bpp]) / 255.0;
+      double px1 = static_cast<int>(data[y1 * imgWidth + x1]) / 255.0;
+      double px2 = static_cast<int>(data[y1 * imgWidth + x2]) / 255.0;
       float h1 = (px1 - ((px1 - px2) * dx));
 
-      double px3 = static_cast<int>(data[y2 * pitch + x1 * bpp]) / 255.0;
-      double px4 = static_cast<int>(data[y2 * pitch + x2 * bpp]) / 255.0;
+      double px3 = static_cast<int>(data[y2 * imgWidth + x1]) / 255.0;
+      double px4 = static_cast<int>(data[y2 * imgWidth + x2]) / 255.0;
       float h2 = (px3 - ((px3 - px4) * dx));
 
       float h = (h1 - ((h1 - h2) * dy)) * _scale.Z();
@@ -100,14 +133,9 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
         h = 1.0 - h;
 
       // Store the height for future use
-      if (!_flipY)
-        _heights[y * _vertSize + x] = h;
-      else
-        _heights[(_vertSize - y - 1) * _vertSize + x] = h;
+      _heights[r * _columns + c] = h;
     }
   }
-
-  delete [] data;
 }
 
 //////////////////////////////////////////////////
@@ -103,6 +103,59 @@ TEST_F(ImageHeightmapTest, FillHeightmap)
   EXPECT_NEAR(5.0, elevations.at(elevations.size() / 2), ELEVATION_TOL);
 }
 
+/////////////////////////////////////////////////
+TEST_F(ImageHeightmapTest, FillHeightmapRegion)
+{
+  common::ImageHeightmap img;
+  EXPECT_EQ(0, img.Load("file://media/materials/textures/heightmap_bowl.png"));
+
+  int subsampling = 2;
+  unsigned int vertSize = (img.GetWidth() * subsampling) - subsampling + 1;
+  ignition::math::Vector3d size(129, 129, 10);
+  ignition::math::Vector3d scale(size.X() / vertSize, size.Y() / vertSize,
+      fabs(size.Z()) / img.GetMaxElevation());
+
+  for (bool flipY : {false, true})
+  {
+    std::vector<float> elevations;
+    img.FillHeightMap(subsampling, vertSize, size, scale, flipY, elevations);
+    ASSERT_EQ(vertSize * vertSize, elevations.size());
+
+    // A tile of the full table
+    const unsigned int x0 = 64;
+    const unsigned int y0 = 32;
+    const unsigned int side = 17;
+    std::vector<float> region;
+    img.FillHeightMapRegion(subsampling, vertSize, size, scale, flipY,
+        x0, y0, side, side, 1, region);
+    ASSERT_EQ(side * side, region.size());
+    for (unsigned int r = 0; r < side; ++r)
+    {
+      for (unsigned int c = 0; c < side; ++c)
+      {
+        EXPECT_FLOAT_EQ(elevations[(y0 + r) * vertSize + x0 + c],
+            region[r * side + c]);
+      }
+    }
+
+    // The whole table, keeping every 8th vertex
+    const unsigned int stride = 8;
+    const unsigned int coarseSize = (vertSize - 1) / stride + 1;
+    img.FillHeightMapRegion(subsampling, vertSize, size, scale, flipY,
+        0, 0, coarseSize, coarseSize, stride, region);
+    ASSERT_EQ(coarseSize * coarseSize, region.size());
+    for (unsigned int r = 0; r < coarseSize; ++r)
+    {
+      for (unsigned int c = 0; c < coarseSize; ++c)
+      {
+        EXPECT_FLOAT_EQ(
+            elevations[r * stride * vertSize + c * stride],
+            region[r * coarseSize + c]);
+      }
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -74,6 +74,9 @@ void help()
   << "                                the world file.\n"
   << "  --lockstep                    Lockstep simulation so sensor update "
   <<                                  "rates are respected.\n"
+  << "  --sensor_threads arg          Number of threads updating the sensors "
+  << "which do\n"
+  << "                                not render.\n"
   << "\n";
 }
 
@@ -344,6 +344,86 @@ namespace gazebo
       return result;
     }
 
+    /////////////////////////////////////////////////
+    void Set(msgs::Any *_a, const double _v)
+    {
+      _a->Clear();
+      _a->set_type(msgs::Any::DOUBLE);
+      _a->set_double_value(_v);
+    }
+
+    /////////////////////////////////////////////////
+    void Set(msgs::Any *_a, const int _i)
+    {
+      _a->Clear();
+      _a->set_type(msgs::Any::INT32);
+      _a->set_int_value(_i);
+    }
+
+    /////////////////////////////////////////////////
+    void Set(msgs::Any *_a, const std::string &_s)
+    {
+      _a->Clear();
+      _a->set_type(msgs::Any::STRING);
+      _a->set_string_value(_s);
+    }
+
+    /////////////////////////////////////////////////
+    void Set(msgs::Any *_a, const char *_s)
+    {
+      _a->Clear();
+      _a->set_type(msgs::Any::STRING);
+      _a->set_string_value(_s);
+    }
+
+    /////////////////////////////////////////////////
+    void Set(msgs::Any *_a, const bool _b)
+    {
+      _a->Clear();
+      _a->set_type(msgs::Any::BOOLEAN);
+      _a->set_bool_value(_b);
+    }
+
+    /////////////////////////////////////////////////
+    void Set(msgs::Any *_a, const ignition::math::Vector3d &_v)
+    {
+      _a->Clear();
+      _a->set_type(msgs::Any::VECTOR3D);
+      Set(_a->mutable_vector3d_value(), _v);
+    }
+
+    /////////////////////////////////////////////////
+    void Set(msgs::Any *_a, const ignition::math::Color &_c)
+    {
+      _a->Clear();
+      _a->set_type(msgs::Any::COLOR);
+      Set(_a->mutable_color_value(), _c);
+    }
+
+    /////////////////////////////////////////////////
+    void Set(msgs::Any *_a, const ignition::math::Pose3d &_p)
+    {
+      _a->Clear();
+      _a->set_type(msgs::Any::POSE3D);
+      Set(_a->mutable_pose3d_value(), _p);
+    }
+
+    /////////////////////////////////////////////////
+    void Set(msgs::Any *_a, const ignition::math::Quaterniond &_q)
+    {
+      _a->Clear();
+      _a->set_type(msgs::Any::QUATERNIOND);
+      Set(_a->mutable_quaternion_value(), _q);
+    }
+
+    /////////////////////////////////////////////////
+    void Set(msgs::Any *_a, const common::Time &_t)
+    {
+      _a->Clear();
+      _a->set_type(msgs::Any::TIME);
+      Set(_a->mutable_time_value(), _t);
+    }
+
     /////////////////////////////////////////////////
     msgs::Vector3d Convert(const ignition::math::Vector3d &_v)
     {
@@ -138,6 +138,76 @@ namespace gazebo
     GAZEBO_VISIBLE
     msgs::Any ConvertAny(const common::Time &_t);
 
+    /// \brief Set a msgs::Any from a double.
+    /// Unlike ConvertAny, the memory of the message is reused.
+    /// \param[out] _a A msgs::Any pointer.
+    /// \param[in] _v The double to set.
+    GAZEBO_VISIBLE
+    void Set(msgs::Any *_a, const double _v);
+
+    /// \brief Set a msgs::Any from an int.
+    /// Unlike ConvertAny, the memory of the message is reused.
+    /// \param[out] _a A msgs::Any pointer.
+    /// \param[in] _i The int to set.
+    GAZEBO_VISIBLE
+    void Set(msgs::Any *_a, const int _i);
+
+    /// \brief Set a msgs::Any from a std::string.
+    /// Unlike ConvertAny, the memory of the message is reused.
+    /// \param[out] _a A msgs::Any pointer.
+    /// \param[in] _s The string to set.
+    GAZEBO_VISIBLE
+    void Set(msgs::Any *_a, const std::string &_s);
+
+    /// \brief Set a msgs::Any from a string literal.
+    /// Unlike ConvertAny, the memory of the message is reused.
+    /// \param[out] _a A msgs::Any pointer.
+    /// \param[in] _s The string to set.
+    GAZEBO_VISIBLE
+    void Set(msgs::Any *_a, const char *_s);
+
+    /// \brief Set a msgs::Any from a bool.
+    /// Unlike ConvertAny, the memory of the message is reused.
+    /// \param[out] _a A msgs::Any pointer.
+    /// \param[in] _b The bool to set.
+    GAZEBO_VISIBLE
+    void Set(msgs::Any *_a, const bool _b);
+
+    /// \brief Set a msgs::Any from an ignition::math::Vector3d.
+    /// Unlike ConvertAny, the memory of the message is reused.
+    /// \param[out] _a A msgs::Any pointer.
+    /// \param[in] _v The vector to set.
+    GAZEBO_VISIBLE
+    void Set(msgs::Any *_a, const ignition::math::Vector3d &_v);
+
+    /// \brief Set a msgs::Any from an ignition::math::Color.
+    /// Unlike ConvertAny, the memory of the message is reused.
+    /// \param[out] _a A msgs::Any pointer.
+    /// \param[in] _c The color to set.
+    GAZEBO_VISIBLE
+    void Set(msgs::Any *_a, const ignition::math::Color &_c);
+
+    /// \brief Set a msgs::Any from an ignition::math::Pose3d.
+    /// Unlike ConvertAny, the memory of the message is reused.
+    /// \param[out] _a A msgs::Any pointer.
+    /// \param[in] _p The pose to set.
+    GAZEBO_VISIBLE
+    void Set(msgs::Any *_a, const ignition::math::Pose3d &_p);
+
+    /// \brief Set a msgs::Any from an ignition::math::Quaterniond.
+    /// Unlike ConvertAny, the memory of the message is reused.
+    /// \param[out] _a A msgs::Any pointer.
+    /// \param[in] _q The quaternion to set.
+    GAZEBO_VISIBLE
+    void Set(msgs::Any *_a, const ignition::math::Quaterniond &_q);
+
+    /// \brief Set a msgs::Any from a common::Time.
+    /// Unlike ConvertAny, the memory of the message is reused.
+    /// \param[out] _a A msgs::Any pointer.
+    /// \param[in] _t The time to set.
+    GAZEBO_VISIBLE
+    void Set(msgs::Any *_a, const common::Time &_t);
+
     /// \brief Convert a ignition::math::Vector3 to a msgs::Vector3d
     /// \param[in] _v The vector to convert
     /// \return A msgs::Vector3d object
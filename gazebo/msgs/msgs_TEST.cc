@@ -206,6 +206,36 @@ TEST_F(MsgsTest, ConvertTimeToAny)
   EXPECT_EQ(123, msg.time_value().nsec());
 }
 
+TEST_F(MsgsTest, SetAny)
+{
+  msgs::Any msg;
+  msgs::Set(&msg, ignition::math::Pose3d(1, 2, 3, 0, 0, 0));
+  EXPECT_EQ(msg.type(), msgs::Any::POSE3D);
+  ASSERT_TRUE(msg.has_pose3d_value());
+  EXPECT_DOUBLE_EQ(3, msg.pose3d_value().position().z());
+
+  // The value of the previous type is cleared.
+  msgs::Set(&msg, 4.0);
+  EXPECT_EQ(msg.type(), msgs::Any::DOUBLE);
+  EXPECT_FALSE(msg.has_pose3d_value());
+  EXPECT_DOUBLE_EQ(4, msg.double_value());
+
+  msgs::Set(&msg, "test_string");
+  EXPECT_EQ(msg.type(), msgs::Any::STRING);
+  EXPECT_FALSE(msg.has_double_value());
+  EXPECT_EQ("test_string", msg.string_value());
+
+  msgs::Set(&msg, common::Time(2, 123));
+  EXPECT_EQ(msg.type(), msgs::Any::TIME);
+  EXPECT_EQ(2, msg.time_value().sec());
+  EXPECT_EQ(123, msg.time_value().nsec());
+
+  // Same result as ConvertAny.
+  msgs::Set(&msg, ignition::math::Vector3d(1, 2, 3));
+  EXPECT_EQ(msg.SerializeAsString(),
+      msgs::ConvertAny(ignition::math::Vector3d(1, 2, 3)).SerializeAsString());
+}
+
 TEST_F(MsgsTest, CovertMathVector3ToMsgs)
 {
   msgs::Vector3d msg = msgs::Convert(ignition::math::Vector3d(1, 2, 3));
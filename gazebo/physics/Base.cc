@@ -35,6 +35,7 @@ Base::Base(BasePtr _parent)
   this->typeStr = "base";
   this->saveable = true;
   this->selected = false;
+  this->indexed = false;
 
   this->sdf.reset(new sdf::Element);
   this->sdf->AddAttribute("name", "string", "__default__", true);
@@ -72,6 +73,7 @@ void Base::Load(sdf::ElementPtr _sdf)
   }
 
   this->ComputeScopedName();
+  this->Index();
 
   this->RegisterIntrospectionItems();
 }
@@ -89,6 +91,8 @@ void Base::Fini()
 {
   this->UnregisterIntrospectionItems();
 
+  this->Unindex();
+
   // Remove self as a child of the parent
   if (this->parent)
   {
@@ -137,6 +141,7 @@ void Base::SetName(const std::string &_name)
   this->sdf->GetAttribute("name")->Set(_name);
   this->name = _name;
   this->ComputeScopedName();
+  this->Index();
 }
 
 //////////////////////////////////////////////////
@@ -193,6 +198,9 @@ void Base::AddChild(BasePtr _child)
   {
     this->children.push_back(_child);
   }
+
+  _child->indexed = true;
+  _child->Index();
 }
 
 //////////////////////////////////////////////////
@@ -242,7 +250,9 @@ BasePtr Base::GetChild(unsigned int _i) const
 //////////////////////////////////////////////////
 BasePtr Base::GetChild(const std::string &_name)
 {
-  std::string fullName = this->GetScopedName() + "::" + _name;
+  std::string fullName;
+  fullName.reserve(this->scopedName.size() + 2 + _name.size());
+  fullName.append(this->scopedName).append("::").append(_name);
   return this->GetByName(fullName);
 }
 
@@ -271,6 +281,8 @@ void Base::RemoveChild(physics::BasePtr _child)
 //////////////////////////////////////////////////
 void Base::RemoveChildren()
 {
+  for (auto &child : this->children)
+    child->Unindex();
   this->children.clear();
 }
 
@@ -278,6 +290,15 @@ void Base::RemoveChildren()
 BasePtr Base::GetById(unsigned int _id) const
 {
   BasePtr result;
+
+  if (this->world)
+  {
+    result = this->world->IndexedEntityById(_id);
+    if (result)
+      return result->parent.get() == this ? result : BasePtr();
+  }
+
+  // The child may not be indexed if it has no world.
   Base_V::const_iterator biter;
 
   for (biter = this->children.begin(); biter != this->children.end(); ++biter)
@@ -295,10 +316,25 @@ BasePtr Base::GetById(unsigned int _id) const
 //////////////////////////////////////////////////
 BasePtr Base::GetByName(const std::string &_name)
 {
-  if (this->GetScopedName() == _name || this->GetName() == _name)
+  if (this->scopedName == _name || this->name == _name)
     return shared_from_this();
 
   BasePtr result;
+
+  // The index answers unless more than one entity of the world matches the
+  // name. Only entities under this one are returned.
+  if (this->world && this->world->IndexedEntityByName(_name, result))
+  {
+    if (!result)
+      return result;
+
+    Base *p = result->parent.get();
+    while (p && p != this)
+      p = p->parent.get();
+
+    return p ? result : BasePtr();
+  }
+
   Base_V::const_iterator iter;
 
   for (iter = this->children.begin();
@@ -373,6 +409,27 @@ void Base::ComputeScopedName()
   }
 }
 
+//////////////////////////////////////////////////
+void Base::Index()
+{
+  if (this->indexed && this->world)
+    this->world->IndexEntity(shared_from_this());
+}
+
+//////////////////////////////////////////////////
+void Base::Unindex()
+{
+  if (!this->indexed)
+    return;
+
+  if (this->world)
+    this->world->UnindexEntity(this->id);
+  this->indexed = false;
+
+  for (auto &child : this->children)
+    child->Unindex();
+}
+
 //////////////////////////////////////////////////
 bool Base::HasType(const Base::EntityType &_t) const
 {
@@ -428,7 +485,11 @@ bool Base::operator ==(const Base &ent) const
 //////////////////////////////////////////////////
 void Base::SetWorld(const WorldPtr &_newWorld)
 {
+  if (this->indexed && this->world && this->world != _newWorld)
+    this->world->UnindexEntity(this->id);
+
   this->world = _newWorld;
+  this->Index();
 
   Base_V::iterator iter;
   for (iter = this->children.begin(); iter != this->children.end(); ++iter)
@@ -227,7 +227,9 @@ namespace gazebo
       public: BasePtr GetById(unsigned int _id) const;
       /// \endcond
 
-      /// \brief Get by name.
+      /// \brief Get by name. The lookup uses the index of the world, and
+      /// only searches the children when more than one entity of the world
+      /// has the name.
       /// \param[in] _name Get a child (or self) object by name
       /// \return A pointer to the object, NULL if not found
       public: BasePtr GetByName(const std::string &_name);
@@ -341,6 +343,15 @@ namespace gazebo
       /// \sa Base::GetScopedName
       protected: void ComputeScopedName();
 
+      /// \brief Add this entity to the index of its world, or update the
+      /// names under which it's indexed. Only entities which were added to
+      /// a parent are indexed.
+      private: void Index();
+
+      /// \brief Remove this entity and its children from the index of their
+      /// world.
+      private: void Unindex();
+
       /// \brief The SDF values for this object.
       protected: sdf::ElementPtr sdf;
 
@@ -377,6 +388,10 @@ namespace gazebo
       /// \brief Local copy of the scoped name.
       private: std::string scopedName;
 
+      /// \brief True if this entity was added to a parent, and is in the
+      /// index of its world.
+      private: bool indexed;
+
       protected: friend class Entity;
     };
     /// \}
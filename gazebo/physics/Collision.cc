@@ -87,6 +87,9 @@ void Collision::Fini()
     delete msg;
   }
 
+  if (this->world)
+    this->world->SpatialIndex().Remove(this->GetId());
+
   this->link.reset();
   this->shape.reset();
   this->surface.reset();
@@ -127,6 +130,14 @@ void Collision::Init()
   this->shape->Init();
 
   this->SetRelativePose(this->SDFPoseRelativeToParent());
+
+  // Ray sensors are not part of the spatial index.
+  if (this->world && this->world->SpatialIndex().Enabled() &&
+      !this->shape->HasType(Base::RAY_SHAPE) &&
+      !this->shape->HasType(Base::MULTIRAY_SHAPE))
+  {
+    this->world->SpatialIndex().Insert(this->GetId(), this->BoundingBox());
+  }
 }
 
 //////////////////////////////////////////////////
@@ -410,6 +421,9 @@ void Collision::SetWorldPoseDirty()
   // Tell the collision object that the next call to ::GetWorldPose should
   // compute a new worldPose value.
   this->worldPoseDirty = true;
+
+  if (this->world)
+    this->world->_AddSpatialDirty(this->GetId());
 }
 
 std::optional<sdf::SemanticPose> Collision::SDFSemanticPose() const
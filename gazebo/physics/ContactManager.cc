@@ -14,6 +14,7 @@
  * limitations under the License.
  *
 */
+#include <utility>
 #include <boost/algorithm/string.hpp>
 
 #include "gazebo/transport/Node.hh"
@@ -99,41 +100,31 @@ bool ContactManager::SubscribersConnected(Collision *_collision1,
   if (this->contactPub->HasConnections()) return true;
 
   boost::recursive_mutex::scoped_lock lock(*this->customMutex);
-  boost::unordered_map<std::string, ContactPublisher *>::const_iterator iter;
-  for (iter = this->customContactPublishers.begin();
-       iter != this->customContactPublishers.end(); ++iter)
+
+  // A model can simply be loaded later, so check the collisionNames as well.
+  if (this->pendingFilterCollisions)
   {
-    // A model can simply be loaded later, so check the collisionNames as well.
-    if (!iter->second->collisionNames.empty())
+    for (auto const &filter : this->filters)
     {
-      std::vector<std::string>::const_iterator it;
-      for (it = iter->second->collisionNames.begin();
-           it != iter->second->collisionNames.end(); ++it)
+      for (auto const &name : filter->collisionNames)
       {
-        BasePtr b = this->world->BaseByName(*it);
-        if (b)
-        {
-          return true;
-        }
         // We could do the same transformation which is done in
-        // GetCustomPublishers() here (insert collisions which now have been
-        // loaded), but this would remove the const qualifier of this function.
-        // It would however speed up repeated calls of this function without
-        // a call of NewContact() or GetCustomPublishers() in between.
+        // ResolveFilterCollisions() here, but this would remove the const
+        // qualifier of this function.
+        if (this->world->BaseByName(name))
+          return true;
       }
     }
-
-    // only reason _collision1 or _collision1 cannot be const parameters
-    // is that compiler can't find const pointers in unordered set
-    if (iter->second->collisions.find(_collision1) !=
-        iter->second->collisions.end() ||
-        iter->second->collisions.find(_collision2) !=
-        iter->second->collisions.end())
-    {
-      return true;
-    }
   }
-  return false;
+
+  // only reason _collision1 or _collision1 cannot be const parameters
+  // is that compiler can't find const pointers in unordered map
+  auto monitored = [this](Collision *_collision)
+  {
+    auto iter = this->collisionFilters.find(_collision);
+    return iter != this->collisionFilters.end() && iter->second.any();
+  };
+  return monitored(_collision1) || monitored(_collision2);
 }
 
 /////////////////////////////////////////////////
@@ -142,45 +133,94 @@ void ContactManager::GetCustomPublishers(Collision *_collision1,
                      std::vector<ContactPublisher*> &_publishers)
 {
   boost::recursive_mutex::scoped_lock lock(*this->customMutex);
-  boost::unordered_map<std::string, ContactPublisher *>::iterator iter;
-  for (iter = this->customContactPublishers.begin();
-       iter != this->customContactPublishers.end(); ++iter)
+
+  auto iter1 = this->collisionFilters.find(_collision1);
+  auto iter2 = this->collisionFilters.find(_collision2);
+  const boost::dynamic_bitset<> *mask1 =
+    iter1 != this->collisionFilters.end() ? &iter1->second : nullptr;
+  const boost::dynamic_bitset<> *mask2 =
+    iter2 != this->collisionFilters.end() ? &iter2->second : nullptr;
+
+  auto addPublisher = [&](const size_t _index)
+  {
+    ContactPublisher *contactPublisher = this->filters[_index];
+    GZ_ASSERT(contactPublisher->publisher != NULL,
+              "ContactPublisher must have a valid publisher");
+    if (!_getOnlyConnected || contactPublisher->publisher->HasConnections())
+      _publishers.push_back(contactPublisher);
+  };
+
+  // Visit the filters of both collisions, once each.
+  if (mask1)
   {
-    // A model can simply be loaded later, so convert ones that are not yet
-    // found
-    if (!iter->second->collisionNames.empty())
+    for (size_t i = mask1->find_first(); i != mask1->npos;
+         i = mask1->find_next(i))
     {
-      std::vector<std::string>::iterator it;
-      for (it = iter->second->collisionNames.begin();
-          it != iter->second->collisionNames.end();)
-      {
-        Collision *col = boost::dynamic_pointer_cast<Collision>(
-            this->world->BaseByName(*it)).get();
-        if (!col)
-        {
-          ++it;
-          continue;
-        }
-        it = iter->second->collisionNames.erase(it);
-        iter->second->collisions.insert(col);
-      }
+      addPublisher(i);
     }
+  }
+  if (mask2)
+  {
+    for (size_t i = mask2->find_first(); i != mask2->npos;
+         i = mask2->find_next(i))
+    {
+      if (!mask1 || !mask1->test(i))
+        addPublisher(i);
+    }
+  }
+}
 
-    // only reason _collision1 or _collision1 cannot be const parameters
-    // is that compiler can't find const pointers in unordered set
-    if (iter->second->collisions.find(_collision1) !=
-        iter->second->collisions.end() ||
-        iter->second->collisions.find(_collision2) !=
-        iter->second->collisions.end())
+/////////////////////////////////////////////////
+void ContactManager::ResolveFilterCollisions()
+{
+  if (!this->pendingFilterCollisions)
+    return;
+
+  bool found = false;
+  for (auto &filter : this->filters)
+  {
+    for (auto it = filter->collisionNames.begin();
+         it != filter->collisionNames.end();)
     {
-      GZ_ASSERT(iter->second->publisher != NULL,
-                "ContactPublisher must have a valid publisher");
-      if (!_getOnlyConnected || iter->second->publisher->HasConnections())
+      Collision *col = boost::dynamic_pointer_cast<Collision>(
+          this->world->BaseByName(*it)).get();
+      if (!col)
       {
-        _publishers.push_back(iter->second);
+        ++it;
+        continue;
       }
+      it = filter->collisionNames.erase(it);
+      filter->collisions.insert(col);
+      found = true;
     }
   }
+
+  if (found)
+    this->UpdateFilterMasks();
+}
+
+/////////////////////////////////////////////////
+void ContactManager::UpdateFilterMasks()
+{
+  this->filters.clear();
+  this->collisionFilters.clear();
+  this->pendingFilterCollisions = false;
+
+  for (auto const &iter : this->customContactPublishers)
+    this->filters.push_back(iter.second);
+
+  for (size_t i = 0; i < this->filters.size(); ++i)
+  {
+    for (auto const &col : this->filters[i]->collisions)
+    {
+      boost::dynamic_bitset<> &mask = this->collisionFilters[col];
+      mask.resize(this->filters.size());
+      mask.set(i);
+    }
+
+    if (!this->filters[i]->collisionNames.empty())
+      this->pendingFilterCollisions = true;
+  }
 }
 
 /////////////////////////////////////////////////
@@ -198,7 +238,8 @@ Contact *ContactManager::NewContact(Collision *_collision1,
   // This is a signal to the Physics engine that it can skip the extra
   // processing necessary to get back contact information.
 
-  std::vector<ContactPublisher *> publishers;
+  std::vector<ContactPublisher *> &publishers = this->matchedPublishers;
+  publishers.clear();
   bool getOnlyConnected = false;
   // TODO check: getOnlyConnected set to false to keep same behaviour as before.
   // But should we not only add publishers which are connected, as is done
@@ -222,6 +263,7 @@ Contact *ContactManager::NewContact(Collision *_collision1,
     for (unsigned int i = 0; i < publishers.size(); ++i)
     {
       publishers[i]->contacts.push_back(result);
+      publishers[i]->contactIndices.push_back(this->contactIndex - 1);
     }
   }
 
@@ -262,6 +304,10 @@ const std::vector<Contact*> &ContactManager::GetContacts() const
 void ContactManager::ResetCount()
 {
   this->contactIndex = 0;
+
+  // Collisions of the filters may have been loaded since the last step.
+  boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+  this->ResolveFilterCollisions();
 }
 
 /////////////////////////////////////////////////
@@ -276,7 +322,14 @@ void ContactManager::Clear()
   boost::unordered_map<std::string, ContactPublisher *>::iterator iter;
   for (iter = this->customContactPublishers.begin();
       iter != this->customContactPublishers.end(); ++iter)
+  {
     iter->second->contacts.clear();
+    iter->second->contactIndices.clear();
+  }
+
+  this->contactsMsg.reset();
+  this->spareContactsMsg.reset();
+  this->contactMsgIndices.clear();
 
   // Reset the contact count to zero.
   this->contactIndex = 0;
@@ -295,21 +348,34 @@ void ContactManager::PublishContacts()
     return;
   }
 
+  // The message of each contact is filled once, when a topic first needs
+  // it. Clearing the messages keeps them allocated for the next step. The
+  // publisher holds the last message it sent, so the spare message, sent
+  // the step before, is used instead. A new one is only allocated while a
+  // subscriber still holds it.
+  if (this->contactsMsg && !this->contactsMsg.unique())
+    std::swap(this->contactsMsg, this->spareContactsMsg);
+  if (!this->contactsMsg || !this->contactsMsg.unique())
+    this->contactsMsg.reset(new msgs::Contacts);
+  this->contactsMsg->clear_contact();
+  this->contactMsgIndices.assign(this->contactIndex, -1);
+  const common::Time simTime = this->world->SimTime();
+
   // publish to default topic, ~/physics/contacts
-  if (!transport::getMinimalComms())
+  if (!transport::getMinimalComms() && this->contactPub->HasConnections())
   {
-    msgs::Contacts msg;
     for (unsigned int i = 0; i < this->contactIndex; ++i)
     {
       if (this->contacts[i]->count == 0)
         continue;
 
-      msgs::Contact *contactMsg = msg.add_contact();
-      this->contacts[i]->FillMsg(*contactMsg);
+      this->ContactMsg(i);
     }
 
-    msgs::Set(msg.mutable_time(), this->world->SimTime());
-    this->contactPub->Publish(msg);
+    // The subscribers in this process share the message. Contacts with a
+    // message are not filled again below, so it is not modified anymore.
+    msgs::Set(this->contactsMsg->mutable_time(), simTime);
+    this->contactPub->Publish(this->contactsMsg);
   }
 
   // publish to other custom topics
@@ -319,20 +385,36 @@ void ContactManager::PublishContacts()
       iter != this->customContactPublishers.end(); ++iter)
   {
     ContactPublisher *contactPublisher = iter->second;
-    msgs::Contacts msg2;
-    for (unsigned int j = 0;
-        j < contactPublisher->contacts.size(); ++j)
+
+    // Don't build messages no one receives.
+    if (contactPublisher->publisher->HasConnections())
     {
-      if (contactPublisher->contacts[j]->count == 0)
-        continue;
+      this->filterMsg.clear_contact();
+      for (auto const index : contactPublisher->contactIndices)
+      {
+        if (index >= this->contactIndex || this->contacts[index]->count == 0)
+          continue;
 
-      msgs::Contact *contactMsg = msg2.add_contact();
-      contactPublisher->contacts[j]->FillMsg(*contactMsg);
+        this->filterMsg.add_contact()->CopyFrom(this->ContactMsg(index));
+      }
+      msgs::Set(this->filterMsg.mutable_time(), simTime);
+      contactPublisher->publisher->Publish(this->filterMsg);
     }
-    msgs::Set(msg2.mutable_time(), this->world->SimTime());
-    contactPublisher->publisher->Publish(msg2);
     contactPublisher->contacts.clear();
+    contactPublisher->contactIndices.clear();
+  }
+}
+
+/////////////////////////////////////////////////
+const msgs::Contact &ContactManager::ContactMsg(const unsigned int _index)
+{
+  int &msgIndex = this->contactMsgIndices[_index];
+  if (msgIndex < 0)
+  {
+    msgIndex = this->contactsMsg->contact_size();
+    this->contacts[_index]->FillMsg(*this->contactsMsg->add_contact());
   }
+  return this->contactsMsg->contact(msgIndex);
 }
 
 /////////////////////////////////////////////////
@@ -375,6 +457,7 @@ std::string ContactManager::CreateFilter(const std::string &_name,
   {
     boost::recursive_mutex::scoped_lock lock(*this->customMutex);
     this->customContactPublishers[name] = contactPublisher;
+    this->UpdateFilterMasks();
   }
 
   return topic;
@@ -419,6 +502,8 @@ std::string ContactManager::CreateFilter(const std::string &_name,
 
     // Let it know about collisions not yet found.
     this->customContactPublishers[name]->collisionNames = collisionNames;
+    if (!collisionNames.empty())
+      this->pendingFilterCollisions = true;
   }
 
   return topic;
@@ -437,11 +522,13 @@ void ContactManager::RemoveFilter(const std::string &_name)
   {
     ContactPublisher *contactPublisher = iter->second;
     contactPublisher->contacts.clear();
+    contactPublisher->contactIndices.clear();
     contactPublisher->collisionNames.clear();
     contactPublisher->collisions.clear();
     contactPublisher->publisher->Fini();
     contactPublisher->publisher.reset();
     this->customContactPublishers.erase(iter);
+    this->UpdateFilterMasks();
   }
 }
 
@@ -23,6 +23,7 @@
 #include <map>
 #include <ignition/transport/Node.hh>
 
+#include <boost/dynamic_bitset.hpp>
 #include <boost/unordered/unordered_set.hpp>
 #include <boost/unordered/unordered_map.hpp>
 #include <boost/thread/recursive_mutex.hpp>
@@ -56,6 +57,10 @@ namespace gazebo
       /// \brief A list of contacts associated to the collisions.
       public: std::vector<Contact *> contacts;
 
+      /// \brief Indices of the contacts in the buffer of the contact
+      /// manager, in the same order as contacts.
+      public: std::vector<unsigned int> contactIndices;
+
       // Place ignition::transport objects at the end of this file to
       // guarantee they are destructed first.
 
@@ -215,6 +220,22 @@ namespace gazebo
                        Collision *_collision2, const bool _getOnlyConnected,
                        std::vector<ContactPublisher*> &_publishers);
 
+      /// \brief Look up the collisions of the filters which were not
+      /// loaded when the filters were created, and rebuild the filter masks
+      /// if any is found. Must be called with customMutex locked.
+      private: void ResolveFilterCollisions();
+
+      /// \brief Rebuild the list of filters and the filter masks of the
+      /// collisions. Must be called with customMutex locked.
+      private: void UpdateFilterMasks();
+
+      /// \brief Get the message of a contact in the buffer. The message
+      /// is filled the first time it is needed after the contacts are
+      /// published, and shared by all topics.
+      /// \param[in] _index Index of the contact in the buffer.
+      /// \return The contact message.
+      private: const msgs::Contact &ContactMsg(const unsigned int _index);
+
       private: std::vector<Contact*> contacts;
 
       private: unsigned int contactIndex;
@@ -236,6 +257,37 @@ namespace gazebo
       /// \brief Mutex to protect the list of custom publishers.
       private: boost::recursive_mutex *customMutex;
 
+      /// \brief Custom publishers, indexed by their bit in the filter
+      /// masks.
+      private: std::vector<ContactPublisher *> filters;
+
+      /// \brief Mask of the filters that monitor each collision.
+      private: boost::unordered_map<Collision *, boost::dynamic_bitset<>>
+          collisionFilters;
+
+      /// \brief True if a filter has collisions which were not loaded.
+      private: bool pendingFilterCollisions = false;
+
+      /// \brief Messages of the contacts published in this step, shared
+      /// with the subscribers in this process.
+      private: msgs::ContactsPtr contactsMsg;
+
+      /// \brief Message published the step before contactsMsg. The
+      /// publisher keeps the last message it sent, so the two messages
+      /// take turns, and are cleared but not freed once the subscribers
+      /// released them.
+      private: msgs::ContactsPtr spareContactsMsg;
+
+      /// \brief Index of the message of each contact in contactsMsg, -1 if
+      /// it has not been filled.
+      private: std::vector<int> contactMsgIndices;
+
+      /// \brief Message reused for the custom topics.
+      private: msgs::Contacts filterMsg;
+
+      /// \brief Publishers of a new contact, reused between contacts.
+      private: std::vector<ContactPublisher *> matchedPublishers;
+
       // Place ignition::transport objects at the end of this file to
       // guarantee they are destructed first.
 
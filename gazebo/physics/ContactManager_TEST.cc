@@ -15,6 +15,9 @@
  *
 */
 
+#include <mutex>
+#include <vector>
+
 #include "gazebo/physics/ContactManager.hh"
 #include "gazebo/test/ServerFixture.hh"
 
@@ -24,6 +27,37 @@ class ContactManagerTest : public ServerFixture
 {
 };
 
+/// \brief Mutex for the filtered contact messages.
+std::mutex g_contactsMutex;
+
+/// \brief Last messages received on the topics of two filters.
+msgs::Contacts g_contacts1;
+msgs::Contacts g_contacts2;
+
+/////////////////////////////////////////////////
+void OnContacts1(ConstContactsPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_contactsMutex);
+  g_contacts1 = *_msg;
+}
+
+/////////////////////////////////////////////////
+void OnContacts2(ConstContactsPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_contactsMutex);
+  g_contacts2 = *_msg;
+}
+
+/// \brief Addresses of the messages received on ~/physics/contacts.
+std::vector<const void *> g_contactsAddresses;
+
+/////////////////////////////////////////////////
+void OnContactsAddress(ConstContactsPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_contactsMutex);
+  g_contactsAddresses.push_back(_msg.get());
+}
+
 /////////////////////////////////////////////////
 TEST_F(ContactManagerTest, CreateFilter)
 {
@@ -194,6 +228,108 @@ TEST_F(ContactManagerTest, NeverDropContacts)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(ContactManagerTest, FilterContacts)
+{
+  Load("test/worlds/box.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  physics::ContactManager *manager = physics->GetContactManager();
+  ASSERT_TRUE(manager != nullptr);
+
+  // Two filters share the contacts of the box, one of them also names a
+  // collision which is not loaded.
+  std::vector<std::string> collisions;
+  collisions.push_back("box::link::collision");
+  std::string topic1 = manager->CreateFilter("filter1", collisions);
+  collisions.push_back("missing::link::collision");
+  std::string topic2 = manager->CreateFilter("filter2", collisions);
+  EXPECT_EQ(manager->GetFilterCount(), 2u);
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::SubscriberPtr sub1 = node->Subscribe(topic1, &OnContacts1);
+  transport::SubscriberPtr sub2 = node->Subscribe(topic2, &OnContacts2);
+
+  world->Step(10);
+
+  msgs::Contacts msg1;
+  msgs::Contacts msg2;
+  for (int sleep = 0; sleep < 30; ++sleep)
+  {
+    {
+      std::lock_guard<std::mutex> lock(g_contactsMutex);
+      msg1 = g_contacts1;
+      msg2 = g_contacts2;
+    }
+    if (msg1.contact_size() > 0 && msg2.contact_size() > 0)
+      break;
+    common::Time::MSleep(100);
+  }
+
+  // Both topics receive the same contacts, between the box and the ground.
+  ASSERT_GT(msg1.contact_size(), 0);
+  ASSERT_EQ(msg1.contact_size(), msg2.contact_size());
+  for (int i = 0; i < msg1.contact_size(); ++i)
+  {
+    EXPECT_TRUE(msg1.contact(i).collision1() == "box::link::collision" ||
+                msg1.contact(i).collision2() == "box::link::collision");
+    EXPECT_EQ(msg1.contact(i).collision1(), msg2.contact(i).collision1());
+    EXPECT_EQ(msg1.contact(i).depth_size(), msg2.contact(i).depth_size());
+  }
+
+  // No contacts are routed to a removed filter.
+  manager->RemoveFilter("filter1");
+  manager->RemoveFilter("filter2");
+  EXPECT_EQ(manager->GetFilterCount(), 0u);
+  world->Step(1);
+  EXPECT_EQ(manager->GetContactCount(), 0u);
+}
+
+/////////////////////////////////////////////////
+// The publisher keeps the last contacts message it sent, the manager
+// alternates between two messages once the subscribers released them.
+TEST_F(ContactManagerTest, ReuseContactsMessage)
+{
+  Load("test/worlds/box.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::SubscriberPtr sub =
+    node->Subscribe("~/physics/contacts", &OnContactsAddress);
+
+  for (size_t step = 1; step <= 4; ++step)
+  {
+    world->Step(1);
+    for (int sleep = 0; sleep < 30; ++sleep)
+    {
+      {
+        std::lock_guard<std::mutex> lock(g_contactsMutex);
+        if (g_contactsAddresses.size() >= step)
+          break;
+      }
+      common::Time::MSleep(100);
+    }
+    // Let the subscriber release the message
+    common::Time::MSleep(100);
+  }
+
+  std::lock_guard<std::mutex> lock(g_contactsMutex);
+  ASSERT_EQ(g_contactsAddresses.size(), 4u);
+  EXPECT_NE(g_contactsAddresses[0], g_contactsAddresses[1]);
+  EXPECT_EQ(g_contactsAddresses[0], g_contactsAddresses[2]);
+  EXPECT_EQ(g_contactsAddresses[1], g_contactsAddresses[3]);
+}
+
+/////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
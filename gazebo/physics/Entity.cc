@@ -199,7 +199,7 @@ void Entity::SetAnimation(common::PoseAnimationPtr _anim)
   this->prevAnimationTime = this->world->SimTime();
   this->animation = _anim;
   this->onAnimationComplete.clear();
-  this->animationConnection = event::Events::ConnectWorldUpdateBegin(
+  this->animationConnection = this->world->ConnectUpdateBegin(
       boost::bind(&Entity::UpdateAnimation, this, _1));
 }
 
@@ -212,7 +212,7 @@ void Entity::SetAnimation(const common::PoseAnimationPtr &_anim,
   this->prevAnimationTime = this->world->SimTime();
   this->animation = _anim;
   this->onAnimationComplete = _onComplete;
-  this->animationConnection = event::Events::ConnectWorldUpdateBegin(
+  this->animationConnection = this->world->ConnectUpdateBegin(
       boost::bind(&Entity::UpdateAnimation, this, _1));
 }
 
@@ -226,7 +226,8 @@ void Gripper::Load(sdf::ElementPtr _sdf)
           &GripperPrivate::OnContacts, this->dataPtr.get());
     }
   }
-  this->dataPtr->connections.push_back(event::Events::ConnectWorldUpdateEnd(
+  this->dataPtr->connections.push_back(
+      this->dataPtr->world->ConnectUpdateEnd(
           std::bind(&GripperPrivate::OnUpdate, this->dataPtr.get())));
 }
 
@@ -16,7 +16,9 @@
 */
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <string>
+#include <vector>
 #include <ignition/math/Helpers.hh>
 #include <gazebo/gazebo_config.h>
 
@@ -26,6 +28,7 @@
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/SphericalCoordinates.hh"
 #include "gazebo/physics/HeightmapShape.hh"
+#include "gazebo/physics/HeightmapShapePrivate.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/transport/transport.hh"
 
@@ -35,13 +38,14 @@ using namespace physics;
 
 //////////////////////////////////////////////////
 HeightmapShape::HeightmapShape(CollisionPtr _parent)
-    : Shape(_parent)
+    : Shape(_parent), dataPtr(new HeightmapShapePrivate)
 {
   static_assert(
       std::is_same<HeightType, float>::value ||
       std::is_same<HeightType, double>::value,
       "Height field needs to be double or float");
   this->vertSize = 0;
+  this->tilingSupported = false;
   this->AddType(Base::HEIGHTMAP_SHAPE);
 }
 
@@ -181,6 +185,44 @@ void HeightmapShape::Load(sdf::ElementPtr _sdf)
     }
   }
 
+  // Optional paging of the heights in tiles, see UpdateTiles
+  if (this->sdf->HasElement("gz:tile_size"))
+  {
+    unsigned int t = this->sdf->Get<unsigned int>("gz:tile_size");
+    if (t & (t - 1u))
+    {
+      gzerr << "Heightmap tile size must be a power of 2. "
+            << "Tiling will be disabled." << std::endl;
+    }
+    else
+    {
+      this->dataPtr->tileSize = t;
+    }
+  }
+
+  if (this->sdf->HasElement("gz:tile_radius"))
+    this->dataPtr->tileRadius = this->sdf->Get<double>("gz:tile_radius");
+
+  if (this->sdf->HasElement("gz:max_tiles"))
+  {
+    this->dataPtr->maxTiles =
+        std::max(1u, this->sdf->Get<unsigned int>("gz:max_tiles"));
+  }
+
+  if (this->sdf->HasElement("gz:far_stride"))
+  {
+    unsigned int s = this->sdf->Get<unsigned int>("gz:far_stride");
+    if (s & (s - 1u))
+    {
+      gzerr << "Heightmap far stride must be a power of 2. "
+            << "The coarse grid will be disabled." << std::endl;
+    }
+    else
+    {
+      this->dataPtr->farStride = s;
+    }
+  }
+
   // Check if the geometry of the terrain data matches Ogre constrains
   if (this->heightmapData->GetWidth() != this->heightmapData->GetHeight() ||
       !ignition::math::isPowerOfTwo(this->heightmapData->GetWidth() - 1))
@@ -245,8 +287,290 @@ void HeightmapShape::Init()
   else
     this->scale.Z() = fabs(terrainSize.Z()) / heightmapSizeZ;
 
-  // Construct the heightmap lookup table
-  this->FillHeightfield(this->heights);
+  if (this->dataPtr->tileSize > 0 && !this->tilingSupported)
+  {
+    gzwarn << "Heightmap tiling is not supported by this physics engine. "
+           << "The full lookup table will be used." << std::endl;
+    this->dataPtr->tileSize = 0;
+  }
+
+  // Construct the heightmap lookup table, or the tiles that replace it
+  if (this->dataPtr->tileSize > 0)
+    this->InitTiles();
+  else
+    this->FillHeightfield(this->heights);
+}
+
+//////////////////////////////////////////////////
+void HeightmapShape::InitTiles()
+{
+  const unsigned int intervals = this->vertSize - 1;
+  this->dataPtr->tileSize = std::min(this->dataPtr->tileSize, intervals);
+  this->dataPtr->tileCount = intervals / this->dataPtr->tileSize;
+
+  // Keep links half a tile away from unloaded tiles by default
+  if (this->dataPtr->tileRadius <= 0)
+  {
+    this->dataPtr->tileRadius =
+        0.5 * this->dataPtr->tileSize * this->Size().X() / intervals;
+  }
+
+  if (this->dataPtr->farStride > 0)
+  {
+    this->dataPtr->farStride = std::min(this->dataPtr->farStride, intervals);
+    this->dataPtr->coarseSize = intervals / this->dataPtr->farStride + 1;
+
+    std::vector<float> coarse;
+    this->heightmapData->FillHeightMapRegion(this->subSampling,
+        this->vertSize, this->Size(), this->scale, this->flipY, 0, 0,
+        this->dataPtr->coarseSize, this->dataPtr->coarseSize,
+        this->dataPtr->farStride, coarse);
+    this->dataPtr->coarseHeights.assign(coarse.begin(), coarse.end());
+  }
+
+  // Bounds of the heights, derived from the elevation range of the data so
+  // that the full lookup table never has to be built. Interpolated
+  // heights stay within these bounds.
+  double low = 0.0;
+  double high = 0.0;
+  bool isDem = false;
+#ifdef HAVE_GDAL
+  auto demData = dynamic_cast<common::Dem *>(this->heightmapData);
+  if (demData)
+  {
+    low = demData->GetMinElevation();
+    high = low + (demData->GetMaxElevation() - low) * this->scale.Z();
+    isDem = true;
+  }
+#endif
+
+  // Mirror the inversion done by FillHeightMap for negative sizes
+  if (isDem)
+  {
+    if (this->Size().Z() < 0)
+    {
+      std::swap(low, high);
+      low = -low;
+      high = -high;
+    }
+  }
+  else if (dynamic_cast<common::ImageHeightmap *>(this->heightmapData))
+  {
+    high = this->heightmapData->GetMaxElevation() * this->scale.Z();
+    if (this->Size().Z() < 0)
+    {
+      std::swap(low, high);
+      low = 1.0 - low;
+      high = 1.0 - high;
+    }
+  }
+  else
+  {
+    // Unknown data, build the full table once
+    std::vector<float> all;
+    this->heightmapData->FillHeightMap(this->subSampling, this->vertSize,
+        this->Size(), this->scale, this->flipY, all);
+    auto range = std::minmax_element(all.begin(), all.end());
+    low = *range.first;
+    high = *range.second;
+  }
+  this->dataPtr->minHeight = low;
+  this->dataPtr->maxHeight = high;
+
+  gzmsg << "Heightmap [" << this->GetURI() << "] paged in "
+        << this->dataPtr->tileCount * this->dataPtr->tileCount
+        << " tiles of " << this->dataPtr->tileSize << " intervals"
+        << std::endl;
+}
+
+//////////////////////////////////////////////////
+HeightmapTile &HeightmapShape::LoadTile(unsigned int _tx,
+    unsigned int _ty) const
+{
+  const unsigned int size = this->dataPtr->tileSize;
+
+  std::vector<float> values;
+  this->heightmapData->FillHeightMapRegion(this->subSampling, this->vertSize,
+      this->Size(), this->scale, this->flipY, _tx * size, _ty * size,
+      size + 1, size + 1, 1, values);
+
+  const unsigned int index = _ty * this->dataPtr->tileCount + _tx;
+  HeightmapTile &tile = this->dataPtr->tiles[index];
+  tile.heights.assign(values.begin(), values.end());
+  tile.lastUsed = ++this->dataPtr->useClock;
+
+  // Loads made outside of UpdateTiles, e.g. by GetHeight while paused, are
+  // bounded too. Erasing other tiles keeps this reference valid.
+  this->EvictTiles(index);
+  return tile;
+}
+
+//////////////////////////////////////////////////
+void HeightmapShape::EvictTiles(const unsigned int _keep) const
+{
+  auto &tiles = this->dataPtr->tiles;
+  while (tiles.size() > this->dataPtr->maxTiles)
+  {
+    auto oldest = tiles.end();
+    for (auto iter = tiles.begin(); iter != tiles.end(); ++iter)
+    {
+      if (iter->first == _keep ||
+          iter->second.needed == this->dataPtr->generation)
+      {
+        continue;
+      }
+      if (oldest == tiles.end() ||
+          iter->second.lastUsed < oldest->second.lastUsed)
+      {
+        oldest = iter;
+      }
+    }
+
+    // The remaining tiles are all needed
+    if (oldest == tiles.end())
+      break;
+    tiles.erase(oldest);
+  }
+}
+
+//////////////////////////////////////////////////
+void HeightmapShape::ReadRows(const unsigned int _y, const unsigned int _rows,
+    std::vector<float> &_heights) const
+{
+  this->heightmapData->FillHeightMapRegion(this->subSampling, this->vertSize,
+      this->Size(), this->scale, this->flipY, 0, _y, this->vertSize, _rows,
+      1, _heights);
+}
+
+//////////////////////////////////////////////////
+HeightmapShape::HeightType HeightmapShape::TileHeight(int _x, int _y,
+    bool _coarse) const
+{
+  const int last = static_cast<int>(this->vertSize) - 1;
+  if (_x < 0 || _y < 0 || _x > last || _y > last)
+    return 0.0;
+
+  const unsigned int size = this->dataPtr->tileSize;
+  const unsigned int x = static_cast<unsigned int>(_x);
+  const unsigned int y = static_cast<unsigned int>(_y);
+  const unsigned int tx = std::min(x / size, this->dataPtr->tileCount - 1);
+  const unsigned int ty = std::min(y / size, this->dataPtr->tileCount - 1);
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->tilesMutex);
+  auto iter = this->dataPtr->tiles.find(ty * this->dataPtr->tileCount + tx);
+  if (iter != this->dataPtr->tiles.end())
+  {
+    iter->second.lastUsed = ++this->dataPtr->useClock;
+    return iter->second.heights[(y - ty * size) * (size + 1) +
+        x - tx * size];
+  }
+
+  if (!_coarse || this->dataPtr->coarseHeights.empty())
+  {
+    const HeightmapTile &tile = this->LoadTile(tx, ty);
+    return tile.heights[(y - ty * size) * (size + 1) + x - tx * size];
+  }
+
+  // Bilinear interpolation of the coarse grid
+  const unsigned int coarseSize = this->dataPtr->coarseSize;
+  const double xf = x / static_cast<double>(this->dataPtr->farStride);
+  const double yf = y / static_cast<double>(this->dataPtr->farStride);
+  const unsigned int x1 = static_cast<unsigned int>(xf);
+  const unsigned int y1 = static_cast<unsigned int>(yf);
+  const unsigned int x2 = std::min(x1 + 1, coarseSize - 1);
+  const unsigned int y2 = std::min(y1 + 1, coarseSize - 1);
+  const double dx = xf - x1;
+  const double dy = yf - y1;
+
+  const auto &coarse = this->dataPtr->coarseHeights;
+  double h1 = coarse[y1 * coarseSize + x1] +
+      (coarse[y1 * coarseSize + x2] - coarse[y1 * coarseSize + x1]) * dx;
+  double h2 = coarse[y2 * coarseSize + x1] +
+      (coarse[y2 * coarseSize + x2] - coarse[y2 * coarseSize + x1]) * dx;
+  return h1 + (h2 - h1) * dy;
+}
+
+//////////////////////////////////////////////////
+void HeightmapShape::UpdateTiles(
+    const std::vector<ignition::math::Vector2d> &_vertices,
+    const double _radius)
+{
+  if (this->dataPtr->tileSize == 0)
+    return;
+
+  const double size = this->dataPtr->tileSize;
+  const double last = this->vertSize - 1;
+  const int lastTile = static_cast<int>(this->dataPtr->tileCount) - 1;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->tilesMutex);
+  const uint64_t generation = ++this->dataPtr->generation;
+
+  for (const auto &vertex : _vertices)
+  {
+    // Skip vertices whose neighbourhood is entirely off the heightmap
+    if (vertex.X() + _radius < 0 || vertex.X() - _radius > last ||
+        vertex.Y() + _radius < 0 || vertex.Y() - _radius > last)
+    {
+      continue;
+    }
+
+    const int x0 = std::clamp(
+        static_cast<int>(std::floor((vertex.X() - _radius) / size)),
+        0, lastTile);
+    const int x1 = std::clamp(
+        static_cast<int>(std::floor((vertex.X() + _radius) / size)),
+        0, lastTile);
+    const int y0 = std::clamp(
+        static_cast<int>(std::floor((vertex.Y() - _radius) / size)),
+        0, lastTile);
+    const int y1 = std::clamp(
+        static_cast<int>(std::floor((vertex.Y() + _radius) / size)),
+        0, lastTile);
+
+    for (int ty = y0; ty <= y1; ++ty)
+    {
+      for (int tx = x0; tx <= x1; ++tx)
+      {
+        auto iter =
+            this->dataPtr->tiles.find(ty * this->dataPtr->tileCount + tx);
+        if (iter == this->dataPtr->tiles.end())
+          this->LoadTile(tx, ty).needed = generation;
+        else
+        {
+          iter->second.lastUsed = ++this->dataPtr->useClock;
+          iter->second.needed = generation;
+        }
+      }
+    }
+  }
+
+  // Evict the least recently used tiles that are not needed now
+  this->EvictTiles(std::numeric_limits<unsigned int>::max());
+}
+
+//////////////////////////////////////////////////
+bool HeightmapShape::Tiled() const
+{
+  return this->dataPtr->tileSize > 0;
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapShape::TileSize() const
+{
+  return this->dataPtr->tileSize;
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapShape::LoadedTileCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->tilesMutex);
+  return this->dataPtr->tiles.size();
+}
+
+//////////////////////////////////////////////////
+double HeightmapShape::TileRadius() const
+{
+  return this->dataPtr->tileRadius;
 }
 
 //////////////////////////////////////////////////
@@ -294,12 +618,35 @@ void HeightmapShape::FillMsg(msgs::Geometry &_msg)
 //////////////////////////////////////////////////
 void HeightmapShape::FillHeights(msgs::Geometry &_msg) const
 {
+  // Read tiled heights a band of rows at a time, rather than loading every
+  // tile into the cache.
+  if (this->dataPtr->tileSize > 0)
+  {
+    auto *heights = _msg.mutable_heightmap()->mutable_heights();
+    heights->Reserve(heights->size() +
+        static_cast<int>(this->vertSize * this->vertSize));
+
+    std::vector<float> band;
+    for (unsigned int end = this->vertSize; end > 0;)
+    {
+      const unsigned int rows = std::min(end, this->dataPtr->tileSize);
+      this->ReadRows(end - rows, rows, band);
+      for (unsigned int r = rows; r > 0; --r)
+      {
+        for (unsigned int x = 0; x < this->vertSize; ++x)
+          heights->Add(band[(r - 1) * this->vertSize + x]);
+      }
+      end -= rows;
+    }
+    return;
+  }
+
   for (unsigned int y = 0; y < this->vertSize; ++y)
   {
     for (unsigned int x = 0; x < this->vertSize; ++x)
     {
-      int index = (this->vertSize - y - 1) * this->vertSize + x;
-      _msg.mutable_heightmap()->add_heights(this->heights[index]);
+      _msg.mutable_heightmap()->add_heights(
+          this->GetHeight(x, this->vertSize - y - 1));
     }
   }
 }
@@ -319,6 +666,9 @@ ignition::math::Vector2i HeightmapShape::VertexCount() const
 /////////////////////////////////////////////////
 HeightmapShape::HeightType HeightmapShape::GetHeight(int _x, int _y) const
 {
+  if (this->dataPtr->tileSize > 0)
+    return this->TileHeight(_x, _y, false);
+
   int index =  _y * this->vertSize + _x;
   if (_x < 0 || _y < 0 || index >= static_cast<int>(this->heights.size()))
     return 0.0;
@@ -326,9 +676,22 @@ HeightmapShape::HeightType HeightmapShape::GetHeight(int _x, int _y) const
   return this->heights[index];
 }
 
+/////////////////////////////////////////////////
+HeightmapShape::HeightType HeightmapShape::CollisionHeight(int _x,
+    int _y) const
+{
+  if (this->dataPtr->tileSize > 0)
+    return this->TileHeight(_x, _y, true);
+
+  return this->GetHeight(_x, _y);
+}
+
 /////////////////////////////////////////////////
 HeightmapShape::HeightType HeightmapShape::GetMaxHeight() const
 {
+  if (this->dataPtr->tileSize > 0)
+    return this->dataPtr->maxHeight;
+
   HeightType max = -std::numeric_limits<HeightType>::max();
   for (unsigned int i = 0; i < this->heights.size(); ++i)
   {
@@ -342,6 +705,9 @@ HeightmapShape::HeightType HeightmapShape::GetMaxHeight() const
 /////////////////////////////////////////////////
 HeightmapShape::HeightType HeightmapShape::GetMinHeight() const
 {
+  if (this->dataPtr->tileSize > 0)
+    return this->dataPtr->minHeight;
+
   HeightType min = std::numeric_limits<HeightType>::max();
   for (unsigned int i = 0; i < this->heights.size(); ++i)
   {
@@ -367,21 +733,39 @@ common::Image HeightmapShape::GetImage() const
   // Create the image data buffer
   imageData = new unsigned char[size * size];
 
+  // Tiled heights are read a row at a time, rather than loading every
+  // tile into the cache.
+  const bool tiled = this->dataPtr->tileSize > 0;
+  std::vector<float> row;
+
   // Get height data from all vertices
   for (uint16_t y = 0; y < size; ++y)
   {
+    int sy;
+    if (!this->flipY)
+      sy = static_cast<int>(y * this->subSampling);
+    else
+      sy = static_cast<int>(size - 1 -y) * this->subSampling;
+
+    if (tiled)
+    {
+      if (sy < static_cast<int>(this->vertSize))
+        this->ReadRows(sy, 1, row);
+      else
+        row.assign(this->vertSize, 0.0f);
+    }
+
     for (uint16_t x = 0; x < size; ++x)
     {
       int sx = static_cast<int>(x * this->subSampling);
-      int sy;
-
-      if (!this->flipY)
-        sy = static_cast<int>(y * this->subSampling);
-      else
-        sy = static_cast<int>(size - 1 -y) * this->subSampling;
 
       // Normalize height value
-      height = (this->GetHeight(sx, sy) - minHeight) / maxHeight;
+      double value;
+      if (!tiled)
+        value = this->GetHeight(sx, sy);
+      else
+        value = sx < static_cast<int>(this->vertSize) ? row[sx] : 0.0;
+      height = (value - minHeight) / maxHeight;
 
       GZ_ASSERT(height <= 1.0, "Normalized terrain height > 1.0");
       GZ_ASSERT(height >= 0.0, "Normalized terrain height < 0.0");
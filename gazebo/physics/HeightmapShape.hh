@@ -17,6 +17,7 @@
 #ifndef GAZEBO_PHYSICS_HEIGHTMAPSHAPE_HH_
 #define GAZEBO_PHYSICS_HEIGHTMAPSHAPE_HH_
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <ignition/transport/Node.hh>
@@ -35,6 +36,10 @@ namespace gazebo
 {
   namespace physics
   {
+    // Forward declare private data class
+    class HeightmapShapePrivate;
+    class HeightmapTile;
+
     /// \addtogroup gazebo_physics
     /// \{
 
@@ -128,6 +133,78 @@ namespace gazebo
       /// and black pixels the lowest.
       public: common::Image GetImage() const;
 
+      /// \brief Get whether the heights are paged in square tiles instead
+      /// of being held in a single lookup table. Tiling is requested with
+      /// the <gz:tile_size> element of the heightmap, and only takes effect
+      /// with physics engines that support it.
+      /// \return True if the heights are tiled.
+      public: bool Tiled() const;
+
+      /// \brief Get the number of vertex intervals along a side of a tile.
+      /// \return The tile size, or 0 if the heights are not tiled.
+      public: unsigned int TileSize() const;
+
+      /// \brief Get the number of tiles currently held in memory.
+      /// \return Number of loaded tiles.
+      public: unsigned int LoadedTileCount() const;
+
+      /// \brief Load the tiles around a set of vertices, then evict the
+      /// least recently used tiles beyond the <gz:max_tiles> limit. Tiles
+      /// around the given vertices are never evicted. Does nothing if the
+      /// heights are not tiled.
+      /// \param[in] _vertices Vertex coordinates to load tiles around.
+      /// \param[in] _radius Radius to load around each vertex, in vertices.
+      public: void UpdateTiles(
+          const std::vector<ignition::math::Vector2d> &_vertices,
+          const double _radius);
+
+      /// \brief Get the height to use for collision at a vertex. Outside
+      /// of the loaded tiles, this comes from the coarse grid requested
+      /// with <gz:far_stride> if there is one.
+      /// \param[in] _x X position.
+      /// \param[in] _y Y position.
+      /// \return The collision height at the specified location.
+      protected: HeightType CollisionHeight(int _x, int _y) const;
+
+      /// \brief Get the radius around active links in which tiles are kept.
+      /// \return The radius in meters.
+      protected: double TileRadius() const;
+
+      /// \brief Set up the tiles and the coarse grid, in place of filling
+      /// the lookup table.
+      private: void InitTiles();
+
+      /// \brief Get a height from the tiles.
+      /// \param[in] _x X position.
+      /// \param[in] _y Y position.
+      /// \param[in] _coarse True to use the coarse grid, if any, when the
+      /// tile is not loaded. Otherwise the tile is loaded.
+      /// \return The height at the specified location.
+      private: HeightType TileHeight(int _x, int _y, bool _coarse) const;
+
+      /// \brief Fill a tile and add it to the loaded tiles, then evict the
+      /// least recently used tiles beyond the <gz:max_tiles> limit. The
+      /// tiles mutex must be locked.
+      /// \param[in] _tx Column of the tile.
+      /// \param[in] _ty Row of the tile.
+      /// \return The loaded tile.
+      private: HeightmapTile &LoadTile(unsigned int _tx,
+          unsigned int _ty) const;
+
+      /// \brief Evict the least recently used tiles beyond the
+      /// <gz:max_tiles> limit, except the ones needed by the last call to
+      /// UpdateTiles. The tiles mutex must be locked.
+      /// \param[in] _keep Index of a tile which is not evicted either.
+      private: void EvictTiles(const unsigned int _keep) const;
+
+      /// \brief Fill rows of heights straight from the heightmap data,
+      /// without loading tiles, for reads of the whole terrain.
+      /// \param[in] _y First row.
+      /// \param[in] _rows Number of rows.
+      /// \param[out] _heights Heights of the rows, row by row.
+      private: void ReadRows(const unsigned int _y, const unsigned int _rows,
+          std::vector<float> &_heights) const;
+
       /// \brief Load a terrain file specified by _filename. The terrain file
       /// format might be an image or a DEM file. libgdal is required to enable
       /// DEM support. For a list of all raster formats supported you can type
@@ -166,6 +243,10 @@ namespace gazebo
       /// \brief The amount of subsampling. Default is 2.
       protected: int subSampling;
 
+      /// \brief True if the physics engine reads the heights through
+      /// GetHeight or CollisionHeight, which is required for tiling.
+      protected: bool tilingSupported;
+
       /// \brief Transportation node.
       private: transport::NodePtr node;
 
@@ -186,6 +267,10 @@ namespace gazebo
       private: common::Dem dem;
       #endif
 
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<HeightmapShapePrivate> dataPtr;
+
       // Place ignition::transport objects at the end of this file to
       // guarantee they are destructed first.
 
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_HEIGHTMAPSHAPE_PRIVATE_HH_
+#define GAZEBO_PHYSICS_HEIGHTMAPSHAPE_PRIVATE_HH_
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "gazebo/physics/HeightmapShape.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief A square block of the height lookup table. Neighbouring tiles
+    /// share their edge vertices.
+    class HeightmapTile
+    {
+      /// \brief Heights of the tile, row by row.
+      public: std::vector<HeightmapShape::HeightType> heights;
+
+      /// \brief Value of HeightmapShapePrivate::useClock when the tile
+      /// was last read or loaded.
+      public: uint64_t lastUsed = 0;
+
+      /// \brief Value of HeightmapShapePrivate::generation when the tile
+      /// was last needed by UpdateTiles.
+      public: uint64_t needed = 0;
+    };
+
+    /// \internal
+    /// \brief Private data for the HeightmapShape class
+    class HeightmapShapePrivate
+    {
+      /// \brief Number of vertex intervals along a side of a tile, 0 if the
+      /// heights are held in a single lookup table.
+      public: unsigned int tileSize = 0;
+
+      /// \brief Number of tiles along a side of the heightmap.
+      public: unsigned int tileCount = 0;
+
+      /// \brief Radius in meters around active links where tiles are kept.
+      public: double tileRadius = 0;
+
+      /// \brief Number of tiles kept in memory before the least recently
+      /// used ones are evicted.
+      public: unsigned int maxTiles = 64;
+
+      /// \brief Distance in vertices between the samples of the coarse
+      /// grid used away from the loaded tiles, 0 to disable it.
+      public: unsigned int farStride = 0;
+
+      /// \brief Number of vertices along a side of the coarse grid.
+      public: unsigned int coarseSize = 0;
+
+      /// \brief Heights of the coarse grid, row by row.
+      public: std::vector<HeightmapShape::HeightType> coarseHeights;
+
+      /// \brief Loaded tiles, indexed by row * tileCount + column.
+      public: std::unordered_map<unsigned int, HeightmapTile> tiles;
+
+      /// \brief Incremented on each call to UpdateTiles.
+      public: uint64_t generation = 0;
+
+      /// \brief Incremented on each read or load of a tile, orders the
+      /// tiles for eviction.
+      public: uint64_t useClock = 0;
+
+      /// \brief Lower bound of the heights when tiled.
+      public: HeightmapShape::HeightType minHeight = 0;
+
+      /// \brief Upper bound of the heights when tiled.
+      public: HeightmapShape::HeightType maxHeight = 0;
+
+      /// \brief Protects the tiles, which are read from the collision
+      /// and sensor threads.
+      public: std::mutex tilesMutex;
+    };
+  }
+}
+#endif
@@ -125,6 +125,9 @@ namespace gazebo
         return _out;
       }
 
+      /// \brief Snapshots fill states directly from their flat data.
+      private: friend class WorldSnapshotPrivate;
+
       /// \brief Pose of the light.
       private: ignition::math::Pose3d pose;
     };
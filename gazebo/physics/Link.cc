@@ -295,7 +295,7 @@ void Link::Load(sdf::ElementPtr _sdf)
   this->sdf->GetElement("enable_wind")->GetValue()->SetUpdateFunc(
       std::bind(&Link::WindMode, this));
 
-  this->connections.push_back(event::Events::ConnectWorldUpdateBegin(
+  this->connections.push_back(this->world->ConnectUpdateBegin(
       std::bind(
       static_cast<void(Link::*)(const common::UpdateInfo &)>(&Link::Update),
       this, std::placeholders::_1)));
@@ -853,7 +853,7 @@ void Link::SetWindEnabled(const bool _enable)
 {
   if (_enable)
   {
-    this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
+    this->dataPtr->updateConnection = this->world->ConnectUpdateBegin(
         std::bind(&Link::UpdateWind, this, std::placeholders::_1));
   }
   else
@@ -1237,7 +1237,7 @@ void Link::SetPublishData(bool _enable)
     std::string topic = "~/" + this->GetScopedName();
     this->dataPtr->dataPub = this->node->Advertise<msgs::LinkData>(topic);
     this->connections.push_back(
-      event::Events::ConnectWorldUpdateEnd(
+      this->world->ConnectUpdateEnd(
         std::bind(&Link::PublishData, this)));
   }
   else
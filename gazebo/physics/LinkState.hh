@@ -239,6 +239,9 @@ namespace gazebo
       /// \return True if link velocity is recorded
       public: bool RecordVelocity() const;
 
+      /// \brief Snapshots fill states directly from their flat data.
+      private: friend class WorldSnapshotPrivate;
+
       /// \brief 3D pose of the link relative to the model.
       private: ignition::math::Pose3d pose;
 
@@ -285,6 +285,9 @@ namespace gazebo
         return _out;
       }
 
+      /// \brief Snapshots fill states directly from their flat data.
+      private: friend class WorldSnapshotPrivate;
+
       /// \brief Pose of the model.
       private: ignition::math::Pose3d pose;
 
@@ -17,6 +17,8 @@
 #include "gazebo/common/Exception.hh"
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/MultiRayShape.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/World.hh"
 
 using namespace gazebo;
 using namespace physics;
@@ -177,13 +179,37 @@ void MultiRayShape::Update()
   {
     this->rays[i]->SetLength(fullRange);
     this->rays[i]->SetRetro(0.0);
+    this->rays[i]->SetCollisionName("");
 
     // Get the global points of the line
     this->rays[i]->Update();
   }
 
-  // do actual collision checks
-  this->UpdateRays();
+  // Cast all the rays at once when the physics engine supports it,
+  // otherwise do actual collision checks
+  this->rayCasts.resize(raySize);
+  for (unsigned int i = 0; i < raySize; ++i)
+  {
+    this->rays[i]->GlobalPoints(this->rayCasts[i].start,
+        this->rayCasts[i].end);
+  }
+
+  PhysicsEnginePtr engine = this->GetWorld()->Physics();
+  if (engine && engine->CastRays(this->rayCasts))
+  {
+    for (unsigned int i = 0; i < raySize; ++i)
+    {
+      const RayCast &cast = this->rayCasts[i];
+      if (cast.collision.empty())
+        continue;
+
+      this->rays[i]->SetLength(cast.distance);
+      this->rays[i]->SetRetro(cast.retro);
+      this->rays[i]->SetCollisionName(cast.collision);
+    }
+  }
+  else
+    this->UpdateRays();
 
   // for plugin
   this->newLaserScans();
@@ -22,6 +22,7 @@
 #include <ignition/math/Angle.hh>
 
 #include "gazebo/physics/Collision.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/Shape.hh"
 #include "gazebo/physics/RayShape.hh"
 #include "gazebo/util/system.hh"
@@ -208,6 +209,10 @@ namespace gazebo
 
       /// \brief Max range of a ray
       private: double maxRange = 1000;
+
+      /// \brief Rays passed to PhysicsEngine::CastRays, reused across
+      /// updates.
+      private: std::vector<RayCast> rayCasts;
     };
     /// \}
   }
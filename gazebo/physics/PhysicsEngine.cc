@@ -15,6 +15,8 @@
  *
 */
 
+#include <algorithm>
+
 #include <boost/lexical_cast.hpp>
 
 #include <sdf/sdf.hh>
@@ -202,6 +204,18 @@ void PhysicsEngine::SetMaxContacts(unsigned int /*_maxContacts*/)
 {
 }
 
+//////////////////////////////////////////////////
+void PhysicsEngine::SaveSolverState(std::string &_state) const
+{
+  _state.clear();
+}
+
+//////////////////////////////////////////////////
+bool PhysicsEngine::RestoreSolverState(const std::string &_state)
+{
+  return _state.empty();
+}
+
 //////////////////////////////////////////////////
 void PhysicsEngine::OnRequest(ConstRequestPtr &/*_msg*/)
 {
@@ -211,6 +225,9 @@ void PhysicsEngine::OnRequest(ConstRequestPtr &/*_msg*/)
 void PhysicsEngine::OnPhysicsMsg(ConstPhysicsPtr &_msg)
 {
   this->world->PresetMgr()->CurrentProfile(_msg->profile_name());
+
+  if (_msg->has_model_update_threads())
+    this->world->SetModelUpdateThreads(_msg->model_update_threads());
 }
 
 //////////////////////////////////////////////////
@@ -243,6 +260,12 @@ bool PhysicsEngine::SetParam(const std::string &_key,
       this->world->SetMagneticField(
           any_cast<ignition::math::Vector3d>(copy));
     }
+    else if (_key == "model_update_threads")
+    {
+      int value = any_cast<int>(_value);
+      this->world->SetModelUpdateThreads(
+          static_cast<unsigned int>(std::max(value, 0)));
+    }
     else
     {
       gzwarn << "SetParam failed for [" << _key << "] in physics engine "
@@ -295,6 +318,8 @@ bool PhysicsEngine::GetParam(const std::string &_key,
     _value = this->world->Gravity();
   else if (_key == "magnetic_field")
     _value = this->world->MagneticField();
+  else if (_key == "model_update_threads")
+    _value = static_cast<int>(this->world->ModelUpdateThreads());
   else
   {
     gzwarn << "GetParam failed for [" << _key << "] in physics engine "
@@ -305,6 +330,12 @@ bool PhysicsEngine::GetParam(const std::string &_key,
   return true;
 }
 
+//////////////////////////////////////////////////
+bool PhysicsEngine::CastRays(std::vector<RayCast> &/*_rays*/)
+{
+  return false;
+}
+
 //////////////////////////////////////////////////
 ContactManager *PhysicsEngine::GetContactManager() const
 {
@@ -20,6 +20,8 @@
 #include <boost/thread/recursive_mutex.hpp>
 #include <boost/any.hpp>
 #include <string>
+#include <vector>
+#include <ignition/math/Vector3.hh>
 #include <ignition/transport/Node.hh>
 
 #include "gazebo/transport/TransportTypes.hh"
@@ -34,6 +36,26 @@ namespace gazebo
   {
     class ContactManager;
 
+    /// \brief A ray of a batch cast by PhysicsEngine::CastRays.
+    struct RayCast
+    {
+      /// \brief Start of the ray, in the world frame.
+      ignition::math::Vector3d start;
+
+      /// \brief End of the ray, in the world frame.
+      ignition::math::Vector3d end;
+
+      /// \brief Distance from the start to the closest hit, or the length
+      /// of the ray if nothing was hit.
+      double distance = 0;
+
+      /// \brief Laser retro value of the hit collision, 0 if none.
+      double retro = 0;
+
+      /// \brief Scoped name of the hit collision, empty if none.
+      std::string collision;
+    };
+
     /// \addtogroup gazebo_physics
     /// \{
 
@@ -97,6 +119,20 @@ namespace gazebo
       /// \param[in] _seed The random number seed.
       public: virtual void SetSeed(uint32_t _seed) = 0;
 
+      /// \brief Save the solver state that is not part of the state of the
+      /// entities, such as warm start data and the state of the random
+      /// number generator of the engine. Nothing is saved by default.
+      /// \param[out] _state Engine specific data.
+      /// \sa RestoreSolverState
+      public: virtual void SaveSolverState(std::string &_state) const;
+
+      /// \brief Restore solver state saved by SaveSolverState, in a world
+      /// with the same entities.
+      /// \param[in] _state Data saved by SaveSolverState.
+      /// \return False if _state does not fit this engine and world, in
+      /// which case nothing is restored.
+      public: virtual bool RestoreSolverState(const std::string &_state);
+
       /// \brief Get the simulation update period.
       /// \return Simulation update period.
       public: double GetUpdatePeriod();
@@ -242,6 +278,16 @@ namespace gazebo
       /// \return Pointer to the world.
       public: WorldPtr World() const;
 
+      /// \brief Cast a batch of rays against the collisions of the world.
+      /// Rays hit the same collisions as a MultiRayShape, i.e. all
+      /// collisions but the sensor collisions. This can be called from any
+      /// thread.
+      /// \param[in,out] _rays Rays to cast. The start and end of each ray
+      /// are read, and its hit is written.
+      /// \return False if the physics engine does not support batches, in
+      /// which case the rays are left unchanged.
+      public: virtual bool CastRays(std::vector<RayCast> &_rays);
+
       /// \brief Get a pointer to the contact manger.
       /// \return Pointer to the contact manager.
       public: ContactManager *GetContactManager() const;
@@ -52,6 +52,8 @@ namespace gazebo
     class UserCmdManager;
     class PhysicsEngine;
     class Wind;
+    class RealTimePacer;
+    class SpatialIndex;
     class Atmosphere;
     class Mass;
     class Road;
@@ -67,6 +69,10 @@ namespace gazebo
     class PlaneShape;
     class HeightmapShape;
     class PolylineShape;
+    class WorldState;
+    class WorldSnapshot;
+    class WorldBatch;
+    class WorldCheckpoint;
     class ModelState;
     class LightState;
     class LinkState;
@@ -0,0 +1,335 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifdef __linux__
+#include <time.h>
+#include <cerrno>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <thread>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/physics/RealTimePacer.hh"
+
+/// \brief Clock of the deadlines.
+using PacerClock = std::chrono::steady_clock;
+
+/////////////////////////////////////////////////
+/// \brief Convert a duration to seconds.
+/// \param[in] _duration Duration.
+/// \return Seconds.
+static double Seconds(const PacerClock::duration &_duration)
+{
+  return std::chrono::duration<double>(_duration).count();
+}
+
+/////////////////////////////////////////////////
+/// \brief Sleep until an absolute deadline.
+/// \param[in] _deadline Time to wake up.
+static void SleepUntil(const PacerClock::time_point &_deadline)
+{
+#ifdef __linux__
+  // steady_clock reads CLOCK_MONOTONIC on Linux.
+  const auto sinceEpoch = _deadline.time_since_epoch();
+  const auto sec = std::chrono::duration_cast<std::chrono::seconds>(
+      sinceEpoch);
+  struct timespec ts;
+  ts.tv_sec = sec.count();
+  ts.tv_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      sinceEpoch - sec).count();
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) ==
+      EINTR)
+  {
+  }
+#else
+  std::this_thread::sleep_until(_deadline);
+#endif
+}
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Private data for the RealTimePacer class
+    class RealTimePacerPrivate
+    {
+      /// \brief Add a step to the statistics.
+      /// \param[in] _late Time by which the step started after it was due,
+      /// in seconds. Negative if it started early.
+      /// \param[in] _period Update period in seconds.
+      public: void Record(const double _late, const double _period);
+
+      /// \brief Pacing mode.
+      public: std::atomic<int> mode{RealTimePacer::SLEEP};
+
+      /// \brief Spin time of the hybrid mode in seconds.
+      public: std::atomic<double> spinTime{0.001};
+
+      /// \brief True to restart the deadlines at the next wait.
+      public: std::atomic<bool> restart{true};
+
+      /// \brief Start of the previous step in the sleep mode, deadline of
+      /// the previous step in the other modes. Only used by the waiting
+      /// thread.
+      public: PacerClock::time_point prev;
+
+      /// \brief Average oversleep of the sleep mode in seconds. Only used
+      /// by the waiting thread.
+      public: double sleepOffset = 0;
+
+      /// \brief Mutex to protect the statistics.
+      public: mutable std::mutex mutex;
+
+      /// \brief Number of steps recorded.
+      public: uint64_t stepCount = 0;
+
+      /// \brief Number of overruns.
+      public: uint64_t overrunCount = 0;
+
+      /// \brief Sum of the jitter in seconds.
+      public: double jitterSum = 0;
+
+      /// \brief Largest jitter in seconds.
+      public: double jitterMax = 0;
+
+      /// \brief Number of steps in each bucket of the jitter histogram.
+      public: std::vector<uint64_t> histogram = std::vector<uint64_t>(
+                  RealTimePacer::HistogramEdges().size() + 1, 0);
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+/////////////////////////////////////////////////
+void RealTimePacerPrivate::Record(const double _late, const double _period)
+{
+  const double jitter = std::abs(_late);
+  const auto &edges = RealTimePacer::HistogramEdges();
+  const size_t bucket = std::upper_bound(edges.begin(), edges.end(), jitter) -
+      edges.begin();
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  ++this->stepCount;
+  if (_late >= _period)
+    ++this->overrunCount;
+  this->jitterSum += jitter;
+  this->jitterMax = std::max(this->jitterMax, jitter);
+  ++this->histogram[bucket];
+}
+
+/////////////////////////////////////////////////
+RealTimePacer::RealTimePacer()
+  : dataPtr(new RealTimePacerPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+RealTimePacer::~RealTimePacer()
+{
+}
+
+/////////////////////////////////////////////////
+void RealTimePacer::SetMode(const PacingMode _mode)
+{
+  this->dataPtr->mode = _mode;
+  this->dataPtr->restart = true;
+}
+
+/////////////////////////////////////////////////
+RealTimePacer::PacingMode RealTimePacer::Mode() const
+{
+  return static_cast<PacingMode>(this->dataPtr->mode.load());
+}
+
+/////////////////////////////////////////////////
+bool RealTimePacer::ModeFromString(const std::string &_name,
+    PacingMode &_mode)
+{
+  if (_name == "sleep")
+    _mode = SLEEP;
+  else if (_name == "hybrid")
+    _mode = HYBRID;
+  else if (_name == "deadline")
+    _mode = DEADLINE;
+  else
+    return false;
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+void RealTimePacer::SetSpinTime(const double _seconds)
+{
+  this->dataPtr->spinTime = std::max(0.0, _seconds);
+}
+
+/////////////////////////////////////////////////
+double RealTimePacer::SpinTime() const
+{
+  return this->dataPtr->spinTime;
+}
+
+/////////////////////////////////////////////////
+void RealTimePacer::Restart()
+{
+  this->dataPtr->restart = true;
+}
+
+/////////////////////////////////////////////////
+bool RealTimePacer::Wait(const double _period)
+{
+  const auto period = std::chrono::duration_cast<PacerClock::duration>(
+      std::chrono::duration<double>(_period));
+
+  PacerClock::time_point now = PacerClock::now();
+  if (this->dataPtr->restart.exchange(false))
+  {
+    this->dataPtr->prev = now;
+    this->dataPtr->sleepOffset = 0;
+  }
+
+  const PacingMode mode = this->Mode();
+  if (mode == SLEEP)
+  {
+    // sleep here to get the correct update rate
+    double sleepTime = Seconds(this->dataPtr->prev + period - now) -
+      this->dataPtr->sleepOffset;
+
+    double actualSleep = 0;
+    if (sleepTime > 0)
+    {
+      common::Time::Sleep(common::Time(sleepTime));
+      actualSleep = Seconds(PacerClock::now() - now);
+    }
+    else
+      sleepTime = 0;
+
+    // exponentially avg out
+    this->dataPtr->sleepOffset = (actualSleep - sleepTime) * 0.01 +
+      this->dataPtr->sleepOffset * 0.99;
+
+    // throttling update rate, with sleepOffset as tolerance
+    // the tolerance is needed as the sleep time is not exact
+    now = PacerClock::now();
+    const double late = Seconds(now - this->dataPtr->prev) - _period;
+    if (late + this->dataPtr->sleepOffset < 0)
+      return false;
+
+    this->dataPtr->Record(late, _period);
+    this->dataPtr->prev = now;
+    return true;
+  }
+
+  const PacerClock::time_point deadline = this->dataPtr->prev + period;
+  if (now < deadline)
+  {
+    if (mode == HYBRID)
+    {
+      // Sleeping wakes up late by a scheduler quantum, spin the rest.
+      const PacerClock::time_point spinStart = deadline -
+        std::chrono::duration_cast<PacerClock::duration>(
+            std::chrono::duration<double>(this->dataPtr->spinTime.load()));
+      if (now < spinStart)
+        SleepUntil(spinStart);
+
+      while (PacerClock::now() < deadline)
+      {
+      }
+    }
+    else
+    {
+      SleepUntil(deadline);
+    }
+    now = PacerClock::now();
+  }
+
+  const double late = Seconds(now - deadline);
+  this->dataPtr->Record(late, _period);
+
+  // Follow the deadlines, so that a late step does not delay the next
+  // ones, unless a whole period was missed. Catching up would then run a
+  // burst of steps.
+  this->dataPtr->prev = late >= _period ? now : deadline;
+  return true;
+}
+
+/////////////////////////////////////////////////
+uint64_t RealTimePacer::StepCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->stepCount;
+}
+
+/////////////////////////////////////////////////
+uint64_t RealTimePacer::OverrunCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->overrunCount;
+}
+
+/////////////////////////////////////////////////
+double RealTimePacer::JitterMean() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->stepCount == 0)
+    return 0;
+  return this->dataPtr->jitterSum / this->dataPtr->stepCount;
+}
+
+/////////////////////////////////////////////////
+double RealTimePacer::JitterMax() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->jitterMax;
+}
+
+/////////////////////////////////////////////////
+std::vector<uint64_t> RealTimePacer::JitterHistogram() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->histogram;
+}
+
+/////////////////////////////////////////////////
+const std::vector<double> &RealTimePacer::HistogramEdges()
+{
+  static const std::vector<double> edges =
+  {
+    1e-6, 2e-6, 5e-6, 1e-5, 2e-5, 5e-5, 1e-4, 2e-4, 5e-4,
+    1e-3, 2e-3, 5e-3, 1e-2
+  };
+  return edges;
+}
+
+/////////////////////////////////////////////////
+void RealTimePacer::ResetStatistics()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->stepCount = 0;
+  this->dataPtr->overrunCount = 0;
+  this->dataPtr->jitterSum = 0;
+  this->dataPtr->jitterMax = 0;
+  std::fill(this->dataPtr->histogram.begin(),
+      this->dataPtr->histogram.end(), 0);
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_REALTIMEPACER_HH_
+#define GAZEBO_PHYSICS_REALTIMEPACER_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class.
+    class RealTimePacerPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class RealTimePacer RealTimePacer.hh physics/physics.hh
+    /// \brief Paces a loop to a real time update period, and keeps
+    /// statistics of how late each step starts.
+    ///
+    /// The World paces World::Step with it when the real time update rate
+    /// is not 0, see World::Pacer. The pacing mode is set with the
+    /// `<gz:real_time_pacing>` element of the world, and the spin time of
+    /// the hybrid mode with `<gz:pacing_spin_time>`.
+    ///
+    /// The jitter of a step is the absolute difference between the time it
+    /// starts and the time it is due. A step is an overrun when it starts
+    /// one period or more after it is due. All functions are thread safe.
+    class GZ_PHYSICS_VISIBLE RealTimePacer
+    {
+      /// \brief How the pacer waits for the next step.
+      public: enum PacingMode
+              {
+                /// \brief Sleep for the remaining time, corrected by an
+                /// average of the past oversleep. A step which is not due
+                /// after the sleep is skipped. This is the default.
+                SLEEP,
+
+                /// \brief Sleep until shortly before the step is due, then
+                /// spin until it is. Steps follow absolute deadlines.
+                HYBRID,
+
+                /// \brief Sleep until an absolute deadline, with
+                /// clock_nanosleep where available. Steps follow absolute
+                /// deadlines.
+                DEADLINE
+              };
+
+      /// \brief Constructor.
+      public: RealTimePacer();
+
+      /// \brief Destructor.
+      public: virtual ~RealTimePacer();
+
+      /// \brief Set the pacing mode. Restarts the sequence of deadlines.
+      /// \param[in] _mode Pacing mode.
+      public: void SetMode(const PacingMode _mode);
+
+      /// \brief Get the pacing mode.
+      /// \return Pacing mode.
+      public: PacingMode Mode() const;
+
+      /// \brief Convert a mode name, one of "sleep", "hybrid" and
+      /// "deadline", to a pacing mode.
+      /// \param[in] _name Mode name.
+      /// \param[out] _mode Pacing mode, unchanged if the name is unknown.
+      /// \return True if the name is known.
+      public: static bool ModeFromString(const std::string &_name,
+                                         PacingMode &_mode);
+
+      /// \brief Set the time spent spinning before a step is due in the
+      /// hybrid mode.
+      /// \param[in] _seconds Spin time in seconds, negative values are
+      /// clamped to 0. Defaults to 0.001.
+      public: void SetSpinTime(const double _seconds);
+
+      /// \brief Get the time spent spinning before a step is due in the
+      /// hybrid mode.
+      /// \return Spin time in seconds.
+      public: double SpinTime() const;
+
+      /// \brief Restart the sequence of deadlines from now, e.g. when the
+      /// loop starts.
+      public: void Restart();
+
+      /// \brief Wait until the next step is due.
+      /// \param[in] _period Update period in seconds.
+      /// \return True if the step is due, false if it must be skipped.
+      /// Only the sleep mode skips steps.
+      public: bool Wait(const double _period);
+
+      /// \brief Get the number of steps recorded in the statistics.
+      /// \return Number of steps.
+      public: uint64_t StepCount() const;
+
+      /// \brief Get the number of steps which started one period or more
+      /// after they were due.
+      /// \return Number of overruns.
+      public: uint64_t OverrunCount() const;
+
+      /// \brief Get the average jitter of the steps.
+      /// \return Jitter in seconds.
+      public: double JitterMean() const;
+
+      /// \brief Get the largest jitter of the steps.
+      /// \return Jitter in seconds.
+      public: double JitterMax() const;
+
+      /// \brief Get the histogram of the jitter. Bucket i counts the steps
+      /// whose jitter is less than HistogramEdges()[i] and not less than
+      /// the previous edge. The last bucket counts the remaining steps.
+      /// \return Number of steps in each bucket, one more than the edges.
+      public: std::vector<uint64_t> JitterHistogram() const;
+
+      /// \brief Get the upper edges of the jitter histogram buckets.
+      /// \return Edges in seconds, increasing.
+      public: static const std::vector<double> &HistogramEdges();
+
+      /// \brief Clear the statistics.
+      public: void ResetStatistics();
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<RealTimePacerPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <numeric>
+
+#include "test/util.hh"
+#include "gazebo/common/Time.hh"
+#include "gazebo/physics/RealTimePacer.hh"
+
+using namespace gazebo;
+
+class RealTimePacerTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Wait for a number of steps and return the wall time it took.
+/// \param[in] _pacer Pacer.
+/// \param[in] _period Update period in seconds.
+/// \param[in] _steps Number of steps to take.
+/// \return Elapsed wall time in seconds.
+static double PaceSteps(physics::RealTimePacer &_pacer, const double _period,
+    const unsigned int _steps)
+{
+  const common::Time start = common::Time::GetWallTime();
+  unsigned int steps = 0;
+  while (steps < _steps)
+  {
+    if (_pacer.Wait(_period))
+      ++steps;
+  }
+  return (common::Time::GetWallTime() - start).Double();
+}
+
+/////////////////////////////////////////////////
+TEST_F(RealTimePacerTest, Configuration)
+{
+  physics::RealTimePacer pacer;
+  EXPECT_EQ(pacer.Mode(), physics::RealTimePacer::SLEEP);
+  EXPECT_DOUBLE_EQ(pacer.SpinTime(), 0.001);
+
+  physics::RealTimePacer::PacingMode mode = physics::RealTimePacer::SLEEP;
+  EXPECT_TRUE(physics::RealTimePacer::ModeFromString("hybrid", mode));
+  EXPECT_EQ(mode, physics::RealTimePacer::HYBRID);
+  EXPECT_TRUE(physics::RealTimePacer::ModeFromString("deadline", mode));
+  EXPECT_EQ(mode, physics::RealTimePacer::DEADLINE);
+  EXPECT_TRUE(physics::RealTimePacer::ModeFromString("sleep", mode));
+  EXPECT_EQ(mode, physics::RealTimePacer::SLEEP);
+  EXPECT_FALSE(physics::RealTimePacer::ModeFromString("spin", mode));
+  EXPECT_EQ(mode, physics::RealTimePacer::SLEEP);
+
+  pacer.SetMode(physics::RealTimePacer::HYBRID);
+  EXPECT_EQ(pacer.Mode(), physics::RealTimePacer::HYBRID);
+
+  pacer.SetSpinTime(0.0005);
+  EXPECT_DOUBLE_EQ(pacer.SpinTime(), 0.0005);
+  pacer.SetSpinTime(-1);
+  EXPECT_DOUBLE_EQ(pacer.SpinTime(), 0.0);
+
+  // Empty statistics
+  EXPECT_EQ(pacer.StepCount(), 0u);
+  EXPECT_EQ(pacer.OverrunCount(), 0u);
+  EXPECT_DOUBLE_EQ(pacer.JitterMean(), 0.0);
+  EXPECT_DOUBLE_EQ(pacer.JitterMax(), 0.0);
+  EXPECT_EQ(pacer.JitterHistogram().size(),
+      physics::RealTimePacer::HistogramEdges().size() + 1);
+}
+
+/////////////////////////////////////////////////
+TEST_F(RealTimePacerTest, Modes)
+{
+  const double period = 0.002;
+  const unsigned int steps = 100;
+
+  for (auto mode : {physics::RealTimePacer::SLEEP,
+                    physics::RealTimePacer::HYBRID,
+                    physics::RealTimePacer::DEADLINE})
+  {
+    physics::RealTimePacer pacer;
+    pacer.SetMode(mode);
+
+    // The loop runs close to real time. The bound on the upper side is
+    // loose for loaded hosts.
+    const double elapsed = PaceSteps(pacer, period, steps);
+    EXPECT_GT(elapsed, steps * period * 0.9) << mode;
+    EXPECT_LT(elapsed, steps * period * 3.0) << mode;
+
+    EXPECT_EQ(pacer.StepCount(), steps) << mode;
+    EXPECT_GE(pacer.JitterMax(), pacer.JitterMean()) << mode;
+
+    const auto histogram = pacer.JitterHistogram();
+    EXPECT_EQ(std::accumulate(histogram.begin(), histogram.end(),
+        uint64_t(0)), steps) << mode;
+
+    pacer.ResetStatistics();
+    EXPECT_EQ(pacer.StepCount(), 0u) << mode;
+    EXPECT_DOUBLE_EQ(pacer.JitterMax(), 0.0) << mode;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(RealTimePacerTest, Overrun)
+{
+  const double period = 0.002;
+
+  physics::RealTimePacer pacer;
+  pacer.SetMode(physics::RealTimePacer::DEADLINE);
+  PaceSteps(pacer, period, 5);
+
+  // A step longer than several periods is an overrun.
+  common::Time::MSleep(20);
+  PaceSteps(pacer, period, 1);
+  EXPECT_GE(pacer.OverrunCount(), 1u);
+  EXPECT_GE(pacer.JitterMax(), 0.01);
+
+  // The deadlines restart after an overrun rather than catching up with a
+  // burst of steps.
+  const double elapsed = PaceSteps(pacer, period, 5);
+  EXPECT_GT(elapsed, 5 * period * 0.9);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
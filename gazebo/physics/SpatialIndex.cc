@@ -0,0 +1,843 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+
+#include <ignition/math/Plane.hh>
+
+#include "gazebo/physics/SpatialIndex.hh"
+
+namespace gazebo
+{
+namespace physics
+{
+/// \brief Index of a missing node.
+static const int kNullNode = -1;
+
+/// \brief Axis aligned bounds. Unlike AxisAlignedBox, it is a plain value.
+struct SpatialBounds
+{
+  /// \brief Minimum corner.
+  ignition::math::Vector3d min;
+
+  /// \brief Maximum corner.
+  ignition::math::Vector3d max;
+};
+
+/// \brief A node of the tree.
+struct SpatialNode
+{
+  /// \brief Bounds of the node. For a leaf, the bounds of the entry
+  /// enlarged by the margin.
+  SpatialBounds bounds;
+
+  /// \brief Exact bounds of the entry, only set for a leaf.
+  SpatialBounds tight;
+
+  /// \brief Parent node, or next free node when the node is free.
+  int parent = kNullNode;
+
+  /// \brief Left child, kNullNode for a leaf.
+  int left = kNullNode;
+
+  /// \brief Right child, kNullNode for a leaf.
+  int right = kNullNode;
+
+  /// \brief Height of the node, 0 for a leaf, -1 when the node is free.
+  int height = 0;
+
+  /// \brief Id of the entry, only set for a leaf.
+  uint32_t id = 0;
+
+  /// \brief Get whether the node is a leaf.
+  /// \return True if the node is a leaf.
+  bool IsLeaf() const { return this->left == kNullNode; }
+};
+
+/////////////////////////////////////////////////
+class SpatialIndexPrivate
+{
+  /// \brief Get a node from the free list, or a new node.
+  /// \return Index of the node.
+  public: int Allocate();
+
+  /// \brief Return a node to the free list.
+  /// \param[in] _node Index of the node.
+  public: void Free(const int _node);
+
+  /// \brief Insert a leaf in the tree.
+  /// \param[in] _leaf Index of the leaf.
+  public: void InsertLeaf(const int _leaf);
+
+  /// \brief Remove a leaf from the tree. The node is not freed.
+  /// \param[in] _leaf Index of the leaf.
+  public: void RemoveLeaf(const int _leaf);
+
+  /// \brief Recompute the bounds and heights of the ancestors of a node,
+  /// rotating unbalanced nodes.
+  /// \param[in] _node Index of the first node to refit.
+  public: void Refit(int _node);
+
+  /// \brief Rotate a node if its children are unbalanced.
+  /// \param[in] _node Index of the node.
+  /// \return Index of the node that replaced it.
+  public: int Balance(const int _node);
+
+  /// \brief True if the index is enabled.
+  public: bool enabled = true;
+
+  /// \brief Margin by which the stored boxes are enlarged.
+  public: double margin = 0.1;
+
+  /// \brief Nodes of the tree.
+  public: std::vector<SpatialNode> nodes;
+
+  /// \brief Root of the tree.
+  public: int root = kNullNode;
+
+  /// \brief First free node.
+  public: int freeList = kNullNode;
+
+  /// \brief Leaf of each entry in the tree.
+  public: std::unordered_map<uint32_t, int> leaves;
+
+  /// \brief Entries whose box is not finite, kept out of the tree.
+  public: std::unordered_map<uint32_t, SpatialBounds> unbounded;
+
+  /// \brief Mutex to protect the index.
+  public: mutable std::mutex mutex;
+};
+}
+}
+
+using namespace gazebo;
+using namespace physics;
+
+/////////////////////////////////////////////////
+/// \brief Get the union of two bounds.
+static SpatialBounds Union(const SpatialBounds &_a, const SpatialBounds &_b)
+{
+  SpatialBounds result;
+  result.min.Set(std::min(_a.min.X(), _b.min.X()),
+      std::min(_a.min.Y(), _b.min.Y()), std::min(_a.min.Z(), _b.min.Z()));
+  result.max.Set(std::max(_a.max.X(), _b.max.X()),
+      std::max(_a.max.Y(), _b.max.Y()), std::max(_a.max.Z(), _b.max.Z()));
+  return result;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the surface area of bounds, the cost used to build the tree.
+static double Area(const SpatialBounds &_b)
+{
+  const ignition::math::Vector3d size = _b.max - _b.min;
+  return 2.0 * (size.X() * size.Y() + size.Y() * size.Z() +
+      size.Z() * size.X());
+}
+
+/////////////////////////////////////////////////
+/// \brief Get whether bounds contain other bounds.
+static bool Contains(const SpatialBounds &_outer, const SpatialBounds &_inner)
+{
+  return _outer.min.X() <= _inner.min.X() && _outer.min.Y() <= _inner.min.Y()
+      && _outer.min.Z() <= _inner.min.Z() && _outer.max.X() >= _inner.max.X()
+      && _outer.max.Y() >= _inner.max.Y() && _outer.max.Z() >= _inner.max.Z();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get whether two bounds overlap.
+static bool Overlaps(const SpatialBounds &_a, const SpatialBounds &_b)
+{
+  return _a.min.X() <= _b.max.X() && _a.max.X() >= _b.min.X() &&
+         _a.min.Y() <= _b.max.Y() && _a.max.Y() >= _b.min.Y() &&
+         _a.min.Z() <= _b.max.Z() && _a.max.Z() >= _b.min.Z();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get whether bounds may be inside a frustum, i.e. are not fully
+/// on the negative side of one of its planes.
+static bool InFrustum(const ignition::math::Frustum &_frustum,
+    const SpatialBounds &_b)
+{
+  for (int i = ignition::math::FRUSTUM_PLANE_NEAR;
+       i <= ignition::math::FRUSTUM_PLANE_BOTTOM; ++i)
+  {
+    const ignition::math::Planed plane =
+      _frustum.Plane(static_cast<ignition::math::FrustumPlane>(i));
+    const ignition::math::Vector3d &n = plane.Normal();
+
+    // Corner of the bounds furthest along the normal.
+    const ignition::math::Vector3d corner(
+        n.X() >= 0 ? _b.max.X() : _b.min.X(),
+        n.Y() >= 0 ? _b.max.Y() : _b.min.Y(),
+        n.Z() >= 0 ? _b.max.Z() : _b.min.Z());
+    if (n.Dot(corner) - plane.Offset() < 0)
+      return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Intersect a segment with bounds.
+/// \param[in] _start Start of the segment.
+/// \param[in] _dir End minus start of the segment.
+/// \param[in] _b Bounds to intersect.
+/// \param[out] _t Fraction of the segment where it enters the bounds.
+/// \return True if the segment intersects the bounds.
+static bool Intersect(const ignition::math::Vector3d &_start,
+    const ignition::math::Vector3d &_dir, const SpatialBounds &_b, double &_t)
+{
+  double tMin = 0;
+  double tMax = 1;
+  for (int i = 0; i < 3; ++i)
+  {
+    if (std::abs(_dir[i]) < 1e-12)
+    {
+      if (_start[i] < _b.min[i] || _start[i] > _b.max[i])
+        return false;
+      continue;
+    }
+
+    double t1 = (_b.min[i] - _start[i]) / _dir[i];
+    double t2 = (_b.max[i] - _start[i]) / _dir[i];
+    if (t1 > t2)
+      std::swap(t1, t2);
+    tMin = std::max(tMin, t1);
+    tMax = std::min(tMax, t2);
+    if (tMin > tMax)
+      return false;
+  }
+
+  _t = tMin;
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the squared distance from a point to bounds.
+static double DistanceSquared(const ignition::math::Vector3d &_p,
+    const SpatialBounds &_b)
+{
+  double result = 0;
+  for (int i = 0; i < 3; ++i)
+  {
+    double d = 0;
+    if (_p[i] < _b.min[i])
+      d = _b.min[i] - _p[i];
+    else if (_p[i] > _b.max[i])
+      d = _p[i] - _b.max[i];
+    // Avoid inf * 0 for bounds that are not finite.
+    if (d > 0)
+      result += d * d;
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+/// \brief Convert a box to bounds.
+/// \param[in] _box Box to convert.
+/// \param[out] _bounds Bounds of the box.
+/// \return False if the box is invalid.
+static bool ToBounds(const ignition::math::AxisAlignedBox &_box,
+    SpatialBounds &_bounds)
+{
+  _bounds.min = _box.Min();
+  _bounds.max = _box.Max();
+  for (int i = 0; i < 3; ++i)
+  {
+    if (std::isnan(_bounds.min[i]) || std::isnan(_bounds.max[i]) ||
+        _bounds.min[i] > _bounds.max[i])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get whether bounds are finite.
+static bool IsFinite(const SpatialBounds &_b)
+{
+  return _b.min.IsFinite() && _b.max.IsFinite();
+}
+
+/////////////////////////////////////////////////
+int SpatialIndexPrivate::Allocate()
+{
+  if (this->freeList == kNullNode)
+  {
+    this->nodes.emplace_back();
+    return static_cast<int>(this->nodes.size()) - 1;
+  }
+
+  const int node = this->freeList;
+  this->freeList = this->nodes[node].parent;
+  this->nodes[node] = SpatialNode();
+  return node;
+}
+
+/////////////////////////////////////////////////
+void SpatialIndexPrivate::Free(const int _node)
+{
+  this->nodes[_node].parent = this->freeList;
+  this->nodes[_node].height = -1;
+  this->freeList = _node;
+}
+
+/////////////////////////////////////////////////
+void SpatialIndexPrivate::InsertLeaf(const int _leaf)
+{
+  if (this->root == kNullNode)
+  {
+    this->root = _leaf;
+    this->nodes[_leaf].parent = kNullNode;
+    return;
+  }
+
+  // Descend to the sibling that least increases the area of the tree.
+  const SpatialBounds leafBounds = this->nodes[_leaf].bounds;
+  int index = this->root;
+  while (!this->nodes[index].IsLeaf())
+  {
+    const SpatialNode &node = this->nodes[index];
+    const double area = Area(node.bounds);
+    const double combinedArea = Area(Union(node.bounds, leafBounds));
+
+    // Cost of making a new parent for this node and the leaf.
+    const double cost = 2.0 * combinedArea;
+
+    // Minimum cost of pushing the leaf further down the tree.
+    const double inheritance = 2.0 * (combinedArea - area);
+
+    double childCost[2];
+    const int children[2] = {node.left, node.right};
+    for (int i = 0; i < 2; ++i)
+    {
+      const SpatialNode &child = this->nodes[children[i]];
+      childCost[i] = Area(Union(leafBounds, child.bounds)) + inheritance;
+      if (!child.IsLeaf())
+        childCost[i] -= Area(child.bounds);
+    }
+
+    if (cost < childCost[0] && cost < childCost[1])
+      break;
+
+    index = childCost[0] < childCost[1] ? children[0] : children[1];
+  }
+
+  // Create a new parent for the sibling and the leaf.
+  const int sibling = index;
+  const int oldParent = this->nodes[sibling].parent;
+  const int newParent = this->Allocate();
+  this->nodes[newParent].parent = oldParent;
+  this->nodes[newParent].bounds = Union(leafBounds,
+      this->nodes[sibling].bounds);
+  this->nodes[newParent].height = this->nodes[sibling].height + 1;
+  this->nodes[newParent].left = sibling;
+  this->nodes[newParent].right = _leaf;
+  this->nodes[sibling].parent = newParent;
+  this->nodes[_leaf].parent = newParent;
+
+  if (oldParent == kNullNode)
+    this->root = newParent;
+  else if (this->nodes[oldParent].left == sibling)
+    this->nodes[oldParent].left = newParent;
+  else
+    this->nodes[oldParent].right = newParent;
+
+  this->Refit(newParent);
+}
+
+/////////////////////////////////////////////////
+void SpatialIndexPrivate::RemoveLeaf(const int _leaf)
+{
+  if (_leaf == this->root)
+  {
+    this->root = kNullNode;
+    return;
+  }
+
+  // Replace the parent of the leaf by the sibling of the leaf.
+  const int parent = this->nodes[_leaf].parent;
+  const int grandParent = this->nodes[parent].parent;
+  const int sibling = this->nodes[parent].left == _leaf ?
+    this->nodes[parent].right : this->nodes[parent].left;
+
+  this->nodes[sibling].parent = grandParent;
+  if (grandParent == kNullNode)
+  {
+    this->root = sibling;
+  }
+  else
+  {
+    if (this->nodes[grandParent].left == parent)
+      this->nodes[grandParent].left = sibling;
+    else
+      this->nodes[grandParent].right = sibling;
+  }
+  this->Free(parent);
+  this->nodes[_leaf].parent = kNullNode;
+
+  this->Refit(grandParent);
+}
+
+/////////////////////////////////////////////////
+void SpatialIndexPrivate::Refit(int _node)
+{
+  while (_node != kNullNode)
+  {
+    _node = this->Balance(_node);
+
+    SpatialNode &node = this->nodes[_node];
+    const SpatialNode &left = this->nodes[node.left];
+    const SpatialNode &right = this->nodes[node.right];
+    node.height = 1 + std::max(left.height, right.height);
+    node.bounds = Union(left.bounds, right.bounds);
+
+    _node = node.parent;
+  }
+}
+
+/////////////////////////////////////////////////
+int SpatialIndexPrivate::Balance(const int _node)
+{
+  SpatialNode &a = this->nodes[_node];
+  if (a.IsLeaf() || a.height < 2)
+    return _node;
+
+  const int iB = a.left;
+  const int iC = a.right;
+  SpatialNode &b = this->nodes[iB];
+  SpatialNode &c = this->nodes[iC];
+  const int balance = c.height - b.height;
+
+  // Rotate the taller child up. The child takes the place of the node, and
+  // the node takes the shorter grandchild.
+  if (balance > 1 || balance < -1)
+  {
+    const int iUp = balance > 1 ? iC : iB;
+    SpatialNode &up = this->nodes[iUp];
+    SpatialNode &other = balance > 1 ? b : c;
+    const int iF = up.left;
+    const int iG = up.right;
+    SpatialNode &f = this->nodes[iF];
+    SpatialNode &g = this->nodes[iG];
+
+    up.left = _node;
+    up.parent = a.parent;
+    a.parent = iUp;
+
+    if (up.parent == kNullNode)
+      this->root = iUp;
+    else if (this->nodes[up.parent].left == _node)
+      this->nodes[up.parent].left = iUp;
+    else
+      this->nodes[up.parent].right = iUp;
+
+    const bool keepF = f.height > g.height;
+    const int iKeep = keepF ? iF : iG;
+    const int iMove = keepF ? iG : iF;
+    SpatialNode &keep = this->nodes[iKeep];
+    SpatialNode &move = this->nodes[iMove];
+
+    up.right = iKeep;
+    if (balance > 1)
+      a.right = iMove;
+    else
+      a.left = iMove;
+    move.parent = _node;
+
+    a.bounds = Union(other.bounds, move.bounds);
+    a.height = 1 + std::max(other.height, move.height);
+    up.bounds = Union(a.bounds, keep.bounds);
+    up.height = 1 + std::max(a.height, keep.height);
+
+    return iUp;
+  }
+
+  return _node;
+}
+
+/////////////////////////////////////////////////
+SpatialIndex::SpatialIndex()
+  : dataPtr(new SpatialIndexPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+SpatialIndex::~SpatialIndex()
+{
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::SetEnabled(const bool _enable)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->enabled = _enable;
+  if (!_enable)
+  {
+    this->dataPtr->nodes.clear();
+    this->dataPtr->root = kNullNode;
+    this->dataPtr->freeList = kNullNode;
+    this->dataPtr->leaves.clear();
+    this->dataPtr->unbounded.clear();
+  }
+}
+
+/////////////////////////////////////////////////
+bool SpatialIndex::Enabled() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->enabled;
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::SetMargin(const double _margin)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->margin = std::max(0.0, _margin);
+}
+
+/////////////////////////////////////////////////
+double SpatialIndex::Margin() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->margin;
+}
+
+/////////////////////////////////////////////////
+bool SpatialIndex::Insert(const uint32_t _id,
+    const ignition::math::AxisAlignedBox &_box)
+{
+  SpatialBounds bounds;
+  if (!ToBounds(_box, bounds))
+    return false;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->enabled)
+    return false;
+
+  // Remove the previous entry.
+  auto leafIter = this->dataPtr->leaves.find(_id);
+  if (leafIter != this->dataPtr->leaves.end())
+  {
+    this->dataPtr->RemoveLeaf(leafIter->second);
+    this->dataPtr->Free(leafIter->second);
+    this->dataPtr->leaves.erase(leafIter);
+  }
+  this->dataPtr->unbounded.erase(_id);
+
+  if (!IsFinite(bounds))
+  {
+    this->dataPtr->unbounded[_id] = bounds;
+    return true;
+  }
+
+  const ignition::math::Vector3d margin(this->dataPtr->margin,
+      this->dataPtr->margin, this->dataPtr->margin);
+  const int leaf = this->dataPtr->Allocate();
+  this->dataPtr->nodes[leaf].id = _id;
+  this->dataPtr->nodes[leaf].tight = bounds;
+  this->dataPtr->nodes[leaf].bounds.min = bounds.min - margin;
+  this->dataPtr->nodes[leaf].bounds.max = bounds.max + margin;
+  this->dataPtr->InsertLeaf(leaf);
+  this->dataPtr->leaves[_id] = leaf;
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool SpatialIndex::Update(const uint32_t _id,
+    const ignition::math::AxisAlignedBox &_box)
+{
+  SpatialBounds bounds;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    auto leafIter = this->dataPtr->leaves.find(_id);
+    if (leafIter == this->dataPtr->leaves.end())
+    {
+      if (this->dataPtr->unbounded.find(_id) ==
+          this->dataPtr->unbounded.end())
+      {
+        return false;
+      }
+    }
+    else if (ToBounds(_box, bounds) && IsFinite(bounds))
+    {
+      // Small motions stay within the enlarged box.
+      SpatialNode &leaf = this->dataPtr->nodes[leafIter->second];
+      if (Contains(leaf.bounds, bounds))
+      {
+        leaf.tight = bounds;
+        return true;
+      }
+    }
+  }
+
+  // Moving out of the enlarged box, or in or out of the unbounded
+  // entries, reinserts the entry.
+  if (!this->Insert(_id, _box))
+    this->Remove(_id);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool SpatialIndex::Remove(const uint32_t _id)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  auto leafIter = this->dataPtr->leaves.find(_id);
+  if (leafIter != this->dataPtr->leaves.end())
+  {
+    this->dataPtr->RemoveLeaf(leafIter->second);
+    this->dataPtr->Free(leafIter->second);
+    this->dataPtr->leaves.erase(leafIter);
+    return true;
+  }
+
+  return this->dataPtr->unbounded.erase(_id) > 0;
+}
+
+/////////////////////////////////////////////////
+void SpatialIndex::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->nodes.clear();
+  this->dataPtr->root = kNullNode;
+  this->dataPtr->freeList = kNullNode;
+  this->dataPtr->leaves.clear();
+  this->dataPtr->unbounded.clear();
+}
+
+/////////////////////////////////////////////////
+bool SpatialIndex::Has(const uint32_t _id) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->leaves.find(_id) != this->dataPtr->leaves.end() ||
+    this->dataPtr->unbounded.find(_id) != this->dataPtr->unbounded.end();
+}
+
+/////////////////////////////////////////////////
+size_t SpatialIndex::Size() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->leaves.size() + this->dataPtr->unbounded.size();
+}
+
+/////////////////////////////////////////////////
+int SpatialIndex::Height() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->root == kNullNode)
+    return 0;
+  return this->dataPtr->nodes[this->dataPtr->root].height + 1;
+}
+
+/////////////////////////////////////////////////
+std::vector<uint32_t> SpatialIndex::QueryBox(
+    const ignition::math::AxisAlignedBox &_box) const
+{
+  std::vector<uint32_t> result;
+  SpatialBounds bounds;
+  if (!ToBounds(_box, bounds))
+    return result;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  for (auto const &entry : this->dataPtr->unbounded)
+  {
+    if (Overlaps(entry.second, bounds))
+      result.push_back(entry.first);
+  }
+
+  std::vector<int> stack;
+  if (this->dataPtr->root != kNullNode)
+    stack.push_back(this->dataPtr->root);
+  while (!stack.empty())
+  {
+    const SpatialNode &node = this->dataPtr->nodes[stack.back()];
+    stack.pop_back();
+    if (!Overlaps(node.bounds, bounds))
+      continue;
+
+    if (node.IsLeaf())
+    {
+      if (Overlaps(node.tight, bounds))
+        result.push_back(node.id);
+    }
+    else
+    {
+      stack.push_back(node.left);
+      stack.push_back(node.right);
+    }
+  }
+
+  return result;
+}
+
+/////////////////////////////////////////////////
+std::vector<uint32_t> SpatialIndex::QueryFrustum(
+    const ignition::math::Frustum &_frustum) const
+{
+  std::vector<uint32_t> result;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  for (auto const &entry : this->dataPtr->unbounded)
+  {
+    if (InFrustum(_frustum, entry.second))
+      result.push_back(entry.first);
+  }
+
+  std::vector<int> stack;
+  if (this->dataPtr->root != kNullNode)
+    stack.push_back(this->dataPtr->root);
+  while (!stack.empty())
+  {
+    const SpatialNode &node = this->dataPtr->nodes[stack.back()];
+    stack.pop_back();
+    if (!InFrustum(_frustum, node.bounds))
+      continue;
+
+    if (node.IsLeaf())
+    {
+      if (InFrustum(_frustum, node.tight))
+        result.push_back(node.id);
+    }
+    else
+    {
+      stack.push_back(node.left);
+      stack.push_back(node.right);
+    }
+  }
+
+  return result;
+}
+
+/////////////////////////////////////////////////
+std::vector<uint32_t> SpatialIndex::QueryRay(
+    const ignition::math::Vector3d &_start,
+    const ignition::math::Vector3d &_end) const
+{
+  const ignition::math::Vector3d dir = _end - _start;
+  std::vector<std::pair<double, uint32_t>> hits;
+  double t = 0;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+    for (auto const &entry : this->dataPtr->unbounded)
+    {
+      if (Intersect(_start, dir, entry.second, t))
+        hits.emplace_back(t, entry.first);
+    }
+
+    std::vector<int> stack;
+    if (this->dataPtr->root != kNullNode)
+      stack.push_back(this->dataPtr->root);
+    while (!stack.empty())
+    {
+      const SpatialNode &node = this->dataPtr->nodes[stack.back()];
+      stack.pop_back();
+      if (!Intersect(_start, dir, node.bounds, t))
+        continue;
+
+      if (node.IsLeaf())
+      {
+        if (Intersect(_start, dir, node.tight, t))
+          hits.emplace_back(t, node.id);
+      }
+      else
+      {
+        stack.push_back(node.left);
+        stack.push_back(node.right);
+      }
+    }
+  }
+
+  std::sort(hits.begin(), hits.end());
+
+  std::vector<uint32_t> result;
+  result.reserve(hits.size());
+  for (auto const &hit : hits)
+    result.push_back(hit.second);
+  return result;
+}
+
+/////////////////////////////////////////////////
+bool SpatialIndex::Nearest(const ignition::math::Vector3d &_point,
+    uint32_t &_id, double &_distance) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  double best = std::numeric_limits<double>::infinity();
+  bool found = false;
+
+  for (auto const &entry : this->dataPtr->unbounded)
+  {
+    const double d = DistanceSquared(_point, entry.second);
+    if (d < best)
+    {
+      best = d;
+      _id = entry.first;
+      found = true;
+    }
+  }
+
+  // Visit the nodes closest to the point first, and stop when the closest
+  // remaining node is further than the best entry.
+  typedef std::pair<double, int> QueueEntry;
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>,
+      std::greater<QueueEntry>> queue;
+  if (this->dataPtr->root != kNullNode)
+  {
+    queue.emplace(DistanceSquared(_point,
+          this->dataPtr->nodes[this->dataPtr->root].bounds),
+        this->dataPtr->root);
+  }
+  while (!queue.empty() && queue.top().first < best)
+  {
+    const SpatialNode &node = this->dataPtr->nodes[queue.top().second];
+    queue.pop();
+
+    if (node.IsLeaf())
+    {
+      const double d = DistanceSquared(_point, node.tight);
+      if (d < best)
+      {
+        best = d;
+        _id = node.id;
+        found = true;
+      }
+    }
+    else
+    {
+      queue.emplace(DistanceSquared(_point,
+            this->dataPtr->nodes[node.left].bounds), node.left);
+      queue.emplace(DistanceSquared(_point,
+            this->dataPtr->nodes[node.right].bounds), node.right);
+    }
+  }
+
+  if (found)
+    _distance = std::sqrt(best);
+  return found;
+}
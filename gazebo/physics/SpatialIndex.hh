@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_SPATIALINDEX_HH_
+#define GAZEBO_PHYSICS_SPATIALINDEX_HH_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Frustum.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class.
+    class SpatialIndexPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class SpatialIndex SpatialIndex.hh physics/physics.hh
+    /// \brief A dynamic bounding volume tree of axis aligned boxes, keyed
+    /// by entity id.
+    ///
+    /// Each box is stored enlarged by a margin, so that small motions
+    /// update an entry without changing the tree. Boxes that are not
+    /// finite, e.g. the box of a plane, are kept out of the tree and
+    /// tested by every query.
+    ///
+    /// The World keeps an index of the bounding boxes of its collisions,
+    /// see World::SpatialIndex. All functions are thread safe.
+    class GZ_PHYSICS_VISIBLE SpatialIndex
+    {
+      /// \brief Constructor.
+      public: SpatialIndex();
+
+      /// \brief Destructor.
+      public: virtual ~SpatialIndex();
+
+      /// \brief Enable or disable the index. A disabled index is empty,
+      /// and ignores insertions.
+      /// \param[in] _enable True to enable the index.
+      public: void SetEnabled(const bool _enable);
+
+      /// \brief Get whether the index is enabled. Callers should fall back
+      /// to a full search when it is not.
+      /// \return True if the index is enabled.
+      public: bool Enabled() const;
+
+      /// \brief Set the margin by which the stored boxes are enlarged.
+      /// Only affects boxes inserted or moved afterwards.
+      /// \param[in] _margin Margin in meters.
+      public: void SetMargin(const double _margin);
+
+      /// \brief Get the margin by which the stored boxes are enlarged.
+      /// \return Margin in meters.
+      public: double Margin() const;
+
+      /// \brief Insert an entry, or update it if it exists.
+      /// \param[in] _id Id of the entry.
+      /// \param[in] _box Bounding box of the entry.
+      /// \return False if the index is disabled or the box is invalid.
+      public: bool Insert(const uint32_t _id,
+                          const ignition::math::AxisAlignedBox &_box);
+
+      /// \brief Update the bounding box of an existing entry.
+      /// \param[in] _id Id of the entry.
+      /// \param[in] _box New bounding box of the entry.
+      /// \return False if the entry does not exist.
+      public: bool Update(const uint32_t _id,
+                          const ignition::math::AxisAlignedBox &_box);
+
+      /// \brief Remove an entry.
+      /// \param[in] _id Id of the entry.
+      /// \return False if the entry does not exist.
+      public: bool Remove(const uint32_t _id);
+
+      /// \brief Remove all entries.
+      public: void Clear();
+
+      /// \brief Get whether an entry exists.
+      /// \param[in] _id Id of the entry.
+      /// \return True if the entry exists.
+      public: bool Has(const uint32_t _id) const;
+
+      /// \brief Get the number of entries.
+      /// \return Number of entries.
+      public: size_t Size() const;
+
+      /// \brief Get the height of the tree, 0 if it is empty.
+      /// \return Height of the tree.
+      public: int Height() const;
+
+      /// \brief Find the entries whose box overlaps a box.
+      /// \param[in] _box Box to test.
+      /// \return Ids of the entries, in no particular order.
+      public: std::vector<uint32_t> QueryBox(
+                  const ignition::math::AxisAlignedBox &_box) const;
+
+      /// \brief Find the entries whose box may be inside a frustum. Boxes
+      /// are tested against the planes of the frustum, which can report a
+      /// box near a corner that is outside it.
+      /// \param[in] _frustum Frustum to test.
+      /// \return Ids of the entries, in no particular order.
+      public: std::vector<uint32_t> QueryFrustum(
+                  const ignition::math::Frustum &_frustum) const;
+
+      /// \brief Find the entries whose box intersects a segment.
+      /// \param[in] _start Start of the segment.
+      /// \param[in] _end End of the segment.
+      /// \return Ids of the entries, ordered by the distance from _start
+      /// at which the segment enters their box.
+      public: std::vector<uint32_t> QueryRay(
+                  const ignition::math::Vector3d &_start,
+                  const ignition::math::Vector3d &_end) const;
+
+      /// \brief Find the entry whose box is the closest to a point.
+      /// \param[in] _point Point to test.
+      /// \param[out] _id Id of the closest entry.
+      /// \param[out] _distance Distance from the point to the box of the
+      /// entry, 0 if the point is inside the box.
+      /// \return False if the index is empty.
+      public: bool Nearest(const ignition::math::Vector3d &_point,
+                           uint32_t &_id, double &_distance) const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<SpatialIndexPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <limits>
+
+#include <ignition/math/Angle.hh>
+#include <ignition/math/Pose3.hh>
+
+#include "test/util.hh"
+#include "gazebo/physics/SpatialIndex.hh"
+
+using namespace gazebo;
+
+class SpatialIndexTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Get a unit box centered on a point.
+static ignition::math::AxisAlignedBox UnitBox(const double _x,
+    const double _y, const double _z)
+{
+  return ignition::math::AxisAlignedBox(_x - 0.5, _y - 0.5, _z - 0.5,
+      _x + 0.5, _y + 0.5, _z + 0.5);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SpatialIndexTest, InsertUpdateRemove)
+{
+  physics::SpatialIndex index;
+  EXPECT_TRUE(index.Enabled());
+  EXPECT_EQ(index.Size(), 0u);
+  EXPECT_EQ(index.Height(), 0);
+
+  // A grid of boxes keeps the tree balanced.
+  uint32_t id = 1;
+  for (int x = 0; x < 16; ++x)
+  {
+    for (int y = 0; y < 16; ++y)
+      EXPECT_TRUE(index.Insert(id++, UnitBox(x * 2, y * 2, 0)));
+  }
+  EXPECT_EQ(index.Size(), 256u);
+  EXPECT_LE(index.Height(), 20);
+  EXPECT_TRUE(index.Has(1));
+  EXPECT_FALSE(index.Has(id));
+
+  // Invalid boxes are rejected.
+  EXPECT_FALSE(index.Insert(id, ignition::math::AxisAlignedBox(
+          1, 1, 1, 0, 0, 0)));
+  EXPECT_FALSE(index.Update(id, UnitBox(0, 0, 0)));
+
+  // Move an entry a little, then far away.
+  EXPECT_TRUE(index.Update(1, UnitBox(0.05, 0, 0)));
+  EXPECT_TRUE(index.Update(1, UnitBox(100, 100, 100)));
+  std::vector<uint32_t> ids = index.QueryBox(UnitBox(100, 100, 100));
+  ASSERT_EQ(ids.size(), 1u);
+  EXPECT_EQ(ids[0], 1u);
+  EXPECT_TRUE(index.QueryBox(UnitBox(-2, -2, 0)).empty());
+
+  EXPECT_TRUE(index.Remove(1));
+  EXPECT_FALSE(index.Remove(1));
+  EXPECT_TRUE(index.QueryBox(UnitBox(100, 100, 100)).empty());
+  EXPECT_EQ(index.Size(), 255u);
+
+  index.Clear();
+  EXPECT_EQ(index.Size(), 0u);
+  EXPECT_TRUE(index.QueryBox(UnitBox(0, 0, 0)).empty());
+
+  // A disabled index ignores insertions.
+  index.SetEnabled(false);
+  EXPECT_FALSE(index.Enabled());
+  EXPECT_FALSE(index.Insert(1, UnitBox(0, 0, 0)));
+  EXPECT_EQ(index.Size(), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SpatialIndexTest, QueryBox)
+{
+  physics::SpatialIndex index;
+  for (uint32_t i = 0; i < 100; ++i)
+    index.Insert(i, UnitBox(i * 2, 0, 0));
+
+  // The stored boxes are enlarged, but the queries use the exact boxes.
+  std::vector<uint32_t> ids = index.QueryBox(
+      ignition::math::AxisAlignedBox(9.55, -1, -1, 12.45, 1, 1));
+  std::sort(ids.begin(), ids.end());
+  ASSERT_EQ(ids.size(), 2u);
+  EXPECT_EQ(ids[0], 5u);
+  EXPECT_EQ(ids[1], 6u);
+
+  // A box that is not finite, like the box of a plane, matches every query
+  // that touches it.
+  const double inf = std::numeric_limits<double>::infinity();
+  EXPECT_TRUE(index.Insert(1000,
+        ignition::math::AxisAlignedBox(-inf, -inf, -inf, inf, inf, 0)));
+  ids = index.QueryBox(UnitBox(-50, -50, 0));
+  ASSERT_EQ(ids.size(), 1u);
+  EXPECT_EQ(ids[0], 1000u);
+  EXPECT_TRUE(index.QueryBox(UnitBox(-50, -50, 10)).empty());
+
+  // Moving an entry to a finite box puts it in the tree.
+  EXPECT_TRUE(index.Update(1000, UnitBox(-50, -50, 10)));
+  ids = index.QueryBox(UnitBox(-50, -50, 10));
+  ASSERT_EQ(ids.size(), 1u);
+  EXPECT_EQ(ids[0], 1000u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SpatialIndexTest, QueryRay)
+{
+  physics::SpatialIndex index;
+  for (uint32_t i = 0; i < 10; ++i)
+    index.Insert(i, UnitBox(0, 0, i * 2));
+
+  // Hits are ordered by distance from the start.
+  std::vector<uint32_t> ids = index.QueryRay(
+      ignition::math::Vector3d(0, 0, 100), ignition::math::Vector3d(0, 0, 5));
+  ASSERT_EQ(ids.size(), 7u);
+  for (unsigned int i = 0; i < ids.size(); ++i)
+    EXPECT_EQ(ids[i], 9u - i);
+
+  // Miss beside the column.
+  EXPECT_TRUE(index.QueryRay(ignition::math::Vector3d(2, 0, 100),
+        ignition::math::Vector3d(2, 0, -100)).empty());
+
+  // Diagonal segment through a single box.
+  ids = index.QueryRay(ignition::math::Vector3d(-1, -1, 3),
+      ignition::math::Vector3d(1, 1, 5));
+  ASSERT_EQ(ids.size(), 1u);
+  EXPECT_EQ(ids[0], 2u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SpatialIndexTest, QueryFrustum)
+{
+  physics::SpatialIndex index;
+  for (int x = -20; x <= 20; ++x)
+  {
+    for (int y = -20; y <= 20; ++y)
+    {
+      index.Insert(static_cast<uint32_t>((x + 20) * 41 + (y + 20)),
+          UnitBox(x * 2, y * 2, 0));
+    }
+  }
+
+  // Frustum looking along +x from the origin.
+  ignition::math::Frustum frustum(1, 10, IGN_DTOR(60), 1,
+      ignition::math::Pose3d::Zero);
+  std::vector<uint32_t> ids = index.QueryFrustum(frustum);
+  EXPECT_FALSE(ids.empty());
+
+  // Every box in the frustum is reported, none behind the camera is.
+  for (int x = -20; x <= 20; ++x)
+  {
+    for (int y = -20; y <= 20; ++y)
+    {
+      const uint32_t id = static_cast<uint32_t>((x + 20) * 41 + (y + 20));
+      const bool found = std::find(ids.begin(), ids.end(), id) != ids.end();
+      if (frustum.Contains(UnitBox(x * 2, y * 2, 0)))
+        EXPECT_TRUE(found) << x << " " << y;
+      if (x < 0)
+        EXPECT_FALSE(found) << x << " " << y;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(SpatialIndexTest, Nearest)
+{
+  physics::SpatialIndex index;
+  uint32_t id = 0;
+  double distance = 0;
+  EXPECT_FALSE(index.Nearest(ignition::math::Vector3d::Zero, id, distance));
+
+  for (uint32_t i = 0; i < 50; ++i)
+    index.Insert(i, UnitBox(i * 3, 0, 0));
+
+  EXPECT_TRUE(index.Nearest(ignition::math::Vector3d(31, 0, 0), id,
+        distance));
+  EXPECT_EQ(id, 10u);
+  EXPECT_DOUBLE_EQ(distance, 0.5);
+
+  EXPECT_TRUE(index.Nearest(ignition::math::Vector3d(60, 0, 0), id,
+        distance));
+  EXPECT_EQ(id, 20u);
+  EXPECT_DOUBLE_EQ(distance, 0.0);
+
+  EXPECT_TRUE(index.Nearest(ignition::math::Vector3d(-10, 0, 0), id,
+        distance));
+  EXPECT_EQ(id, 0u);
+  EXPECT_DOUBLE_EQ(distance, 9.5);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -20,7 +20,7 @@
 #include "gazebo/transport/transport.hh"
 
 #include "gazebo/physics/World.hh"
-#include "gazebo/physics/WorldState.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
 
 #include "gazebo/physics/UserCmdManagerPrivate.hh"
 #include "gazebo/physics/UserCmdManager.hh"
@@ -42,15 +42,13 @@ UserCmd::UserCmd(const unsigned int _id,
   this->dataPtr->type = _type;
 
   // Record current world state
-  this->dataPtr->startState = WorldState(this->dataPtr->world);
+  this->dataPtr->startState.Capture(*this->dataPtr->world, nullptr);
 }
 
 /////////////////////////////////////////////////
 UserCmd::~UserCmd()
 {
   this->dataPtr->world.reset();
-  this->dataPtr->startState.SetWorld(WorldPtr());
-  this->dataPtr->endState.SetWorld(WorldPtr());
 
   delete this->dataPtr;
   this->dataPtr = NULL;
@@ -60,7 +58,7 @@ UserCmd::~UserCmd()
 void UserCmd::Undo()
 {
   // Record / override the state for redo
-  this->dataPtr->endState = WorldState(this->dataPtr->world);
+  this->dataPtr->endState.Capture(*this->dataPtr->world, nullptr);
 
   // Reset physics states for the whole world
   this->dataPtr->world->ResetPhysicsStates();
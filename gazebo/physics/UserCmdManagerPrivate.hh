@@ -29,7 +29,7 @@ namespace gazebo
 {
   namespace physics
   {
-    class WorldState;
+    class WorldSnapshot;
 
     /// \internal
     /// \brief Private data for the UserCmdManager class
@@ -39,11 +39,11 @@ namespace gazebo
       public: WorldPtr world;
 
       /// \brief Whole world state the moment the user command was executed.
-      public: WorldState startState;
+      public: WorldSnapshot startState;
 
       /// \brief Whole world state for the most recent time the user has
       /// triggered undo for this command.
-      public: WorldState endState;
+      public: WorldSnapshot endState;
 
       /// \brief Unique ID identifying this command in the server.
       public: unsigned int id;
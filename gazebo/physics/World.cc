@@ -19,13 +19,22 @@
 
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
+#include <tbb/task_arena.h>
 
 #include <sdf/sdf.hh>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <deque>
 #include <list>
+#include <mutex>
 #include <set>
+#include <sstream>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <boost/algorithm/string/predicate.hpp>
@@ -79,6 +88,7 @@
 #include "gazebo/physics/Light.hh"
 #include "gazebo/physics/Actor.hh"
 #include "gazebo/physics/Wind.hh"
+#include "gazebo/physics/WorldCheckpoint.hh"
 #include "gazebo/physics/WorldPrivate.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/common/SphericalCoordinates.hh"
@@ -94,6 +104,56 @@ using namespace physics;
 /// This will be replaced with a class member variable in Gazebo 3.0
 bool g_clearModels;
 
+/// \brief Serializes the process wide events signaled by worlds stepped
+/// with World::BatchStep.
+static std::recursive_mutex g_batchEventsMutex;
+
+/// \brief Number of initialized worlds. Singletons shared by the worlds are
+/// finalized along with the last one.
+static std::atomic<unsigned int> g_initializedWorlds(0);
+
+/////////////////////////////////////////////////
+/// \brief Lock the process wide events if a world is batched.
+/// \param[in] _batched True if the world is stepped by World::BatchStep.
+/// \return The lock, which does not own the mutex if _batched is false.
+static std::unique_lock<std::recursive_mutex> LockBatchEvents(
+    const bool _batched)
+{
+  std::unique_lock<std::recursive_mutex> lock(g_batchEventsMutex,
+      std::defer_lock);
+  if (_batched)
+    lock.lock();
+  return lock;
+}
+
+/////////////////////////////////////////////////
+/// \brief Queue the pose of an entity and of the models containing it for
+/// the next pose message.
+/// \param[in] _entity Entity whose pose changed.
+/// \param[in,out] _dirty Ids of the entities to publish.
+static void AddPoseDirty(const Entity *_entity, std::vector<uint32_t> &_dirty)
+{
+  _dirty.push_back(_entity->GetId());
+
+  // The relative pose of a model changes with its canonical link, see
+  // Entity::SetWorldPoseCanonicalLink. The relative poses of the other links
+  // and of the nested models then change too, even if they are at rest.
+  const bool canonical = _entity->IsCanonicalLink();
+  for (BasePtr parent = _entity->GetParent();
+       parent && parent->HasType(Base::MODEL); parent = parent->GetParent())
+  {
+    _dirty.push_back(parent->GetId());
+    if (!canonical)
+      continue;
+
+    const Model *model = static_cast<const Model *>(parent.get());
+    for (auto const &link : model->GetLinks())
+      _dirty.push_back(link->GetId());
+    for (auto const &nested : model->NestedModels())
+      _dirty.push_back(nested->GetId());
+  }
+}
+
 class ModelUpdate_TBB
 {
   public: explicit ModelUpdate_TBB(Model_V *_models) : models(_models) {}
@@ -134,7 +194,6 @@ World::World(const std::string &_name)
   this->dataPtr->sensorsInitialized = false;
 
   this->dataPtr->currentStateBuffer = 0;
-  this->dataPtr->stateToggle = 0;
 
   this->dataPtr->pluginsLoaded = false;
 
@@ -148,8 +207,6 @@ World::World(const std::string &_name)
   this->dataPtr->enableWind = true;
   this->dataPtr->enableAtmosphere = true;
 
-  this->dataPtr->sleepOffset = common::Time(0);
-
   this->dataPtr->prevStatTime = common::Time::GetWallTime();
   this->dataPtr->prevProcessMsgsTime = common::Time::GetWallTime();
   this->dataPtr->logLastStatePlayedSimTime = common::Time(0);
@@ -164,6 +221,9 @@ World::World(const std::string &_name)
 
   this->dataPtr->waitForSensors = nullptr;
 
+  this->dataPtr->spatialIndex.reset(new physics::SpatialIndex);
+  this->dataPtr->pacer.reset(new physics::RealTimePacer);
+
   // Make sure dbs are initialized
   common::ModelDatabase::Instance();
   common::FuelModelDatabase::Instance();
@@ -265,9 +325,10 @@ void World::Load(sdf::ElementPtr _sdf)
 
   this->dataPtr->responsePub = this->dataPtr->node->Advertise<msgs::Response>(
       "~/response");
+  // Throttled by PublishWorldStats, see SetStatsPublishRate.
   this->dataPtr->statPub =
     this->dataPtr->node->Advertise<msgs::WorldStatistics>(
-        "~/world_stats", 100, 5);
+        "~/world_stats", 100);
   this->dataPtr->modelPub = this->dataPtr->node->Advertise<msgs::Model>(
       "~/model/info");
   this->dataPtr->lightPub = this->dataPtr->node->Advertise<msgs::Light>(
@@ -296,6 +357,11 @@ void World::Load(sdf::ElementPtr _sdf)
 
   this->dataPtr->physicsEngine->Load(physicsElem);
 
+  // Only ODE reports the bounding boxes of collisions in the world frame.
+  this->dataPtr->spatialIndexEnabled = type == "ode";
+  this->dataPtr->spatialIndex->SetEnabled(
+      this->dataPtr->spatialIndexEnabled);
+
   // This should come before loading of entities
   sdf::ElementPtr windElem = this->dataPtr->sdf->GetElement("wind");
 
@@ -353,13 +419,47 @@ void World::Load(sdf::ElementPtr _sdf)
       this->ModelByIndex(i)->LoadJoints();
   }
 
-  // TODO: Performance test to see if TBB model updating is necessary
-  // Choose threaded or unthreaded model updating depending on the number of
-  // models in the scene
-  // if (this->ModelCount() < 20)
-  this->dataPtr->modelUpdateFunc = &World::ModelUpdateSingleLoop;
-  // else
-  // this->dataPtr->modelUpdateFunc = &World::ModelUpdateTBB;
+  // Choose threaded or unthreaded model updating. Models are updated
+  // sequentially unless the physics element asks for more than one thread.
+  unsigned int modelUpdateThreads = 0;
+  if (physicsElem->HasElement("gz:model_update_threads"))
+  {
+    modelUpdateThreads =
+        physicsElem->Get<unsigned int>("gz:model_update_threads");
+  }
+  this->SetModelUpdateThreads(modelUpdateThreads);
+
+  // Publishing of world statistics and poses
+  if (this->dataPtr->sdf->HasElement("gz:stats_publish_rate"))
+  {
+    this->SetStatsPublishRate(
+        this->dataPtr->sdf->Get<double>("gz:stats_publish_rate"));
+  }
+  if (this->dataPtr->sdf->HasElement("gz:pose_publish_steps"))
+  {
+    this->SetPosePublishSteps(
+        this->dataPtr->sdf->Get<unsigned int>("gz:pose_publish_steps"));
+  }
+
+  // Pacing of the steps to the real time update rate
+  if (this->dataPtr->sdf->HasElement("gz:real_time_pacing"))
+  {
+    const std::string pacing =
+      this->dataPtr->sdf->Get<std::string>("gz:real_time_pacing");
+    RealTimePacer::PacingMode mode;
+    if (RealTimePacer::ModeFromString(pacing, mode))
+      this->dataPtr->pacer->SetMode(mode);
+    else
+    {
+      gzerr << "Unknown real time pacing [" << pacing
+            << "], expected sleep, hybrid or deadline" << std::endl;
+    }
+  }
+  if (this->dataPtr->sdf->HasElement("gz:pacing_spin_time"))
+  {
+    this->dataPtr->pacer->SetSpinTime(
+        this->dataPtr->sdf->Get<double>("gz:pacing_spin_time"));
+  }
 
   event::Events::worldCreated(this->Name());
 
@@ -436,22 +536,23 @@ void World::Init(UpdateScenePosesFunc _func)
   this->dataPtr->testRay = boost::dynamic_pointer_cast<RayShape>(
       this->Physics()->CreateShape("ray", CollisionPtr()));
 
-  this->dataPtr->prevStates[0].SetWorld(shared_from_this());
-  this->dataPtr->prevStates[1].SetWorld(shared_from_this());
-
-  this->dataPtr->prevStates[0].SetName(this->Name());
-  this->dataPtr->prevStates[1].SetName(this->Name());
-
   this->dataPtr->updateInfo.worldName = this->Name();
 
   this->dataPtr->iterations = 0;
-  this->dataPtr->logPrevIteration = 0;
 
   util::DiagnosticManager::Instance()->Init(this->Name());
 
   util::LogRecord::Instance()->Add(this->Name(), "state.log",
       std::bind(&World::OnLog, this, std::placeholders::_1));
 
+  // Preallocate the log snapshots, used by RunLoop and BatchStep alike.
+  if (this->dataPtr->logSnapshots.empty())
+  {
+    this->dataPtr->logSnapshots.resize(16);
+    for (auto &snapshot : this->dataPtr->logSnapshots)
+      snapshot.reset(new WorldSnapshot);
+  }
+
   // Check if we have to insert an object population.
   if (this->dataPtr->sdf->HasElement("population"))
   {
@@ -480,6 +581,8 @@ void World::Init(UpdateScenePosesFunc _func)
 
   this->dataPtr->updateScenePoses = _func;
 
+  if (!this->dataPtr->initialized)
+    ++g_initializedWorlds;
   this->dataPtr->initialized = true;
 
   // Mark the world initialization
@@ -544,12 +647,7 @@ void World::RunLoop()
   if (this->IsPaused())
     this->dataPtr->pauseStartTime = this->dataPtr->startTime;
 
-  this->dataPtr->prevStepWallTime = common::Time::GetWallTime();
-
-  // Get the first state
-  this->dataPtr->prevStates[0] = WorldState(shared_from_this());
-  this->dataPtr->prevStates[1] = WorldState(shared_from_this());
-  this->dataPtr->stateToggle = 0;
+  this->dataPtr->pacer->Restart();
 
   this->dataPtr->logThread =
     new std::thread(std::bind(&World::LogWorker, this));
@@ -714,39 +812,21 @@ void World::Step()
         this->dataPtr->physicsEngine->GetMaxStepSize());
 
   double updatePeriod = this->dataPtr->physicsEngine->GetUpdatePeriod();
-  // sleep here to get the correct update rate
-  common::Time tmpTime = common::Time::GetWallTime();
-  common::Time sleepTime = this->dataPtr->prevStepWallTime +
-    common::Time(updatePeriod) - tmpTime - this->dataPtr->sleepOffset;
 
-  common::Time actualSleep;
-  if (sleepTime > 0)
-  {
-    common::Time::Sleep(sleepTime);
-    actualSleep = common::Time::GetWallTime() - tmpTime;
-  }
-  else
-    sleepTime = 0;
-
-  // exponentially avg out
-  this->dataPtr->sleepOffset = (actualSleep - sleepTime) * 0.01 +
-                      this->dataPtr->sleepOffset * 0.99;
+  // Running as fast as possible skips the pacing and its clock reads.
+  const bool due = updatePeriod <= 0 ||
+    this->dataPtr->pacer->Wait(updatePeriod);
 
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Step", "sleepOffset");
 
   IGN_PROFILE_BEGIN("worldUpdateMutex");
-  // throttling update rate, with sleepOffset as tolerance
-  // the tolerance is needed as the sleep time is not exact
-  if (common::Time::GetWallTime() - this->dataPtr->prevStepWallTime +
-      this->dataPtr->sleepOffset >= common::Time(updatePeriod))
+  if (due)
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
 
     DIAG_TIMER_LAP("World::Step", "worldUpdateMutex");
 
-    this->dataPtr->prevStepWallTime = common::Time::GetWallTime();
-
     double stepTime = this->dataPtr->physicsEngine->GetMaxStepSize();
 
     if (!this->IsPaused() || this->dataPtr->stepInc > 0
@@ -810,6 +890,63 @@ void World::Step(const unsigned int _steps)
   }
 }
 
+//////////////////////////////////////////////////
+void World::BatchStep(const unsigned int _steps)
+{
+  if (!this->dataPtr->initialized || this->dataPtr->thread)
+  {
+    gzerr << "World[" << this->Name() << "] must be initialized and not "
+          << "running to be stepped in a batch" << std::endl;
+    return;
+  }
+
+  // Batches run on pool threads, which may change from call to call.
+  this->dataPtr->physicsEngine->InitForThread();
+
+  // Real time starts with the first batch step, see RunLoop.
+  if (this->dataPtr->iterations == 0)
+    this->dataPtr->startTime = common::Time::GetWallTime();
+
+  for (unsigned int i = 0; i < _steps; ++i)
+  {
+    {
+      std::lock_guard<std::recursive_mutex> lock(
+          this->dataPtr->worldUpdateMutex);
+      this->dataPtr->batchStep = true;
+      this->dataPtr->simTime += this->dataPtr->physicsEngine->GetMaxStepSize();
+      this->dataPtr->iterations++;
+      this->Update();
+      this->dataPtr->batchStep = false;
+    }
+
+    // Load the plugins after the first iteration of the physics engine, see
+    // Step. There is no sensor manager to wait for in a batch.
+    if (!this->dataPtr->pluginsLoaded)
+    {
+      this->LoadPlugins();
+      this->dataPtr->pluginsLoaded = true;
+    }
+
+    this->ProcessMessages();
+  }
+
+  this->PublishWorldStats();
+}
+
+//////////////////////////////////////////////////
+event::ConnectionPtr World::ConnectUpdateBegin(
+    std::function<void (const common::UpdateInfo &)> _subscriber)
+{
+  return this->dataPtr->updateBegin.Connect(_subscriber);
+}
+
+//////////////////////////////////////////////////
+event::ConnectionPtr World::ConnectUpdateEnd(
+    std::function<void ()> _subscriber)
+{
+  return this->dataPtr->updateEnd.Connect(_subscriber);
+}
+
 //////////////////////////////////////////////////
 void World::Update()
 {
@@ -831,10 +968,17 @@ void World::Update()
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "needsReset");
 
+  // Poses queued from here on are decimated, see ProcessMessages
+  this->dataPtr->updating = true;
+
   IGN_PROFILE_BEGIN("worldUpdateBegin");
   this->dataPtr->updateInfo.simTime = this->SimTime();
   this->dataPtr->updateInfo.realTime = this->RealTime();
-  event::Events::worldUpdateBegin(this->dataPtr->updateInfo);
+  this->dataPtr->updateBegin(this->dataPtr->updateInfo);
+  {
+    auto lock = LockBatchEvents(this->dataPtr->batchStep);
+    event::Events::worldUpdateBegin(this->dataPtr->updateInfo);
+  }
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "Events::worldUpdateBegin");
 
@@ -851,25 +995,13 @@ void World::Update()
   DIAG_TIMER_LAP("World::Update", "PhysicsEngine::UpdateCollision");
 
   IGN_PROFILE_BEGIN("beforePhysicsUpdate");
-  // Wait for logging to finish, if it's running.
-  if (util::LogRecord::Instance()->Running())
-  {
-    std::unique_lock<std::mutex> lock(this->dataPtr->logMutex);
-
-    // It's possible the logWorker thread never processed the previous
-    // state. This checks to make sure that we don't continute until the log
-    // worker catchs up.
-    if (this->dataPtr->iterations - this->dataPtr->logPrevIteration > 1)
-    {
-      this->dataPtr->logCondition.notify_one();
-      this->dataPtr->logContinueCondition.wait(lock);
-    }
-  }
-
   // Give clients a possibility to react to collisions before the physics
   // gets updated.
   this->dataPtr->updateInfo.realTime = this->RealTime();
-  event::Events::beforePhysicsUpdate(this->dataPtr->updateInfo);
+  {
+    auto lock = LockBatchEvents(this->dataPtr->batchStep);
+    event::Events::beforePhysicsUpdate(this->dataPtr->updateInfo);
+  }
 
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "Events::beforePhysicsUpdate");
@@ -895,7 +1027,16 @@ void World::Update()
 
       for (auto &dirtyEntity : this->dataPtr->dirtyPoses)
       {
-        dirtyEntity->SetWorldPose(dirtyEntity->DirtyPose(), false);
+        dirtyEntity->SetWorldPose(dirtyEntity->DirtyPose(), false, false);
+      }
+
+      // Queue the moved entities for the next pose message at once rather
+      // than one lock per entity.
+      {
+        std::lock_guard<std::recursive_mutex> lock(
+            this->dataPtr->receiveMutex);
+        for (auto &dirtyEntity : this->dataPtr->dirtyPoses)
+          AddPoseDirty(dirtyEntity, this->dataPtr->posesDirty);
       }
 
       this->dataPtr->dirtyPoses.clear();
@@ -905,12 +1046,15 @@ void World::Update()
     DIAG_TIMER_LAP("World::Update", "SetWorldPose(dirtyPoses)");
   }
 
-  IGN_PROFILE_BEGIN("LogRecordNotify");
-  // Only update state information if logging data.
-  if (util::LogRecord::Instance()->Running())
-    this->dataPtr->logCondition.notify_one();
+  IGN_PROFILE_BEGIN("RefreshSpatialIndex");
+  this->RefreshSpatialIndex();
   IGN_PROFILE_END();
-  DIAG_TIMER_LAP("World::Update", "LogRecordNotify");
+
+  IGN_PROFILE_BEGIN("LogRecordCapture");
+  // Only capture state information if logging data.
+  this->CaptureLogState();
+  IGN_PROFILE_END();
+  DIAG_TIMER_LAP("World::Update", "LogRecordCapture");
 
   IGN_PROFILE_BEGIN("PublishContacts");
   // Output the contact information
@@ -919,9 +1063,17 @@ void World::Update()
   IGN_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "ContactManager::PublishContacts");
 
-  event::Events::worldUpdateEnd();
+  this->dataPtr->updateEnd();
+  {
+    auto lock = LockBatchEvents(this->dataPtr->batchStep);
+    event::Events::worldUpdateEnd();
+  }
+
+  // Batched worlds share a single introspection update, see WorldBatch.
+  if (!this->dataPtr->batchStep)
+    gazebo::util::IntrospectionManager::Instance()->Update();
 
-  gazebo::util::IntrospectionManager::Instance()->Update();
+  this->dataPtr->updating = false;
 
   DIAG_TIMER_STOP("World::Update");
 }
@@ -977,9 +1129,12 @@ void World::Fini()
   this->dataPtr->testRay.reset();
   this->dataPtr->plugins.clear();
 
-  this->dataPtr->publishModelPoses.clear();
+  this->dataPtr->posesDirty.clear();
+  this->dataPtr->posesQueuedIdle = false;
+  this->dataPtr->poseSlots.clear();
+  this->dataPtr->poseMsg.reset();
+  this->dataPtr->sparePoseMsg.reset();
   this->dataPtr->publishModelScales.clear();
-  this->dataPtr->publishLightPoses.clear();
 
   // Clean entities
   for (auto &model : this->dataPtr->models)
@@ -1008,9 +1163,18 @@ void World::Fini()
     this->dataPtr->rootElement->Fini();
     this->dataPtr->rootElement.reset();
   }
-  this->dataPtr->prevStates[0].SetWorld(WorldPtr());
-  this->dataPtr->prevStates[1].SetWorld(WorldPtr());
-  this->dataPtr->prevUnfilteredState.SetWorld(WorldPtr());
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->entityIndexMutex);
+    this->dataPtr->entitiesById.clear();
+    this->dataPtr->entitiesByName.clear();
+  }
+  this->dataPtr->spatialIndexEnabled = false;
+  this->dataPtr->spatialIndex->Clear();
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->spatialDirtyMutex);
+    this->dataPtr->spatialDirty.clear();
+  }
   this->dataPtr->logPlayState.SetWorld(WorldPtr());
   this->dataPtr->states[0].clear();
   this->dataPtr->states[1].clear();
@@ -1026,9 +1190,19 @@ void World::Fini()
     this->dataPtr->physicsEngine->Fini();
   this->dataPtr->physicsEngine.reset();
 
-  // Clear singletons whose states are tied to this world
-  util::DiagnosticManager::Instance()->Fini();
-  util::LogRecord::Instance()->Fini();
+  // Clear singletons whose states are tied to this world. Other worlds of
+  // the process, e.g. those of a WorldBatch, may still use them.
+  util::LogRecord::Instance()->Remove(this->Name());
+  if (this->dataPtr->initialized)
+  {
+    this->dataPtr->initialized = false;
+    --g_initializedWorlds;
+  }
+  if (g_initializedWorlds == 0)
+  {
+    util::DiagnosticManager::Instance()->Fini();
+    util::LogRecord::Instance()->Fini();
+  }
 
   // End world run thread
   if (this->dataPtr->thread)
@@ -1089,6 +1263,64 @@ Wind &World::Wind() const
   return *this->dataPtr->wind;
 }
 
+//////////////////////////////////////////////////
+physics::SpatialIndex &World::SpatialIndex() const
+{
+  return *this->dataPtr->spatialIndex;
+}
+
+//////////////////////////////////////////////////
+physics::RealTimePacer &World::Pacer() const
+{
+  return *this->dataPtr->pacer;
+}
+
+//////////////////////////////////////////////////
+CollisionPtr World::CollisionById(const uint32_t _id) const
+{
+  return boost::dynamic_pointer_cast<Collision>(
+      this->IndexedEntityById(_id));
+}
+
+//////////////////////////////////////////////////
+void World::RefreshSpatialIndex() const
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->spatialDirtyMutex);
+    if (this->dataPtr->spatialDirty.empty() ||
+        !this->dataPtr->physicsEngine)
+    {
+      return;
+    }
+  }
+
+  // Bounding boxes are read from the physics engine.
+  boost::recursive_mutex::scoped_lock plock(
+      *this->dataPtr->physicsEngine->GetPhysicsUpdateMutex());
+
+  auto &refresh = this->dataPtr->spatialRefresh;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->spatialDirtyMutex);
+    refresh.swap(this->dataPtr->spatialDirty);
+  }
+
+  // A collision is marked each time its link moves.
+  std::sort(refresh.begin(), refresh.end());
+  refresh.erase(std::unique(refresh.begin(), refresh.end()), refresh.end());
+
+  for (auto const id : refresh)
+  {
+    // Only update collisions which are in the index.
+    if (!this->dataPtr->spatialIndex->Has(id))
+      continue;
+
+    CollisionPtr collision = this->CollisionById(id);
+    if (collision)
+      this->dataPtr->spatialIndex->Update(id, collision->BoundingBox());
+  }
+  refresh.clear();
+}
+
 //////////////////////////////////////////////////
 Atmosphere &World::Atmosphere() const
 {
@@ -1139,6 +1371,55 @@ void World::SetMagneticField(const ignition::math::Vector3d &_mag)
   this->dataPtr->sdf->GetElement("magnetic_field")->Set(_mag);
 }
 
+//////////////////////////////////////////////////
+void World::SetModelUpdateThreads(const unsigned int _threads)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+
+  this->dataPtr->modelUpdateThreads = _threads;
+  if (_threads > 1)
+  {
+    this->dataPtr->modelUpdateArena.reset(
+        new tbb::task_arena(static_cast<int>(_threads)));
+    this->dataPtr->modelUpdateFunc = &World::ModelUpdateTBB;
+  }
+  else
+  {
+    this->dataPtr->modelUpdateArena.reset();
+    this->dataPtr->modelUpdateFunc = &World::ModelUpdateSingleLoop;
+  }
+}
+
+//////////////////////////////////////////////////
+unsigned int World::ModelUpdateThreads() const
+{
+  return this->dataPtr->modelUpdateThreads;
+}
+
+//////////////////////////////////////////////////
+void World::SetStatsPublishRate(const double _rate)
+{
+  this->dataPtr->statsPublishRate = std::max(0.0, _rate);
+}
+
+//////////////////////////////////////////////////
+double World::StatsPublishRate() const
+{
+  return this->dataPtr->statsPublishRate;
+}
+
+//////////////////////////////////////////////////
+void World::SetPosePublishSteps(const unsigned int _steps)
+{
+  this->dataPtr->posePublishSteps = std::max(1u, _steps);
+}
+
+//////////////////////////////////////////////////
+unsigned int World::PosePublishSteps() const
+{
+  return this->dataPtr->posePublishSteps;
+}
+
 //////////////////////////////////////////////////
 BasePtr World::BaseByName(const std::string &_name) const
 {
@@ -1148,6 +1429,113 @@ BasePtr World::BaseByName(const std::string &_name) const
     return BasePtr();
 }
 
+//////////////////////////////////////////////////
+/// \brief Remove an entity from one key of the index by name.
+/// \param[in,out] _index Index by name.
+/// \param[in] _key Key to remove the entity from.
+/// \param[in] _entity Entity to remove.
+static void RemoveIndexKey(
+    std::unordered_map<std::string, std::vector<BasePtr>> &_index,
+    const std::string &_key, const BasePtr &_entity)
+{
+  auto iter = _index.find(_key);
+  if (iter == _index.end())
+    return;
+
+  auto &entities = iter->second;
+  entities.erase(std::remove(entities.begin(), entities.end(), _entity),
+      entities.end());
+  if (entities.empty())
+    _index.erase(iter);
+}
+
+//////////////////////////////////////////////////
+void World::IndexEntity(const BasePtr &_entity)
+{
+  std::string scopedName = _entity->GetScopedName();
+  std::string name = _entity->GetName();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->entityIndexMutex);
+
+  auto &indexed = this->dataPtr->entitiesById[_entity->GetId()];
+  if (indexed.entity == _entity && indexed.scopedName == scopedName &&
+      indexed.name == name)
+  {
+    return;
+  }
+
+  // Remove the keys of the previous names.
+  if (indexed.entity)
+  {
+    RemoveIndexKey(this->dataPtr->entitiesByName, indexed.scopedName,
+        indexed.entity);
+    RemoveIndexKey(this->dataPtr->entitiesByName, indexed.name,
+        indexed.entity);
+  }
+
+  indexed.entity = _entity;
+  indexed.scopedName = scopedName;
+  indexed.name = name;
+  this->dataPtr->entitiesByName[scopedName].push_back(_entity);
+  if (name != scopedName)
+    this->dataPtr->entitiesByName[name].push_back(_entity);
+}
+
+//////////////////////////////////////////////////
+void World::UnindexEntity(const uint32_t _id)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->entityIndexMutex);
+
+    auto iter = this->dataPtr->entitiesById.find(_id);
+    if (iter == this->dataPtr->entitiesById.end())
+      return;
+
+    RemoveIndexKey(this->dataPtr->entitiesByName, iter->second.scopedName,
+        iter->second.entity);
+    RemoveIndexKey(this->dataPtr->entitiesByName, iter->second.name,
+        iter->second.entity);
+    this->dataPtr->entitiesById.erase(iter);
+  }
+
+  // Forget the last published pose, taken after the index lock is released
+  // as ProcessMessages locks them in the opposite order.
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  this->dataPtr->poseSlots.erase(_id);
+}
+
+//////////////////////////////////////////////////
+bool World::IndexedEntityByName(const std::string &_name,
+    BasePtr &_entity) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->entityIndexMutex);
+
+  auto iter = this->dataPtr->entitiesByName.find(_name);
+  if (iter == this->dataPtr->entitiesByName.end())
+  {
+    _entity.reset();
+    return true;
+  }
+
+  if (iter->second.size() != 1)
+    return false;
+
+  _entity = iter->second.front();
+  return true;
+}
+
+//////////////////////////////////////////////////
+BasePtr World::IndexedEntityById(const uint32_t _id) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->entityIndexMutex);
+
+  auto iter = this->dataPtr->entitiesById.find(_id);
+  if (iter == this->dataPtr->entitiesById.end())
+    return BasePtr();
+
+  return iter->second.entity;
+}
+
 /////////////////////////////////////////////////
 ModelPtr World::ModelById(unsigned int _id) const
 {
@@ -1682,12 +2070,17 @@ void World::BuildSceneMsg(msgs::Scene &_scene, BasePtr _entity)
 
 
 //////////////////////////////////////////////////
-// void World::ModelUpdateTBB()
-// {
-//   tbb::parallel_for (tbb::blocked_range<size_t>(0,
-//   this->dataPtr->models.size(), 10),
-//       ModelUpdate_TBB(&this->dataPtr->models));
-// }
+void World::ModelUpdateTBB()
+{
+  // Run inside the world's own arena so the number of worker threads is
+  // bounded by modelUpdateThreads, independently of other TBB users.
+  this->dataPtr->modelUpdateArena->execute([this]()
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0,
+        this->dataPtr->models.size()),
+        ModelUpdate_TBB(&this->dataPtr->models));
+  });
+}
 
 //////////////////////////////////////////////////
 void World::ModelUpdateSingleLoop()
@@ -2326,6 +2719,13 @@ EntityPtr World::EntityBelowPoint(const ignition::math::Vector3d &_pt) const
   end = _pt;
   end.Z() -= 1000;
 
+  // Skip the ray when no collision is below the point. Collisions moved
+  // while paused are refreshed first.
+  this->RefreshSpatialIndex();
+  physics::SpatialIndex &index = this->SpatialIndex();
+  if (index.Enabled() && index.QueryRay(_pt, end).empty())
+    return EntityPtr();
+
   this->dataPtr->physicsEngine->InitForThread();
   this->dataPtr->testRay->SetPoints(_pt, end);
   this->dataPtr->testRay->GetIntersection(dist, entityName);
@@ -2464,6 +2864,46 @@ void World::SetState(const WorldState &_state)
   }
 }
 
+//////////////////////////////////////////////////
+void World::SetState(const WorldSnapshot &_snapshot)
+{
+  if (!_snapshot.Matches(*this))
+  {
+    WorldState state;
+    _snapshot.ToWorldState(state);
+    state.SetInsertions(_snapshot.Insertions());
+    state.SetDeletions(_snapshot.Deletions());
+    this->SetState(state);
+    return;
+  }
+
+  this->SetSimTime(_snapshot.SimTime());
+  this->dataPtr->logRealTime = _snapshot.RealTime();
+  this->dataPtr->iterations = _snapshot.Iterations();
+
+  _snapshot.Apply(*this);
+}
+
+//////////////////////////////////////////////////
+void World::SaveCheckpoint(WorldCheckpoint &_checkpoint)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+  boost::recursive_mutex::scoped_lock physicsLock(
+      *this->dataPtr->physicsEngine->GetPhysicsUpdateMutex());
+
+  _checkpoint.Capture(*this);
+}
+
+//////////////////////////////////////////////////
+bool World::RestoreCheckpoint(const WorldCheckpoint &_checkpoint)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+  boost::recursive_mutex::scoped_lock physicsLock(
+      *this->dataPtr->physicsEngine->GetPhysicsUpdateMutex());
+
+  return _checkpoint.Restore(*this);
+}
+
 //////////////////////////////////////////////////
 void World::InsertModelFile(const std::string &_sdfFilename)
 {
@@ -2662,6 +3102,19 @@ bool World::OnLog(std::ostringstream &_stream)
   // of data, and reset states.
   if (!util::LogRecord::Instance()->Running())
   {
+    // Give the log worker a chance to convert the snapshots captured
+    // before recording stopped.
+    {
+      std::unique_lock<std::mutex> lock(this->dataPtr->logMutex);
+      this->dataPtr->logContinueCondition.wait_for(lock,
+          std::chrono::seconds(1), [this]
+          {
+            return this->dataPtr->stop ||
+                this->dataPtr->logSnapshotTail ==
+                this->dataPtr->logSnapshotHead;
+          });
+    }
+
     std::lock_guard<std::mutex> lock(this->dataPtr->logBufferMutex);
 
     // Output any data that may have been pushed onto the queue
@@ -2686,9 +3139,7 @@ bool World::OnLog(std::ostringstream &_stream)
     // Clear everything.
     this->dataPtr->states[0].clear();
     this->dataPtr->states[1].clear();
-    this->dataPtr->stateToggle = 0;
-    this->dataPtr->prevStates[0] = WorldState();
-    this->dataPtr->prevStates[1] = WorldState();
+    this->dataPtr->logLastSnapshot = WorldSnapshot();
   }
 
   this->LogModelResources();
@@ -2702,63 +3153,80 @@ void World::ProcessMessages()
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
 
-    if ((this->dataPtr->posePub && this->dataPtr->posePub->HasConnections()) ||
+    // The poses of the entities which moved are gathered until the next
+    // message is due, see SetPosePublishSteps. Only physics steps count,
+    // not the passes made while paused or while the pacer was not due.
+    const uint64_t iterations = this->dataPtr->iterations;
+    const uint64_t stepped =
+        iterations > this->dataPtr->posePublishIterations ?
+        iterations - this->dataPtr->posePublishIterations : 0;
+    this->dataPtr->posePublishIterations = iterations;
+    this->dataPtr->posePublishCounter += stepped;
+
+    // Poses queued outside World::Update, such as a model moved while
+    // paused, are not held back.
+    const unsigned int poseSteps = this->dataPtr->posePublishSteps;
+    const bool posesDue = poseSteps <= 1 ||
+        this->dataPtr->posePublishCounter >= poseSteps ||
+        this->dataPtr->posesQueuedIdle;
+
+    if (posesDue &&
+        ((this->dataPtr->posePub && this->dataPtr->posePub->HasConnections()) ||
       // When ready to use the direct API for updating scene poses from server,
       // uncomment the following line:
          this->dataPtr->updateScenePoses ||
         (this->dataPtr->poseLocalPub &&
-         this->dataPtr->poseLocalPub->HasConnections()))
-    {
-      msgs::PosesStamped msg;
+         this->dataPtr->poseLocalPub->HasConnections())))
+    {
+      // The message keeps its pose entries allocated between publications.
+      // The publisher holds the last message it sent, so the spare message,
+      // sent the time before, is used instead. A new one is only allocated
+      // while a subscriber still holds it.
+      if (this->dataPtr->poseMsg && !this->dataPtr->poseMsg.unique())
+        std::swap(this->dataPtr->poseMsg, this->dataPtr->sparePoseMsg);
+      if (!this->dataPtr->poseMsg || !this->dataPtr->poseMsg.unique())
+        this->dataPtr->poseMsg.reset(new msgs::PosesStamped);
+      msgs::PosesStamped &msg = *this->dataPtr->poseMsg;
+      msg.mutable_pose()->Clear();
 
       // Time stamp this PosesStamped message
       msgs::Set(msg.mutable_time(), this->SimTime());
 
-      if (!this->dataPtr->publishModelPoses.empty() ||
-          !this->dataPtr->publishLightPoses.empty())
+      auto &dirty = this->dataPtr->posesDirty;
+      if (!dirty.empty())
       {
-        for (auto const &model : this->dataPtr->publishModelPoses)
+        std::sort(dirty.begin(), dirty.end());
+        dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+
+        std::lock_guard<std::mutex> indexLock(
+            this->dataPtr->entityIndexMutex);
+        for (const uint32_t id : dirty)
         {
-          std::list<ModelPtr> modelList;
-          modelList.push_back(model);
-          while (!modelList.empty())
+          // Skip the entities removed since their pose changed.
+          auto iter = this->dataPtr->entitiesById.find(id);
+          if (iter == this->dataPtr->entitiesById.end() ||
+              !iter->second.entity->HasType(Base::ENTITY))
           {
-            ModelPtr m = modelList.front();
-            modelList.pop_front();
-            msgs::Pose *poseMsg = msg.add_pose();
-
-            // Publish the model's relative pose
-            poseMsg->set_name(m->GetScopedName());
-            poseMsg->set_id(m->GetId());
-            msgs::Set(poseMsg, m->RelativePose());
-
-            // Publish each of the model's child links relative poses
-            Link_V links = m->GetLinks();
-            for (auto const &link : links)
-            {
-              poseMsg = msg.add_pose();
-              poseMsg->set_name(link->GetScopedName());
-              poseMsg->set_id(link->GetId());
-              msgs::Set(poseMsg, link->RelativePose());
-            }
-
-            // add all nested models to the queue
-            Model_V models = m->NestedModels();
-            for (auto const &n : models)
-              modelList.push_back(n);
+            this->dataPtr->poseSlots.erase(id);
+            continue;
           }
-        }
-
-        for (auto const &light : this->dataPtr->publishLightPoses)
-        {
-          msgs::Pose *poseMsg = msg.add_pose();
 
-          // Publish the light's pose
-          poseMsg->set_name(light->GetScopedName());
-          poseMsg->set_id(light->GetId());
-          msgs::Set(poseMsg, light->RelativePose());
+          // Only the pose is refreshed once the entity has an entry, the
+          // name is copied from the index on first appearance or rename.
+          msgs::Pose &slot = this->dataPtr->poseSlots[id];
+          if (slot.name() != iter->second.scopedName)
+          {
+            slot.set_name(iter->second.scopedName);
+            slot.set_id(id);
+          }
+          msgs::Set(&slot, static_cast<const Entity *>(
+              iter->second.entity.get())->RelativePose());
+          msg.add_pose()->CopyFrom(slot);
         }
+      }
 
+      if (msg.pose_size() > 0)
+      {
         if (this->dataPtr->posePub && this->dataPtr->posePub->HasConnections())
           this->dataPtr->posePub->Publish(msg);
       }
@@ -2767,8 +3235,9 @@ void World::ProcessMessages()
           this->dataPtr->poseLocalPub->HasConnections())
       {
         // rendering::Scene depends on this timestamp, which is used by
-        // rendering sensors to time stamp their data
-        this->dataPtr->poseLocalPub->Publish(msg);
+        // rendering sensors to time stamp their data. The subscribers share
+        // the message.
+        this->dataPtr->poseLocalPub->Publish(this->dataPtr->poseMsg);
       }
 
       // When ready to use the direct API for updating scene poses from server,
@@ -2780,8 +3249,12 @@ void World::ProcessMessages()
       }
     }
 
-    this->dataPtr->publishModelPoses.clear();
-    this->dataPtr->publishLightPoses.clear();
+    if (posesDue)
+    {
+      this->dataPtr->posePublishCounter = 0;
+      this->dataPtr->posesDirty.clear();
+      this->dataPtr->posesQueuedIdle = false;
+    }
   }
 
   {
@@ -2869,6 +3342,18 @@ void World::ProcessMessages()
 //////////////////////////////////////////////////
 void World::PublishWorldStats()
 {
+  // Only build the message when it is due and someone listens.
+  if (!this->dataPtr->statPub || !this->dataPtr->statPub->HasConnections())
+    return;
+
+  const double rate = this->dataPtr->statsPublishRate;
+  const common::Time wallTime = common::Time::GetWallTime();
+  if (rate > 0 &&
+      (wallTime - this->dataPtr->prevStatTime).Double() < 1.0 / rate)
+  {
+    return;
+  }
+
   this->dataPtr->worldStatsMsg.Clear();
 
   msgs::Set(this->dataPtr->worldStatsMsg.mutable_sim_time(),
@@ -2893,9 +3378,8 @@ void World::PublishWorldStats()
         logStats);
   }
 
-  if (this->dataPtr->statPub && this->dataPtr->statPub->HasConnections())
-    this->dataPtr->statPub->Publish(this->dataPtr->worldStatsMsg);
-  this->dataPtr->prevStatTime = common::Time::GetWallTime();
+  this->dataPtr->statPub->Publish(this->dataPtr->worldStatsMsg);
+  this->dataPtr->prevStatTime = wallTime;
 }
 
 //////////////////////////////////////////////////
@@ -2907,10 +3391,29 @@ bool World::IsLoaded() const
 //////////////////////////////////////////////////
 void World::PublishModelPose(physics::ModelPtr _model)
 {
+  if (!_model)
+    return;
+
   std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  if (!this->dataPtr->updating)
+    this->dataPtr->posesQueuedIdle = true;
 
-  // Only add if the model name is not in the list
-  this->dataPtr->publishModelPoses.insert(_model);
+  // Queue the model, its links and its nested models. Duplicates are
+  // removed when the message is built.
+  std::list<ModelPtr> modelList;
+  modelList.push_back(_model);
+  while (!modelList.empty())
+  {
+    ModelPtr m = modelList.front();
+    modelList.pop_front();
+    this->dataPtr->posesDirty.push_back(m->GetId());
+
+    for (auto const &link : m->GetLinks())
+      this->dataPtr->posesDirty.push_back(link->GetId());
+
+    for (auto const &n : m->NestedModels())
+      modelList.push_back(n);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -2925,97 +3428,162 @@ void World::PublishModelScale(physics::ModelPtr _model)
 //////////////////////////////////////////////////
 void World::PublishLightPose(const physics::LightPtr _light)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  if (!_light)
+    return;
 
-  // Only add if the light name is not in the list
-  this->dataPtr->publishLightPoses.insert(_light);
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  if (!this->dataPtr->updating)
+    this->dataPtr->posesQueuedIdle = true;
+  this->dataPtr->posesDirty.push_back(_light->GetId());
 }
 
 //////////////////////////////////////////////////
-void World::LogWorker()
+void World::CaptureLogState()
 {
-  std::unique_lock<std::mutex> lock(this->dataPtr->logMutex);
+  util::LogRecord *logRecord = util::LogRecord::Instance();
+  if (!logRecord->Running())
+  {
+    // The next recording starts from a new layout, without insertions or
+    // deletions.
+    this->dataPtr->logPrevSnapshot = nullptr;
+    return;
+  }
+
+  common::Time startTime = common::Time::GetWallTime();
+  const common::Time simTime = this->SimTime();
 
-  WorldPtr self = shared_from_this();
-  this->dataPtr->logPrevIteration = this->dataPtr->iterations;
+  std::lock_guard<std::mutex> dLock(this->dataPtr->entityDeleteMutex);
 
-  GZ_ASSERT(self, "Self pointer to World is invalid");
+  // Throttle state capture based on log recording frequency. Insertions
+  // and deletions are always captured right away.
+  const WorldSnapshot *prev = this->dataPtr->logPrevSnapshot;
+  if (prev && simTime - this->dataPtr->logLastStateTime < logRecord->Period()
+      && prev->Matches(*this))
+  {
+    return;
+  }
 
-  // Init the prevUnfilteredState
-  this->dataPtr->prevUnfilteredState.Load(self);
+  // The snapshots are allocated by Init.
+  const size_t slotCount = this->dataPtr->logSnapshots.size();
+  if (slotCount == 0)
+    return;
 
-  while (!this->dataPtr->stop)
+  // Only wait if the log worker is a full ring behind, so that no state is
+  // dropped.
+  const uint64_t head = this->dataPtr->logSnapshotHead;
+  if (head - this->dataPtr->logSnapshotTail >= slotCount)
   {
-    // get unfiltered world state
-    WorldState unfilteredState;
+    common::Time stallStart = common::Time::GetWallTime();
     {
-      std::lock_guard<std::mutex> dLock(this->dataPtr->entityDeleteMutex);
-      unfilteredState.Load(self);
+      std::unique_lock<std::mutex> lock(this->dataPtr->logMutex);
+      this->dataPtr->logContinueCondition.wait(lock, [&]
+          {
+            return this->dataPtr->stop ||
+                head - this->dataPtr->logSnapshotTail < slotCount;
+          });
     }
+    common::Time stall = common::Time::GetWallTime() - stallStart;
+    this->dataPtr->logStallTime = this->dataPtr->logStallTime + stall.Double();
+    this->dataPtr->logStallCount++;
+    startTime += stall;
+
+    if (this->dataPtr->stop)
+      return;
+  }
 
-    // compute world state diff and find out about insertions and deletions
-    std::vector<std::string> insertions;
-    std::vector<std::string> deletions;
-    bool insertDelete = false;
+  WorldSnapshot *snapshot = this->dataPtr->logSnapshots[head % slotCount].get();
+  snapshot->Capture(*this, prev);
+  this->dataPtr->logPrevSnapshot = snapshot;
+  this->dataPtr->logLastStateTime = simTime;
+  this->dataPtr->logSnapshotHead = head + 1;
 
+  if (!this->dataPtr->logThread)
+  {
+    // A world stepped by BatchStep has no log worker, store the snapshot
+    // on this thread.
+    this->StoreLogSnapshot(*snapshot);
+    this->dataPtr->logSnapshotTail = head + 1;
+  }
+  else
+  {
+    // Lock so the notification can't slip in between the worker checking
+    // for work and going to sleep.
     {
-      WorldState unfilteredDiffState = unfilteredState -
-          this->dataPtr->prevUnfilteredState;
-      if (!unfilteredDiffState.IsZero())
-      {
-        insertions = unfilteredDiffState.Insertions();
-        deletions = unfilteredDiffState.Deletions();
-        insertDelete = !insertions.empty() || !deletions.empty();
-      }
+      std::lock_guard<std::mutex> lock(this->dataPtr->logMutex);
     }
-    this->dataPtr->prevUnfilteredState = unfilteredState;
+    this->dataPtr->logCondition.notify_one();
+  }
 
-    // Throttle state capture based on log recording frequency.
-    auto simTime = this->SimTime();
-    if ((simTime - this->dataPtr->logLastStateTime >=
-        util::LogRecord::Instance()->Period()) || insertDelete)
-    {
-      int currState = (this->dataPtr->stateToggle + 1) % 2;
+  this->dataPtr->logCaptureTime =
+      (common::Time::GetWallTime() - startTime).Double();
+}
 
-      std::string filterStr = util::LogRecord::Instance()->Filter();
-      // compute diff for filtered states
-      {
-        std::lock_guard<std::mutex> dLock(this->dataPtr->entityDeleteMutex);
-        this->dataPtr->prevStates[currState].LoadWithFilter(self, filterStr);
-      }
-      WorldState diffState = this->dataPtr->prevStates[currState] -
-          this->dataPtr->prevStates[this->dataPtr->stateToggle];
-      this->dataPtr->logPrevIteration = this->dataPtr->iterations;
+//////////////////////////////////////////////////
+void World::StoreLogSnapshot(const WorldSnapshot &_snapshot)
+{
+  const bool insertDelete = !_snapshot.Insertions().empty() ||
+      !_snapshot.Deletions().empty();
+  const std::string filter = util::LogRecord::Instance()->Filter();
 
-      if (!diffState.IsZero() || insertDelete)
-      {
-        this->dataPtr->stateToggle = currState;
-        {
-          // Store the entire current state (instead of the diffState). A slow
-          // moving link may never be captured if only diff state is recorded.
-          std::lock_guard<std::mutex> bLock(this->dataPtr->logBufferMutex);
-
-          this->dataPtr->prevStates[currState].SetInsertions(insertions);
-          this->dataPtr->prevStates[currState].SetDeletions(deletions);
-          this->dataPtr->states[this->dataPtr->currentStateBuffer].push_back(
-              this->dataPtr->prevStates[currState]);
-
-          // Tell the logger to update, once the number of states exceeds 1000
-          if (this->dataPtr->states[this->dataPtr->currentStateBuffer].size() >
-              1000)
+  // Compare the flat arrays of the snapshots first. Only snapshots that
+  // differ from the last stored one are converted to a WorldState.
+  bool changed = false;
+  {
+    std::lock_guard<std::mutex> bLock(this->dataPtr->logBufferMutex);
+    changed = insertDelete ||
+        _snapshot.Diff(this->dataPtr->logLastSnapshot, filter);
+    if (changed)
+      this->dataPtr->logLastSnapshot = _snapshot;
+  }
+
+  if (!changed)
+    return;
+
+  // Store the entire current state (instead of the diffState). A slow
+  // moving link may never be captured if only diff state is recorded.
+  WorldState state;
+  _snapshot.ToWorldState(state, filter);
+  state.SetInsertions(_snapshot.Insertions());
+  state.SetDeletions(_snapshot.Deletions());
+
+  std::lock_guard<std::mutex> bLock(this->dataPtr->logBufferMutex);
+  this->dataPtr->states[this->dataPtr->currentStateBuffer].push_back(state);
+
+  // Tell the logger to update, once the number of states exceeds 1000
+  if (this->dataPtr->states[this->dataPtr->currentStateBuffer].size() > 1000)
+    util::LogRecord::Instance()->Notify();
+}
+
+//////////////////////////////////////////////////
+void World::LogWorker()
+{
+  const size_t slotCount = this->dataPtr->logSnapshots.size();
+
+  while (true)
+  {
+    // Wait until there is work to be done.
+    {
+      std::unique_lock<std::mutex> lock(this->dataPtr->logMutex);
+      this->dataPtr->logCondition.wait(lock, [this]
           {
-            util::LogRecord::Instance()->Notify();
-          }
-        }
-      }
+            return this->dataPtr->stop ||
+                this->dataPtr->logSnapshotTail !=
+                this->dataPtr->logSnapshotHead;
+          });
 
-      this->dataPtr->logLastStateTime = simTime;
+      if (this->dataPtr->logSnapshotTail == this->dataPtr->logSnapshotHead)
+        break;
     }
 
-    this->dataPtr->logContinueCondition.notify_all();
+    const uint64_t tail = this->dataPtr->logSnapshotTail;
+    this->StoreLogSnapshot(*this->dataPtr->logSnapshots[tail % slotCount]);
 
-    // Wait until there is work to be done.
-    this->dataPtr->logCondition.wait(lock);
+    // Hand the slot back to the update thread.
+    this->dataPtr->logSnapshotTail = tail + 1;
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->logMutex);
+    }
+    this->dataPtr->logContinueCondition.notify_all();
   }
 
   // Make sure nothing is blocked by this thread.
@@ -3124,33 +3692,6 @@ void World::RemoveModel(const std::string &_name)
       }
     }
   }
-
-  // Cleanup the publishModelPoses list.
-  {
-    std::lock_guard<std::recursive_mutex> lock2(this->dataPtr->receiveMutex);
-    for (auto model = this->dataPtr->publishModelPoses.begin();
-             model != this->dataPtr->publishModelPoses.end(); ++model)
-    {
-      if ((*model)->GetName() == _name || (*model)->GetScopedName() == _name)
-      {
-        this->dataPtr->publishModelPoses.erase(model);
-        break;
-      }
-    }
-  }
-
-  // Cleanup the publishLightPoses list.
-  {
-    std::lock_guard<std::recursive_mutex> lock2(this->dataPtr->receiveMutex);
-    for (auto light : this->dataPtr->publishLightPoses)
-    {
-      if (light->GetName() == _name || light->GetScopedName() == _name)
-      {
-        this->dataPtr->publishLightPoses.erase(light);
-        break;
-      }
-    }
-  }
 }
 
 /////////////////////////////////////////////////
@@ -3235,6 +3776,16 @@ void World::_AddDirty(Entity *_entity)
   this->dataPtr->dirtyPoses.push_back(_entity);
 }
 
+/////////////////////////////////////////////////
+void World::_AddSpatialDirty(const uint32_t _id)
+{
+  if (!this->dataPtr->spatialIndexEnabled)
+    return;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->spatialDirtyMutex);
+  this->dataPtr->spatialDirty.push_back(_id);
+}
+
 /////////////////////////////////////////////////
 void World::ResetPhysicsStates()
 {
@@ -3259,6 +3810,109 @@ void World::RegisterIntrospectionItems()
   // Add here all the items that might be introspected.
   gazebo::util::IntrospectionManager::Instance()->Register<common::Time>(
       timeURI.Str(), std::bind(&World::SimTime, this));
+
+  common::URI captureTimeURI(uri);
+  captureTimeURI.Query().Insert("p", "log/capture_time");
+  this->dataPtr->introspectionItems.push_back(captureTimeURI);
+  gazebo::util::IntrospectionManager::Instance()->Register<double>(
+      captureTimeURI.Str(), [this]()
+      {
+        return this->dataPtr->logCaptureTime.load();
+      });
+
+  common::URI stallTimeURI(uri);
+  stallTimeURI.Query().Insert("p", "log/stall_time");
+  this->dataPtr->introspectionItems.push_back(stallTimeURI);
+  gazebo::util::IntrospectionManager::Instance()->Register<double>(
+      stallTimeURI.Str(), [this]()
+      {
+        return this->dataPtr->logStallTime.load();
+      });
+
+  common::URI stallCountURI(uri);
+  stallCountURI.Query().Insert("p", "log/stall_count");
+  this->dataPtr->introspectionItems.push_back(stallCountURI);
+  gazebo::util::IntrospectionManager::Instance()->Register<int>(
+      stallCountURI.Str(), [this]()
+      {
+        return this->dataPtr->logStallCount.load();
+      });
+
+  common::URI pendingURI(uri);
+  pendingURI.Query().Insert("p", "log/pending_states");
+  this->dataPtr->introspectionItems.push_back(pendingURI);
+  gazebo::util::IntrospectionManager::Instance()->Register<int>(
+      pendingURI.Str(), [this]()
+      {
+        return static_cast<int>(this->dataPtr->logSnapshotHead -
+            this->dataPtr->logSnapshotTail);
+      });
+
+  // Statistics of the real time pacing.
+  RealTimePacer *pacer = this->dataPtr->pacer.get();
+
+  common::URI stepCountURI(uri);
+  stepCountURI.Query().Insert("p", "real_time/step_count");
+  this->dataPtr->introspectionItems.push_back(stepCountURI);
+  gazebo::util::IntrospectionManager::Instance()->Register<int>(
+      stepCountURI.Str(), [pacer]()
+      {
+        return static_cast<int>(pacer->StepCount());
+      });
+
+  common::URI overrunCountURI(uri);
+  overrunCountURI.Query().Insert("p", "real_time/overrun_count");
+  this->dataPtr->introspectionItems.push_back(overrunCountURI);
+  gazebo::util::IntrospectionManager::Instance()->Register<int>(
+      overrunCountURI.Str(), [pacer]()
+      {
+        return static_cast<int>(pacer->OverrunCount());
+      });
+
+  common::URI jitterMeanURI(uri);
+  jitterMeanURI.Query().Insert("p", "real_time/jitter_mean");
+  this->dataPtr->introspectionItems.push_back(jitterMeanURI);
+  gazebo::util::IntrospectionManager::Instance()->Register<double>(
+      jitterMeanURI.Str(), [pacer]()
+      {
+        return pacer->JitterMean();
+      });
+
+  common::URI jitterMaxURI(uri);
+  jitterMaxURI.Query().Insert("p", "real_time/jitter_max");
+  this->dataPtr->introspectionItems.push_back(jitterMaxURI);
+  gazebo::util::IntrospectionManager::Instance()->Register<double>(
+      jitterMaxURI.Str(), [pacer]()
+      {
+        return pacer->JitterMax();
+      });
+
+  // One item per bucket of the jitter histogram, named after its upper
+  // edge in microseconds, e.g. real_time/jitter_lt_50us.
+  const auto &edges = RealTimePacer::HistogramEdges();
+  for (size_t i = 0; i <= edges.size(); ++i)
+  {
+    std::ostringstream bucketName;
+    if (i < edges.size())
+    {
+      bucketName << "real_time/jitter_lt_"
+                 << static_cast<int>(std::round(edges[i] * 1e6)) << "us";
+    }
+    else
+    {
+      bucketName << "real_time/jitter_ge_"
+                 << static_cast<int>(std::round(edges.back() * 1e6)) << "us";
+    }
+
+    common::URI bucketURI(uri);
+    bucketURI.Query().Insert("p", bucketName.str());
+    this->dataPtr->introspectionItems.push_back(bucketURI);
+    gazebo::util::IntrospectionManager::Instance()->Register<int>(
+        bucketURI.Str(), [pacer, i]()
+        {
+          return static_cast<int>(pacer->JitterHistogram()[i]);
+        });
+  }
 }
 
 /////////////////////////////////////////////////
@@ -39,6 +39,8 @@
 
 #include "gazebo/physics/Base.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/RealTimePacer.hh"
+#include "gazebo/physics/SpatialIndex.hh"
 #include "gazebo/physics/WorldState.hh"
 #include "gazebo/physics/Wind.hh"
 #include "gazebo/util/system.hh"
@@ -155,6 +157,21 @@ namespace gazebo
       /// \return Reference to the wind.
       public: physics::Wind &Wind() const;
 
+      /// \brief Get the spatial index of the bounding boxes of the
+      /// collisions of the world, keyed by collision id. Ray sensor
+      /// collisions are not indexed. Moved collisions are refreshed once
+      /// per step, after the physics update. The index is disabled when the
+      /// physics engine does not report bounding boxes in the world frame.
+      /// \return Reference to the spatial index.
+      public: physics::SpatialIndex &SpatialIndex() const;
+
+      /// \brief Get a collision by id, e.g. an id returned by a query of
+      /// the spatial index.
+      /// \param[in] _id Id of the collision.
+      /// \return A pointer to the collision, or NULL if no collision has
+      /// this id.
+      public: CollisionPtr CollisionById(const uint32_t _id) const;
+
       /// \brief Return the spherical coordinates converter.
       /// \return Pointer to the spherical coordinates converter.
       public: common::SphericalCoordinatesPtr SphericalCoords() const;
@@ -179,6 +196,75 @@ namespace gazebo
       /// \param[in] _mag New magnetic field vector.
       public: void SetMagneticField(const ignition::math::Vector3d &_mag);
 
+      /// \brief Set the number of threads used to call Model::Update on the
+      /// top level models of this world.
+      ///
+      /// With 0 or 1 thread, models are updated sequentially in the world
+      /// thread (the default). With more threads, top level models are
+      /// partitioned across a work-stealing TBB task arena of that size.
+      /// The value can also be set with the `<gz:model_update_threads>`
+      /// element inside `<physics>` or the model_update_threads field of
+      /// a msgs::Physics message published on `~/physics`.
+      ///
+      /// Thread-safety contract in parallel mode:
+      /// - Events::worldUpdateBegin, Events::beforePhysicsUpdate and
+      ///   Events::worldUpdateEnd callbacks still run sequentially in the
+      ///   world thread, before and after the model update pass.
+      /// - Model::Update of different top level models, including their
+      ///   nested models, joints, joint controllers and joint animations,
+      ///   may run concurrently. Anything those call back into (for example
+      ///   Joint update events or joint animation completion callbacks)
+      ///   must only touch state owned by that model, or protect shared
+      ///   state with its own locks.
+      /// - The order in which models are updated is unspecified.
+      /// \param[in] _threads Number of threads.
+      /// \sa ModelUpdateThreads()
+      public: void SetModelUpdateThreads(const unsigned int _threads);
+
+      /// \brief Get the number of threads used to update models.
+      /// \return Number of threads, 0 or 1 if models are updated
+      /// sequentially.
+      /// \sa SetModelUpdateThreads()
+      public: unsigned int ModelUpdateThreads() const;
+
+      /// \brief Set the rate at which world statistics are published, in
+      /// wall clock time. The message is only built when it is due and
+      /// someone subscribed to it. The default of 5 Hz can also be set
+      /// with the <gz:stats_publish_rate> element of the world.
+      /// \param[in] _rate Rate in Hz, 0 to publish after every step.
+      /// \sa StatsPublishRate()
+      public: void SetStatsPublishRate(const double _rate);
+
+      /// \brief Get the rate at which world statistics are published.
+      /// \return Rate in Hz, 0 if published after every step.
+      /// \sa SetStatsPublishRate()
+      public: double StatsPublishRate() const;
+
+      /// \brief Set the number of physics steps between two pose messages.
+      /// Poses of the entities which moved in between are gathered in the
+      /// next message, while poses changed outside of World::Update,
+      /// e.g. when paused, are published right away. The default of 1 can
+      /// also be set with the <gz:pose_publish_steps> element of the world.
+      /// Values greater than 1 also delay the poses of the scene of
+      /// rendering sensors.
+      /// \param[in] _steps Number of steps, 0 is treated as 1.
+      /// \sa PosePublishSteps()
+      public: void SetPosePublishSteps(const unsigned int _steps);
+
+      /// \brief Get the number of steps between two pose messages.
+      /// \return Number of steps.
+      /// \sa SetPosePublishSteps()
+      public: unsigned int PosePublishSteps() const;
+
+      /// \brief Get the pacer which holds the steps to the real time update
+      /// rate of the physics engine. Its mode can also be set with the
+      /// <gz:real_time_pacing> element of the world, one of "sleep" (the
+      /// default), "hybrid" and "deadline", and the spin time of the hybrid
+      /// mode with <gz:pacing_spin_time>. The jitter statistics are also
+      /// available from the introspection service, under "real_time/".
+      /// \return Reference to the pacer.
+      public: physics::RealTimePacer &Pacer() const;
+
       /// \brief Get the number of models.
       /// \return The number of models in the World.
       public: unsigned int ModelCount() const;
@@ -297,6 +383,30 @@ namespace gazebo
       /// \param _state The state to set the World to.
       public: void SetState(const WorldState &_state);
 
+      /// \brief Set the current world state from a snapshot. When the
+      /// snapshot was captured from the current entities of this world,
+      /// its flat arrays are applied directly, otherwise it is converted
+      /// to a WorldState and applied by name.
+      /// \param[in] _snapshot The snapshot to set the World to.
+      public: void SetState(const WorldSnapshot &_snapshot);
+
+      /// \brief Save the full dynamic state of the world to an in-memory
+      /// checkpoint: entity states including velocities, simulation time,
+      /// random seed and physics engine solver state. Storage of the
+      /// checkpoint is reused, so saving repeatedly into the same
+      /// checkpoint does not allocate while the world structure is stable.
+      /// \param[out] _checkpoint Checkpoint to fill.
+      /// \sa RestoreCheckpoint
+      public: void SaveCheckpoint(WorldCheckpoint &_checkpoint);
+
+      /// \brief Restore a checkpoint saved by SaveCheckpoint. This is much
+      /// faster than Reset or SetState, and can be repeated to run several
+      /// rollouts from the same state.
+      /// \param[in] _checkpoint Checkpoint to restore.
+      /// \return False if models or lights were inserted or removed since
+      /// the checkpoint was saved, in which case nothing is restored.
+      public: bool RestoreCheckpoint(const WorldCheckpoint &_checkpoint);
+
       /// \brief Insert a model from an SDF file.
       /// Spawns a model into the world base on and SDF file.
       /// \param[in] _sdfFilename The name of the SDF file (including path).
@@ -383,8 +493,9 @@ namespace gazebo
       public: void ClearModels();
 
       /// \brief Publish pose updates for a model.
-      /// This list of models to publish is processed and cleared once every
-      /// iteration.
+      /// The model, its links and its nested models are queued for the next
+      /// pose message. Entities moved by the physics engine are queued on
+      /// their own.
       /// \param[in] _model Pointer to the model to publish.
       public: void PublishModelPose(physics::ModelPtr _model);
 
@@ -395,8 +506,7 @@ namespace gazebo
       public: void PublishModelScale(physics::ModelPtr _model);
 
       /// \brief Publish pose updates for a light.
-      /// Adds light to a list of lights to publish, which is processed and
-      /// cleared once every iteration.
+      /// The light is queued for the next pose message.
       /// \param[in] _light Pointer to the light to publish.
       public: void PublishLightPose(const physics::LightPtr _light);
 
@@ -414,6 +524,36 @@ namespace gazebo
       /// A value of zero disables run stop.
       public: void RunBlocking(const unsigned int _iterations = 0);
 
+      /// \brief Step the world in the calling thread, as a member of a
+      /// WorldBatch. The steps are taken regardless of the pause state and
+      /// without real time throttling, and the world must not be running
+      /// its own thread, see Run. The process wide event::Events are
+      /// signaled under a lock shared by all batched worlds, and the
+      /// introspection manager is left to the batch.
+      /// \param[in] _steps Number of steps to take.
+      /// \sa WorldBatch
+      public: void BatchStep(const unsigned int _steps);
+
+      /// \brief Connect to the start of each update of this world only.
+      /// Unlike event::Events::ConnectWorldUpdateBegin, the callback is not
+      /// called for the updates of other worlds of the process. It is
+      /// called right before the process wide event.
+      /// \param[in] _subscriber Callback.
+      /// \return Connection, the callback is disconnected when it is
+      /// released.
+      public: event::ConnectionPtr ConnectUpdateBegin(
+                  std::function<void (const common::UpdateInfo &)>
+                  _subscriber);
+
+      /// \brief Connect to the end of each update of this world only.
+      /// The callback is called right before event::Events::worldUpdateEnd.
+      /// \param[in] _subscriber Callback.
+      /// \return Connection, the callback is disconnected when it is
+      /// released.
+      /// \sa ConnectUpdateBegin
+      public: event::ConnectionPtr ConnectUpdateEnd(
+                  std::function<void ()> _subscriber);
+
       /// \brief Remove a model. This function will block until
       /// the physics engine is not locked. The duration of the block
       /// is less than the time to complete a simulation iteration.
@@ -438,6 +578,12 @@ namespace gazebo
       /// \param[in] _entity Entity that has moved.
       public: void _AddDirty(Entity *_entity);
 
+      /// \internal
+      /// \brief Inform the World that the pose of a collision changed. The
+      /// entry of the collision in the spatial index is refreshed later.
+      /// \param[in] _id Id of the collision.
+      public: void _AddSpatialDirty(const uint32_t _id);
+
       /// \brief Get whether sensors have been initialized.
       /// \return True if sensors have been initialized.
       public: bool SensorsInitialized() const;
@@ -613,6 +759,17 @@ namespace gazebo
       /// \brief Publish the world stats message.
       private: void PublishWorldStats();
 
+      /// \brief Copy the world state into the next free log snapshot, if
+      /// recording and the log period elapsed. Called from the update
+      /// thread; the conversion to WorldState happens in LogWorker, or
+      /// right away for a world stepped by BatchStep.
+      private: void CaptureLogState();
+
+      /// \brief Add a log snapshot to the states written by OnLog, if it
+      /// differs from the last one added.
+      /// \param[in] _snapshot Captured snapshot.
+      private: void StoreLogSnapshot(const WorldSnapshot &_snapshot);
+
       /// \brief Thread function for logging state data.
       private: void LogWorker();
 
@@ -651,10 +808,40 @@ namespace gazebo
       private: bool PluginInfoService(const ignition::msgs::StringMsg &_request,
           ignition::msgs::Plugin_V &_plugins);
 
+      /// \brief Add an entity to the index of the world, or update the names
+      /// under which it's indexed.
+      /// \param[in] _entity Entity to index.
+      private: void IndexEntity(const BasePtr &_entity);
+
+      /// \brief Remove an entity from the index of the world.
+      /// \param[in] _id Id of the entity.
+      private: void UnindexEntity(const uint32_t _id);
+
+      /// \brief Find an entity in the index by scoped name or by name.
+      /// \param[in] _name Scoped name or name.
+      /// \param[out] _entity The only entity which matches the name, or
+      /// NULL if none does.
+      /// \return False if more than one entity matches the name, in which
+      /// case the caller has to search the tree of entities.
+      private: bool IndexedEntityByName(const std::string &_name,
+                   BasePtr &_entity) const;
+
+      /// \brief Find an entity in the index by id.
+      /// \param[in] _id Id of the entity.
+      /// \return The entity, or NULL if it's not indexed.
+      private: BasePtr IndexedEntityById(const uint32_t _id) const;
+
+      /// \brief Update the spatial index with the collisions whose pose
+      /// changed.
+      private: void RefreshSpatialIndex() const;
+
       /// \internal
       /// \brief Private data pointer.
       private: std::unique_ptr<WorldPrivate> dataPtr;
 
+      /// Friend Base so that it maintains the index of entities
+      private: friend class Base;
+
       /// Friend DARTLink so that it has access to dataPtr->dirtyPoses
       private: friend class DARTLink;
 
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/physics/PhysicsIface.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldBatch.hh"
+#include "gazebo/util/IntrospectionManager.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Private data for the WorldBatch class
+    class WorldBatchPrivate
+    {
+      /// \brief Worlds of the batch.
+      public: std::vector<WorldPtr> worlds;
+
+      /// \brief Number of threads, 0 for the TBB default.
+      public: unsigned int threads = 0;
+
+      /// \brief Task arena bounding the threads stepping the worlds. Not
+      /// allocated when the worlds are stepped sequentially.
+      public: std::unique_ptr<tbb::task_arena> arena;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+/////////////////////////////////////////////////
+WorldBatch::WorldBatch()
+  : dataPtr(new WorldBatchPrivate)
+{
+  this->SetThreadCount(0);
+}
+
+/////////////////////////////////////////////////
+WorldBatch::~WorldBatch()
+{
+}
+
+/////////////////////////////////////////////////
+bool WorldBatch::Load(sdf::ElementPtr _sdf, const unsigned int _count)
+{
+  if (!_sdf || _sdf->GetName() != "world")
+  {
+    gzerr << "WorldBatch::Load requires a world element" << std::endl;
+    return false;
+  }
+
+  const std::string baseName = _sdf->Get<std::string>("name");
+
+  std::vector<std::string> names;
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    names.push_back(baseName + "_" + std::to_string(i));
+    if (has_world(names.back()))
+    {
+      gzerr << "Unable to create batch world[" << names.back()
+            << "], a world with that name already exists" << std::endl;
+      return false;
+    }
+  }
+
+  for (auto const &name : names)
+  {
+    // World::Load takes the name of the world from the element.
+    sdf::ElementPtr worldElem = _sdf->Clone();
+    worldElem->GetAttribute("name")->Set(name);
+
+    WorldPtr world = create_world(name);
+    load_world(world, worldElem);
+    init_world(world, nullptr);
+    this->AddWorld(world);
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+void WorldBatch::AddWorld(WorldPtr _world)
+{
+  if (_world)
+    this->dataPtr->worlds.push_back(_world);
+}
+
+/////////////////////////////////////////////////
+const std::vector<WorldPtr> &WorldBatch::Worlds() const
+{
+  return this->dataPtr->worlds;
+}
+
+/////////////////////////////////////////////////
+void WorldBatch::SetThreadCount(const unsigned int _threads)
+{
+  this->dataPtr->threads = _threads;
+  if (_threads == 1)
+  {
+    this->dataPtr->arena.reset();
+  }
+  else
+  {
+    this->dataPtr->arena.reset(new tbb::task_arena(_threads > 0 ?
+        static_cast<int>(_threads) : tbb::task_arena::automatic));
+  }
+}
+
+/////////////////////////////////////////////////
+unsigned int WorldBatch::ThreadCount() const
+{
+  return this->dataPtr->threads;
+}
+
+/////////////////////////////////////////////////
+void WorldBatch::Step(const unsigned int _steps)
+{
+  auto &worlds = this->dataPtr->worlds;
+
+  if (this->dataPtr->arena && worlds.size() > 1)
+  {
+    // One task per world, the worlds are independent.
+    this->dataPtr->arena->execute([&worlds, _steps]()
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, worlds.size(), 1),
+          [&worlds, _steps](const tbb::blocked_range<size_t> &_r)
+      {
+        for (size_t i = _r.begin(); i != _r.end(); ++i)
+          worlds[i]->BatchStep(_steps);
+      });
+    });
+  }
+  else
+  {
+    for (auto &world : worlds)
+      world->BatchStep(_steps);
+  }
+
+  // Sample the introspection items once all the worlds are idle.
+  util::IntrospectionManager::Instance()->Update();
+  util::IntrospectionManager::Instance()->NotifyUpdates();
+}
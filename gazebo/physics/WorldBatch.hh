@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_WORLDBATCH_HH_
+#define GAZEBO_PHYSICS_WORLDBATCH_HH_
+
+#include <memory>
+#include <vector>
+
+#include <sdf/sdf.hh>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class
+    class WorldBatchPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class WorldBatch WorldBatch.hh physics/physics.hh
+    /// \brief Steps many independent worlds of one process in parallel,
+    /// without real time throttling and without a thread per world.
+    ///
+    /// Each call to Step hands every world to a thread of a shared pool,
+    /// which steps it with World::BatchStep. Batched worlds keep their
+    /// state in their own context where the process has one per world
+    /// name (transport topics, log records and introspection items), and
+    /// their entities only follow the updates of their own world, see
+    /// World::ConnectUpdateBegin. The following remain shared by the
+    /// process:
+    /// - Callbacks connected to event::Events::ConnectWorldUpdateBegin and
+    ///   ConnectBeforePhysicsUpdate are called for every world of the
+    ///   batch, one at a time, from the thread stepping that world. They
+    ///   must only touch the world named by common::UpdateInfo::worldName.
+    ///   Callbacks of event::Events::ConnectWorldUpdateEnd can not tell the
+    ///   worlds apart.
+    /// - The introspection manager is updated once per call to Step.
+    /// - The random number generators, so noise draws depend on the order
+    ///   in which the threads step the worlds.
+    /// - Sensors, which are not supported in batched worlds.
+    ///
+    /// Worlds of a batch must not be run with World::Run. They are
+    /// finalized along with the other worlds of the process, see
+    /// physics::fini.
+    class GZ_PHYSICS_VISIBLE WorldBatch
+    {
+      /// \brief Constructor.
+      public: WorldBatch();
+
+      /// \brief Destructor.
+      public: virtual ~WorldBatch();
+
+      /// \brief Create, load and initialize copies of a world. The copies
+      /// are named after the world with a suffix, e.g. "default_0".
+      /// Transport must have been set up, e.g. by gazebo::setupServer.
+      /// \param[in] _sdf The world element to copy.
+      /// \param[in] _count Number of copies.
+      /// \return False if a world with the name of a copy already exists,
+      /// in which case no world is created.
+      public: bool Load(sdf::ElementPtr _sdf, const unsigned int _count);
+
+      /// \brief Add a world which was loaded and initialized elsewhere.
+      /// \param[in] _world The world to add.
+      public: void AddWorld(WorldPtr _world);
+
+      /// \brief Get the worlds of the batch.
+      /// \return The worlds, in the order they were added.
+      public: const std::vector<WorldPtr> &Worlds() const;
+
+      /// \brief Set the number of threads used to step the worlds.
+      /// \param[in] _threads Number of threads, 0 to let TBB pick one per
+      /// core and 1 to step the worlds sequentially in the calling thread.
+      public: void SetThreadCount(const unsigned int _threads);
+
+      /// \brief Get the number of threads used to step the worlds.
+      /// \return Number of threads, see SetThreadCount.
+      public: unsigned int ThreadCount() const;
+
+      /// \brief Step every world of the batch. Blocks until all the worlds
+      /// have taken their steps.
+      /// \param[in] _steps Number of steps each world takes.
+      public: void Step(const unsigned int _steps);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<WorldBatchPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+#include "gazebo/test/ServerFixture.hh"
+#include "test/util.hh"
+#include "gazebo/common/Events.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/PhysicsIface.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldBatch.hh"
+#include "gazebo/util/LogRecord.hh"
+
+using namespace gazebo;
+
+class WorldBatchTest : public ServerFixture { };
+
+//////////////////////////////////////////////////
+TEST_F(WorldBatchTest, StepWorlds)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr fixtureWorld = physics::get_world("default");
+  ASSERT_TRUE(fixtureWorld != nullptr);
+  const uint32_t fixtureIterations = fixtureWorld->Iterations();
+
+  std::ostringstream sdfStr;
+  sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+    << "<world name='batch'>"
+    << "  <model name='box'>"
+    << "    <pose>0 0 2 0 0 0</pose>"
+    << "    <link name='link'>"
+    << "      <collision name='c'><geometry><box><size>1 1 1</size>"
+    << "      </box></geometry></collision>"
+    << "    </link>"
+    << "  </model>"
+    << "</world>"
+    << "</sdf>";
+  sdf::SDFPtr sdf(new sdf::SDF);
+  sdf::init(sdf);
+  ASSERT_TRUE(sdf::readString(sdfStr.str(), sdf));
+  sdf::ElementPtr worldElem = sdf->Root()->GetElement("world");
+
+  const unsigned int worldCount = 4;
+  physics::WorldBatch batch;
+  EXPECT_EQ(batch.ThreadCount(), 0u);
+  ASSERT_TRUE(batch.Load(worldElem, worldCount));
+  ASSERT_EQ(batch.Worlds().size(), worldCount);
+  for (unsigned int i = 0; i < worldCount; ++i)
+  {
+    EXPECT_EQ(batch.Worlds()[i]->Name(), "batch_" + std::to_string(i));
+    EXPECT_TRUE(physics::has_world(batch.Worlds()[i]->Name()));
+  }
+
+  // The names are taken now
+  physics::WorldBatch other;
+  EXPECT_FALSE(other.Load(worldElem, 1));
+  EXPECT_TRUE(other.Worlds().empty());
+
+  // Count the updates seen by each world and by the process wide event
+  std::mutex countMutex;
+  std::map<std::string, unsigned int> globalCounts;
+  event::ConnectionPtr globalConnection =
+    event::Events::ConnectWorldUpdateBegin(
+        [&](const common::UpdateInfo &_info)
+        {
+          std::lock_guard<std::mutex> lock(countMutex);
+          ++globalCounts[_info.worldName];
+        });
+
+  unsigned int firstCount = 0;
+  std::string firstName;
+  event::ConnectionPtr firstConnection =
+    batch.Worlds()[0]->ConnectUpdateBegin(
+        [&](const common::UpdateInfo &_info)
+        {
+          ++firstCount;
+          firstName = _info.worldName;
+        });
+
+  const unsigned int steps = 100;
+  batch.SetThreadCount(worldCount);
+  EXPECT_EQ(batch.ThreadCount(), worldCount);
+  batch.Step(steps);
+
+  // Sequentially
+  batch.SetThreadCount(1);
+  batch.Step(steps);
+
+  globalConnection.reset();
+  firstConnection.reset();
+
+  EXPECT_EQ(firstCount, 2 * steps);
+  EXPECT_EQ(firstName, "batch_0");
+
+  // Independent copies of the same world end in the same state
+  physics::ModelPtr box0 = batch.Worlds()[0]->ModelByName("box");
+  ASSERT_TRUE(box0 != nullptr);
+  EXPECT_LT(box0->WorldPose().Pos().Z(), 2.0);
+  for (auto const &world : batch.Worlds())
+  {
+    EXPECT_EQ(world->Iterations(), 2 * steps);
+    EXPECT_NEAR(world->SimTime().Double(),
+        2 * steps * world->Physics()->GetMaxStepSize(), 1e-6);
+    EXPECT_EQ(globalCounts[world->Name()], 2 * steps);
+
+    physics::ModelPtr box = world->ModelByName("box");
+    ASSERT_TRUE(box != nullptr);
+    EXPECT_EQ(box->WorldPose(), box0->WorldPose());
+  }
+
+  // The paused world of the fixture was not stepped by the batch
+  EXPECT_EQ(fixtureWorld->Iterations(), fixtureIterations);
+}
+
+/////////////////////////////////////////////////
+/// \brief Batched worlds have no log worker, their state is recorded while
+/// they step.
+TEST_F(WorldBatchTest, Recording)
+{
+  this->Load("worlds/empty.world", true);
+
+  std::ostringstream sdfStr;
+  sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+    << "<world name='recorded'>"
+    << "  <model name='box'>"
+    << "    <pose>0 0 2 0 0 0</pose>"
+    << "    <link name='link'>"
+    << "      <collision name='c'><geometry><box><size>1 1 1</size>"
+    << "      </box></geometry></collision>"
+    << "    </link>"
+    << "  </model>"
+    << "</world>"
+    << "</sdf>";
+  sdf::SDFPtr sdf(new sdf::SDF);
+  sdf::init(sdf);
+  ASSERT_TRUE(sdf::readString(sdfStr.str(), sdf));
+  sdf::ElementPtr worldElem = sdf->Root()->GetElement("world");
+
+  const unsigned int worldCount = 2;
+  physics::WorldBatch batch;
+  ASSERT_TRUE(batch.Load(worldElem, worldCount));
+  batch.SetThreadCount(worldCount);
+
+  util::LogRecord *recorder = util::LogRecord::Instance();
+  recorder->Init("test");
+  ASSERT_TRUE(recorder->Start("txt"));
+  ASSERT_TRUE(recorder->Running());
+  const std::string filename = recorder->Filename("recorded_0");
+  EXPECT_FALSE(filename.empty());
+
+  // More steps than log snapshots, this blocked when the snapshots were
+  // handed to a log worker which batched worlds don't run.
+  const unsigned int steps = 100;
+  batch.Step(steps);
+  for (auto const &world : batch.Worlds())
+    EXPECT_EQ(world->Iterations(), steps);
+
+  recorder->Stop();
+  int sleep = 0;
+  while (!recorder->IsReadyToStart() && sleep++ < 100)
+    common::Time::MSleep(100);
+  EXPECT_TRUE(recorder->IsReadyToStart());
+
+  // The box fell, so the states of the first world were written
+  std::ifstream logFile(filename);
+  ASSERT_TRUE(logFile.is_open());
+  const std::string log((std::istreambuf_iterator<char>(logFile)),
+      std::istreambuf_iterator<char>());
+  EXPECT_NE(log.find("world_name='recorded_0'"), std::string::npos);
+  EXPECT_NE(log.find("<model name='box'>"), std::string::npos);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
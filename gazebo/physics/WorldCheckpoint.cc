@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <string>
+#include <vector>
+
+#include <ignition/math/Rand.hh>
+
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
+#include "gazebo/physics/WorldCheckpoint.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Private data for the WorldCheckpoint class
+    class WorldCheckpointPrivate
+    {
+      /// \brief State of the entities.
+      public: WorldSnapshot snapshot;
+
+      /// \brief Whether each link was enabled, in the order of
+      /// CaptureEnabled. Disabled bodies would not move after a restore.
+      public: std::vector<char> linksEnabled;
+
+      /// \brief Random seed.
+      public: uint32_t seed = 0;
+
+      /// \brief Solver state of the physics engine.
+      public: std::string solverState;
+
+      /// \brief True once a state has been captured.
+      public: bool valid = false;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+/////////////////////////////////////////////////
+/// \brief Append the enabled flag of the links of a model and of its nested
+/// models.
+/// \param[in] _model Model to read.
+/// \param[out] _enabled Flags to append to.
+static void CaptureEnabled(const Model &_model, std::vector<char> &_enabled)
+{
+  for (auto const &link : _model.GetLinks())
+    _enabled.push_back(link->GetEnabled());
+  for (auto const &nested : _model.NestedModels())
+    CaptureEnabled(*nested, _enabled);
+}
+
+/////////////////////////////////////////////////
+/// \brief Set the enabled flag of the links of a model and of its nested
+/// models, in the order of CaptureEnabled.
+/// \param[in] _model Model to update.
+/// \param[in] _enabled Flags to apply.
+/// \param[in,out] _index Index of the next flag.
+static void ApplyEnabled(const Model &_model,
+    const std::vector<char> &_enabled, size_t &_index)
+{
+  for (auto const &link : _model.GetLinks())
+  {
+    if (_index < _enabled.size())
+      link->SetEnabled(_enabled[_index] != 0);
+    ++_index;
+  }
+  for (auto const &nested : _model.NestedModels())
+    ApplyEnabled(*nested, _enabled, _index);
+}
+
+/////////////////////////////////////////////////
+WorldCheckpoint::WorldCheckpoint()
+  : dataPtr(new WorldCheckpointPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+WorldCheckpoint::WorldCheckpoint(const WorldCheckpoint &_checkpoint)
+  : dataPtr(new WorldCheckpointPrivate(*_checkpoint.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+WorldCheckpoint::~WorldCheckpoint()
+{
+}
+
+/////////////////////////////////////////////////
+WorldCheckpoint &WorldCheckpoint::operator=(
+    const WorldCheckpoint &_checkpoint)
+{
+  if (this != &_checkpoint)
+    *this->dataPtr = *_checkpoint.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+void WorldCheckpoint::Capture(World &_world)
+{
+  // Reuse the layout of the previous capture when the world has not changed
+  if (this->dataPtr->valid)
+    this->dataPtr->snapshot.Capture(_world, &this->dataPtr->snapshot);
+  else
+    this->dataPtr->snapshot.Capture(_world, nullptr);
+
+  this->dataPtr->linksEnabled.clear();
+  for (auto const &model : _world.Models())
+    CaptureEnabled(*model, this->dataPtr->linksEnabled);
+
+  this->dataPtr->seed = ignition::math::Rand::Seed();
+  _world.Physics()->SaveSolverState(this->dataPtr->solverState);
+  this->dataPtr->valid = true;
+}
+
+/////////////////////////////////////////////////
+bool WorldCheckpoint::Restore(World &_world) const
+{
+  if (!this->dataPtr->valid || !this->dataPtr->snapshot.Matches(_world))
+    return false;
+
+  if (!_world.Physics()->RestoreSolverState(this->dataPtr->solverState))
+    return false;
+
+  // Re-seeding restarts the random sequence of the seed, so that rollouts
+  // from the same checkpoint draw the same numbers.
+  ignition::math::Rand::Seed(this->dataPtr->seed);
+
+  _world.SetState(this->dataPtr->snapshot);
+
+  size_t index = 0;
+  for (auto const &model : _world.Models())
+    ApplyEnabled(*model, this->dataPtr->linksEnabled, index);
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool WorldCheckpoint::Valid() const
+{
+  return this->dataPtr->valid;
+}
+
+/////////////////////////////////////////////////
+const WorldSnapshot &WorldCheckpoint::Snapshot() const
+{
+  return this->dataPtr->snapshot;
+}
+
+/////////////////////////////////////////////////
+uint32_t WorldCheckpoint::Seed() const
+{
+  return this->dataPtr->seed;
+}
+
+/////////////////////////////////////////////////
+const std::string &WorldCheckpoint::SolverState() const
+{
+  return this->dataPtr->solverState;
+}
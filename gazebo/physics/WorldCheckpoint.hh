@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_WORLDCHECKPOINT_HH_
+#define GAZEBO_PHYSICS_WORLDCHECKPOINT_HH_
+
+#include <memory>
+#include <string>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class
+    class WorldCheckpointPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class WorldCheckpoint WorldCheckpoint.hh physics/physics.hh
+    /// \brief An in-memory copy of the full dynamic state of a world, which
+    /// can be restored any number of times.
+    ///
+    /// A checkpoint holds a WorldSnapshot of the entities, including link
+    /// velocities and joint positions and velocities, along with the
+    /// simulation time, the random seed and the solver state of the
+    /// physics engine. Restoring reaches the entities through the layout of
+    /// the snapshot, without name lookups or SDF parsing, which makes it
+    /// suitable for frequent resets and for branching rollouts from the
+    /// middle of an episode. See World::SaveCheckpoint and
+    /// World::RestoreCheckpoint.
+    class GZ_PHYSICS_VISIBLE WorldCheckpoint
+    {
+      /// \brief Constructor.
+      public: WorldCheckpoint();
+
+      /// \brief Copy constructor.
+      /// \param[in] _checkpoint Checkpoint to copy.
+      public: WorldCheckpoint(const WorldCheckpoint &_checkpoint);
+
+      /// \brief Destructor.
+      public: virtual ~WorldCheckpoint();
+
+      /// \brief Assignment operator. The storage of this checkpoint is
+      /// reused.
+      /// \param[in] _checkpoint Checkpoint to copy.
+      /// \return Reference to this checkpoint.
+      public: WorldCheckpoint &operator=(const WorldCheckpoint &_checkpoint);
+
+      /// \brief Copy the state of a world. The caller must hold the world
+      /// update and physics mutexes, see World::SaveCheckpoint.
+      /// \param[in] _world World to capture.
+      public: void Capture(World &_world);
+
+      /// \brief Restore the state of a world. The caller must hold the world
+      /// update and physics mutexes, see World::RestoreCheckpoint.
+      /// \param[in] _world World to restore.
+      /// \return False if entities were inserted or removed since the
+      /// capture, or if the solver state does not fit the physics engine,
+      /// in which case nothing is restored.
+      public: bool Restore(World &_world) const;
+
+      /// \brief Check if the checkpoint holds a state.
+      /// \return True once Capture has been called.
+      public: bool Valid() const;
+
+      /// \brief Get the snapshot of the entities.
+      /// \return The snapshot.
+      public: const WorldSnapshot &Snapshot() const;
+
+      /// \brief Get the random seed at the time of the capture.
+      /// \return The seed.
+      public: uint32_t Seed() const;
+
+      /// \brief Get the solver state saved by the physics engine.
+      /// \return Engine specific data, see
+      /// PhysicsEngine::SaveSolverState.
+      public: const std::string &SolverState() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<WorldCheckpointPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <map>
+#include <sstream>
+#include <string>
+
+#include "gazebo/test/ServerFixture.hh"
+#include "test/util.hh"
+#include "gazebo/physics/Joint.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldCheckpoint.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
+
+using namespace gazebo;
+
+class WorldCheckpointTest : public ServerFixture { };
+
+//////////////////////////////////////////////////
+/// \brief Record the world pose of every link.
+/// \param[in] _world World to read.
+/// \return Poses keyed by scoped link name.
+static std::map<std::string, ignition::math::Pose3d> LinkPoses(
+    const physics::WorldPtr &_world)
+{
+  std::map<std::string, ignition::math::Pose3d> poses;
+  for (auto const &model : _world->Models())
+  {
+    for (auto const &link : model->GetLinks())
+      poses[link->GetScopedName()] = link->WorldPose();
+  }
+  return poses;
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldCheckpointTest, RestoreRollouts)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // A swinging arm and a falling box, so that joints and contacts are part
+  // of the state.
+  std::ostringstream sdfStr;
+  sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+    << "<model name='arm'>"
+    << "  <pose>0 0 2 0 0 0</pose>"
+    << "  <link name='base'><gravity>0</gravity></link>"
+    << "  <link name='forearm'><pose>0 0.5 0 0 0 0</pose>"
+    << "    <collision name='c'><geometry><box><size>0.1 1 0.1</size>"
+    << "    </box></geometry></collision>"
+    << "  </link>"
+    << "  <joint name='fixed' type='fixed'>"
+    << "    <parent>world</parent><child>base</child>"
+    << "  </joint>"
+    << "  <joint name='elbow' type='revolute'>"
+    << "    <parent>base</parent><child>forearm</child>"
+    << "    <axis><xyz>1 0 0</xyz></axis>"
+    << "  </joint>"
+    << "</model>"
+    << "</sdf>";
+  this->SpawnSDF(sdfStr.str());
+  this->SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(2, 0, 1), ignition::math::Vector3d(0.3, 0, 0));
+
+  physics::ModelPtr arm = world->ModelByName("arm");
+  ASSERT_TRUE(arm != nullptr);
+  physics::JointPtr elbow = arm->GetJoint("elbow");
+  ASSERT_TRUE(elbow != nullptr);
+
+  world->Step(100);
+
+  physics::WorldCheckpoint checkpoint;
+  EXPECT_FALSE(checkpoint.Valid());
+  EXPECT_FALSE(world->RestoreCheckpoint(checkpoint));
+
+  world->SaveCheckpoint(checkpoint);
+  EXPECT_TRUE(checkpoint.Valid());
+  EXPECT_EQ(checkpoint.Snapshot().SimTime(), world->SimTime());
+  EXPECT_EQ(checkpoint.Snapshot().Iterations(), world->Iterations());
+  if (world->Physics()->GetType() == "ode")
+    EXPECT_FALSE(checkpoint.SolverState().empty());
+
+  double velocity = 0;
+  EXPECT_TRUE(checkpoint.Snapshot().JointVelocity(elbow->GetId(), 0,
+      velocity));
+  EXPECT_DOUBLE_EQ(velocity, elbow->GetVelocity(0));
+  EXPECT_NE(velocity, 0.0);
+
+  const common::Time checkpointTime = world->SimTime();
+  const auto checkpointPoses = LinkPoses(world);
+
+  // First rollout
+  world->Step(200);
+  const common::Time rolloutTime = world->SimTime();
+  const auto rolloutPoses = LinkPoses(world);
+  const double rolloutPosition = elbow->Position(0);
+
+  // Restore and check the state is back to the checkpoint
+  for (int i = 0; i < 3; ++i)
+  {
+    EXPECT_TRUE(world->RestoreCheckpoint(checkpoint));
+    EXPECT_EQ(world->SimTime(), checkpointTime);
+    EXPECT_EQ(LinkPoses(world), checkpointPoses);
+    EXPECT_NEAR(elbow->GetVelocity(0), velocity, 1e-6);
+
+    // The same rollout again
+    world->Step(200);
+    EXPECT_EQ(world->SimTime(), rolloutTime);
+    EXPECT_EQ(LinkPoses(world), rolloutPoses);
+    EXPECT_NEAR(elbow->Position(0), rolloutPosition, 1e-6);
+  }
+
+  // A checkpoint does not apply once the world structure changed
+  this->SpawnSphere("sphere", ignition::math::Vector3d(0, 3, 1),
+      ignition::math::Vector3d::Zero);
+  ASSERT_TRUE(world->ModelByName("sphere") != nullptr);
+  EXPECT_FALSE(world->RestoreCheckpoint(checkpoint));
+
+  // Saving again into the same checkpoint picks up the new structure
+  world->SaveCheckpoint(checkpoint);
+  world->Step(50);
+  EXPECT_TRUE(world->RestoreCheckpoint(checkpoint));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
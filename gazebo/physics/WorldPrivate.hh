@@ -27,8 +27,11 @@
 #include <string>
 #include <mutex>
 #include <thread>
+#include <unordered_map>
 #include <condition_variable>
 
+#include <tbb/task_arena.h>
+
 #include <ignition/transport.hh>
 
 #include "gazebo/common/Event.hh"
@@ -40,6 +43,7 @@
 #include "gazebo/transport/TransportTypes.hh"
 
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
 #include "gazebo/physics/WorldState.hh"
 
 namespace gazebo
@@ -49,9 +53,6 @@ namespace gazebo
     /// \brief Private data class for World.
     class WorldPrivate
     {
-      /// \brief For keeping track of time step throttling.
-      public: common::Time prevStepWallTime;
-
       /// \brief Pointer the physics engine.
       public: PhysicsEnginePtr physicsEngine;
 
@@ -158,9 +159,31 @@ namespace gazebo
       /// \brief Function pointer to the model update function.
       public: void (World::*modelUpdateFunc)();
 
+      /// \brief Number of threads used to update models. Values of 0 and 1
+      /// update models sequentially in the world thread.
+      public: unsigned int modelUpdateThreads = 0;
+
+      /// \brief Task arena used by World::ModelUpdateTBB. Only allocated
+      /// when modelUpdateThreads is greater than one.
+      public: std::unique_ptr<tbb::task_arena> modelUpdateArena;
+
       /// \brief Last time a world statistics message was sent.
       public: common::Time prevStatTime;
 
+      /// \brief Rate at which world statistics are published in Hz, 0 to
+      /// publish after every step.
+      public: std::atomic<double> statsPublishRate{5.0};
+
+      /// \brief Number of steps between two pose messages.
+      public: std::atomic<unsigned int> posePublishSteps{1};
+
+      /// \brief Physics steps taken since the last pose message.
+      public: uint64_t posePublishCounter = 0;
+
+      /// \brief Iteration count at the last pass of ProcessMessages, used
+      /// to count the physics steps between two passes.
+      public: uint64_t posePublishIterations = 0;
+
       /// \brief Time at which pause started.
       public: common::Time pauseStartTime;
 
@@ -176,6 +199,33 @@ namespace gazebo
       /// \brief Mutex to protext loading of lights.
       public: std::mutex loadLightMutex;
 
+      /// \brief Entry of the entity index, see entitiesById.
+      public: struct IndexedEntity
+              {
+                /// \brief The entity.
+                BasePtr entity;
+
+                /// \brief Scoped name under which the entity is indexed.
+                std::string scopedName;
+
+                /// \brief Name under which the entity is indexed.
+                std::string name;
+              };
+
+      /// \brief Entities of the world, except the root element, indexed by
+      /// id. Maintained by Base when an entity is added to a parent, renamed
+      /// or finalized.
+      public: std::unordered_map<uint32_t, IndexedEntity> entitiesById;
+
+      /// \brief Entities indexed by scoped name and by name. An entity
+      /// appears under both keys when they differ. More than one entity
+      /// matches an ambiguous key.
+      public: std::unordered_map<std::string, std::vector<BasePtr>>
+              entitiesByName;
+
+      /// \brief Mutex to protect entitiesById and entitiesByName.
+      public: mutable std::mutex entityIndexMutex;
+
       /// \TODO: Add an accessor for this, and make it private
       /// Used in Entity.cc.
       /// Entity::Reset to call Entity::SetWorldPose and Entity::SetRelativePose
@@ -250,9 +300,6 @@ namespace gazebo
       /// \brief True if the plugins have been loaded.
       public: bool pluginsLoaded;
 
-      /// \brief sleep timing error offset due to clock wake up latency
-      public: common::Time sleepOffset;
-
       /// \brief Last time incoming messages were processed.
       public: common::Time prevProcessMsgsTime;
 
@@ -265,16 +312,6 @@ namespace gazebo
       /// \brief Keep track of current state buffer being updated
       public: int currentStateBuffer;
 
-      /// \brief Buffer of prev states
-      public: WorldState prevStates[2];
-
-      /// \brief Previous unfiltered state. Used for determining insertions
-      /// and deletions
-      public: WorldState prevUnfilteredState;
-
-      /// \brief Int used to toggle between prevStates
-      public: int stateToggle;
-
       /// \brief State from from log file.
       public: sdf::ElementPtr logPlayStateSDF;
 
@@ -285,15 +322,34 @@ namespace gazebo
       /// objects are inserted via the factory.
       public: sdf::SDFPtr factorySDF;
 
-      /// \brief The list of models that need to publish their pose.
-      public: std::set<ModelPtr> publishModelPoses;
+      /// \brief Ids of the models, links and lights whose pose changed
+      /// since the last pose message.
+      public: std::vector<uint32_t> posesDirty;
+
+      /// \brief True if poses were queued outside World::Update since the
+      /// last pose message. They are published without waiting for the
+      /// next message to be due.
+      public: bool posesQueuedIdle = false;
+
+      /// \brief True while World::Update runs.
+      public: std::atomic<bool> updating{false};
+
+      /// \brief Last pose published for each entity, by id. The name and id
+      /// of an entry are filled when the entity first appears.
+      public: std::unordered_map<uint32_t, msgs::Pose> poseSlots;
+
+      /// \brief Pose message, published without copy to the subscribers in
+      /// this process.
+      public: msgs::PosesStampedPtr poseMsg;
+
+      /// \brief Pose message published before poseMsg. The publisher keeps
+      /// the last message it sent, so the two messages take turns, and are
+      /// reused once the subscribers released them.
+      public: msgs::PosesStampedPtr sparePoseMsg;
 
       /// \brief The list of models that need to publish their scale.
       public: std::set<ModelPtr> publishModelScales;
 
-      /// \brief The list of lights that need to publish their pose.
-      public: std::set<LightPtr> publishLightPoses;
-
       /// \brief Info passed through the WorldUpdateBegin event.
       public: common::UpdateInfo updateInfo;
 
@@ -303,15 +359,43 @@ namespace gazebo
       /// \brief The number of simulation iterations to take before stopping.
       public: uint64_t stopIterations;
 
-      /// \brief Condition used for log worker.
+      /// \brief Condition used to wake up the log worker when a snapshot
+      /// is available.
       public: std::condition_variable logCondition;
 
-      /// \brief Condition used to guarantee the log worker thread doesn't
-      /// skip an interation.
+      /// \brief Condition used to wake up the update thread when the log
+      /// worker frees a snapshot slot.
       public: std::condition_variable logContinueCondition;
 
-      /// \brief Last iteration recorded by the log worker thread.
-      public: uint64_t logPrevIteration;
+      /// \brief Ring of snapshots handed from the update thread to the log
+      /// worker. Slots are preallocated so that capturing does not allocate
+      /// once the world layout is stable.
+      public: std::vector<std::unique_ptr<WorldSnapshot>> logSnapshots;
+
+      /// \brief Number of snapshots written by the update thread.
+      public: std::atomic<uint64_t> logSnapshotHead{0};
+
+      /// \brief Number of snapshots consumed by the log worker.
+      public: std::atomic<uint64_t> logSnapshotTail{0};
+
+      /// \brief Last snapshot written by the update thread, used as layout
+      /// reference for the next capture. Null while not recording.
+      public: const WorldSnapshot *logPrevSnapshot = nullptr;
+
+      /// \brief Copy of the last snapshot stored by the log worker. New
+      /// snapshots are only converted to a WorldState and stored if they
+      /// differ from it.
+      public: WorldSnapshot logLastSnapshot;
+
+      /// \brief Wall time, in seconds, spent in the last state capture.
+      public: std::atomic<double> logCaptureTime{0.0};
+
+      /// \brief Total wall time, in seconds, the update thread waited for
+      /// the log worker to free a snapshot slot.
+      public: std::atomic<double> logStallTime{0.0};
+
+      /// \brief Number of captures that had to wait for the log worker.
+      public: std::atomic<int> logStallCount{0};
 
       /// \brief Real time value set from a log file.
       public: common::Time logRealTime;
@@ -343,6 +427,27 @@ namespace gazebo
       /// physics::Link in World::Update.
       public: std::list<Entity*> dirtyPoses;
 
+      /// \brief Bounding boxes of the collisions, see World::SpatialIndex.
+      public: std::unique_ptr<SpatialIndex> spatialIndex;
+
+      /// \brief Paces the steps to the real time update rate, see
+      /// World::Pacer.
+      public: std::unique_ptr<RealTimePacer> pacer;
+
+      /// \brief True if the spatial index is enabled.
+      public: std::atomic<bool> spatialIndexEnabled{false};
+
+      /// \brief Ids of the collisions whose pose changed since the spatial
+      /// index was refreshed.
+      public: std::vector<uint32_t> spatialDirty;
+
+      /// \brief Ids being refreshed, swapped with spatialDirty to keep
+      /// the capacity of both.
+      public: std::vector<uint32_t> spatialRefresh;
+
+      /// \brief Mutex to protect spatialDirty.
+      public: std::mutex spatialDirtyMutex;
+
       /// \brief Class to manage preset simulation parameter profiles.
       public: PresetManagerPtr presetManager;
 
@@ -385,6 +490,15 @@ namespace gazebo
 
       /// \brief SDF World DOM object
       public: std::unique_ptr<sdf::World> worldSDFDom;
+
+      /// \brief Signaled at the start of each update of this world.
+      public: event::EventT<void (const common::UpdateInfo &)> updateBegin;
+
+      /// \brief Signaled at the end of each update of this world.
+      public: event::EventT<void ()> updateEnd;
+
+      /// \brief True while the world is stepped by World::BatchStep.
+      public: bool batchStep = false;
     };
   }
 }
@@ -0,0 +1,829 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <list>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/regex.hpp>
+#include <ignition/math/Helpers.hh>
+
+#include "gazebo/physics/Joint.hh"
+#include "gazebo/physics/Light.hh"
+#include "gazebo/physics/LightState.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/LinkState.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/ModelState.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldState.hh"
+#include "gazebo/physics/WorldSnapshotPrivate.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/////////////////////////////////////////////////
+/// \brief Check that a model and its nested models match a layout entry.
+/// \param[in] _model Model to check.
+/// \param[in] _layout Layout to check against.
+/// \param[in] _index Index of the model entry in the layout.
+/// \return True if the ids of the model, links and nested models match.
+static bool MatchModel(const Model &_model,
+    const WorldSnapshotLayout &_layout, const unsigned int _index)
+{
+  const WorldSnapshotLayout::ModelEntry &entry = _layout.models[_index];
+  if (_model.GetId() != entry.id)
+    return false;
+
+  const Link_V &links = _model.GetLinks();
+  if (links.size() != entry.linkCount)
+    return false;
+  for (unsigned int i = 0; i < entry.linkCount; ++i)
+  {
+    if (links[i]->GetId() != _layout.linkIds[entry.firstLink + i])
+      return false;
+  }
+
+  const Joint_V &joints = _model.GetJoints();
+  if (joints.size() != entry.jointCount)
+    return false;
+  for (unsigned int i = 0; i < entry.jointCount; ++i)
+  {
+    if (joints[i]->GetId() != _layout.jointIds[entry.firstJoint + i])
+      return false;
+  }
+
+  const Model_V &nested = _model.NestedModels();
+  if (nested.size() != entry.children.size())
+    return false;
+  for (unsigned int i = 0; i < nested.size(); ++i)
+  {
+    if (!MatchModel(*nested[i], _layout, entry.children[i]))
+      return false;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that the entities of a world match a layout.
+/// \param[in] _models Top level models of the world.
+/// \param[in] _lights Lights of the world.
+/// \param[in] _layout Layout to check against.
+/// \return True if the layout matches.
+static bool MatchWorld(const Model_V &_models, const Light_V &_lights,
+    const WorldSnapshotLayout &_layout)
+{
+  if (_models.size() != _layout.topModels.size() ||
+      _lights.size() != _layout.lightIds.size())
+  {
+    return false;
+  }
+
+  for (unsigned int i = 0; i < _models.size(); ++i)
+  {
+    if (!MatchModel(*_models[i], _layout, _layout.topModels[i]))
+      return false;
+  }
+
+  for (unsigned int i = 0; i < _lights.size(); ++i)
+  {
+    if (_lights[i]->GetId() != _layout.lightIds[i])
+      return false;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Append a model and its nested models to a layout.
+/// \param[in] _model Model to add.
+/// \param[in,out] _layout Layout to extend.
+/// \return Index of the new model entry.
+static unsigned int AddModel(const Model &_model,
+    WorldSnapshotLayout &_layout)
+{
+  const unsigned int index = _layout.models.size();
+  _layout.models.emplace_back();
+
+  const Link_V &links = _model.GetLinks();
+  const Joint_V &joints = _model.GetJoints();
+  {
+    WorldSnapshotLayout::ModelEntry &entry = _layout.models.back();
+    entry.name = _model.GetName();
+    entry.id = _model.GetId();
+    entry.firstLink = _layout.linkNames.size();
+    entry.linkCount = links.size();
+    entry.firstJoint = _layout.jointNames.size();
+    entry.jointCount = joints.size();
+  }
+  _layout.modelIndices[_model.GetId()] = index;
+
+  for (auto const &link : links)
+  {
+    _layout.linkIndices[link->GetId()] = _layout.linkNames.size();
+    _layout.linkNames.push_back(link->GetName());
+    _layout.linkIds.push_back(link->GetId());
+  }
+
+  if (_layout.jointAxes.empty())
+    _layout.jointAxes.push_back(0);
+  for (auto const &joint : joints)
+  {
+    _layout.jointIndices[joint->GetId()] = _layout.jointNames.size();
+    _layout.jointNames.push_back(joint->GetName());
+    _layout.jointIds.push_back(joint->GetId());
+    _layout.jointAxes.push_back(_layout.jointAxes.back() + joint->DOF());
+  }
+
+  // Adding children may reallocate the entries, so index them each time.
+  for (auto const &nested : _model.NestedModels())
+  {
+    const unsigned int child = AddModel(*nested, _layout);
+    _layout.models[index].children.push_back(child);
+  }
+
+  WorldSnapshotLayout::ModelEntry &entry = _layout.models[index];
+  entry.modelEnd = _layout.models.size();
+  entry.linkEnd = _layout.linkNames.size();
+  entry.jointEnd = _layout.jointNames.size();
+
+  return index;
+}
+
+/////////////////////////////////////////////////
+/// \brief Copy the state of a model and its nested models.
+/// \param[in] _model Model to copy.
+/// \param[in] _index Index of the model in the layout.
+/// \param[out] _data Snapshot data to fill.
+static void CaptureModel(const Model &_model, const unsigned int _index,
+    WorldSnapshotPrivate &_data)
+{
+  const WorldSnapshotLayout::ModelEntry &entry = _data.layout->models[_index];
+
+  _data.modelPoses[_index] = _model.WorldPose();
+  _data.modelScales[_index] = _model.Scale();
+
+  const Link_V &links = _model.GetLinks();
+  for (unsigned int i = 0; i < entry.linkCount; ++i)
+  {
+    const Link &link = *links[i];
+    const unsigned int k = entry.firstLink + i;
+    _data.linkPoses[k] = link.WorldPose();
+    _data.linkLinearVels[k] = link.WorldLinearVel();
+    _data.linkAngularVels[k] = link.WorldAngularVel();
+    _data.linkLinearAccels[k] = link.WorldLinearAccel();
+    _data.linkAngularAccels[k] = link.WorldAngularAccel();
+    _data.linkForces[k] = link.WorldForce();
+  }
+
+  const Joint_V &joints = _model.GetJoints();
+  for (unsigned int i = 0; i < entry.jointCount; ++i)
+  {
+    const Joint &joint = *joints[i];
+    const unsigned int first = _data.layout->jointAxes[entry.firstJoint + i];
+    const unsigned int last = _data.layout->jointAxes[entry.firstJoint + i + 1];
+    for (unsigned int axis = 0; first + axis < last; ++axis)
+    {
+      _data.jointPositions[first + axis] = joint.Position(axis);
+      _data.jointVelocities[first + axis] = joint.GetVelocity(axis);
+    }
+  }
+
+  const Model_V &nested = _model.NestedModels();
+  for (unsigned int i = 0; i < nested.size(); ++i)
+    CaptureModel(*nested[i], entry.children[i], _data);
+}
+
+/////////////////////////////////////////////////
+/// \brief Set the state of a model and its nested models.
+/// \param[in] _model Model to update.
+/// \param[in] _index Index of the model in the layout.
+/// \param[in] _data Snapshot data to apply.
+static void ApplyModel(Model &_model, const unsigned int _index,
+    const WorldSnapshotPrivate &_data)
+{
+  const WorldSnapshotLayout::ModelEntry &entry = _data.layout->models[_index];
+
+  _model.SetWorldPose(_data.modelPoses[_index], true);
+  _model.SetScale(_data.modelScales[_index], true);
+
+  const Link_V &links = _model.GetLinks();
+  for (unsigned int i = 0; i < entry.linkCount; ++i)
+  {
+    Link &link = *links[i];
+    const unsigned int k = entry.firstLink + i;
+    link.SetWorldPose(_data.linkPoses[k]);
+    link.SetLinearVel(_data.linkLinearVels[k]);
+    link.SetAngularVel(_data.linkAngularVels[k]);
+    link.SetForce(_data.linkForces[k]);
+    link.SetTorque(ignition::math::Vector3d::Zero);
+  }
+
+  const Model_V &nested = _model.NestedModels();
+  for (unsigned int i = 0; i < nested.size(); ++i)
+    ApplyModel(*nested[i], entry.children[i], _data);
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse the model part of a log filter, see
+/// WorldState::LoadWithFilter.
+/// \param[in] _filter Log filter.
+/// \param[out] _regex Regular expression top level model names must match.
+/// \return True if the filter selects models by name, false if it selects
+/// all of them.
+static bool FilterRegex(const std::string &_filter, boost::regex &_regex)
+{
+  // Only the first part of the filter, which selects top level models, is
+  // used.
+  std::string filter = _filter;
+  std::list<std::string> mainParts, parts;
+  boost::split(mainParts, filter, boost::is_any_of("/"));
+  if (!mainParts.empty())
+  {
+    boost::split(parts, mainParts.front(), boost::is_any_of("."));
+    if (parts.empty() && !mainParts.front().empty())
+      parts.push_back(mainParts.front());
+  }
+
+  if (parts.empty() || parts.front().empty() || parts.front() == "*")
+    return false;
+
+  std::string regexStr = parts.front();
+  boost::replace_all(regexStr, "*", ".*");
+  _regex = boost::regex(regexStr);
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check if two ranges of poses differ, with the tolerance of
+/// Pose3d::operator==.
+/// \param[in] _a First poses.
+/// \param[in] _b Second poses.
+/// \param[in] _begin First index to compare.
+/// \param[in] _end One past the last index to compare.
+/// \return True if a pair of poses differs.
+static bool PosesDiffer(const std::vector<ignition::math::Pose3d> &_a,
+    const std::vector<ignition::math::Pose3d> &_b,
+    const size_t _begin, const size_t _end)
+{
+  // Accumulate instead of returning early, so the loop has no data
+  // dependent branch.
+  bool differ = false;
+  for (size_t i = _begin; i < _end; ++i)
+    differ |= _a[i] != _b[i];
+  return differ;
+}
+
+/////////////////////////////////////////////////
+WorldSnapshot::WorldSnapshot()
+  : dataPtr(new WorldSnapshotPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+WorldSnapshot::WorldSnapshot(const WorldSnapshot &_snapshot)
+  : dataPtr(new WorldSnapshotPrivate(*_snapshot.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+WorldSnapshot::~WorldSnapshot()
+{
+}
+
+/////////////////////////////////////////////////
+WorldSnapshot &WorldSnapshot::operator=(const WorldSnapshot &_snapshot)
+{
+  if (this != &_snapshot)
+    *this->dataPtr = *_snapshot.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+bool WorldSnapshot::Capture(const World &_world,
+    const WorldSnapshot *_previous)
+{
+  const Model_V models = _world.Models();
+  const Light_V lights = _world.Lights();
+
+  this->dataPtr->wallTime = common::Time::GetWallTime();
+  this->dataPtr->realTime = _world.RealTime();
+  this->dataPtr->simTime = _world.SimTime();
+  this->dataPtr->iterations = _world.Iterations();
+  this->dataPtr->insertions.clear();
+  this->dataPtr->deletions.clear();
+
+  std::shared_ptr<const WorldSnapshotLayout> previousLayout;
+  if (_previous)
+    previousLayout = _previous->dataPtr->layout;
+
+  bool changed = false;
+  if (previousLayout && MatchWorld(models, lights, *previousLayout))
+  {
+    this->dataPtr->layout = previousLayout;
+  }
+  else
+  {
+    changed = true;
+
+    auto layout = std::make_shared<WorldSnapshotLayout>();
+    layout->worldName = _world.Name();
+    for (auto const &model : models)
+      layout->topModels.push_back(AddModel(*model, *layout));
+    for (auto const &light : lights)
+    {
+      layout->lightNames.push_back(light->GetName());
+      layout->lightIds.push_back(light->GetId());
+    }
+
+    // Work out which top level entities came and went. The SDF of new
+    // entities is only available here, while they are still alive.
+    if (previousLayout)
+    {
+      std::set<std::string> previousNames;
+      for (auto const &index : previousLayout->topModels)
+        previousNames.insert(previousLayout->models[index].name);
+      std::set<std::string> currentNames;
+      for (auto const &model : models)
+      {
+        currentNames.insert(model->GetName());
+        if (previousNames.find(model->GetName()) == previousNames.end())
+        {
+          this->dataPtr->insertions.push_back(
+              model->UnscaledSDF()->ToString(""));
+        }
+      }
+      for (auto const &index : previousLayout->topModels)
+      {
+        const std::string &name = previousLayout->models[index].name;
+        if (currentNames.find(name) == currentNames.end())
+          this->dataPtr->deletions.push_back(name);
+      }
+
+      std::set<std::string> previousLights(
+          previousLayout->lightNames.begin(), previousLayout->lightNames.end());
+      std::set<std::string> currentLights(
+          layout->lightNames.begin(), layout->lightNames.end());
+      for (auto const &name : previousLayout->lightNames)
+      {
+        if (currentLights.find(name) == currentLights.end())
+          this->dataPtr->deletions.push_back(name);
+      }
+      for (auto const &light : lights)
+      {
+        if (previousLights.find(light->GetName()) == previousLights.end())
+          this->dataPtr->insertions.push_back(light->GetSDF()->ToString(""));
+      }
+    }
+
+    this->dataPtr->layout = layout;
+  }
+
+  const WorldSnapshotLayout &layout = *this->dataPtr->layout;
+  const size_t linkCount = layout.linkNames.size();
+  this->dataPtr->modelPoses.resize(layout.models.size());
+  this->dataPtr->modelScales.resize(layout.models.size());
+  this->dataPtr->linkPoses.resize(linkCount);
+  this->dataPtr->linkLinearVels.resize(linkCount);
+  this->dataPtr->linkAngularVels.resize(linkCount);
+  this->dataPtr->linkLinearAccels.resize(linkCount);
+  this->dataPtr->linkAngularAccels.resize(linkCount);
+  this->dataPtr->linkForces.resize(linkCount);
+  const size_t axisCount =
+      layout.jointAxes.empty() ? 0 : layout.jointAxes.back();
+  this->dataPtr->jointPositions.resize(axisCount);
+  this->dataPtr->jointVelocities.resize(axisCount);
+  this->dataPtr->lightPoses.resize(lights.size());
+
+  for (unsigned int i = 0; i < models.size(); ++i)
+    CaptureModel(*models[i], layout.topModels[i], *this->dataPtr);
+
+  for (unsigned int i = 0; i < lights.size(); ++i)
+    this->dataPtr->lightPoses[i] = lights[i]->WorldPose();
+
+  return changed;
+}
+
+/////////////////////////////////////////////////
+bool WorldSnapshot::Matches(const World &_world) const
+{
+  if (!this->dataPtr->layout)
+    return false;
+
+  return MatchWorld(_world.Models(), _world.Lights(), *this->dataPtr->layout);
+}
+
+/////////////////////////////////////////////////
+void WorldSnapshot::ToWorldState(WorldState &_state,
+    const std::string &_filter) const
+{
+  this->dataPtr->FillWorldState(_state, _filter);
+}
+
+/////////////////////////////////////////////////
+bool WorldSnapshot::FromWorldState(const WorldState &_state)
+{
+  if (!this->dataPtr->layout)
+    return false;
+
+  const WorldSnapshotLayout &layout = *this->dataPtr->layout;
+  this->dataPtr->wallTime = _state.GetWallTime();
+  this->dataPtr->realTime = _state.GetRealTime();
+  this->dataPtr->simTime = _state.GetSimTime();
+  this->dataPtr->iterations = _state.GetIterations();
+  this->dataPtr->insertions = _state.Insertions();
+  this->dataPtr->deletions = _state.Deletions();
+
+  bool result = true;
+  for (auto const &index : layout.topModels)
+  {
+    auto iter = _state.GetModelStates().find(layout.models[index].name);
+    if (iter == _state.GetModelStates().end())
+      result = false;
+    else
+      result = this->dataPtr->ReadModelState(iter->second, index) && result;
+  }
+
+  for (unsigned int i = 0; i < layout.lightNames.size(); ++i)
+  {
+    auto iter = _state.LightStates().find(layout.lightNames[i]);
+    if (iter == _state.LightStates().end())
+      result = false;
+    else
+      this->dataPtr->lightPoses[i] = iter->second.Pose();
+  }
+
+  return result;
+}
+
+/////////////////////////////////////////////////
+bool WorldSnapshot::Diff(const WorldSnapshot &_previous,
+    const std::string &_filter) const
+{
+  const WorldSnapshotPrivate &curr = *this->dataPtr;
+  const WorldSnapshotPrivate &prev = *_previous.dataPtr;
+  if (!curr.layout || curr.layout != prev.layout)
+    return true;
+
+  const WorldSnapshotLayout &layout = *curr.layout;
+
+  boost::regex regex;
+  const bool useRegex = FilterRegex(_filter, regex);
+
+  // Without filter, all the arrays are compared at once. Otherwise each
+  // selected top level model is compared as a block, since its nested
+  // models, links and joints are contiguous in the layout.
+  std::vector<std::pair<unsigned int,
+      const WorldSnapshotLayout::ModelEntry *>> blocks;
+  WorldSnapshotLayout::ModelEntry all;
+  if (useRegex)
+  {
+    for (auto const &index : layout.topModels)
+    {
+      if (boost::regex_match(layout.models[index].name, regex))
+        blocks.push_back(std::make_pair(index, &layout.models[index]));
+    }
+  }
+  else
+  {
+    all.modelEnd = layout.models.size();
+    all.linkEnd = layout.linkNames.size();
+    all.jointEnd = layout.jointNames.size();
+    blocks.push_back(std::make_pair(0u, &all));
+  }
+
+  for (auto const &block : blocks)
+  {
+    const unsigned int firstModel = block.first;
+    const WorldSnapshotLayout::ModelEntry *entry = block.second;
+    if (PosesDiffer(curr.modelPoses, prev.modelPoses, firstModel,
+          entry->modelEnd) ||
+        PosesDiffer(curr.linkPoses, prev.linkPoses, entry->firstLink,
+          entry->linkEnd))
+    {
+      return true;
+    }
+
+    bool differ = false;
+    for (unsigned int i = firstModel; i < entry->modelEnd; ++i)
+      differ |= curr.modelScales[i] != prev.modelScales[i];
+
+    const unsigned int firstAxis = layout.jointAxes.empty() ? 0 :
+        layout.jointAxes[entry->firstJoint];
+    const unsigned int lastAxis = layout.jointAxes.empty() ? 0 :
+        layout.jointAxes[entry->jointEnd];
+    for (unsigned int i = firstAxis; i < lastAxis; ++i)
+    {
+      differ |= !ignition::math::equal(curr.jointPositions[i],
+          prev.jointPositions[i]);
+    }
+
+    if (differ)
+      return true;
+  }
+
+  return PosesDiffer(curr.lightPoses, prev.lightPoses, 0,
+      curr.lightPoses.size());
+}
+
+/////////////////////////////////////////////////
+bool WorldSnapshot::Apply(World &_world) const
+{
+  if (!this->Matches(_world))
+    return false;
+
+  const WorldSnapshotLayout &layout = *this->dataPtr->layout;
+
+  const Model_V models = _world.Models();
+  for (unsigned int i = 0; i < models.size(); ++i)
+    ApplyModel(*models[i], layout.topModels[i], *this->dataPtr);
+
+  const Light_V lights = _world.Lights();
+  for (unsigned int i = 0; i < lights.size(); ++i)
+  {
+    LightState state;
+    this->dataPtr->FillLightState(state, i);
+    lights[i]->SetState(state);
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool WorldSnapshot::ModelPose(const uint32_t _id,
+    ignition::math::Pose3d &_pose) const
+{
+  if (!this->dataPtr->layout)
+    return false;
+
+  auto iter = this->dataPtr->layout->modelIndices.find(_id);
+  if (iter == this->dataPtr->layout->modelIndices.end())
+    return false;
+
+  _pose = this->dataPtr->modelPoses[iter->second];
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool WorldSnapshot::LinkPose(const uint32_t _id,
+    ignition::math::Pose3d &_pose) const
+{
+  if (!this->dataPtr->layout)
+    return false;
+
+  auto iter = this->dataPtr->layout->linkIndices.find(_id);
+  if (iter == this->dataPtr->layout->linkIndices.end())
+    return false;
+
+  _pose = this->dataPtr->linkPoses[iter->second];
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool WorldSnapshot::JointPosition(const uint32_t _id,
+    const unsigned int _axis, double &_position) const
+{
+  if (!this->dataPtr->layout)
+    return false;
+
+  const WorldSnapshotLayout &layout = *this->dataPtr->layout;
+  auto iter = layout.jointIndices.find(_id);
+  if (iter == layout.jointIndices.end())
+    return false;
+
+  const unsigned int axis = layout.jointAxes[iter->second] + _axis;
+  if (axis >= layout.jointAxes[iter->second + 1])
+    return false;
+
+  _position = this->dataPtr->jointPositions[axis];
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool WorldSnapshot::JointVelocity(const uint32_t _id,
+    const unsigned int _axis, double &_velocity) const
+{
+  if (!this->dataPtr->layout)
+    return false;
+
+  const WorldSnapshotLayout &layout = *this->dataPtr->layout;
+  auto iter = layout.jointIndices.find(_id);
+  if (iter == layout.jointIndices.end())
+    return false;
+
+  const unsigned int axis = layout.jointAxes[iter->second] + _axis;
+  if (axis >= layout.jointAxes[iter->second + 1])
+    return false;
+
+  _velocity = this->dataPtr->jointVelocities[axis];
+  return true;
+}
+
+/////////////////////////////////////////////////
+const std::vector<std::string> &WorldSnapshot::Insertions() const
+{
+  return this->dataPtr->insertions;
+}
+
+/////////////////////////////////////////////////
+const std::vector<std::string> &WorldSnapshot::Deletions() const
+{
+  return this->dataPtr->deletions;
+}
+
+/////////////////////////////////////////////////
+common::Time WorldSnapshot::SimTime() const
+{
+  return this->dataPtr->simTime;
+}
+
+/////////////////////////////////////////////////
+common::Time WorldSnapshot::RealTime() const
+{
+  return this->dataPtr->realTime;
+}
+
+/////////////////////////////////////////////////
+uint64_t WorldSnapshot::Iterations() const
+{
+  return this->dataPtr->iterations;
+}
+
+/////////////////////////////////////////////////
+size_t WorldSnapshot::ModelCount() const
+{
+  return this->dataPtr->modelPoses.size();
+}
+
+/////////////////////////////////////////////////
+size_t WorldSnapshot::LinkCount() const
+{
+  return this->dataPtr->linkPoses.size();
+}
+
+/////////////////////////////////////////////////
+size_t WorldSnapshot::JointCount() const
+{
+  return this->dataPtr->layout ? this->dataPtr->layout->jointNames.size() : 0;
+}
+
+/////////////////////////////////////////////////
+size_t WorldSnapshot::LightCount() const
+{
+  return this->dataPtr->lightPoses.size();
+}
+
+/////////////////////////////////////////////////
+void WorldSnapshotPrivate::FillWorldState(WorldState &_state,
+    const std::string &_filter) const
+{
+  _state.world.reset();
+  _state.name = this->layout ? this->layout->worldName : "";
+  _state.wallTime = this->wallTime;
+  _state.realTime = this->realTime;
+  _state.simTime = this->simTime;
+  _state.iterations = this->iterations;
+  _state.insertions.clear();
+  _state.deletions.clear();
+  _state.modelStates.clear();
+  _state.lightStates.clear();
+
+  if (!this->layout)
+    return;
+
+  // Same filter semantics as WorldState::LoadWithFilter.
+  boost::regex regex;
+  const bool useRegex = FilterRegex(_filter, regex);
+
+  for (auto const &index : this->layout->topModels)
+  {
+    const std::string &modelName = this->layout->models[index].name;
+    if (useRegex && !boost::regex_match(modelName, regex))
+      continue;
+
+    this->FillModelState(_state.modelStates[modelName], index);
+  }
+
+  for (unsigned int i = 0; i < this->layout->lightNames.size(); ++i)
+    this->FillLightState(_state.lightStates[this->layout->lightNames[i]], i);
+}
+
+/////////////////////////////////////////////////
+void WorldSnapshotPrivate::FillModelState(ModelState &_state,
+    const unsigned int _index) const
+{
+  const WorldSnapshotLayout::ModelEntry &entry = this->layout->models[_index];
+
+  _state.name = entry.name;
+  _state.wallTime = this->wallTime;
+  _state.realTime = this->realTime;
+  _state.simTime = this->simTime;
+  _state.iterations = this->iterations;
+  _state.pose = this->modelPoses[_index];
+  _state.scale = this->modelScales[_index];
+
+  _state.linkStates.clear();
+  for (unsigned int i = 0; i < entry.linkCount; ++i)
+  {
+    const unsigned int k = entry.firstLink + i;
+    this->FillLinkState(_state.linkStates[this->layout->linkNames[k]], k);
+  }
+
+  _state.jointStates.clear();
+
+  _state.modelStates.clear();
+  for (auto const &child : entry.children)
+  {
+    this->FillModelState(
+        _state.modelStates[this->layout->models[child].name], child);
+  }
+}
+
+/////////////////////////////////////////////////
+void WorldSnapshotPrivate::FillLinkState(LinkState &_state,
+    const unsigned int _index) const
+{
+  _state.name = this->layout->linkNames[_index];
+  _state.wallTime = this->wallTime;
+  _state.realTime = this->realTime;
+  _state.simTime = this->simTime;
+  _state.iterations = this->iterations;
+
+  _state.pose = this->linkPoses[_index];
+  _state.velocity.Set(this->linkLinearVels[_index],
+                      this->linkAngularVels[_index]);
+  _state.acceleration.Set(this->linkLinearAccels[_index],
+                          this->linkAngularAccels[_index]);
+  _state.wrench.Set(this->linkForces[_index],
+                    ignition::math::Quaterniond::Identity);
+}
+
+/////////////////////////////////////////////////
+void WorldSnapshotPrivate::FillLightState(LightState &_state,
+    const unsigned int _index) const
+{
+  _state.name = this->layout->lightNames[_index];
+  _state.wallTime = this->wallTime;
+  _state.realTime = this->realTime;
+  _state.simTime = this->simTime;
+  _state.iterations = this->iterations;
+  _state.pose = this->lightPoses[_index];
+}
+
+/////////////////////////////////////////////////
+bool WorldSnapshotPrivate::ReadModelState(const ModelState &_state,
+    const unsigned int _index)
+{
+  const WorldSnapshotLayout::ModelEntry &entry = this->layout->models[_index];
+
+  this->modelPoses[_index] = _state.pose;
+  this->modelScales[_index] = _state.scale;
+
+  bool result = true;
+  for (unsigned int i = 0; i < entry.linkCount; ++i)
+  {
+    const unsigned int k = entry.firstLink + i;
+    auto iter = _state.linkStates.find(this->layout->linkNames[k]);
+    if (iter == _state.linkStates.end())
+    {
+      result = false;
+      continue;
+    }
+
+    const LinkState &linkState = iter->second;
+    this->linkPoses[k] = linkState.pose;
+    this->linkLinearVels[k] = linkState.velocity.Pos();
+    this->linkAngularVels[k] = linkState.velocity.Rot().Euler();
+    this->linkLinearAccels[k] = linkState.acceleration.Pos();
+    this->linkAngularAccels[k] = linkState.acceleration.Rot().Euler();
+    this->linkForces[k] = linkState.wrench.Pos();
+  }
+
+  for (auto const &child : entry.children)
+  {
+    auto iter = _state.modelStates.find(this->layout->models[child].name);
+    if (iter == _state.modelStates.end())
+      result = false;
+    else
+      result = this->ReadModelState(iter->second, child) && result;
+  }
+
+  return result;
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_WORLDSNAPSHOT_HH_
+#define GAZEBO_PHYSICS_WORLDSNAPSHOT_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/WorldState.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class
+    class WorldSnapshotPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class WorldSnapshot WorldSnapshot.hh physics/physics.hh
+    /// \brief A flat copy of the dynamic state of a world.
+    ///
+    /// Unlike WorldState, a snapshot stores model, link, joint and light
+    /// data in contiguous arrays, and the names, ids and hierarchy of the
+    /// entities are kept in a layout which is shared between snapshots for
+    /// as long as no entity is inserted or removed. Capturing, comparing
+    /// and applying snapshots therefore involve no string lookups, and the
+    /// conversion to a WorldState can happen later on another thread
+    /// without touching any live entity.
+    class GZ_PHYSICS_VISIBLE WorldSnapshot
+    {
+      /// \brief Constructor.
+      public: WorldSnapshot();
+
+      /// \brief Copy constructor. The layout is shared with _snapshot.
+      /// \param[in] _snapshot Snapshot to copy.
+      public: WorldSnapshot(const WorldSnapshot &_snapshot);
+
+      /// \brief Destructor.
+      public: virtual ~WorldSnapshot();
+
+      /// \brief Assignment operator. The layout is shared with _snapshot,
+      /// and the storage of this snapshot is reused.
+      /// \param[in] _snapshot Snapshot to copy.
+      /// \return Reference to this snapshot.
+      public: WorldSnapshot &operator=(const WorldSnapshot &_snapshot);
+
+      /// \brief Copy the current state of a world.
+      ///
+      /// The caller must make sure entities are not inserted or removed
+      /// during the call, e.g. by capturing from the world update thread
+      /// while holding the entity delete mutex.
+      /// \param[in] _world World to capture.
+      /// \param[in] _previous Snapshot captured earlier from the same
+      /// world, or nullptr. Its layout is reused when the world structure
+      /// has not changed, otherwise Insertions() and Deletions() are
+      /// computed relative to it.
+      /// \return True if the layout differs from the one of _previous.
+      public: bool Capture(const World &_world,
+                           const WorldSnapshot *_previous);
+
+      /// \brief Check if the world still has the entities this snapshot
+      /// was captured from. Only entity ids are compared, no state is
+      /// copied.
+      /// \param[in] _world World to compare against.
+      /// \return True if the layout of this snapshot matches the world.
+      public: bool Matches(const World &_world) const;
+
+      /// \brief Fill a WorldState from this snapshot. This does not access
+      /// the world, and can be called from any thread.
+      /// \param[out] _state State to fill. Any previous content is
+      /// replaced.
+      /// \param[in] _filter Log filter, with the same syntax as
+      /// WorldState::LoadWithFilter.
+      public: void ToWorldState(WorldState &_state,
+                                const std::string &_filter = "") const;
+
+      /// \brief Overwrite the data of this snapshot with the content of a
+      /// WorldState. The layout is kept, and entities are matched by name.
+      /// Joint positions are not part of WorldState, and are left as is.
+      /// \param[in] _state State to copy.
+      /// \return False if the snapshot has no layout, or if a model, link
+      /// or light of the layout is missing in _state.
+      public: bool FromWorldState(const WorldState &_state);
+
+      /// \brief Compare against an earlier snapshot. This is the flat
+      /// counterpart of (current - previous).IsZero() on WorldState, where
+      /// model poses and scales, link poses and joint positions are
+      /// compared.
+      /// \param[in] _previous Snapshot to compare against.
+      /// \param[in] _filter Log filter selecting the top level models to
+      /// compare, with the same syntax as WorldState::LoadWithFilter.
+      /// \return True if the state of a selected model or of a light
+      /// differs, or if the snapshots do not share the same layout.
+      public: bool Diff(const WorldSnapshot &_previous,
+                        const std::string &_filter = "") const;
+
+      /// \brief Set the state of the entities of a world from this
+      /// snapshot, the same way Model::SetState and Light::SetState do.
+      /// Entities are reached through the layout, without name lookups.
+      /// Like WorldState, joint positions are not applied since the link
+      /// poses define the configuration of the models.
+      /// \param[in] _world World to update. Simulation time and iterations
+      /// are not changed, see World::SetState.
+      /// \return False if the world does not match the layout of the
+      /// snapshot, in which case nothing is changed.
+      public: bool Apply(World &_world) const;
+
+      /// \brief Get the world pose of a model.
+      /// \param[in] _id Id of the model.
+      /// \param[out] _pose World pose of the model.
+      /// \return False if the model is not part of the snapshot.
+      public: bool ModelPose(const uint32_t _id,
+                             ignition::math::Pose3d &_pose) const;
+
+      /// \brief Get the world pose of a link.
+      /// \param[in] _id Id of the link.
+      /// \param[out] _pose World pose of the link.
+      /// \return False if the link is not part of the snapshot.
+      public: bool LinkPose(const uint32_t _id,
+                            ignition::math::Pose3d &_pose) const;
+
+      /// \brief Get the position of a joint axis.
+      /// \param[in] _id Id of the joint.
+      /// \param[in] _axis Index of the axis.
+      /// \param[out] _position Position of the axis.
+      /// \return False if the joint is not part of the snapshot, or if it
+      /// has no such axis.
+      public: bool JointPosition(const uint32_t _id, const unsigned int _axis,
+                                 double &_position) const;
+
+      /// \brief Get the velocity of a joint axis.
+      /// \param[in] _id Id of the joint.
+      /// \param[in] _axis Index of the axis.
+      /// \param[out] _velocity Velocity of the axis.
+      /// \return False if the joint is not part of the snapshot, or if it
+      /// has no such axis.
+      public: bool JointVelocity(const uint32_t _id, const unsigned int _axis,
+                                 double &_velocity) const;
+
+      /// \brief Get the SDF of models and lights inserted since the
+      /// snapshot passed to the last Capture call.
+      /// \return SDF strings of the new entities.
+      public: const std::vector<std::string> &Insertions() const;
+
+      /// \brief Get the names of models and lights removed since the
+      /// snapshot passed to the last Capture call.
+      /// \return Names of the removed entities.
+      public: const std::vector<std::string> &Deletions() const;
+
+      /// \brief Get the simulation time of the capture.
+      /// \return Simulation time.
+      public: common::Time SimTime() const;
+
+      /// \brief Get the real time of the capture.
+      /// \return Real time.
+      public: common::Time RealTime() const;
+
+      /// \brief Get the number of world iterations at the time of the
+      /// capture.
+      /// \return Iteration count.
+      public: uint64_t Iterations() const;
+
+      /// \brief Get the number of models, including nested ones.
+      /// \return Number of models.
+      public: size_t ModelCount() const;
+
+      /// \brief Get the number of links.
+      /// \return Number of links.
+      public: size_t LinkCount() const;
+
+      /// \brief Get the number of joints.
+      /// \return Number of joints.
+      public: size_t JointCount() const;
+
+      /// \brief Get the number of lights.
+      /// \return Number of lights.
+      public: size_t LightCount() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<WorldSnapshotPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
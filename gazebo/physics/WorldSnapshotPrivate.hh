@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_WORLDSNAPSHOTPRIVATE_HH_
+#define GAZEBO_PHYSICS_WORLDSNAPSHOTPRIVATE_HH_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \brief Names and hierarchy of the entities of a snapshot. A layout
+    /// is immutable once built, and shared between all the snapshots
+    /// captured while the world structure does not change.
+    class WorldSnapshotLayout
+    {
+      /// \brief One model of the layout.
+      public: class ModelEntry
+      {
+        /// \brief Model name.
+        public: std::string name;
+
+        /// \brief Id of the model, used to detect structure changes.
+        public: uint32_t id = 0;
+
+        /// \brief Index of the first link of the model.
+        public: unsigned int firstLink = 0;
+
+        /// \brief Number of links of the model.
+        public: unsigned int linkCount = 0;
+
+        /// \brief Index of the first joint of the model.
+        public: unsigned int firstJoint = 0;
+
+        /// \brief Number of joints of the model.
+        public: unsigned int jointCount = 0;
+
+        /// \brief Indices of the nested models.
+        public: std::vector<unsigned int> children;
+
+        /// \brief One past the index of the last model of the subtree
+        /// rooted at this model. Nested models follow their parent, so the
+        /// subtree is the range [index, modelEnd).
+        public: unsigned int modelEnd = 0;
+
+        /// \brief One past the index of the last link of the subtree.
+        public: unsigned int linkEnd = 0;
+
+        /// \brief One past the index of the last joint of the subtree.
+        public: unsigned int jointEnd = 0;
+      };
+
+      /// \brief Name of the world.
+      public: std::string worldName;
+
+      /// \brief All the models, in depth first order.
+      public: std::vector<ModelEntry> models;
+
+      /// \brief Indices of the top level models.
+      public: std::vector<unsigned int> topModels;
+
+      /// \brief Link names, indexed like the link arrays of a snapshot.
+      public: std::vector<std::string> linkNames;
+
+      /// \brief Link ids, used to detect structure changes.
+      public: std::vector<uint32_t> linkIds;
+
+      /// \brief Joint names, indexed like the joints of the layout.
+      public: std::vector<std::string> jointNames;
+
+      /// \brief Joint ids, used to detect structure changes.
+      public: std::vector<uint32_t> jointIds;
+
+      /// \brief Index of the first position of each joint in the joint
+      /// position array. Has one more element than there are joints, the
+      /// last one being the size of the array.
+      public: std::vector<unsigned int> jointAxes;
+
+      /// \brief Light names.
+      public: std::vector<std::string> lightNames;
+
+      /// \brief Light ids, used to detect structure changes.
+      public: std::vector<uint32_t> lightIds;
+
+      /// \brief Model index by entity id.
+      public: std::unordered_map<uint32_t, unsigned int> modelIndices;
+
+      /// \brief Link index by entity id.
+      public: std::unordered_map<uint32_t, unsigned int> linkIndices;
+
+      /// \brief Joint index by entity id.
+      public: std::unordered_map<uint32_t, unsigned int> jointIndices;
+    };
+
+    /// \internal
+    /// \brief Private data for the WorldSnapshot class
+    class WorldSnapshotPrivate
+    {
+      /// \brief Fill a world state from the snapshot data.
+      /// \param[out] _state State to fill.
+      /// \param[in] _filter Log filter applied to the top level models.
+      public: void FillWorldState(WorldState &_state,
+                                  const std::string &_filter) const;
+
+      /// \brief Fill a model state, and the states of its nested models.
+      /// \param[out] _state State to fill.
+      /// \param[in] _index Index of the model in the layout.
+      public: void FillModelState(ModelState &_state,
+                                  const unsigned int _index) const;
+
+      /// \brief Fill a link state.
+      /// \param[out] _state State to fill.
+      /// \param[in] _index Index of the link in the layout.
+      public: void FillLinkState(LinkState &_state,
+                                 const unsigned int _index) const;
+
+      /// \brief Fill a light state.
+      /// \param[out] _state State to fill.
+      /// \param[in] _index Index of the light in the layout.
+      public: void FillLightState(LightState &_state,
+                                  const unsigned int _index) const;
+
+      /// \brief Copy a model state, and the states of its nested models.
+      /// \param[in] _state State to copy.
+      /// \param[in] _index Index of the model in the layout.
+      /// \return False if an entity of the layout is missing in the state.
+      public: bool ReadModelState(const ModelState &_state,
+                                  const unsigned int _index);
+
+      /// \brief Layout of the snapshot.
+      public: std::shared_ptr<const WorldSnapshotLayout> layout;
+
+      /// \brief Wall time of the capture.
+      public: common::Time wallTime;
+
+      /// \brief Real time of the capture.
+      public: common::Time realTime;
+
+      /// \brief Simulation time of the capture.
+      public: common::Time simTime;
+
+      /// \brief World iterations at the time of the capture.
+      public: uint64_t iterations = 0;
+
+      /// \brief World pose of each model.
+      public: std::vector<ignition::math::Pose3d> modelPoses;
+
+      /// \brief Scale of each model.
+      public: std::vector<ignition::math::Vector3d> modelScales;
+
+      /// \brief World pose of each link.
+      public: std::vector<ignition::math::Pose3d> linkPoses;
+
+      /// \brief World linear velocity of each link.
+      public: std::vector<ignition::math::Vector3d> linkLinearVels;
+
+      /// \brief World angular velocity of each link.
+      public: std::vector<ignition::math::Vector3d> linkAngularVels;
+
+      /// \brief World linear acceleration of each link.
+      public: std::vector<ignition::math::Vector3d> linkLinearAccels;
+
+      /// \brief World angular acceleration of each link.
+      public: std::vector<ignition::math::Vector3d> linkAngularAccels;
+
+      /// \brief World force of each link.
+      public: std::vector<ignition::math::Vector3d> linkForces;
+
+      /// \brief Position of each joint axis, see
+      /// WorldSnapshotLayout::jointAxes.
+      public: std::vector<double> jointPositions;
+
+      /// \brief Velocity of each joint axis, indexed like jointPositions.
+      public: std::vector<double> jointVelocities;
+
+      /// \brief World pose of each light.
+      public: std::vector<ignition::math::Pose3d> lightPoses;
+
+      /// \brief SDF of the entities inserted since the previous snapshot.
+      public: std::vector<std::string> insertions;
+
+      /// \brief Names of the entities removed since the previous snapshot.
+      public: std::vector<std::string> deletions;
+    };
+  }
+}
+#endif
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "gazebo/test/ServerFixture.hh"
+#include "test/util.hh"
+#include "gazebo/physics/Joint.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
+#include "gazebo/physics/WorldState.hh"
+
+using namespace gazebo;
+
+class WorldSnapshotTest : public ServerFixture { };
+
+//////////////////////////////////////////////////
+TEST_F(WorldSnapshotTest, MatchesWorldState)
+{
+  this->Load("worlds/shapes.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  world->Step(100);
+
+  physics::WorldSnapshot snapshot;
+  EXPECT_FALSE(snapshot.Matches(*world));
+  EXPECT_TRUE(snapshot.Capture(*world, nullptr));
+  EXPECT_TRUE(snapshot.Matches(*world));
+  EXPECT_TRUE(snapshot.Insertions().empty());
+  EXPECT_TRUE(snapshot.Deletions().empty());
+  EXPECT_EQ(snapshot.Iterations(), world->Iterations());
+  EXPECT_EQ(snapshot.SimTime(), world->SimTime());
+  EXPECT_EQ(snapshot.ModelCount(), world->ModelCount());
+  EXPECT_EQ(snapshot.LightCount(), world->Lights().size());
+
+  physics::WorldState fromSnapshot;
+  snapshot.ToWorldState(fromSnapshot);
+  physics::WorldState fromWorld(world);
+
+  EXPECT_EQ(fromSnapshot.GetName(), fromWorld.GetName());
+  EXPECT_EQ(fromSnapshot.GetIterations(), fromWorld.GetIterations());
+  EXPECT_EQ(fromSnapshot.GetModelStateCount(), fromWorld.GetModelStateCount());
+  EXPECT_EQ(fromSnapshot.LightStateCount(), fromWorld.LightStateCount());
+  EXPECT_TRUE((fromSnapshot - fromWorld).IsZero());
+
+  for (auto const &model : world->Models())
+  {
+    ASSERT_TRUE(fromSnapshot.HasModelState(model->GetName()));
+    physics::ModelState modelState =
+        fromSnapshot.GetModelState(model->GetName());
+    EXPECT_EQ(modelState.Pose(), model->WorldPose());
+    EXPECT_EQ(modelState.GetLinkStateCount(), model->GetLinks().size());
+    for (auto const &link : model->GetLinks())
+    {
+      EXPECT_EQ(modelState.GetLinkState(link->GetName()).Pose(),
+          link->WorldPose());
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldSnapshotTest, InsertionsDeletions)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::WorldSnapshot first;
+  EXPECT_TRUE(first.Capture(*world, nullptr));
+
+  // The layout is reused when nothing changed.
+  world->Step(10);
+  physics::WorldSnapshot second;
+  EXPECT_FALSE(second.Capture(*world, &first));
+  EXPECT_TRUE(second.Insertions().empty());
+  EXPECT_TRUE(second.Deletions().empty());
+
+  this->SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 2), ignition::math::Vector3d::Zero);
+  EXPECT_FALSE(second.Matches(*world));
+
+  physics::WorldSnapshot third;
+  EXPECT_TRUE(third.Capture(*world, &second));
+  ASSERT_EQ(third.Insertions().size(), 1u);
+  EXPECT_NE(third.Insertions()[0].find("box"), std::string::npos);
+  EXPECT_TRUE(third.Deletions().empty());
+
+  // Only the box passes the filter.
+  physics::WorldState filtered;
+  third.ToWorldState(filtered, "box");
+  EXPECT_EQ(filtered.GetModelStateCount(), 1u);
+  EXPECT_TRUE(filtered.HasModelState("box"));
+
+  world->RemoveModel("box");
+  physics::WorldSnapshot fourth;
+  EXPECT_TRUE(fourth.Capture(*world, &third));
+  EXPECT_TRUE(fourth.Insertions().empty());
+  ASSERT_EQ(fourth.Deletions().size(), 1u);
+  EXPECT_EQ(fourth.Deletions()[0], "box");
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldSnapshotTest, DiffApplyJoints)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  std::ostringstream sdfStr;
+  sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+    << "<model name='arm'>"
+    << "  <pose>0 0 1 0 0 0</pose>"
+    << "  <link name='base'/>"
+    << "  <link name='forearm'><pose>0 0 -0.5 0 0 0</pose></link>"
+    << "  <joint name='elbow' type='revolute'>"
+    << "    <parent>base</parent><child>forearm</child>"
+    << "    <axis><xyz>1 0 0</xyz></axis>"
+    << "  </joint>"
+    << "</model>"
+    << "</sdf>";
+  this->SpawnSDF(sdfStr.str());
+
+  physics::ModelPtr arm = world->ModelByName("arm");
+  ASSERT_TRUE(arm != nullptr);
+  ASSERT_FALSE(arm->GetJoints().empty());
+
+  physics::WorldSnapshot initial;
+  EXPECT_TRUE(initial.Capture(*world, nullptr));
+  EXPECT_GT(initial.JointCount(), 0u);
+
+  // Entities can be looked up by id.
+  ignition::math::Pose3d pose;
+  EXPECT_TRUE(initial.ModelPose(arm->GetId(), pose));
+  EXPECT_EQ(pose, arm->WorldPose());
+  for (auto const &link : arm->GetLinks())
+  {
+    EXPECT_TRUE(initial.LinkPose(link->GetId(), pose));
+    EXPECT_EQ(pose, link->WorldPose());
+  }
+  for (auto const &joint : arm->GetJoints())
+  {
+    double position = 0;
+    EXPECT_TRUE(initial.JointPosition(joint->GetId(), 0, position));
+    EXPECT_DOUBLE_EQ(position, joint->Position(0));
+    EXPECT_FALSE(initial.JointPosition(joint->GetId(), joint->DOF(),
+        position));
+  }
+  EXPECT_FALSE(initial.LinkPose(arm->GetId(), pose));
+
+  // An identical capture has no difference.
+  physics::WorldSnapshot same;
+  EXPECT_FALSE(same.Capture(*world, &initial));
+  EXPECT_FALSE(same.Diff(initial));
+
+  // Move the arm.
+  arm->SetWorldPose(ignition::math::Pose3d(1, 2, 0, 0, 0, 0.5));
+  physics::WorldSnapshot moved;
+  EXPECT_FALSE(moved.Capture(*world, &initial));
+  EXPECT_TRUE(moved.Diff(initial));
+  EXPECT_TRUE(moved.Diff(initial, "arm"));
+  EXPECT_FALSE(moved.Diff(initial, "ground_plane"));
+
+  // The flat diff agrees with the WorldState diff.
+  physics::WorldState initialState, movedState;
+  initial.ToWorldState(initialState);
+  moved.ToWorldState(movedState);
+  EXPECT_FALSE((movedState - initialState).IsZero());
+
+  // A WorldState converts back to the same snapshot.
+  physics::WorldSnapshot converted(initial);
+  EXPECT_TRUE(converted.FromWorldState(movedState));
+  EXPECT_FALSE(converted.Diff(moved));
+  EXPECT_EQ(converted.SimTime(), moved.SimTime());
+
+  // Applying the initial snapshot restores the poses.
+  world->SetState(initial);
+  EXPECT_EQ(arm->WorldPose(), initialState.GetModelState("arm").Pose());
+  physics::WorldSnapshot restored;
+  EXPECT_FALSE(restored.Capture(*world, &initial));
+  EXPECT_FALSE(restored.Diff(initial));
+
+  // A snapshot of another layout is applied through WorldState.
+  this->SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 5), ignition::math::Vector3d::Zero);
+  EXPECT_FALSE(moved.Apply(*world));
+  world->SetState(moved);
+  EXPECT_EQ(arm->WorldPose(), ignition::math::Pose3d(1, 2, 0, 0, 0, 0.5));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -260,6 +260,9 @@ namespace gazebo
         return _out;
       }
 
+      /// \brief Snapshots fill states directly from their flat data.
+      private: friend class WorldSnapshotPrivate;
+
       /// \brief State of all the models.
       private: ModelState_M modelStates;
 
@@ -15,6 +15,14 @@
  *
 */
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/test/ServerFixture.hh"
@@ -216,6 +224,354 @@ TEST_F(WorldTest, Stop)
   EXPECT_TRUE(world->Running());
 }
 
+//////////////////////////////////////////////////
+TEST_F(WorldTest, EntityIndex)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  auto box = world->ModelByName("box");
+  ASSERT_NE(nullptr, box);
+  EXPECT_EQ(box, world->ModelById(box->GetId()));
+  EXPECT_EQ(box, world->BaseByName("box"));
+
+  // Scoped names are unique
+  auto boxLink = world->EntityByName("box::link");
+  ASSERT_NE(nullptr, boxLink);
+  EXPECT_EQ(boxLink->GetParent(), box);
+  EXPECT_EQ(boxLink, box->GetChild("link"));
+  EXPECT_EQ(boxLink, box->GetByName("link"));
+  EXPECT_EQ(boxLink, box->GetById(boxLink->GetId()));
+  EXPECT_EQ(nullptr, world->ModelById(boxLink->GetId()));
+  EXPECT_NE(nullptr, world->BaseByName("box::link::collision"));
+
+  // Names shared by several entities are still found, and only under the
+  // entity that is searched
+  EXPECT_NE(nullptr, world->BaseByName("link"));
+  auto sphere = world->ModelByName("sphere");
+  ASSERT_NE(nullptr, sphere);
+  EXPECT_EQ(sphere->GetChild("link")->GetParent(), sphere);
+  EXPECT_EQ(nullptr, sphere->GetByName("box::link"));
+  EXPECT_EQ(nullptr, world->BaseByName("not_an_entity"));
+
+  // Renaming
+  box->SetName("crate");
+  EXPECT_EQ(nullptr, world->ModelByName("box"));
+  EXPECT_EQ(box, world->ModelByName("crate"));
+
+  // Removal
+  uint32_t sphereId = sphere->GetId();
+  std::string sphereLinkName = sphere->GetChild("link")->GetScopedName();
+  sphere.reset();
+  world->RemoveModel("sphere");
+  EXPECT_EQ(nullptr, world->ModelByName("sphere"));
+  EXPECT_EQ(nullptr, world->ModelById(sphereId));
+  EXPECT_EQ(nullptr, world->BaseByName(sphereLinkName));
+}
+
+//////////////////////////////////////////////////
+/// \brief Number of world statistics messages received.
+static std::atomic<unsigned int> g_statsCount(0);
+
+//////////////////////////////////////////////////
+/// \brief Count world statistics messages.
+/// \param[in] _msg Message.
+void OnStatsCount(ConstWorldStatisticsPtr &/*_msg*/)
+{
+  ++g_statsCount;
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, PublishDecimation)
+{
+  this->Load("worlds/empty.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  // Defaults
+  EXPECT_DOUBLE_EQ(world->StatsPublishRate(), 5.0);
+  EXPECT_EQ(world->PosePublishSteps(), 1u);
+
+  // Invalid values are clamped
+  world->SetStatsPublishRate(-1);
+  EXPECT_DOUBLE_EQ(world->StatsPublishRate(), 0.0);
+  world->SetPosePublishSteps(0);
+  EXPECT_EQ(world->PosePublishSteps(), 1u);
+  world->SetPosePublishSteps(10);
+  EXPECT_EQ(world->PosePublishSteps(), 10u);
+
+  transport::SubscriberPtr sub =
+    this->node->Subscribe("~/world_stats", &OnStatsCount);
+
+  // Statistics at 2 Hz
+  world->SetStatsPublishRate(2);
+  common::Time::MSleep(500);
+  g_statsCount = 0;
+  world->SetPaused(false);
+  common::Time::Sleep(common::Time(1.0));
+  const unsigned int throttledCount = g_statsCount;
+  EXPECT_LE(throttledCount, 4u);
+
+  // Statistics after every step
+  world->SetStatsPublishRate(0);
+  common::Time::MSleep(500);
+  g_statsCount = 0;
+  common::Time::Sleep(common::Time(1.0));
+  world->SetPaused(true);
+  EXPECT_GT(g_statsCount, 10u * std::max(1u, throttledCount));
+}
+
+//////////////////////////////////////////////////
+/// \brief Number of local pose messages received.
+static std::atomic<unsigned int> g_poseCount(0);
+
+//////////////////////////////////////////////////
+/// \brief Count local pose messages.
+/// \param[in] _msg Message.
+void OnPoseCount(ConstPosesStampedPtr &/*_msg*/)
+{
+  ++g_poseCount;
+}
+
+//////////////////////////////////////////////////
+/// \brief Pose messages are decimated over physics steps, not over the
+/// passes of the world thread.
+TEST_F(WorldTest, PosePublishSteps)
+{
+  this->Load("worlds/empty.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+  world->SetPosePublishSteps(5);
+
+  transport::SubscriberPtr sub =
+    this->node->Subscribe("~/pose/local/info", &OnPoseCount);
+
+  // Let the poses queued when the world was loaded go out
+  common::Time::MSleep(500);
+
+  // Passes made while paused don't count
+  g_poseCount = 0;
+  common::Time::MSleep(500);
+  EXPECT_EQ(0u, g_poseCount);
+
+  // One message every 5 steps
+  world->Step(20);
+  common::Time::MSleep(200);
+  EXPECT_EQ(4u, g_poseCount);
+
+  // A model moved while paused is published without a step
+  auto ground = world->ModelByName("ground_plane");
+  ASSERT_NE(nullptr, ground);
+  g_poseCount = 0;
+  ground->SetWorldPose(ignition::math::Pose3d(0, 0, -1, 0, 0, 0));
+  common::Time::MSleep(200);
+  EXPECT_EQ(1u, g_poseCount);
+
+  // A falling sphere moves on every step of a real time paced run. The
+  // passes on which the pacer wakes up before the step is due don't
+  // publish its pose.
+  this->SpawnSphere("falling_sphere", ignition::math::Vector3d(0, 0, 100),
+      ignition::math::Vector3d::Zero);
+  common::Time::MSleep(200);
+  world->SetPosePublishSteps(50);
+  g_poseCount = 0;
+  const uint64_t startIterations = world->Iterations();
+  world->SetPaused(false);
+  common::Time::Sleep(common::Time(1.0));
+  world->SetPaused(true);
+  common::Time::MSleep(200);
+  const uint64_t steps = world->Iterations() - startIterations;
+  EXPECT_GT(steps, 100u);
+  EXPECT_GT(g_poseCount, 0u);
+  EXPECT_LE(g_poseCount, steps / 50 + 1);
+}
+
+//////////////////////////////////////////////////
+std::mutex g_poseNamesMutex;
+std::set<std::string> g_poseNames;
+std::map<std::string, ignition::math::Pose3d> g_lastPoses;
+
+//////////////////////////////////////////////////
+/// \brief Record the names and the last poses of the entities in the pose
+/// messages.
+/// \param[in] _msg Pose message.
+void OnPoseNames(ConstPosesStampedPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_poseNamesMutex);
+  for (int i = 0; i < _msg->pose_size(); ++i)
+  {
+    g_poseNames.insert(_msg->pose(i).name());
+    g_lastPoses[_msg->pose(i).name()] = msgs::ConvertIgn(_msg->pose(i));
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Step the world and return the names of the entities published.
+/// \param[in] _world World to step.
+/// \param[in] _steps Number of steps.
+/// \return Names of the entities in the pose messages.
+std::set<std::string> StepPoseNames(physics::WorldPtr _world,
+    const unsigned int _steps)
+{
+  {
+    std::lock_guard<std::mutex> lock(g_poseNamesMutex);
+    g_poseNames.clear();
+  }
+  _world->Step(_steps);
+  common::Time::MSleep(200);
+
+  std::lock_guard<std::mutex> lock(g_poseNamesMutex);
+  return g_poseNames;
+}
+
+//////////////////////////////////////////////////
+/// \brief Only the entities whose pose changed are published.
+TEST_F(WorldTest, PublishDirtyPoses)
+{
+  this->Load("worlds/empty.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  this->SpawnBox("static_box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(2, 0, 0.5), ignition::math::Vector3d::Zero,
+      true);
+  this->SpawnSphere("falling_sphere", ignition::math::Vector3d(0, 0, 5),
+      ignition::math::Vector3d::Zero);
+
+  transport::SubscriberPtr sub =
+    this->node->Subscribe("~/pose/local/info", &OnPoseNames);
+
+  // Let the poses queued when the models were inserted go out
+  StepPoseNames(world, 10);
+
+  // Only the falling sphere moves
+  auto names = StepPoseNames(world, 10);
+  EXPECT_EQ(1u, names.count("falling_sphere"));
+  EXPECT_EQ(1u, names.count("falling_sphere::body"));
+  EXPECT_EQ(0u, names.count("static_box"));
+  EXPECT_EQ(0u, names.count("static_box::body"));
+  EXPECT_EQ(0u, names.count("ground_plane"));
+
+  // Moving the static box publishes it again, with its link
+  auto box = world->ModelByName("static_box");
+  ASSERT_NE(nullptr, box);
+  box->SetWorldPose(ignition::math::Pose3d(4, 0, 0.5, 0, 0, 0));
+  names = StepPoseNames(world, 1);
+  EXPECT_EQ(1u, names.count("static_box"));
+  EXPECT_EQ(1u, names.count("static_box::body"));
+
+  // Removed models are no longer published
+  world->RemoveModel("falling_sphere");
+  names = StepPoseNames(world, 10);
+  EXPECT_EQ(0u, names.count("falling_sphere"));
+  EXPECT_EQ(0u, names.count("falling_sphere::body"));
+}
+
+//////////////////////////////////////////////////
+/// \brief A link at rest is published when the canonical link of its model
+/// moves, since its pose relative to the model changes.
+TEST_F(WorldTest, PublishRestingLinkPoses)
+{
+  this->Load("worlds/empty.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  // The first link is the canonical link. The resting link has no
+  // collision and no gravity, and its body is disabled below so the physics
+  // engine never moves it.
+  std::ostringstream sdfStr;
+  sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+    << "<model name='pair'>"
+    << "  <link name='moving'>"
+    << "    <pose>0 0 5 0 0 0</pose>"
+    << "    <collision name='c'><geometry><sphere><radius>0.5</radius>"
+    << "    </sphere></geometry></collision>"
+    << "  </link>"
+    << "  <link name='resting'>"
+    << "    <pose>3 0 1 0 0 0</pose>"
+    << "    <gravity>false</gravity>"
+    << "  </link>"
+    << "</model>"
+    << "</sdf>";
+  this->SpawnSDF(sdfStr.str());
+
+  auto model = world->ModelByName("pair");
+  ASSERT_NE(nullptr, model);
+  auto moving = model->GetLink("moving");
+  auto resting = model->GetLink("resting");
+  ASSERT_NE(nullptr, moving);
+  ASSERT_NE(nullptr, resting);
+  EXPECT_EQ(moving, model->GetLink("canonical"));
+  resting->SetEnabled(false);
+
+  transport::SubscriberPtr sub =
+    this->node->Subscribe("~/pose/local/info", &OnPoseNames);
+
+  // Let the poses queued when the model was inserted go out
+  StepPoseNames(world, 10);
+
+  auto names = StepPoseNames(world, 10);
+  EXPECT_EQ(1u, names.count("pair"));
+  EXPECT_EQ(1u, names.count("pair::moving"));
+  EXPECT_EQ(1u, names.count("pair::resting"));
+
+  // The resting link kept its world pose, and subscribers have its new pose
+  // relative to the model.
+  EXPECT_EQ(ignition::math::Pose3d(3, 0, 1, 0, 0, 0), resting->WorldPose());
+  EXPECT_LT(moving->WorldPose().Pos().Z(), 5.0);
+  std::lock_guard<std::mutex> lock(g_poseNamesMutex);
+  EXPECT_EQ(resting->RelativePose(), g_lastPoses["pair::resting"]);
+  EXPECT_EQ(model->RelativePose(), g_lastPoses["pair"]);
+}
+
+//////////////////////////////////////////////////
+std::mutex g_sharedPosesMutex;
+const msgs::PosesStamped *g_sharedPosesA = nullptr;
+const msgs::PosesStamped *g_sharedPosesB = nullptr;
+
+//////////////////////////////////////////////////
+/// \brief Record the last local pose message received by a subscriber.
+/// \param[in] _msg Pose message.
+void OnSharedPosesA(ConstPosesStampedPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_sharedPosesMutex);
+  g_sharedPosesA = _msg.get();
+}
+
+//////////////////////////////////////////////////
+/// \brief Record the last local pose message received by a subscriber.
+/// \param[in] _msg Pose message.
+void OnSharedPosesB(ConstPosesStampedPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_sharedPosesMutex);
+  g_sharedPosesB = _msg.get();
+}
+
+//////////////////////////////////////////////////
+/// \brief Local pose subscribers share the message published by the world.
+TEST_F(WorldTest, SharedLocalPoses)
+{
+  this->Load("worlds/empty.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  this->SpawnSphere("falling_sphere", ignition::math::Vector3d(0, 0, 5),
+      ignition::math::Vector3d::Zero);
+
+  transport::SubscriberPtr subA =
+    this->node->Subscribe("~/pose/local/info", &OnSharedPosesA);
+  transport::SubscriberPtr subB =
+    this->node->Subscribe("~/pose/local/info", &OnSharedPosesB);
+
+  world->Step(10);
+  common::Time::MSleep(500);
+
+  std::lock_guard<std::mutex> lock(g_sharedPosesMutex);
+  ASSERT_NE(nullptr, g_sharedPosesA);
+  EXPECT_EQ(g_sharedPosesA, g_sharedPosesB);
+}
+
 //////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
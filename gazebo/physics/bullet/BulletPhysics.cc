@@ -16,6 +16,7 @@
 */
 
 #include <algorithm>
+#include <cstring>
 #include <string>
 
 #include <ignition/common/Profiler.hh>
@@ -422,6 +423,8 @@ void BulletPhysics::OnRequest(ConstRequestPtr &_msg)
       msgs::Convert(this->world->Gravity()));
     physicsMsg.mutable_magnetic_field()->CopyFrom(
         msgs::Convert(this->world->MagneticField()));
+    physicsMsg.set_model_update_threads(
+        this->world->ModelUpdateThreads());
     physicsMsg.set_real_time_update_rate(this->realTimeUpdateRate);
     physicsMsg.set_real_time_factor(this->targetRealTimeFactor);
     physicsMsg.set_max_step_size(this->maxStepSize);
@@ -873,3 +876,30 @@ void BulletPhysics::SetSeed(uint32_t /*_seed*/)
   // It's going to be blank for now.
   /// \todo Implement this function.
 }
+
+/////////////////////////////////////////////////
+void BulletPhysics::SaveSolverState(std::string &_state) const
+{
+  // Only the random generator of the solver is saved. Bullet keeps its warm
+  // start data in contact manifolds that point to the collision objects,
+  // which are cleared on restore instead.
+  const unsigned long seed = this->solver->getRandSeed();
+  _state.assign(reinterpret_cast<const char *>(&seed), sizeof(seed));
+}
+
+/////////////////////////////////////////////////
+bool BulletPhysics::RestoreSolverState(const std::string &_state)
+{
+  unsigned long seed;
+  if (_state.size() != sizeof(seed))
+    return false;
+
+  memcpy(&seed, _state.data(), sizeof(seed));
+  this->solver->setRandSeed(seed);
+
+  // Cached contacts belong to the state being replaced
+  for (int i = 0; i < this->dispatcher->getNumManifolds(); ++i)
+    this->dispatcher->getManifoldByIndexInternal(i)->clearManifold();
+
+  return true;
+}
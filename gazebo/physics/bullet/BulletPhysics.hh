@@ -152,6 +152,12 @@ namespace gazebo
       // Documentation inherited
       public: virtual void SetSeed(uint32_t _seed);
 
+      // Documentation inherited
+      public: virtual void SaveSolverState(std::string &_state) const;
+
+      // Documentation inherited
+      public: virtual bool RestoreSolverState(const std::string &_state);
+
       /// \brief Register a joint with the dynamics world
       public: btDynamicsWorld *GetDynamicsWorld() const
               {return this->dynamicsWorld;}
@@ -840,6 +840,8 @@ void DARTPhysics::OnRequest(ConstRequestPtr &_msg)
       msgs::Convert(this->world->Gravity()));
     physicsMsg.mutable_magnetic_field()->CopyFrom(
       msgs::Convert(this->world->MagneticField()));
+    physicsMsg.set_model_update_threads(
+        this->world->ModelUpdateThreads());
     physicsMsg.set_enable_physics(this->world->PhysicsEnabled());
     physicsMsg.set_real_time_update_rate(this->realTimeUpdateRate);
     physicsMsg.set_real_time_factor(this->targetRealTimeFactor);
@@ -14,7 +14,13 @@
  * limitations under the License.
  *
 */
+#include <functional>
+
+#include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/World.hh"
 #include "gazebo/physics/ode/ODECollision.hh"
 #include "gazebo/physics/ode/ODEHeightmapShape.hh"
 
@@ -26,18 +32,64 @@ ODEHeightmapShape::ODEHeightmapShape(CollisionPtr _parent)
     : HeightmapShape(_parent)
 {
   this->flipY = false;
+  this->tilingSupported = true;
 }
 
 //////////////////////////////////////////////////
 ODEHeightmapShape::~ODEHeightmapShape()
 {
+  this->updateConnection.reset();
 }
 
 //////////////////////////////////////////////////
 dReal ODEHeightmapShape::GetHeightCallback(void *_data, int _x, int _y)
 {
   // Return the height at a specific vertex
-  return static_cast<ODEHeightmapShape*>(_data)->GetHeight(_x, _y);
+  return static_cast<ODEHeightmapShape*>(_data)->CollisionHeight(_x, _y);
+}
+
+//////////////////////////////////////////////////
+/// \brief Append the links of a model and of its nested models.
+/// \param[in] _model The model.
+/// \param[out] _links Links to append to.
+static void appendLinks(const ModelPtr &_model, Link_V &_links)
+{
+  const Link_V &links = _model->GetLinks();
+  _links.insert(_links.end(), links.begin(), links.end());
+  for (const auto &nested : _model->NestedModels())
+    appendLinks(nested, _links);
+}
+
+//////////////////////////////////////////////////
+void ODEHeightmapShape::OnWorldUpdateBegin(const common::UpdateInfo &_info)
+{
+  if (_info.worldName != this->world->Name())
+    return;
+
+  Link_V links;
+  for (const auto &model : this->world->Models())
+  {
+    if (!model->IsStatic())
+      appendLinks(model, links);
+  }
+
+  // Convert the link positions to vertex coordinates. The heightfield is
+  // centered on the collision, and its rows run along -Y (see Init).
+  const ignition::math::Pose3d pose = this->collisionParent->WorldPose();
+  const ignition::math::Vector3d size = this->Size();
+  const double last = this->vertSize - 1;
+
+  std::vector<ignition::math::Vector2d> vertices;
+  vertices.reserve(links.size());
+  for (const auto &link : links)
+  {
+    ignition::math::Vector3d pos = pose.Rot().RotateVectorReverse(
+        link->WorldPose().Pos() - pose.Pos());
+    vertices.emplace_back((0.5 + pos.X() / size.X()) * last,
+        (0.5 - pos.Y() / size.Y()) * last);
+  }
+
+  this->UpdateTiles(vertices, this->TileRadius() / size.X() * last);
 }
 
 
@@ -110,19 +162,43 @@ void ODEHeightmapShape::Init()
 
 
   // Step 3: Setup a callback method for ODE
-  setOdeHeightfieldDetails(
-      this->odeData,
-      this->heights.data(),
-      // in meters
-      this->Size().X(),
-      // in meters
-      this->Size().Y(),
-      // number of vertices
-      this->vertSize,
-      // vertical (z-axis) offset
-      this->Pos().Z(),
-      // vertical thickness for closing the height map mesh
-      1.0);
+  if (this->Tiled())
+  {
+    // Read the heights from the tiles, which are paged in around the links
+    // before each update
+    dGeomHeightfieldDataBuildCallback(
+        this->odeData,
+        this,
+        &ODEHeightmapShape::GetHeightCallback,
+        this->Size().X(),
+        this->Size().Y(),
+        this->vertSize,
+        this->vertSize,
+        1.0,
+        this->Pos().Z(),
+        1.0,
+        0);
+
+    this->updateConnection = this->world->ConnectUpdateBegin(
+        std::bind(&ODEHeightmapShape::OnWorldUpdateBegin, this,
+          std::placeholders::_1));
+  }
+  else
+  {
+    setOdeHeightfieldDetails(
+        this->odeData,
+        this->heights.data(),
+        // in meters
+        this->Size().X(),
+        // in meters
+        this->Size().Y(),
+        // number of vertices
+        this->vertSize,
+        // vertical (z-axis) offset
+        this->Pos().Z(),
+        // vertical thickness for closing the height map mesh
+        1.0);
+  }
 
   // Step 4: Restrict the bounds of the AABB to improve efficiency
   dGeomHeightfieldDataSetBounds(this->odeData, this->GetMinHeight(),
@@ -19,6 +19,7 @@
 
 #include <vector>
 
+#include "gazebo/common/UpdateInfo.hh"
 #include "gazebo/physics/HeightmapShape.hh"
 #include "gazebo/physics/ode/ODEPhysics.hh"
 #include "gazebo/physics/Collision.hh"
@@ -44,6 +45,11 @@ namespace gazebo
       // Documentation inerited.
       public: virtual void Init();
 
+      /// \brief Load the tiles around the links of non-static models, when
+      /// the heights are tiled.
+      /// \param[in] _info World update information.
+      private: void OnWorldUpdateBegin(const common::UpdateInfo &_info);
+
       /// \brief Called by ODE to get the height at a vertex.
       /// \param[in] _data Pointer to the heightmap data.
       /// \param[in] _x X location.
@@ -52,6 +58,9 @@ namespace gazebo
 
       /// \brief The heightmap data.
       private: dHeightfieldDataID odeData;
+
+      /// \brief Connection to the world update event, when tiled.
+      private: event::ConnectionPtr updateConnection;
     };
     /// \}
   }
@@ -22,6 +22,7 @@
 #include "gazebo/common/Exception.hh"
 
 #include "gazebo/physics/Collision.hh"
+#include "gazebo/physics/SpatialIndex.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/WorldPrivate.hh"
 #include "gazebo/physics/Model.hh"
@@ -119,6 +120,22 @@ void ODELink::Init()
   if (!this->GetKinematic())
     this->UpdateMass();
 
+  // Collision::Init indexed the boxes of the geoms before they were
+  // attached to the body, refresh them so that queries made before the
+  // first step see the placed geoms.
+  if (this->world && this->world->SpatialIndex().Enabled())
+  {
+    SpatialIndex &index = this->world->SpatialIndex();
+    for (auto const &child : this->children)
+    {
+      if (child->HasType(Base::COLLISION) && index.Has(child->GetId()))
+      {
+        index.Update(child->GetId(),
+            boost::static_pointer_cast<Collision>(child)->BoundingBox());
+      }
+    }
+  }
+
   if (this->linkId)
   {
     dBodySetMovedCallback(this->linkId, MoveCallback);
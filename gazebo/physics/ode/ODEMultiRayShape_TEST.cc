@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/physics/MultiRayShape.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/RayShape.hh"
+#include "gazebo/sensors/sensors.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class ODEMultiRayShape_TEST : public ServerFixture
+{
+  /// \brief Cast the rays of a laser with ODEMultiRayShape::UpdateRays and
+  /// with ODEPhysics::CastRays, and compare the hits.
+  /// \param[in] _world World of the laser.
+  /// \param[in] _sensorName Name of the laser.
+  /// \param[in] _inside Name of the box the laser is inside of, empty if
+  /// the laser is not inside a box.
+  public: void CompareRays(physics::WorldPtr _world,
+                           const std::string &_sensorName,
+                           const std::string &_inside);
+};
+
+/////////////////////////////////////////////////
+void ODEMultiRayShape_TEST::CompareRays(physics::WorldPtr _world,
+    const std::string &_sensorName, const std::string &_inside)
+{
+  sensors::RaySensorPtr sensor = std::dynamic_pointer_cast<sensors::RaySensor>(
+      sensors::get_sensor(_sensorName));
+  ASSERT_NE(sensor, nullptr);
+  physics::MultiRayShapePtr shape = sensor->LaserShape();
+  ASSERT_NE(shape, nullptr);
+
+  // The sensor must not update the rays meanwhile
+  sensor->SetActive(false);
+  common::Time::MSleep(100);
+
+  // Reset the rays like MultiRayShape::Update, and keep their segments
+  const double fullRange = shape->GetMaxRange() - shape->GetMinRange();
+  const unsigned int count = shape->RayCount();
+  ASSERT_GT(count, 0u);
+  std::vector<physics::RayCast> casts(count);
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    physics::RayShapePtr ray = shape->Ray(i);
+    ray->SetLength(fullRange);
+    ray->SetRetro(0.0);
+    ray->Update();
+    ray->GlobalPoints(casts[i].start, casts[i].end);
+  }
+
+  shape->UpdateRays();
+  ASSERT_TRUE(_world->Physics()->CastRays(casts));
+
+  unsigned int hits = 0;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    physics::RayShapePtr ray = shape->Ray(i);
+    const bool hit = ray->GetLength() < fullRange - 1e-6;
+    EXPECT_EQ(hit, !casts[i].collision.empty()) << "ray " << i;
+    if (!hit)
+    {
+      EXPECT_NEAR(casts[i].distance, fullRange, 1e-6) << "ray " << i;
+      continue;
+    }
+
+    ++hits;
+    EXPECT_NEAR(casts[i].distance, ray->GetLength(), 1e-4) << "ray " << i;
+    EXPECT_EQ(casts[i].collision, ray->CollisionName()) << "ray " << i;
+    EXPECT_FLOAT_EQ(casts[i].retro, ray->GetRetro()) << "ray " << i;
+
+    // Rays which start inside a box hit it on the way out
+    if (!_inside.empty())
+      EXPECT_EQ(casts[i].collision.find(_inside + "::"), 0u) << "ray " << i;
+  }
+  EXPECT_GT(hits, count / 4);
+}
+
+/////////////////////////////////////////////////
+/// \brief CastRays finds the same hits as the ray space of the laser on
+/// boxes, spheres, cylinders, a trimesh and the ground plane.
+TEST_F(ODEMultiRayShape_TEST, CastRaysMatchesUpdateRays)
+{
+  Load("worlds/shapes.world", true, "ode");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_NE(world, nullptr);
+  ASSERT_TRUE(world->SpatialIndex().Enabled());
+
+  // The world has a box, a sphere and a cylinder around the origin
+  SpawnTrimesh("trimesh",
+      "file://" + std::string(TEST_PATH) + "/data/box.dae",
+      ignition::math::Vector3d::One, ignition::math::Vector3d(-2, 0, 0.5),
+      ignition::math::Vector3d::Zero, true);
+  SpawnBox("enclosure", ignition::math::Vector3d(0.6, 0.6, 0.6),
+      ignition::math::Vector3d(6, 0, 0.5), ignition::math::Vector3d::Zero,
+      true);
+
+  // A laser among the shapes, tilted so that some rays hit the ground, and
+  // one inside the enclosure.
+  SpawnRaySensor("laser_model", "laser", ignition::math::Vector3d(2, 0, 0.5),
+      ignition::math::Vector3d::Zero, -IGN_PI, IGN_PI, -0.6, 0.3, 0.05, 10,
+      0.01, 360, 16);
+  SpawnRaySensor("inside_model", "inside_laser",
+      ignition::math::Vector3d(6, 0.1, 0.5), ignition::math::Vector3d::Zero,
+      -IGN_PI, IGN_PI, -0.6, 0.6, 0.05, 10, 0.01, 90, 8);
+
+  // The world is not stepped, the spatial index holds the boxes of the
+  // collisions as placed by ODELink::Init.
+  CompareRays(world, "laser", "");
+  CompareRays(world, "inside_laser", "enclosure");
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
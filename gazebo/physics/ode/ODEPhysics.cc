@@ -21,11 +21,17 @@
 #include <sdf/sdf.hh>
 
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <map>
+#include <numeric>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include <ignition/math/Matrix3.hh>
 #include <ignition/math/Rand.hh>
 #include <ignition/math/Vector3.hh>
 #include <ignition/common/Profiler.hh>
@@ -47,6 +53,7 @@
 #include "gazebo/physics/SurfaceParams.hh"
 #include "gazebo/physics/Collision.hh"
 #include "gazebo/physics/MapShape.hh"
+#include "gazebo/physics/SpatialIndex.hh"
 #include "gazebo/physics/ContactManager.hh"
 
 #include "gazebo/physics/ode/ODECollision.hh"
@@ -98,33 +105,6 @@ class ContactUpdate_TBB
 };
 */
 
-class Colliders_TBB
-{
-  public: Colliders_TBB(
-              std::vector<std::pair<ODECollision*, ODECollision*> > *_colliders,
-              ODEPhysics *_engine,
-              dContactGeom* _contactCollisions) :
-    colliders(_colliders),
-              engine(_engine), contactCollisions(_contactCollisions)
-  {
-    // dAllocateODEDataForThread(dAllocateMaskAll);
-  }
-
-  public: void operator() (const tbb::blocked_range<size_t> &_r) const
-  {
-    for (size_t i = _r.begin(); i != _r.end(); i++)
-    {
-      ODECollision *collision1 = (*this->colliders)[i].first;
-      ODECollision *collision2 = (*this->colliders)[i].second;
-      this->engine->Collide(collision1, collision2, contactCollisions);
-    }
-  }
-
-  private: std::vector< std::pair<ODECollision*, ODECollision*> > *colliders;
-  private: ODEPhysics *engine;
-  private: dContactGeom* contactCollisions;
-};
-
 //////////////////////////////////////////////////
 extern "C" void dMessageQuiet(int, const char *, va_list)
 {
@@ -234,6 +214,27 @@ void ODEPhysics::Load(sdf::ElementPtr _sdf)
   this->SetStepType(this->dataPtr->stepType);
   if (this->dataPtr->physicsStepFunc == nullptr)
     gzthrow(std::string("Invalid step type[") + this->dataPtr->stepType);
+
+  // Trimesh pairs can only be collided concurrently if ODE keeps its
+  // trimesh collision caches in thread local storage.
+  this->dataPtr->mtTrimeshCollisions =
+      dCheckConfiguration("ODE_EXT_mt_collisions") != 0;
+
+  unsigned int collisionThreads = 0;
+  if (_sdf->HasElement("gz:collision_threads"))
+    collisionThreads = _sdf->Get<unsigned int>("gz:collision_threads");
+  this->SetCollisionThreads(collisionThreads);
+
+  if (solverElem->HasElement("island_threads"))
+  {
+    this->SetIslandThreads(static_cast<unsigned int>(
+          std::max(solverElem->Get<int>("island_threads"), 0)));
+  }
+  if (solverElem->HasElement("thread_position_correction"))
+  {
+    dWorldSetQuickStepThreadPositionCorrection(this->dataPtr->worldId,
+        solverElem->Get<bool>("thread_position_correction"));
+  }
 }
 
 /////////////////////////////////////////////////
@@ -275,6 +276,8 @@ void ODEPhysics::OnRequest(ConstRequestPtr &_msg)
       msgs::Convert(this->world->Gravity()));
     physicsMsg.mutable_magnetic_field()->CopyFrom(
       msgs::Convert(this->world->MagneticField()));
+    physicsMsg.set_model_update_threads(
+        this->world->ModelUpdateThreads());
     physicsMsg.set_real_time_update_rate(this->realTimeUpdateRate);
     physicsMsg.set_real_time_factor(this->targetRealTimeFactor);
     physicsMsg.set_max_step_size(this->maxStepSize);
@@ -380,6 +383,17 @@ void ODEPhysics::UpdateCollision()
   DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "dSpaceCollide");
   IGN_PROFILE_END();
 
+  if (this->dataPtr->collisionArena)
+  {
+    IGN_PROFILE_BEGIN("collideParallel");
+    this->CollideParallel();
+    DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "collideParallel");
+    IGN_PROFILE_END();
+
+    DIAG_TIMER_STOP("ODEPhysics::UpdateCollision");
+    return;
+  }
+
   IGN_PROFILE_BEGIN("collideShapes");
   // Generate non-trimesh collisions.
   for (i = 0; i < this->dataPtr->collidersCount; ++i)
@@ -393,7 +407,8 @@ void ODEPhysics::UpdateCollision()
 
   IGN_PROFILE_BEGIN("collideTrimeshes");
   // Generate trimesh collision.
-  // This must happen in this thread sequentially
+  // This must happen in this thread sequentially, see CollideParallel for
+  // the threaded version.
   for (i = 0; i < this->dataPtr->trimeshCollidersCount; ++i)
   {
     ODECollision *collision1 = this->dataPtr->trimeshColliders[i].first;
@@ -849,6 +864,487 @@ double ODEPhysics::GetContactSurfaceLayer()
       "constraints")->Get<double>("contact_surface_layer");
 }
 
+//////////////////////////////////////////////////
+void ODEPhysics::SetCollisionThreads(const unsigned int _threads)
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  this->dataPtr->collisionThreads = _threads;
+  if (_threads > 1)
+  {
+    this->dataPtr->collisionArena.reset(
+        new tbb::task_arena(static_cast<int>(_threads)));
+  }
+  else
+  {
+    this->dataPtr->collisionArena.reset();
+  }
+}
+
+//////////////////////////////////////////////////
+unsigned int ODEPhysics::CollisionThreads() const
+{
+  return this->dataPtr->collisionThreads;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SetIslandThreads(const unsigned int _threads)
+{
+  // The island thread pool is replaced, so it must not be in use.
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+  dWorldSetIslandThreads(this->dataPtr->worldId, static_cast<int>(_threads));
+}
+
+//////////////////////////////////////////////////
+unsigned int ODEPhysics::IslandThreads() const
+{
+  return static_cast<unsigned int>(
+      std::max(dWorldGetIslandThreads(this->dataPtr->worldId), 0));
+}
+
+//////////////////////////////////////////////////
+/// \brief A geom copied by ODEPhysics::CastRays, so that rays are cast
+/// without the physics update mutex.
+struct ODERayTarget
+{
+  /// \brief ODE class of the geom.
+  int geomClass = 0;
+
+  /// \brief Position of the geom.
+  ignition::math::Vector3d pos;
+
+  /// \brief Rotation of the geom.
+  ignition::math::Matrix3d rot;
+
+  /// \brief Half size of a box. Radius in X and length in Z of a sphere,
+  /// cylinder or capsule. Normal of a plane.
+  ignition::math::Vector3d size;
+
+  /// \brief Offset of a plane.
+  double offset = 0;
+
+  /// \brief Minimum corner of the bounding box.
+  ignition::math::Vector3d min;
+
+  /// \brief Maximum corner of the bounding box.
+  ignition::math::Vector3d max;
+
+  /// \brief Laser retro value of the collision.
+  double retro = 0;
+
+  /// \brief Scoped name of the collision.
+  std::string name;
+
+  /// \brief True if the geom is not copied, but collided by ODE while the
+  /// physics update mutex is held.
+  bool complex = false;
+};
+
+//////////////////////////////////////////////////
+/// \brief Intersect a ray with a bounding box.
+/// \param[in] _start Start of the ray.
+/// \param[in] _dir Unit direction of the ray.
+/// \param[in] _length Length of the ray.
+/// \param[in] _min Minimum corner of the box.
+/// \param[in] _max Maximum corner of the box.
+/// \return True if the ray intersects the box.
+static bool RayHitsBox(const ignition::math::Vector3d &_start,
+    const ignition::math::Vector3d &_dir, const double _length,
+    const ignition::math::Vector3d &_min, const ignition::math::Vector3d &_max)
+{
+  double lo = 0;
+  double hi = _length;
+  for (int i = 0; i < 3; ++i)
+  {
+    if (std::abs(_dir[i]) < 1e-12)
+    {
+      if (_start[i] < _min[i] || _start[i] > _max[i])
+        return false;
+      continue;
+    }
+    double t1 = (_min[i] - _start[i]) / _dir[i];
+    double t2 = (_max[i] - _start[i]) / _dir[i];
+    if (t1 > t2)
+      std::swap(t1, t2);
+    lo = std::max(lo, t1);
+    hi = std::min(hi, t2);
+    if (lo > hi)
+      return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Keep the smallest non-negative distance.
+/// \param[in] _t Candidate distance.
+/// \param[in,out] _best Smallest distance so far.
+static void KeepClosest(const double _t, double &_best)
+{
+  if (_t >= 0 && _t < _best)
+    _best = _t;
+}
+
+//////////////////////////////////////////////////
+/// \brief Intersect a ray with a sphere centered on the origin.
+/// \param[in] _o Start of the ray.
+/// \param[in] _d Unit direction of the ray.
+/// \param[in] _radius Radius of the sphere.
+/// \param[in] _center Center of the sphere.
+/// \param[in,out] _best Closest distance at which the ray crosses the
+/// surface.
+/// \param[in] _minZ Only keep crossings whose Z is above this value, used
+/// for the ends of capsules.
+/// \param[in] _maxZ Only keep crossings whose Z is below this value.
+static void RaySphere(const ignition::math::Vector3d &_o,
+    const ignition::math::Vector3d &_d, const double _radius,
+    const ignition::math::Vector3d &_center, double &_best,
+    const double _minZ, const double _maxZ)
+{
+  const ignition::math::Vector3d oc = _o - _center;
+  const double b = oc.Dot(_d);
+  const double c = oc.Dot(oc) - _radius * _radius;
+  const double disc = b * b - c;
+  if (disc < 0)
+    return;
+
+  const double s = std::sqrt(disc);
+  for (const double t : {-b - s, -b + s})
+  {
+    const double z = _o.Z() + t * _d.Z();
+    if (z >= _minZ && z <= _maxZ)
+      KeepClosest(t, _best);
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Intersect a ray with a copied geom. Like ODE, a ray which starts
+/// inside a geom hits its surface on the way out.
+/// \param[in] _target Copied geom.
+/// \param[in] _start Start of the ray, in the world frame.
+/// \param[in] _dir Unit direction of the ray, in the world frame.
+/// \param[in] _length Length of the ray.
+/// \return Distance to the hit, or a negative value if the ray misses.
+static double RayTargetDistance(const ODERayTarget &_target,
+    const ignition::math::Vector3d &_start,
+    const ignition::math::Vector3d &_dir, const double _length)
+{
+  const double inf = std::numeric_limits<double>::infinity();
+  double best = inf;
+
+  if (_target.geomClass == dPlaneClass)
+  {
+    const double k = _target.size.Dot(_dir);
+    if (std::abs(k) > 1e-12)
+      best = (_target.offset - _target.size.Dot(_start)) / k;
+    return best >= 0 && best <= _length ? best : -1;
+  }
+
+  // Work in the frame of the geom.
+  const ignition::math::Matrix3d rotT = _target.rot.Transposed();
+  const ignition::math::Vector3d o = rotT * (_start - _target.pos);
+  const ignition::math::Vector3d d = rotT * _dir;
+
+  switch (_target.geomClass)
+  {
+    case dBoxClass:
+    {
+      double lo = -inf;
+      double hi = inf;
+      for (int i = 0; i < 3; ++i)
+      {
+        const double h = _target.size[i];
+        if (std::abs(d[i]) < 1e-12)
+        {
+          if (o[i] < -h || o[i] > h)
+            return -1;
+          continue;
+        }
+        double t1 = (-h - o[i]) / d[i];
+        double t2 = (h - o[i]) / d[i];
+        if (t1 > t2)
+          std::swap(t1, t2);
+        lo = std::max(lo, t1);
+        hi = std::min(hi, t2);
+        if (lo > hi)
+          return -1;
+      }
+      best = lo >= 0 ? lo : hi;
+      break;
+    }
+    case dSphereClass:
+    {
+      RaySphere(o, d, _target.size.X(), ignition::math::Vector3d::Zero,
+          best, -inf, inf);
+      break;
+    }
+    case dCylinderClass:
+    case dCapsuleClass:
+    {
+      const double r = _target.size.X();
+      const double h = _target.size.Z() * 0.5;
+
+      // Side
+      const double a = d.X() * d.X() + d.Y() * d.Y();
+      if (a > 1e-12)
+      {
+        const double b = o.X() * d.X() + o.Y() * d.Y();
+        const double c = o.X() * o.X() + o.Y() * o.Y() - r * r;
+        const double disc = b * b - a * c;
+        if (disc >= 0)
+        {
+          const double s = std::sqrt(disc);
+          for (const double t : {(-b - s) / a, (-b + s) / a})
+          {
+            if (std::abs(o.Z() + t * d.Z()) <= h)
+              KeepClosest(t, best);
+          }
+        }
+      }
+
+      if (_target.geomClass == dCapsuleClass)
+      {
+        // Half spheres at the ends
+        RaySphere(o, d, r, ignition::math::Vector3d(0, 0, h), best, h, inf);
+        RaySphere(o, d, r, ignition::math::Vector3d(0, 0, -h), best, -inf,
+            -h);
+      }
+      else if (std::abs(d.Z()) > 1e-12)
+      {
+        // Caps
+        for (const double z : {h, -h})
+        {
+          const double t = (z - o.Z()) / d.Z();
+          const double x = o.X() + t * d.X();
+          const double y = o.Y() + t * d.Y();
+          if (x * x + y * y <= r * r)
+            KeepClosest(t, best);
+        }
+      }
+      break;
+    }
+    default:
+      return -1;
+  }
+
+  return best >= 0 && best <= _length ? best : -1;
+}
+
+//////////////////////////////////////////////////
+bool ODEPhysics::CastRays(std::vector<RayCast> &_rays)
+{
+  IGN_PROFILE("ODEPhysics::CastRays");
+
+  SpatialIndex &index = this->world->SpatialIndex();
+  if (!index.Enabled())
+    return false;
+  if (_rays.empty())
+    return true;
+
+  // Each ray only tests the collisions whose box it crosses.
+  std::vector<std::vector<uint32_t>> rayIds(_rays.size());
+  std::vector<uint32_t> ids;
+  for (size_t i = 0; i < _rays.size(); ++i)
+  {
+    RayCast &ray = _rays[i];
+    ray.distance = ray.start.Distance(ray.end);
+    ray.retro = 0;
+    ray.collision.clear();
+    if (ray.distance > 0)
+    {
+      rayIds[i] = index.QueryRay(ray.start, ray.end);
+      ids.insert(ids.end(), rayIds[i].begin(), rayIds[i].end());
+    }
+  }
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+  // Copies of the collisions crossed by at least one ray, and the position
+  // of each id in targets, -1 for collisions that rays ignore.
+  std::vector<ODERayTarget> targets;
+  targets.reserve(ids.size());
+  std::unordered_map<uint32_t, int> targetIndex;
+  targetIndex.reserve(ids.size());
+
+  // Hits on geoms which are not copied, found while the mutex is held.
+  std::vector<int> complexHits(_rays.size(), -1);
+
+  {
+    boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+    // Geoms collided by ODE, by the index of their target.
+    std::unordered_map<int, dGeomID> complexGeoms;
+    for (auto const id : ids)
+    {
+      targetIndex[id] = -1;
+
+      ODECollisionPtr collision = boost::dynamic_pointer_cast<ODECollision>(
+          this->world->CollisionById(id));
+      if (!collision)
+        continue;
+
+      dGeomID geom = collision->GetCollisionId();
+      if (!geom || !dGeomIsEnabled(geom))
+        continue;
+
+      // Same filter as the collision of the ray space of a MultiRayShape
+      // with the space of the world.
+      if (!(dGeomGetCollideBits(geom) & GZ_SENSOR_COLLIDE) &&
+          !(dGeomGetCategoryBits(geom) & ~GZ_SENSOR_COLLIDE))
+      {
+        continue;
+      }
+
+      ODERayTarget target;
+      target.geomClass = dGeomGetClass(geom);
+      target.retro = collision->GetLaserRetro();
+      target.name = collision->GetScopedName();
+
+      dReal aabb[6];
+      dGeomGetAABB(geom, aabb);
+      target.min.Set(aabb[0], aabb[2], aabb[4]);
+      target.max.Set(aabb[1], aabb[3], aabb[5]);
+
+      if (target.geomClass == dPlaneClass)
+      {
+        dVector4 plane;
+        dGeomPlaneGetParams(geom, plane);
+        target.size.Set(plane[0], plane[1], plane[2]);
+        target.offset = plane[3];
+      }
+      else if (target.geomClass != dBoxClass &&
+               target.geomClass != dSphereClass &&
+               target.geomClass != dCylinderClass &&
+               target.geomClass != dCapsuleClass)
+      {
+        target.complex = true;
+        complexGeoms[static_cast<int>(targets.size())] = geom;
+      }
+      else
+      {
+        const dReal *pos = dGeomGetPosition(geom);
+        const dReal *rot = dGeomGetRotation(geom);
+        target.pos.Set(pos[0], pos[1], pos[2]);
+        target.rot.Set(rot[0], rot[1], rot[2],
+                       rot[4], rot[5], rot[6],
+                       rot[8], rot[9], rot[10]);
+
+        if (target.geomClass == dBoxClass)
+        {
+          dVector3 lengths;
+          dGeomBoxGetLengths(geom, lengths);
+          target.size.Set(
+              lengths[0] * 0.5, lengths[1] * 0.5, lengths[2] * 0.5);
+        }
+        else if (target.geomClass == dSphereClass)
+        {
+          target.size.X(dGeomSphereGetRadius(geom));
+        }
+        else
+        {
+          dReal radius, length;
+          if (target.geomClass == dCylinderClass)
+            dGeomCylinderGetParams(geom, &radius, &length);
+          else
+            dGeomCapsuleGetParams(geom, &radius, &length);
+          target.size.Set(radius, 0, length);
+        }
+      }
+
+      targetIndex[id] = static_cast<int>(targets.size());
+      targets.push_back(std::move(target));
+    }
+
+    // Meshes, heightmaps and other geoms are collided by ODE.
+    if (!complexGeoms.empty())
+    {
+      dAllocateODEDataForThread(dAllocateMaskAll);
+      dGeomID rayGeom = dCreateRay(0, 1.0);
+      dGeomRaySetParams(rayGeom, 0, 0);
+      dGeomRaySetClosestHit(rayGeom, 1);
+
+      for (size_t i = 0; i < _rays.size(); ++i)
+      {
+        RayCast &ray = _rays[i];
+        if (ray.distance <= 0)
+          continue;
+        const ignition::math::Vector3d dir =
+          (ray.end - ray.start) / ray.distance;
+        double closest = ray.distance;
+
+        for (auto const id : rayIds[i])
+        {
+          const int j = targetIndex[id];
+          if (j < 0 || !targets[j].complex ||
+              !RayHitsBox(ray.start, dir, closest, targets[j].min,
+                targets[j].max))
+          {
+            continue;
+          }
+
+          dGeomRaySet(rayGeom, ray.start.X(), ray.start.Y(), ray.start.Z(),
+              dir.X(), dir.Y(), dir.Z());
+          dGeomRaySetLength(rayGeom, closest);
+          dContactGeom contact;
+          if (dCollide(rayGeom, complexGeoms[j], 1, &contact,
+                sizeof(contact)) > 0 && contact.depth < closest)
+          {
+            closest = contact.depth;
+            complexHits[i] = j;
+          }
+        }
+
+        if (complexHits[i] >= 0)
+          ray.distance = closest;
+      }
+      dGeomDestroy(rayGeom);
+    }
+  }
+
+  // Cast the rays against the copies.
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, _rays.size(), 64),
+      [&](const tbb::blocked_range<size_t> &_r)
+  {
+    for (size_t i = _r.begin(); i != _r.end(); ++i)
+    {
+      RayCast &ray = _rays[i];
+      if (ray.distance <= 0)
+        continue;
+      const double length = ray.start.Distance(ray.end);
+      const ignition::math::Vector3d dir = (ray.end - ray.start) / length;
+
+      const ODERayTarget *hit = complexHits[i] >= 0 ?
+        &targets[complexHits[i]] : nullptr;
+      for (auto const id : rayIds[i])
+      {
+        // targetIndex is not modified anymore, find is thread safe.
+        const int j = targetIndex.find(id)->second;
+        if (j < 0 || targets[j].complex)
+          continue;
+
+        const ODERayTarget &target = targets[j];
+        if (!RayHitsBox(ray.start, dir, ray.distance, target.min, target.max))
+          continue;
+
+        const double t = RayTargetDistance(target, ray.start, dir,
+            ray.distance);
+        if (t >= 0 && (t < ray.distance || !hit))
+        {
+          ray.distance = t;
+          hit = &target;
+        }
+      }
+
+      if (hit)
+      {
+        ray.retro = hit->retro;
+        ray.collision = hit->name;
+      }
+    }
+  });
+
+  return true;
+}
+
 //////////////////////////////////////////////////
 unsigned int ODEPhysics::GetMaxContacts()
 {
@@ -1012,11 +1508,27 @@ void ODEPhysics::CollisionCallback(void *_data, dGeomID _o1, dGeomID _o2)
 //////////////////////////////////////////////////
 void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
                          dContactGeom *_contactCollisions)
+{
+  unsigned int numc = this->NarrowPhase(_collision1, _collision2,
+      _contactCollisions, this->dataPtr->indices);
+
+  // Return if no contacts.
+  if (numc == 0)
+    return;
+
+  this->AddContactJoints(_collision1, _collision2, _contactCollisions,
+      this->dataPtr->indices, numc);
+}
+
+//////////////////////////////////////////////////
+unsigned int ODEPhysics::NarrowPhase(ODECollision *_collision1,
+    ODECollision *_collision2, dContactGeom *_contactCollisions,
+    int *_indices)
 {
   // Filter collisions based on collide bitmask.
   if ((_collision1->GetSurface()->collideBitmask &
         _collision2->GetSurface()->collideBitmask) == 0)
-    return;
+    return 0;
 
   // Filter collisions based on contact bitmask if collide_without_contact is
   // on.The bitmask is set mainly for speed improvements otherwise a collision
@@ -1028,26 +1540,13 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     if ((_collision1->GetSurface()->collideWithoutContactBitmask &
          _collision2->GetSurface()->collideWithoutContactBitmask) == 0)
     {
-      return;
+      return 0;
     }
   }
 
-  /*
-  if (_collision1->GetCollisionId() && _collision2->GetCollisionId())
-  {
-    const dVector3 *pos1 =
-      (const dVector3*)dGeomGetPosition(_collision1->GetCollisionId());
-    const dVector3 *pos2 =
-      (const dVector3*)dGeomGetPosition(_collision2->GetCollisionId());
-    std::cout << "1[" << (*pos1)[0]<< " " << (*pos1)[1] << " "
-              << (*pos1)[2] << "] "
-      << "2[" << (*pos2)[0]<< " " << (*pos2)[1] << " " << (*pos2)[2] << "]\n";
-  }*/
-
   unsigned int numc = 0;
-  dContact contact;
 
-  // maxCollide must less than the size of this->dataPtr->indices
+  // maxCollide must less than the size of _indices
   // Check the header
   unsigned int maxCollide = MAX_CONTACT_JOINTS;
 
@@ -1068,11 +1567,11 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
 
   // Return if no contacts.
   if (numc == 0)
-    return;
+    return 0;
 
   // Store the indices of the contacts.
   for (int i = 0; i < MAX_CONTACT_JOINTS; i++)
-    this->dataPtr->indices[i] = i;
+    _indices[i] = i;
 
   // Choose only the best contacts if too many were generated.
   if (maxCollide > 0 && numc > maxCollide)
@@ -1083,7 +1582,7 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
       if (_contactCollisions[i].depth > max)
       {
         max = _contactCollisions[i].depth;
-        this->dataPtr->indices[maxCollide-1] = i;
+        _indices[maxCollide-1] = i;
       }
     }
 
@@ -1091,6 +1590,17 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     numc = maxCollide;
   }
 
+  return numc;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::AddContactJoints(ODECollision *_collision1,
+    ODECollision *_collision2, const dContactGeom *_contactCollisions,
+    const int *_indices, const unsigned int _numc)
+{
+  const unsigned int numc = _numc;
+  dContact contact;
+
   // Set the contact surface parameter flags.
   contact.surface.mode = dContactBounce |
                          dContactMu2 |
@@ -1290,7 +1800,7 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   // Create a joint for each contact
   for (unsigned int j = 0; j < numc; ++j)
   {
-    contact.geom = _contactCollisions[this->dataPtr->indices[j]];
+    contact.geom = _contactCollisions[_indices[j]];
 
     // Create the contact joint. This introduces the contact constraint to
     // ODE
@@ -1302,19 +1812,19 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     {
       // Store the contact depth
       contactFeedback->depths[j] =
-        _contactCollisions[this->dataPtr->indices[j]].depth;
+        _contactCollisions[_indices[j]].depth;
 
       // Store the contact position
       contactFeedback->positions[j].Set(
-          _contactCollisions[this->dataPtr->indices[j]].pos[0],
-          _contactCollisions[this->dataPtr->indices[j]].pos[1],
-          _contactCollisions[this->dataPtr->indices[j]].pos[2]);
+          _contactCollisions[_indices[j]].pos[0],
+          _contactCollisions[_indices[j]].pos[1],
+          _contactCollisions[_indices[j]].pos[2]);
 
       // Store the contact normal
       contactFeedback->normals[j].Set(
-          _contactCollisions[this->dataPtr->indices[j]].normal[0],
-          _contactCollisions[this->dataPtr->indices[j]].normal[1],
-          _contactCollisions[this->dataPtr->indices[j]].normal[2]);
+          _contactCollisions[_indices[j]].normal[0],
+          _contactCollisions[_indices[j]].normal[1],
+          _contactCollisions[_indices[j]].normal[2]);
 
       // Set the joint feedback.
       dJointSetFeedback(contactJoint, &(jointFeedback->feedbacks[j]));
@@ -1331,6 +1841,200 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   }
 }
 
+/////////////////////////////////////////////////
+void ODEPhysics::CollideParallel()
+{
+  auto &colliders = this->dataPtr->colliders;
+  auto &trimeshColliders = this->dataPtr->trimeshColliders;
+  const unsigned int collidersCount = this->dataPtr->collidersCount;
+  const unsigned int trimeshCount = this->dataPtr->trimeshCollidersCount;
+
+  // Contacts kept during the previous step are no longer needed.
+  for (auto &scratch : this->dataPtr->collideScratch)
+    scratch.contacts.clear();
+
+  this->dataPtr->colliderResults.assign(collidersCount, ODECollideResult());
+  this->dataPtr->trimeshColliderResults.assign(trimeshCount,
+      ODECollideResult());
+
+  // Collide one pair with the scratch buffers of the calling thread, and
+  // record where its contacts are stored.
+  auto narrowPhase = [this](ODECollision *_collision1,
+      ODECollision *_collision2, ODECollideResult &_result)
+  {
+    // ODE requires per-thread data for collision detection. This is a
+    // no-op if the thread already has it.
+    dAllocateODEDataForThread(dAllocateMaskAll);
+
+    ODECollideScratch &scratch = this->dataPtr->collideScratch.local();
+    unsigned int numc = this->NarrowPhase(_collision1, _collision2,
+        scratch.contactCollisions, scratch.indices);
+
+    _result.scratch = &scratch;
+    _result.offset = scratch.contacts.size();
+    _result.count = numc;
+    for (unsigned int j = 0; j < numc; ++j)
+      scratch.contacts.push_back(scratch.contactCollisions[scratch.indices[j]]);
+  };
+
+  // Trimesh colliders keep per-geom temporal coherence data, and heightmap
+  // colliders write to per-geom scratch buffers during dCollide, so pairs
+  // that share such a collision object are grouped and collided in order by
+  // a single thread. Heightmap pairs are normal colliders, so the colliders
+  // of a group come first, as in the sequential narrow-phase.
+  auto isSerial = [](const ODECollision *_collision)
+  {
+    return _collision->HasType(Base::MESH_SHAPE) ||
+      _collision->HasType(Base::HEIGHTMAP_SHAPE);
+  };
+
+  auto &serialColliders = this->dataPtr->serialColliders;
+  serialColliders.assign(collidersCount, 0);
+  std::vector<unsigned int> serialPairs;
+  for (unsigned int i = 0; i < collidersCount; ++i)
+  {
+    if (isSerial(colliders[i].first) || isSerial(colliders[i].second))
+    {
+      serialColliders[i] = 1;
+      serialPairs.push_back(i);
+    }
+  }
+  for (unsigned int i = 0; i < trimeshCount; ++i)
+    serialPairs.push_back(collidersCount + i);
+
+  auto serialPair = [&](const unsigned int _index)
+  {
+    return _index < collidersCount ? colliders[_index] :
+        trimeshColliders[_index - collidersCount];
+  };
+
+  auto &groups = this->dataPtr->serialGroups;
+  groups.clear();
+  if (!serialPairs.empty())
+  {
+    std::unordered_map<ODECollision *, unsigned int> ids;
+    std::vector<unsigned int> parents;
+    auto find = [&parents](unsigned int _i)
+    {
+      while (parents[_i] != _i)
+      {
+        parents[_i] = parents[parents[_i]];
+        _i = parents[_i];
+      }
+      return _i;
+    };
+    auto id = [&ids, &parents](ODECollision *_collision)
+    {
+      auto iter = ids.find(_collision);
+      if (iter != ids.end())
+        return iter->second;
+      unsigned int newId = parents.size();
+      parents.push_back(newId);
+      ids[_collision] = newId;
+      return newId;
+    };
+
+    std::vector<unsigned int> pairIds(serialPairs.size());
+    for (unsigned int i = 0; i < serialPairs.size(); ++i)
+    {
+      const auto p = serialPair(serialPairs[i]);
+      unsigned int a = find(id(p.first));
+      unsigned int b = find(id(p.second));
+      if (a != b)
+        parents[std::max(a, b)] = std::min(a, b);
+      pairIds[i] = id(p.first);
+    }
+
+    // Pairs are appended in broad-phase order, so each group preserves the
+    // sequential collision order.
+    std::unordered_map<unsigned int, unsigned int> groupIndex;
+    for (unsigned int i = 0; i < serialPairs.size(); ++i)
+    {
+      unsigned int root = find(pairIds[i]);
+      auto iter = groupIndex.find(root);
+      if (iter == groupIndex.end())
+      {
+        iter = groupIndex.emplace(root, groups.size()).first;
+        groups.emplace_back();
+      }
+      groups[iter->second].push_back(serialPairs[i]);
+    }
+
+    // Without thread local trimesh caches, all trimesh pairs must be
+    // collided by a single thread.
+    if (trimeshCount > 0 && !this->dataPtr->mtTrimeshCollisions &&
+        groups.size() > 1)
+    {
+      groups.clear();
+      groups.push_back(serialPairs);
+    }
+  }
+
+  this->dataPtr->collisionArena->execute([&]()
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, collidersCount),
+        [&](const tbb::blocked_range<size_t> &_r)
+    {
+      for (size_t i = _r.begin(); i != _r.end(); ++i)
+      {
+        if (serialColliders[i])
+          continue;
+        narrowPhase(colliders[i].first, colliders[i].second,
+            this->dataPtr->colliderResults[i]);
+      }
+    });
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, groups.size()),
+        [&](const tbb::blocked_range<size_t> &_r)
+    {
+      for (size_t g = _r.begin(); g != _r.end(); ++g)
+      {
+        for (auto const i : groups[g])
+        {
+          if (i < collidersCount)
+          {
+            narrowPhase(colliders[i].first, colliders[i].second,
+                this->dataPtr->colliderResults[i]);
+          }
+          else
+          {
+            const unsigned int t = i - collidersCount;
+            narrowPhase(trimeshColliders[t].first,
+                trimeshColliders[t].second,
+                this->dataPtr->trimeshColliderResults[t]);
+          }
+        }
+      }
+    });
+  });
+
+  // Deterministic merge: create contact joints in the same order as the
+  // sequential narrow-phase, regardless of the number of threads.
+  int indices[MAX_CONTACT_JOINTS];
+  std::iota(indices, indices + MAX_CONTACT_JOINTS, 0);
+
+  for (unsigned int i = 0; i < collidersCount; ++i)
+  {
+    const ODECollideResult &result = this->dataPtr->colliderResults[i];
+    if (result.count == 0)
+      continue;
+    this->AddContactJoints(colliders[i].first, colliders[i].second,
+        result.scratch->contacts.data() + result.offset, indices,
+        result.count);
+  }
+
+  for (unsigned int i = 0; i < trimeshCount; ++i)
+  {
+    const ODECollideResult &result = this->dataPtr->trimeshColliderResults[i];
+    if (result.count == 0)
+      continue;
+    this->AddContactJoints(trimeshColliders[i].first,
+        trimeshColliders[i].second,
+        result.scratch->contacts.data() + result.offset, indices,
+        result.count);
+  }
+}
+
 /////////////////////////////////////////////////
 void ODEPhysics::AddTrimeshCollider(ODECollision *_collision1,
                                     ODECollision *_collision2)
@@ -1417,6 +2121,55 @@ void ODEPhysics::SetSeed(uint32_t _seed)
   dRandSetSeed(_seed);
 }
 
+/////////////////////////////////////////////////
+void ODEPhysics::SaveSolverState(std::string &_state) const
+{
+  // The state of the random generator, which shuffles the constraint rows,
+  // followed by the constraint forces of the joints used for warm starting.
+  // Contact joints are recreated at every step and carry no such data.
+  const unsigned long seed = dRandGetSeed();
+  std::vector<dReal> warmStart(
+      dWorldGetWarmStartSize(this->dataPtr->worldId));
+  if (!warmStart.empty())
+    dWorldGetWarmStart(this->dataPtr->worldId, warmStart.data());
+
+  _state.resize(sizeof(seed) + warmStart.size() * sizeof(dReal));
+  memcpy(&_state[0], &seed, sizeof(seed));
+  if (!warmStart.empty())
+  {
+    memcpy(&_state[sizeof(seed)], warmStart.data(),
+        warmStart.size() * sizeof(dReal));
+  }
+}
+
+/////////////////////////////////////////////////
+bool ODEPhysics::RestoreSolverState(const std::string &_state)
+{
+  unsigned long seed;
+  if (_state.size() < sizeof(seed) ||
+      (_state.size() - sizeof(seed)) % sizeof(dReal) != 0)
+  {
+    return false;
+  }
+
+  std::vector<dReal> warmStart((_state.size() - sizeof(seed)) / sizeof(dReal));
+  if (!warmStart.empty())
+  {
+    memcpy(warmStart.data(), &_state[sizeof(seed)],
+        warmStart.size() * sizeof(dReal));
+  }
+
+  if (!dWorldSetWarmStart(this->dataPtr->worldId, warmStart.data(),
+        static_cast<int>(warmStart.size())))
+  {
+    return false;
+  }
+
+  memcpy(&seed, &_state[0], sizeof(seed));
+  dRandSetSeed(seed);
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool ODEPhysics::SetParam(const std::string &_key, const boost::any &_value)
 {
@@ -1553,7 +2306,12 @@ bool ODEPhysics::SetParam(const std::string &_key, const boost::any &_value)
         gzerr << "boost any_cast error:" << e.what() << "\n";
         return false;
       }
-      dWorldSetIslandThreads(this->dataPtr->worldId, value);
+      this->SetIslandThreads(static_cast<unsigned int>(std::max(value, 0)));
+    }
+    else if (_key == "collision_threads")
+    {
+      int value = any_cast<int>(_value);
+      this->SetCollisionThreads(static_cast<unsigned int>(std::max(value, 0)));
     }
     else if (_key == "ode_quiet")
     {
@@ -1661,7 +2419,9 @@ bool ODEPhysics::GetParam(const std::string &_key, boost::any &_value) const
   else if (_key == "friction_model")
     _value = this->GetFrictionModel();
   else if (_key == "island_threads")
-    _value = dWorldGetIslandThreads(this->dataPtr->worldId);
+    _value = static_cast<int>(this->IslandThreads());
+  else if (_key == "collision_threads")
+    _value = static_cast<int>(this->CollisionThreads());
   else if (_key == "ode_quiet")
     _value = dGetMessageHandler() != 0;
   else if (_key == "world_step_solver")
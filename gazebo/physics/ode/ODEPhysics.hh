@@ -21,6 +21,7 @@
 #include <tbb/concurrent_vector.h>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <boost/thread/thread.hpp>
 
@@ -135,6 +136,16 @@ namespace gazebo
       public: virtual ShapePtr CreateShape(const std::string &_shapeType,
                                            CollisionPtr _collision);
 
+      /// \brief Cast a batch of rays. Boxes, spheres, cylinders, capsules
+      /// and planes near the rays are copied under the physics update
+      /// mutex, and the rays are cast against the copies in parallel
+      /// after the mutex is released. Other geoms, e.g. meshes and
+      /// heightmaps, are collided with ODE while the mutex is held.
+      /// Requires the spatial index of the world, see World::SpatialIndex.
+      /// \param[in,out] _rays Rays to cast.
+      /// \return False if the spatial index is disabled.
+      public: virtual bool CastRays(std::vector<RayCast> &_rays);
+
       // Documentation inherited
       public: virtual JointPtr CreateJoint(const std::string &_type,
                                            ModelPtr _parent);
@@ -213,6 +224,12 @@ namespace gazebo
       // Documentation inherited
       public: virtual void SetSeed(uint32_t _seed);
 
+      // Documentation inherited
+      public: virtual void SaveSolverState(std::string &_state) const;
+
+      // Documentation inherited
+      public: virtual bool RestoreSolverState(const std::string &_state);
+
       /// Documentation inherited
       public: virtual bool SetParam(const std::string &_key,
                   const boost::any &_value);
@@ -287,6 +304,37 @@ namespace gazebo
       public: void Collide(ODECollision *_collision1, ODECollision *_collision2,
                            dContactGeom *_contactCollisions);
 
+      /// \brief Set the number of threads used to run the narrow-phase
+      /// (dCollide) of the collision pairs found by the broad-phase.
+      /// With 0 or 1 thread, pairs are collided sequentially. With more
+      /// threads, pairs are collided concurrently with per-thread contact
+      /// buffers, then contact joints are created sequentially in broad-phase
+      /// order, so results do not depend on the number of threads.
+      /// The value can also be set with the `<gz:collision_threads>` element
+      /// inside `<physics>` or SetParam("collision_threads").
+      /// \param[in] _threads Number of threads.
+      public: void SetCollisionThreads(const unsigned int _threads);
+
+      /// \brief Get the number of threads used by the narrow-phase.
+      /// \return Number of threads, 0 or 1 if the narrow-phase is sequential.
+      public: unsigned int CollisionThreads() const;
+
+      /// \brief Set the number of threads used to step the islands of the
+      /// world. An island is a set of bodies connected by joints or
+      /// contacts, e.g. one robot, and islands are independent of each
+      /// other. With 0 threads, islands are stepped sequentially. With more
+      /// threads, islands are stepped concurrently. Each island only writes
+      /// to its own bodies and joints, so results do not depend on the
+      /// number of threads. The value can also be set with the
+      /// `<island_threads>` element of the ODE solver or
+      /// SetParam("island_threads").
+      /// \param[in] _threads Number of threads.
+      public: void SetIslandThreads(const unsigned int _threads);
+
+      /// \brief Get the number of threads used to step the islands.
+      /// \return Number of threads, 0 if islands are stepped sequentially.
+      public: unsigned int IslandThreads() const;
+
       /// \brief process joint feedbacks.
       /// \param[in] _feedback ODE Joint Contact feedback information.
       public: void ProcessJointFeedback(ODEJointFeedback *_feedback);
@@ -315,6 +363,37 @@ namespace gazebo
       private: void AddCollider(ODECollision *_collision1,
                                 ODECollision *_collision2);
 
+      /// \brief Run dCollide on two collision objects and select the
+      /// contacts to keep. This does not modify the ODE world and is safe to
+      /// call concurrently for pairs that do not share a trimesh.
+      /// \param[in] _collision1 First collision object.
+      /// \param[in] _collision2 Second collision object.
+      /// \param[out] _contactCollisions Array of MAX_COLLIDE_RETURNS contacts.
+      /// \param[out] _indices Array of MAX_CONTACT_JOINTS indices of the
+      /// contacts to keep in _contactCollisions.
+      /// \return Number of contacts to keep.
+      private: unsigned int NarrowPhase(ODECollision *_collision1,
+                                        ODECollision *_collision2,
+                                        dContactGeom *_contactCollisions,
+                                        int *_indices);
+
+      /// \brief Create contact joints between two collision objects.
+      /// \param[in] _collision1 First collision object.
+      /// \param[in] _collision2 Second collision object.
+      /// \param[in] _contactCollisions Array of contacts.
+      /// \param[in] _indices Indices of the contacts to use.
+      /// \param[in] _numc Number of contacts to use.
+      private: void AddContactJoints(ODECollision *_collision1,
+                                     ODECollision *_collision2,
+                                     const dContactGeom *_contactCollisions,
+                                     const int *_indices,
+                                     const unsigned int _numc);
+
+      /// \brief Parallel version of the narrow-phase. Collides all the
+      /// colliders and trimesh colliders, then creates contact joints in the
+      /// same order as the sequential version.
+      private: void CollideParallel();
+
       /// \internal
       /// \brief Private data pointer.
       private: ODEPhysicsPrivate *dataPtr;
@@ -19,10 +19,14 @@
 #define _ODEPHYSICS_PRIVATE_HH_
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 #include <utility>
 
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/task_arena.h>
+
 #include "gazebo/physics/Contact.hh"
 #include "gazebo/physics/ode/ODETypes.hh"
 
@@ -45,6 +49,33 @@ namespace gazebo
       public: dJointFeedback feedbacks[MAX_CONTACT_JOINTS];
     };
 
+    /// \brief Per-thread scratch buffers used by the parallel narrow-phase.
+    class ODECollideScratch
+    {
+      /// \brief Raw contacts returned by dCollide.
+      public: dContactGeom contactCollisions[MAX_COLLIDE_RETURNS];
+
+      /// \brief Indices of the contacts kept in contactCollisions.
+      public: int indices[MAX_CONTACT_JOINTS];
+
+      /// \brief Contacts kept by this thread during the current step.
+      /// Contacts of one collision pair are stored contiguously.
+      public: std::vector<dContactGeom> contacts;
+    };
+
+    /// \brief Narrow-phase result of one collision pair.
+    class ODECollideResult
+    {
+      /// \brief Scratch buffer holding the contacts, nullptr if none.
+      public: ODECollideScratch *scratch = nullptr;
+
+      /// \brief Offset of the first contact in scratch->contacts.
+      public: size_t offset = 0;
+
+      /// \brief Number of contacts.
+      public: unsigned int count = 0;
+    };
+
     class ODEPhysicsPrivate
     {
       /// \brief Top-level world for all bodies
@@ -92,6 +123,39 @@ namespace gazebo
 
       /// \brief Maximum number of contact points per collision pair.
       public: unsigned int maxContacts;
+
+      /// \brief Number of threads used by the narrow-phase. Values of 0 and
+      /// 1 collide all pairs sequentially in the physics thread.
+      public: unsigned int collisionThreads = 0;
+
+      /// \brief Task arena used by the parallel narrow-phase.
+      public: std::unique_ptr<tbb::task_arena> collisionArena;
+
+      /// \brief Per-thread scratch buffers for the parallel narrow-phase.
+      public: tbb::enumerable_thread_specific<ODECollideScratch>
+              collideScratch;
+
+      /// \brief Narrow-phase results of the normal colliders, in the same
+      /// order as colliders.
+      public: std::vector<ODECollideResult> colliderResults;
+
+      /// \brief Narrow-phase results of the triangle mesh colliders, in the
+      /// same order as trimeshColliders.
+      public: std::vector<ODECollideResult> trimeshColliderResults;
+
+      /// \brief Groups of pairs that share a trimesh or heightmap collision
+      /// object. Each group is collided sequentially by one thread. An
+      /// index i below collidersCount is colliders[i], other indices are
+      /// trimeshColliders[i - collidersCount].
+      public: std::vector<std::vector<unsigned int>> serialGroups;
+
+      /// \brief Non-zero for the colliders which belong to a serial group,
+      /// in the same order as colliders.
+      public: std::vector<char> serialColliders;
+
+      /// \brief True if ODE keeps trimesh collision caches per thread, which
+      /// is required to collide trimesh pairs concurrently.
+      public: bool mtTrimeshCollisions = false;
     };
   }
 }
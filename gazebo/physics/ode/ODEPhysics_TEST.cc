@@ -17,6 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include "gazebo/physics/physics.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/ode/ODEPhysics.hh"
@@ -320,6 +325,28 @@ TEST_F(ODEPhysics_TEST, PhysicsParam)
     }
   }
 
+  // Test collision_threads
+  {
+    // collision_threads should be 0 by default
+    int collisionThreads = 1;
+    EXPECT_NO_THROW(collisionThreads =
+      boost::any_cast<int>(odePhysics->GetParam("collision_threads")));
+    EXPECT_EQ(collisionThreads, 0);
+
+    // try enabling threads, then disabling
+    std::vector<int> threads = {1, 2, 4, 0};
+    for (auto const collisionThreadsSet : threads)
+    {
+      EXPECT_TRUE(
+          odePhysics->SetParam("collision_threads", collisionThreadsSet));
+      EXPECT_NO_THROW(collisionThreads =
+        boost::any_cast<int>(odePhysics->GetParam("collision_threads")));
+      EXPECT_EQ(collisionThreads, collisionThreadsSet);
+      EXPECT_EQ(odePhysics->CollisionThreads(),
+          static_cast<unsigned int>(collisionThreadsSet));
+    }
+  }
+
   // Test ode_quiet
   // convenient for disabling LCP internal error messages from world solver
   {
@@ -490,6 +517,171 @@ TEST_F(ODEPhysics_TEST, PhysicsMsgParam)
   PhysicsMsgParam();
 }
 
+/////////////////////////////////////////////////
+/// Check that the parallel narrow-phase gives the same results as the
+/// sequential one.
+TEST_F(ODEPhysics_TEST, ParallelCollisionDeterminism)
+{
+  Load("worlds/stacks.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+      boost::static_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+
+  const unsigned int steps = 500;
+
+  // Record the pose of every link after a number of steps.
+  auto run = [&](const unsigned int _threads)
+  {
+    world->Reset();
+    odePhysics->SetCollisionThreads(_threads);
+    world->Step(steps);
+
+    std::map<std::string, ignition::math::Pose3d> poses;
+    for (auto const &model : world->Models())
+    {
+      for (auto const &link : model->GetLinks())
+        poses[link->GetScopedName()] = link->WorldPose();
+    }
+    return poses;
+  };
+
+  auto serial = run(0);
+  ASSERT_FALSE(serial.empty());
+
+  for (auto const threads : {2u, 4u})
+  {
+    auto parallel = run(threads);
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (auto const &pose : serial)
+    {
+      EXPECT_EQ(pose.second, parallel[pose.first])
+        << pose.first << " with " << threads << " threads";
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// Check that stepping islands in parallel gives the same results as
+/// stepping them sequentially.
+TEST_F(ODEPhysics_TEST, ParallelIslandDeterminism)
+{
+  Load("worlds/stacks.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+      boost::static_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+  EXPECT_EQ(odePhysics->IslandThreads(), 0u);
+
+  // The parameter and the accessor agree.
+  EXPECT_TRUE(odePhysics->SetParam("island_threads", 3));
+  EXPECT_EQ(odePhysics->IslandThreads(), 3u);
+  EXPECT_EQ(boost::any_cast<int>(odePhysics->GetParam("island_threads")), 3);
+
+  const unsigned int steps = 500;
+
+  // Record the pose of every link after a number of steps.
+  auto run = [&](const unsigned int _threads)
+  {
+    world->Reset();
+    odePhysics->SetIslandThreads(_threads);
+    EXPECT_EQ(odePhysics->IslandThreads(), _threads);
+    world->Step(steps);
+
+    std::map<std::string, ignition::math::Pose3d> poses;
+    for (auto const &model : world->Models())
+    {
+      for (auto const &link : model->GetLinks())
+        poses[link->GetScopedName()] = link->WorldPose();
+    }
+    return poses;
+  };
+
+  auto serial = run(0);
+  ASSERT_FALSE(serial.empty());
+
+  for (auto const threads : {2u, 4u})
+  {
+    auto parallel = run(threads);
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (auto const &pose : serial)
+    {
+      EXPECT_EQ(pose.second, parallel[pose.first])
+        << pose.first << " with " << threads << " threads";
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// Check that bodies resting on one heightmap give the same results with
+/// the parallel narrow-phase, where the heightmap pairs share scratch
+/// buffers and must be collided by one thread.
+TEST_F(ODEPhysics_TEST, ParallelCollisionHeightmap)
+{
+  Load("worlds/heightmap_no_visual.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+      boost::static_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+
+  // Several bodies on the same terrain
+  for (int i = 0; i < 8; ++i)
+  {
+    std::ostringstream name;
+    name << "sphere_" << i;
+    SpawnSphere(name.str(),
+        ignition::math::Vector3d((i % 4) * 3.0 - 4.5, (i / 4) * 3.0 - 1.5, 8),
+        ignition::math::Vector3d::Zero);
+  }
+
+  const unsigned int steps = 500;
+
+  // Record the pose of every link after a number of steps.
+  auto run = [&](const unsigned int _threads)
+  {
+    world->Reset();
+    odePhysics->SetCollisionThreads(_threads);
+    world->Step(steps);
+
+    std::map<std::string, ignition::math::Pose3d> poses;
+    for (auto const &model : world->Models())
+    {
+      for (auto const &link : model->GetLinks())
+        poses[link->GetScopedName()] = link->WorldPose();
+    }
+    return poses;
+  };
+
+  auto serial = run(0);
+  ASSERT_EQ(serial.size(), 9u);
+
+  // The spheres fell and did not go through the terrain.
+  for (int i = 0; i < 8; ++i)
+  {
+    std::ostringstream name;
+    name << "sphere_" << i << "::body";
+    EXPECT_LT(serial[name.str()].Pos().Z(), 8.0) << name.str();
+    EXPECT_GT(serial[name.str()].Pos().Z(), -0.5) << name.str();
+  }
+
+  for (auto const threads : {2u, 4u})
+  {
+    auto parallel = run(threads);
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (auto const &pose : serial)
+    {
+      EXPECT_EQ(pose.second, parallel[pose.first])
+        << pose.first << " with " << threads << " threads";
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
@@ -96,11 +96,11 @@ void SimbodyLink::Init()
   // Create the new rigid body
 
   // change link's gravity mode if requested by user
-  this->gravityModeConnection = event::Events::ConnectWorldUpdateBegin(
+  this->gravityModeConnection = this->world->ConnectUpdateBegin(
     boost::bind(&SimbodyLink::ProcessSetGravityMode, this));
 
   // lock or unlock the link if requested by user
-  this->staticLinkConnection = event::Events::ConnectWorldUpdateEnd(
+  this->staticLinkConnection = this->world->ConnectUpdateEnd(
     boost::bind(&SimbodyLink::ProcessSetLinkStatic, this));
 }
 
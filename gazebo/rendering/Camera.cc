@@ -186,6 +186,22 @@ void Camera::Load()
     this->dataPtr->distortion->Load(this->sdf->GetElement("distortion"));
   }
 
+  // How rendered images are copied to memory
+  if (this->sdf->HasElement("gz:readback"))
+  {
+    const std::string readback =
+      this->sdf->Get<std::string>("gz:readback");
+    ReadbackType mode;
+    if (ReadbackFromString(readback, mode))
+      this->SetReadbackMode(mode);
+    else
+    {
+      gzerr << "Unknown readback [" << readback << "] for camera ["
+            << this->Name() << "], expected sync, async or latent"
+            << std::endl;
+    }
+  }
+
   this->LoadCameraIntrinsics();
 }
 
@@ -363,6 +379,10 @@ void Camera::Fini()
 
   this->initialized = false;
 
+  for (auto &readback : this->dataPtr->readbacks)
+    readback.second->Fini();
+  this->dataPtr->readbacks.clear();
+
   this->dataPtr->cmdSub.reset();
   if (this->dataPtr->node)
     this->dataPtr->node->Fini();
@@ -557,6 +577,7 @@ void Camera::Render(const bool _force)
         this->dataPtr->renderPeriod))
   {
     this->newData = true;
+    this->dataPtr->renderSimTime = this->scene->SimTime();
     this->RenderImpl();
   }
 }
@@ -569,7 +590,53 @@ void Camera::RenderImpl()
     Events::cameraPreRender(this->Name());
     this->renderTarget->update();
     Events::cameraPostRender(this->Name());
+
+    if (this->renderTexture && this->newData && (this->captureData ||
+        this->captureDataOnce || this->dataPtr->videoEncoder.IsEncoding()))
+    {
+      this->QueueTexture(this->renderTexture, this->imageFormat);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+bool Camera::QueueTexture(Ogre::Texture *_texture, const int _format)
+{
+  if (this->dataPtr->readbackMode == READBACK_SYNC || !_texture)
+    return false;
+
+  auto &readback = this->dataPtr->readbacks[_texture];
+  if (!readback)
+    readback.reset(new PixelReadback());
+
+  return readback->Queue(_texture, _format, this->dataPtr->renderSimTime);
+}
+
+//////////////////////////////////////////////////
+Camera::ReadbackStatus Camera::ReadQueuedTexture(Ogre::Texture *_texture,
+    void *_data, const size_t _size)
+{
+  this->dataPtr->imageReady = true;
+
+  auto it = this->dataPtr->readbacks.find(_texture);
+  if (this->dataPtr->readbackMode != READBACK_SYNC &&
+      it != this->dataPtr->readbacks.end() && it->second->Pending() > 0)
+  {
+    // Keep one frame in flight
+    if (this->dataPtr->readbackMode == READBACK_LATENT &&
+        it->second->Pending() < 2)
+    {
+      this->dataPtr->imageReady = false;
+      return READBACK_DELAYED;
+    }
+
+    if (it->second->Read(_data, _size, this->dataPtr->imageSimTime))
+      return READBACK_COPIED;
   }
+
+  // The caller reads the frame which was just rendered
+  this->dataPtr->imageSimTime = this->dataPtr->renderSimTime;
+  return READBACK_NOT_QUEUED;
 }
 
 //////////////////////////////////////////////////
@@ -588,7 +655,25 @@ void Camera::ReadPixelBuffer()
 
     // Allocate buffer
     if (!this->saveFrameBuffer)
+    {
       this->saveFrameBuffer = new unsigned char[size];
+      memset(this->saveFrameBuffer, 128, size);
+    }
+
+    // Frames queued by RenderImpl are copied from pixel buffers
+    ReadbackStatus status = READBACK_NOT_QUEUED;
+    if (this->renderTexture)
+    {
+      status = this->ReadQueuedTexture(this->renderTexture,
+          this->saveFrameBuffer, size);
+    }
+    else
+    {
+      this->dataPtr->imageReady = true;
+      this->dataPtr->imageSimTime = this->dataPtr->renderSimTime;
+    }
+    if (status != READBACK_NOT_QUEUED)
+      return;
 
     memset(this->saveFrameBuffer, 128, size);
 
@@ -648,6 +733,48 @@ common::Time Camera::LastRenderWallTime() const
   return this->lastRenderWallTime;
 }
 
+//////////////////////////////////////////////////
+void Camera::SetReadbackMode(const ReadbackType _mode)
+{
+  this->dataPtr->readbackMode = _mode;
+  for (auto &readback : this->dataPtr->readbacks)
+    readback.second->Clear();
+}
+
+//////////////////////////////////////////////////
+Camera::ReadbackType Camera::ReadbackMode() const
+{
+  return this->dataPtr->readbackMode;
+}
+
+//////////////////////////////////////////////////
+bool Camera::ReadbackFromString(const std::string &_name,
+    ReadbackType &_mode)
+{
+  if (_name == "sync")
+    _mode = READBACK_SYNC;
+  else if (_name == "async")
+    _mode = READBACK_ASYNC;
+  else if (_name == "latent")
+    _mode = READBACK_LATENT;
+  else
+    return false;
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+common::Time Camera::ImageSimTime() const
+{
+  return this->dataPtr->imageSimTime;
+}
+
+//////////////////////////////////////////////////
+bool Camera::ImageReady() const
+{
+  return this->dataPtr->imageReady;
+}
+
 //////////////////////////////////////////////////
 void Camera::PostRender()
 {
@@ -658,7 +785,8 @@ void Camera::PostRender()
   if (this->newData)
     this->lastRenderWallTime = common::Time::GetWallTime();
 
-  if (this->newData && (this->captureData || this->captureDataOnce ||
+  if (this->newData && this->dataPtr->imageReady &&
+      (this->captureData || this->captureDataOnce ||
       this->dataPtr->videoEncoder.IsEncoding()))
   {
     unsigned int width = this->ImageWidth();
@@ -1417,6 +1545,13 @@ void Camera::ConvertRGBToBAYER(unsigned char *_dst,
 void Camera::SetCaptureData(const bool _value)
 {
   this->captureData = _value;
+
+  // Do not deliver frames queued before capture stopped
+  if (!_value)
+  {
+    for (auto &readback : this->dataPtr->readbacks)
+      readback.second->Clear();
+  }
 }
 
 //////////////////////////////////////////////////
@@ -91,6 +91,24 @@ namespace gazebo
       public: Camera(const std::string &_namePrefix, ScenePtr _scene,
                      bool _autoRender = true);
 
+      /// \brief Ways of copying rendered images from the GPU to memory.
+      public: enum ReadbackType
+      {
+        /// \brief Copy each frame in PostRender, waiting for the GPU.
+        READBACK_SYNC,
+
+        /// \brief Start the copy when the frame is rendered and finish it
+        /// in PostRender, so that it overlaps the rendering of other
+        /// cameras.
+        READBACK_ASYNC,
+
+        /// \brief Like READBACK_ASYNC, but PostRender delivers the frame
+        /// rendered before the current one, so that the copy also overlaps
+        /// the next frame of this camera. Images are one frame late, see
+        /// ImageSimTime.
+        READBACK_LATENT
+      };
+
       /// \brief Destructor
       public: virtual ~Camera();
 
@@ -624,6 +642,38 @@ namespace gazebo
       /// \return Time the camera was last rendered
       public: common::Time LastRenderWallTime() const;
 
+      /// \brief Set how rendered images are copied to memory. Asynchronous
+      /// modes need the OpenGL render system on Linux, and fall back to
+      /// READBACK_SYNC elsewhere. The mode can also be set with the
+      /// <gz:readback> element of the camera, one of "sync", "async" and
+      /// "latent".
+      /// \param[in] _mode Readback mode, READBACK_SYNC by default.
+      public: void SetReadbackMode(const ReadbackType _mode);
+
+      /// \brief Get how rendered images are copied to memory.
+      /// \return Readback mode.
+      public: ReadbackType ReadbackMode() const;
+
+      /// \brief Convert a readback name, one of "sync", "async" and
+      /// "latent", to a readback mode.
+      /// \param[in] _name Readback name.
+      /// \param[out] _mode Readback mode, unchanged if the name is unknown.
+      /// \return True if the name is known.
+      public: static bool ReadbackFromString(const std::string &_name,
+                                             ReadbackType &_mode);
+
+      /// \brief Get the sim time at which the image delivered by the last
+      /// call to PostRender was rendered. Sensors stamp their data with it,
+      /// since it is older than the current sim time with READBACK_LATENT.
+      /// \return Sim time of the image.
+      public: common::Time ImageSimTime() const;
+
+      /// \brief Get whether the last call to PostRender delivered an image.
+      /// With READBACK_LATENT, the first frame is only delivered with the
+      /// second one.
+      /// \return True if an image was delivered.
+      public: bool ImageReady() const;
+
       /// \brief Return true if the visual is within the camera's view
       /// frustum
       /// \param[in] _visual The visual to check for visibility
@@ -774,6 +824,37 @@ namespace gazebo
       /// \brief Read image data from pixel buffer
       protected: void ReadPixelBuffer();
 
+      /// \brief Outcome of Camera::ReadQueuedTexture.
+      protected: enum ReadbackStatus
+      {
+        /// \brief No copy was queued, read the texture synchronously.
+        READBACK_NOT_QUEUED,
+
+        /// \brief The oldest queued copy was stored in memory.
+        READBACK_COPIED,
+
+        /// \brief A copy is queued, but READBACK_LATENT delivers it with
+        /// the next frame.
+        READBACK_DELAYED
+      };
+
+      /// \brief Start copying a texture to memory, if the readback mode is
+      /// asynchronous. Called by RenderImpl once the texture is rendered.
+      /// \param[in] _texture Rendered texture.
+      /// \param[in] _format Ogre::PixelFormat of the copy.
+      /// \return True if the copy was queued.
+      protected: bool QueueTexture(Ogre::Texture *_texture, const int _format);
+
+      /// \brief Finish a copy started by QueueTexture. Called by PostRender,
+      /// which reads the texture itself if nothing was queued. Updates
+      /// ImageSimTime and ImageReady.
+      /// \param[in] _texture Texture passed to QueueTexture.
+      /// \param[out] _data Destination of the copy.
+      /// \param[in] _size Size of the destination, in bytes.
+      /// \return Outcome of the copy.
+      protected: ReadbackStatus ReadQueuedTexture(Ogre::Texture *_texture,
+                     void *_data, const size_t _size);
+
       /// \brief Implementation of the Camera::TrackVisual call
       /// \param[in] _visualName Name of the visual to track
       /// \return True if able to track the visual
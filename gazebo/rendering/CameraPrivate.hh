@@ -21,16 +21,22 @@
 #include <mutex>
 #include <utility>
 #include <list>
+#include <map>
+#include <memory>
 #include <ignition/math/Pose3.hh>
 
 #include "gazebo/common/PID.hh"
+#include "gazebo/common/Time.hh"
 #include "gazebo/common/VideoEncoder.hh"
 #include "gazebo/msgs/msgs.hh"
+#include "gazebo/rendering/Camera.hh"
+#include "gazebo/rendering/PixelReadback.hh"
 #include "gazebo/util/system.hh"
 
 namespace Ogre
 {
   class CompositorInstance;
+  class Texture;
 }
 
 namespace gazebo
@@ -117,6 +123,22 @@ namespace gazebo
 
       /// \brief Fixed axis to yaw around.
       public: ignition::math::Vector3d yawFixedAxis;
+
+      /// \brief How rendered images are copied to memory.
+      public: Camera::ReadbackType readbackMode = Camera::READBACK_SYNC;
+
+      /// \brief Asynchronous copies of the rendered textures.
+      public: std::map<Ogre::Texture *, std::unique_ptr<PixelReadback>>
+              readbacks;
+
+      /// \brief Sim time of the scene when the camera was last rendered.
+      public: common::Time renderSimTime;
+
+      /// \brief Sim time at which the last delivered image was rendered.
+      public: common::Time imageSimTime;
+
+      /// \brief True if the last call to PostRender delivered an image.
+      public: bool imageReady = true;
     };
   }
 }
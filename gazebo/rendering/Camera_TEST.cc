@@ -16,6 +16,10 @@
 */
 
 #include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
 #include "gazebo/rendering/Camera.hh"
 #include "gazebo/rendering/RenderingIface.hh"
 #include "gazebo/rendering/RenderTypes.hh"
@@ -184,6 +188,128 @@ TEST_F(Camera_TEST, Create)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(Camera_TEST, Readback)
+{
+  Load("worlds/shapes.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene("default");
+
+  if (!scene)
+    scene = gazebo::rendering::create_scene("default", false);
+  ASSERT_TRUE(scene != nullptr);
+
+  rendering::CameraPtr camera =
+      scene->CreateCamera("test_camera_readback", false);
+  ASSERT_TRUE(camera != nullptr);
+
+  std::stringstream ss;
+  ss << "<sdf version='" << SDF_VERSION << "'>"
+     << "  <camera>"
+     << "    <horizontal_fov>1.0</horizontal_fov>"
+     << "    <image>"
+     << "      <width>320</width>"
+     << "      <height>240</height>"
+     << "      <format>R8G8B8</format>"
+     << "    </image>"
+     << "    <clip>"
+     << "      <near>0.1</near><far>100</far>"
+     << "    </clip>"
+     << "  </camera>"
+     << "</sdf>";
+  sdf::ElementPtr cameraSDF(new sdf::Element);
+  sdf::initFile("camera.sdf", cameraSDF);
+  sdf::readString(ss.str(), cameraSDF);
+  camera->Load(cameraSDF);
+  camera->Init();
+  camera->CreateRenderTexture("test_camera_readback_RttTex");
+  camera->SetWorldPose(ignition::math::Pose3d(-5, 0, 0.5, 0, 0, 0));
+  camera->SetCaptureData(true);
+
+  const size_t size = camera->ImageMemorySize();
+  EXPECT_EQ(camera->ReadbackMode(), rendering::Camera::READBACK_SYNC);
+
+  // Synchronous reference image
+  camera->Render(true);
+  camera->PostRender();
+  EXPECT_TRUE(camera->ImageReady());
+  std::vector<unsigned char> reference(camera->ImageData(),
+      camera->ImageData() + size);
+
+  // Asynchronous readback delivers the same image, in the same frame
+  camera->SetReadbackMode(rendering::Camera::READBACK_ASYNC);
+  EXPECT_EQ(camera->ReadbackMode(), rendering::Camera::READBACK_ASYNC);
+  camera->Render(true);
+  camera->PostRender();
+  EXPECT_TRUE(camera->ImageReady());
+  EXPECT_EQ(camera->ImageSimTime(), scene->SimTime());
+  EXPECT_TRUE(std::equal(reference.begin(), reference.end(),
+        camera->ImageData()));
+
+  // Latent readback delivers the first frame with the second one
+  camera->SetReadbackMode(rendering::Camera::READBACK_LATENT);
+  camera->Render(true);
+  camera->PostRender();
+#if !defined(__APPLE__) && !defined(_WIN32)
+  EXPECT_FALSE(camera->ImageReady());
+#endif
+  camera->Render(true);
+  camera->PostRender();
+  EXPECT_TRUE(camera->ImageReady());
+  EXPECT_TRUE(std::equal(reference.begin(), reference.end(),
+        camera->ImageData()));
+
+  scene->RemoveCamera(camera->Name());
+}
+
+/////////////////////////////////////////////////
+TEST_F(Camera_TEST, ReadbackFromSdf)
+{
+  rendering::Camera::ReadbackType mode = rendering::Camera::READBACK_SYNC;
+  EXPECT_TRUE(rendering::Camera::ReadbackFromString("latent", mode));
+  EXPECT_EQ(mode, rendering::Camera::READBACK_LATENT);
+  EXPECT_TRUE(rendering::Camera::ReadbackFromString("async", mode));
+  EXPECT_EQ(mode, rendering::Camera::READBACK_ASYNC);
+  EXPECT_TRUE(rendering::Camera::ReadbackFromString("sync", mode));
+  EXPECT_EQ(mode, rendering::Camera::READBACK_SYNC);
+  EXPECT_FALSE(rendering::Camera::ReadbackFromString("pbo", mode));
+  EXPECT_EQ(mode, rendering::Camera::READBACK_SYNC);
+
+  Load("worlds/empty.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene("default");
+  if (!scene)
+    scene = gazebo::rendering::create_scene("default", false);
+  ASSERT_TRUE(scene != nullptr);
+
+  rendering::CameraPtr camera =
+      scene->CreateCamera("test_camera_readback_sdf", false);
+  ASSERT_TRUE(camera != nullptr);
+
+  std::stringstream ss;
+  ss << "<sdf version='" << SDF_VERSION << "'>"
+     << "  <camera>"
+     << "    <horizontal_fov>1.0</horizontal_fov>"
+     << "    <image>"
+     << "      <width>320</width>"
+     << "      <height>240</height>"
+     << "      <format>R8G8B8</format>"
+     << "    </image>"
+     << "    <clip>"
+     << "      <near>0.1</near><far>100</far>"
+     << "    </clip>"
+     << "    <gz:readback>latent</gz:readback>"
+     << "  </camera>"
+     << "</sdf>";
+  sdf::ElementPtr cameraSDF(new sdf::Element);
+  sdf::initFile("camera.sdf", cameraSDF);
+  sdf::readString(ss.str(), cameraSDF);
+  camera->Load(cameraSDF);
+  EXPECT_EQ(camera->ReadbackMode(), rendering::Camera::READBACK_LATENT);
+
+  scene->RemoveCamera(camera->Name());
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -421,15 +421,23 @@ void DepthCamera::PostRender()
       if (!this->dataPtr->depthBuffer)
         this->dataPtr->depthBuffer = new float[size];
 
-      Ogre::PixelBox dstBox(width, height,
-          1, Ogre::PF_FLOAT32_R, this->dataPtr->depthBuffer);
+      ReadbackStatus status = this->ReadQueuedTexture(this->depthTexture,
+          this->dataPtr->depthBuffer, size);
+      if (status == READBACK_NOT_QUEUED)
+      {
+        Ogre::PixelBox dstBox(width, height,
+            1, Ogre::PF_FLOAT32_R, this->dataPtr->depthBuffer);
 
-      pixelBuffer->lock(Ogre::HardwarePixelBuffer::HBL_NORMAL);
-      pixelBuffer->blitToMemory(dstBox);
-      pixelBuffer->unlock();  // FIXME: do we need to lock/unlock still?
+        pixelBuffer->lock(Ogre::HardwarePixelBuffer::HBL_NORMAL);
+        pixelBuffer->blitToMemory(dstBox);
+        pixelBuffer->unlock();  // FIXME: do we need to lock/unlock still?
+      }
 
-      this->dataPtr->newDepthFrame(
-          this->dataPtr->depthBuffer, width, height, 1, "FLOAT32");
+      if (status != READBACK_DELAYED)
+      {
+        this->dataPtr->newDepthFrame(
+            this->dataPtr->depthBuffer, width, height, 1, "FLOAT32");
+      }
     }
     else
     {
@@ -442,18 +450,27 @@ void DepthCamera::PostRender()
       if (!this->dataPtr->pcdBuffer)
         this->dataPtr->pcdBuffer = new float[width * height * 4];
 
-      memset(this->dataPtr->pcdBuffer, 0, width * height * 4);
+      ReadbackStatus status = this->ReadQueuedTexture(
+          this->dataPtr->pcdTexture, this->dataPtr->pcdBuffer,
+          width * height * 4 * sizeof(float));
+      if (status == READBACK_NOT_QUEUED)
+      {
+        memset(this->dataPtr->pcdBuffer, 0, width * height * 4);
 
-      Ogre::Box pcd_src_box(0, 0, width, height);
-      Ogre::PixelBox pcd_dst_box(width, height,
-          1, Ogre::PF_FLOAT32_RGBA, this->dataPtr->pcdBuffer);
+        Ogre::Box pcd_src_box(0, 0, width, height);
+        Ogre::PixelBox pcd_dst_box(width, height,
+            1, Ogre::PF_FLOAT32_RGBA, this->dataPtr->pcdBuffer);
 
-      pcdPixelBuffer->lock(Ogre::HardwarePixelBuffer::HBL_NORMAL);
-      pcdPixelBuffer->blitToMemory(pcd_src_box, pcd_dst_box);
-      pcdPixelBuffer->unlock();
+        pcdPixelBuffer->lock(Ogre::HardwarePixelBuffer::HBL_NORMAL);
+        pcdPixelBuffer->blitToMemory(pcd_src_box, pcd_dst_box);
+        pcdPixelBuffer->unlock();
+      }
 
-      this->dataPtr->newRGBPointCloud(
-          this->dataPtr->pcdBuffer, width, height, 1, "RGBPOINTS");
+      if (status != READBACK_DELAYED)
+      {
+        this->dataPtr->newRGBPointCloud(
+            this->dataPtr->pcdBuffer, width, height, 1, "RGBPOINTS");
+      }
     }
 
     if (this->dataPtr->outputReflectance)
@@ -466,19 +483,28 @@ void DepthCamera::PostRender()
      if (!this->dataPtr->reflectanceBuffer)
        this->dataPtr->reflectanceBuffer = new float[width * height * 1];
 
-     memset(this->dataPtr->reflectanceBuffer, 0, width * height * 1);
-
-     Ogre::Box reflectance_src_box(0, 0, width, height);
-     Ogre::PixelBox reflectance_dst_box(width, height,
-         1, Ogre::PF_FLOAT32_R, this->dataPtr->reflectanceBuffer);
-
-     reflectancePixelBuffer->lock(Ogre::HardwarePixelBuffer::HBL_NORMAL);
-     reflectancePixelBuffer->blitToMemory(reflectance_src_box,
-                                          reflectance_dst_box);
-     reflectancePixelBuffer->unlock();
-
-     this->dataPtr->newReflectanceFrame(
-         this->dataPtr->reflectanceBuffer, width, height, 1, "REFLECTANCE");
+     ReadbackStatus status = this->ReadQueuedTexture(
+         this->dataPtr->reflectanceTextures, this->dataPtr->reflectanceBuffer,
+         width * height * sizeof(float));
+     if (status == READBACK_NOT_QUEUED)
+     {
+       memset(this->dataPtr->reflectanceBuffer, 0, width * height * 1);
+
+       Ogre::Box reflectance_src_box(0, 0, width, height);
+       Ogre::PixelBox reflectance_dst_box(width, height,
+           1, Ogre::PF_FLOAT32_R, this->dataPtr->reflectanceBuffer);
+
+       reflectancePixelBuffer->lock(Ogre::HardwarePixelBuffer::HBL_NORMAL);
+       reflectancePixelBuffer->blitToMemory(reflectance_src_box,
+                                            reflectance_dst_box);
+       reflectancePixelBuffer->unlock();
+     }
+
+     if (status != READBACK_DELAYED)
+     {
+       this->dataPtr->newReflectanceFrame(
+           this->dataPtr->reflectanceBuffer, width, height, 1, "REFLECTANCE");
+     }
     }
 
     if (this->dataPtr->outputNormals)
@@ -491,18 +517,27 @@ void DepthCamera::PostRender()
       if (!this->dataPtr->normalsBuffer)
         this->dataPtr->normalsBuffer = new float[width * height * 4];
 
-      memset(this->dataPtr->normalsBuffer, 0, width * height * 4);
+      ReadbackStatus status = this->ReadQueuedTexture(
+          this->dataPtr->normalsTextures, this->dataPtr->normalsBuffer,
+          width * height * 4 * sizeof(float));
+      if (status == READBACK_NOT_QUEUED)
+      {
+        memset(this->dataPtr->normalsBuffer, 0, width * height * 4);
 
-      Ogre::Box normals_src_box(0, 0, width, height);
-      Ogre::PixelBox normals_dst_box(width, height,
-          1, Ogre::PF_FLOAT32_RGBA, this->dataPtr->normalsBuffer);
+        Ogre::Box normals_src_box(0, 0, width, height);
+        Ogre::PixelBox normals_dst_box(width, height,
+            1, Ogre::PF_FLOAT32_RGBA, this->dataPtr->normalsBuffer);
 
-      normalsPixelBuffer->lock(Ogre::HardwarePixelBuffer::HBL_NORMAL);
-      normalsPixelBuffer->blitToMemory(normals_src_box, normals_dst_box);
-      normalsPixelBuffer->unlock();
+        normalsPixelBuffer->lock(Ogre::HardwarePixelBuffer::HBL_NORMAL);
+        normalsPixelBuffer->blitToMemory(normals_src_box, normals_dst_box);
+        normalsPixelBuffer->unlock();
+      }
 
-      this->dataPtr->newNormalsPointCloud(
-          this->dataPtr->normalsBuffer, width, height, 1, "NORMALS");
+      if (status != READBACK_DELAYED)
+      {
+        this->dataPtr->newNormalsPointCloud(
+            this->dataPtr->normalsBuffer, width, height, 1, "NORMALS");
+      }
     }
   }
   // also new image frame for camera texture
@@ -613,6 +648,11 @@ void DepthCamera::RenderImpl()
   // Does actual rendering
   this->depthTarget->update(false);
 
+  // Start copying the data read by PostRender
+  const bool capture = this->newData && this->captureData;
+  if (capture && !this->dataPtr->outputPoints)
+    this->QueueTexture(this->depthTexture, Ogre::PF_FLOAT32_R);
+
   sceneMgr->_suppressRenderStateChanges(false);
   sceneMgr->setShadowTechnique(shadowTech);
 
@@ -628,6 +668,8 @@ void DepthCamera::RenderImpl()
                   this->dataPtr->pcdMaterial, "Gazebo/XYZPoints");
 
     this->dataPtr->pcdTarget->update(false);
+    if (capture)
+      this->QueueTexture(this->dataPtr->pcdTexture, Ogre::PF_FLOAT32_RGBA);
 
     sceneMgr->_suppressRenderStateChanges(false);
     sceneMgr->setShadowTechnique(shadowTech);
@@ -636,6 +678,11 @@ void DepthCamera::RenderImpl()
   if (this->dataPtr->outputReflectance)
   {
     this->dataPtr->reflectanceTarget->update(false);
+    if (capture)
+    {
+      this->QueueTexture(this->dataPtr->reflectanceTextures,
+          Ogre::PF_FLOAT32_R);
+    }
   }
 
   if (this->dataPtr->outputNormals)
@@ -647,6 +694,11 @@ void DepthCamera::RenderImpl()
                   this->dataPtr->normalsMaterial, "Gazebo/XYZNormals");
 
     this->dataPtr->normalsTarget->update(false);
+    if (capture)
+    {
+      this->QueueTexture(this->dataPtr->normalsTextures,
+          Ogre::PF_FLOAT32_RGBA);
+    }
 
     sceneMgr->_suppressRenderStateChanges(false);
     sceneMgr->setShadowTechnique(shadowTech);
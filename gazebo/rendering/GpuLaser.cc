@@ -250,12 +250,23 @@ void GpuLaser::PostRender()
     if (!this->dataPtr->laserBuffer)
       this->dataPtr->laserBuffer = new float[size];
 
-    memset(this->dataPtr->laserBuffer, 255, size);
+    ReadbackStatus status = this->ReadQueuedTexture(
+        this->dataPtr->secondPassTexture, this->dataPtr->laserBuffer, size);
+    if (status == READBACK_DELAYED)
+    {
+      this->newData = false;
+      return;
+    }
 
-    Ogre::PixelBox dstBox(width, height,
-        1, Ogre::PF_FLOAT32_RGB, this->dataPtr->laserBuffer);
+    if (status == READBACK_NOT_QUEUED)
+    {
+      memset(this->dataPtr->laserBuffer, 255, size);
 
-    pixelBuffer->blitToMemory(dstBox);
+      Ogre::PixelBox dstBox(width, height,
+          1, Ogre::PF_FLOAT32_RGB, this->dataPtr->laserBuffer);
+
+      pixelBuffer->blitToMemory(dstBox);
+    }
 
     if (!this->dataPtr->laserScan)
     {
@@ -452,6 +463,13 @@ void GpuLaser::RenderImpl()
                 this->dataPtr->matSecondPass, this->dataPtr->orthoCam, true);
   this->dataPtr->secondPassTarget->update(false);
 
+  // Start copying the scan read by PostRender
+  if (this->newData && this->captureData)
+  {
+    this->QueueTexture(this->dataPtr->secondPassTexture,
+        Ogre::PF_FLOAT32_RGB);
+  }
+
   this->dataPtr->visual->SetVisible(false);
 
   sceneMgr->_suppressRenderStateChanges(false);
@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Pixel buffer objects are only used with the OpenGL render system on
+// Linux, where the buffer functions are exported by libGL.
+#if defined(HAVE_OPENGL) && !defined(__APPLE__) && !defined(_WIN32)
+# define GL_GLEXT_PROTOTYPES
+# include <GL/gl.h>
+# include <GL/glext.h>
+# define GZ_PIXEL_READBACK_PBO
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/PixelReadback.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+/// \brief A frame copied into a pixel buffer.
+struct PixelReadbackSlot
+{
+  /// \brief Id of the pixel buffer object, 0 until it is created.
+  unsigned int buffer = 0;
+
+  /// \brief Allocated size of the pixel buffer object, in bytes.
+  size_t capacity = 0;
+
+  /// \brief Size of the frame, in bytes.
+  size_t size = 0;
+
+  /// \brief Sim time at which the frame was rendered.
+  common::Time simTime;
+};
+
+/// \brief Private data for the PixelReadback class.
+class gazebo::rendering::PixelReadbackPrivate
+{
+  /// \brief Double buffered pixel buffers.
+  public: PixelReadbackSlot slots[2];
+
+  /// \brief Index of the oldest queued frame.
+  public: unsigned int head = 0;
+
+  /// \brief Number of queued frames.
+  public: unsigned int count = 0;
+};
+
+#ifdef GZ_PIXEL_READBACK_PBO
+//////////////////////////////////////////////////
+/// \brief Get the OpenGL format and type of an Ogre pixel format, like
+/// Ogre's GL render system does when it downloads a texture.
+/// \param[in] _format Ogre::PixelFormat.
+/// \param[out] _glFormat OpenGL format.
+/// \param[out] _glType OpenGL type.
+/// \return False if the format is not supported.
+static bool GLPixelFormat(const int _format, GLenum &_glFormat,
+    GLenum &_glType)
+{
+#if OGRE_ENDIAN != OGRE_ENDIAN_LITTLE
+  return false;
+#endif
+  switch (_format)
+  {
+    case Ogre::PF_L8:
+      _glFormat = GL_LUMINANCE;
+      _glType = GL_UNSIGNED_BYTE;
+      return true;
+    case Ogre::PF_L16:
+      _glFormat = GL_LUMINANCE;
+      _glType = GL_UNSIGNED_SHORT;
+      return true;
+    case Ogre::PF_R8G8B8:
+      _glFormat = GL_BGR;
+      _glType = GL_UNSIGNED_BYTE;
+      return true;
+    case Ogre::PF_B8G8R8:
+      _glFormat = GL_RGB;
+      _glType = GL_UNSIGNED_BYTE;
+      return true;
+    case Ogre::PF_SHORT_RGB:
+      _glFormat = GL_RGB;
+      _glType = GL_UNSIGNED_SHORT;
+      return true;
+    case Ogre::PF_FLOAT16_R:
+      _glFormat = GL_LUMINANCE;
+      _glType = GL_HALF_FLOAT_ARB;
+      return true;
+    case Ogre::PF_FLOAT32_R:
+      _glFormat = GL_LUMINANCE;
+      _glType = GL_FLOAT;
+      return true;
+    case Ogre::PF_FLOAT32_RGB:
+      _glFormat = GL_RGB;
+      _glType = GL_FLOAT;
+      return true;
+    case Ogre::PF_FLOAT32_RGBA:
+      _glFormat = GL_RGBA;
+      _glType = GL_FLOAT;
+      return true;
+    default:
+      return false;
+  }
+}
+#endif
+
+//////////////////////////////////////////////////
+PixelReadback::PixelReadback()
+  : dataPtr(new PixelReadbackPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+PixelReadback::~PixelReadback()
+{
+  this->Fini();
+}
+
+//////////////////////////////////////////////////
+bool PixelReadback::Queue(Ogre::Texture *_texture, const int _format,
+    const common::Time &_simTime)
+{
+#ifdef GZ_PIXEL_READBACK_PBO
+  GLenum glFormat, glType;
+  if (!_texture || !GLPixelFormat(_format, glFormat, glType))
+    return false;
+
+  // This fails if OpenGL is not the rendering backend
+  GLuint texId = 0;
+  _texture->getCustomAttribute("GLID", &texId);
+  if (texId == 0)
+    return false;
+
+  // Drop the oldest frame when both buffers are in use
+  if (this->dataPtr->count == 2)
+  {
+    this->dataPtr->head = (this->dataPtr->head + 1) % 2;
+    this->dataPtr->count = 1;
+  }
+
+  PixelReadbackSlot &slot =
+    this->dataPtr->slots[(this->dataPtr->head + this->dataPtr->count) % 2];
+  slot.size = Ogre::PixelUtil::getMemorySize(_texture->getWidth(),
+      _texture->getHeight(), 1, static_cast<Ogre::PixelFormat>(_format));
+  slot.simTime = _simTime;
+
+  if (slot.buffer == 0)
+    glGenBuffers(1, &slot.buffer);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+  if (slot.capacity < slot.size)
+  {
+    glBufferData(GL_PIXEL_PACK_BUFFER, slot.size, nullptr, GL_STREAM_READ);
+    slot.capacity = slot.size;
+  }
+
+  // Ogre caches the bound texture, so restore it once the copy is queued.
+  GLint previousTexture = 0;
+  glGetIntegerv(GL_TEXTURE_BINDING_2D, &previousTexture);
+
+  // With a pack buffer bound, the copy is written to the buffer and the
+  // call returns without waiting for the GPU.
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glBindTexture(GL_TEXTURE_2D, texId);
+  glGetTexImage(GL_TEXTURE_2D, 0, glFormat, glType, nullptr);
+  glBindTexture(GL_TEXTURE_2D, previousTexture);
+  glPixelStorei(GL_PACK_ALIGNMENT, 4);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  ++this->dataPtr->count;
+  return true;
+#else
+  (void)_texture;
+  (void)_format;
+  (void)_simTime;
+  return false;
+#endif
+}
+
+//////////////////////////////////////////////////
+unsigned int PixelReadback::Pending() const
+{
+  return this->dataPtr->count;
+}
+
+//////////////////////////////////////////////////
+bool PixelReadback::Read(void *_data, const size_t _size,
+    common::Time &_simTime)
+{
+  if (this->dataPtr->count == 0 || !_data)
+    return false;
+
+  PixelReadbackSlot &slot = this->dataPtr->slots[this->dataPtr->head];
+  this->dataPtr->head = (this->dataPtr->head + 1) % 2;
+  --this->dataPtr->count;
+
+#ifdef GZ_PIXEL_READBACK_PBO
+  // Mapping the buffer waits for the copy to finish
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+  const void *mapped = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+  if (mapped)
+  {
+    memcpy(_data, mapped, std::min(_size, slot.size));
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  _simTime = slot.simTime;
+  return mapped != nullptr;
+#else
+  (void)_size;
+  (void)_simTime;
+  (void)slot;
+  return false;
+#endif
+}
+
+//////////////////////////////////////////////////
+void PixelReadback::Clear()
+{
+  this->dataPtr->head = 0;
+  this->dataPtr->count = 0;
+}
+
+//////////////////////////////////////////////////
+void PixelReadback::Fini()
+{
+  this->Clear();
+
+  for (auto &slot : this->dataPtr->slots)
+  {
+#ifdef GZ_PIXEL_READBACK_PBO
+    if (slot.buffer != 0)
+      glDeleteBuffers(1, &slot.buffer);
+#endif
+    slot.buffer = 0;
+    slot.capacity = 0;
+  }
+}
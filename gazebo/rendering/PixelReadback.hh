@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_PIXELREADBACK_HH_
+#define GAZEBO_RENDERING_PIXELREADBACK_HH_
+
+#include <memory>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/util/system.hh"
+
+namespace Ogre
+{
+  class Texture;
+}
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    // Forward declare private data class.
+    class PixelReadbackPrivate;
+
+    /// \addtogroup gazebo_rendering
+    /// \{
+
+    /// \class PixelReadback PixelReadback.hh rendering/rendering.hh
+    /// \brief Copies render textures to memory through a pair of OpenGL
+    /// pixel buffer objects. Queue starts the copy of a frame and returns
+    /// immediately, so the transfer overlaps the rendering that follows,
+    /// and Read waits for the copy and stores it in memory.
+    ///
+    /// Only the OpenGL render system on Linux is supported. Elsewhere
+    /// Queue returns false, and callers should read the texture with
+    /// Ogre. All functions must be called from the rendering thread.
+    class GZ_RENDERING_VISIBLE PixelReadback
+    {
+      /// \brief Constructor.
+      public: PixelReadback();
+
+      /// \brief Destructor.
+      public: virtual ~PixelReadback();
+
+      /// \brief Start copying a texture into the next pixel buffer. If both
+      /// buffers hold frames which have not been read, the oldest frame is
+      /// dropped.
+      /// \param[in] _texture Texture to copy.
+      /// \param[in] _format Ogre::PixelFormat of the copy.
+      /// \param[in] _simTime Sim time at which the texture was rendered.
+      /// \return False if the texture can not be copied asynchronously.
+      public: bool Queue(Ogre::Texture *_texture, const int _format,
+                         const common::Time &_simTime);
+
+      /// \brief Get the number of queued frames which have not been read.
+      /// \return Number of frames, at most 2.
+      public: unsigned int Pending() const;
+
+      /// \brief Copy the oldest queued frame to memory.
+      /// \param[out] _data Destination of the copy.
+      /// \param[in] _size Size of the destination, in bytes.
+      /// \param[out] _simTime Sim time at which the frame was rendered.
+      /// \return False if no frame is queued, or the copy failed.
+      public: bool Read(void *_data, const size_t _size,
+                        common::Time &_simTime);
+
+      /// \brief Drop the queued frames.
+      public: void Clear();
+
+      /// \brief Drop the queued frames and release the pixel buffers.
+      public: void Fini();
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<PixelReadbackPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -338,10 +338,13 @@ bool CameraSensor::UpdateImpl(const bool /*_force*/)
 
   IGN_PROFILE_BEGIN("fillarray");
 
-  if ((this->imagePub && this->imagePub->HasConnections()) ||
-      this->imagePubIgn.HasConnections())
+  // With latent readback, images are stamped with the time at which they
+  // were rendered, and the first frame is only delivered with the second.
+  if (this->camera->ImageReady() &&
+      ((this->imagePub && this->imagePub->HasConnections()) ||
+      this->imagePubIgn.HasConnections()))
   {
-    auto simTime = this->scene->SimTime();
+    auto simTime = this->camera->ImageSimTime();
     if (this->imagePub && this->imagePub->HasConnections())
     {
       msgs::ImageStamped msg;
@@ -29,6 +29,7 @@
 
 #include "gazebo/sensors/SensorFactory.hh"
 #include "gazebo/sensors/CameraSensor.hh"
+#include "gazebo/sensors/Noise.hh"
 #include "gazebo/sensors/DepthCameraSensorPrivate.hh"
 #include "gazebo/sensors/DepthCameraSensor.hh"
 
@@ -90,6 +91,14 @@ void DepthCameraSensor::Init()
     sdf::ElementPtr cameraSdf = this->sdf->GetElement("camera");
     this->dataPtr->depthCamera->Load(cameraSdf);
 
+    // Noise is added to the depth data on the CPU
+    if (cameraSdf->HasElement("noise"))
+    {
+      this->noises[CAMERA_NOISE] =
+        NoiseFactory::NewNoiseModel(cameraSdf->GetElement("noise"),
+        this->Type());
+    }
+
     // Do some sanity checks
     if (this->dataPtr->depthCamera->ImageWidth() == 0u ||
         this->dataPtr->depthCamera->ImageHeight() == 0u)
@@ -149,10 +158,11 @@ bool DepthCameraSensor::UpdateImpl(const bool /*_force*/)
   if (this->imagePub && this->imagePub->HasConnections() &&
       // check if depth data is available. If not, the depth camera could be
       // generating point clouds instead
-      this->dataPtr->depthCamera->DepthData())
+      this->dataPtr->depthCamera->DepthData() &&
+      this->camera->ImageReady())
   {
     msgs::ImageStamped msg;
-    msgs::Set(msg.mutable_time(), this->scene->SimTime());
+    msgs::Set(msg.mutable_time(), this->camera->ImageSimTime());
     msg.mutable_image()->set_width(this->camera->ImageWidth());
     msg.mutable_image()->set_height(this->camera->ImageHeight());
     msg.mutable_image()->set_pixel_format(common::Image::R_FLOAT32);
@@ -184,6 +194,12 @@ bool DepthCameraSensor::UpdateImpl(const bool /*_force*/)
         this->dataPtr->depthBuffer[i] = -ignition::math::INF_D;
       }
     }
+
+    // Apply noise to the depths, the masked ones stay infinite
+    auto noise = this->noises.find(CAMERA_NOISE);
+    if (noise != this->noises.end() && noise->second)
+      noise->second->Apply(this->dataPtr->depthBuffer, depthSamples);
+
     msg.mutable_image()->set_data(this->dataPtr->depthBuffer, depthBufferSize);
     this->imagePub->Publish(msg);
   }
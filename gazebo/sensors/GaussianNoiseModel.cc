@@ -14,6 +14,9 @@
  * limitations under the License.
  *
 */
+#include <cmath>
+#include <limits>
+
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Rand.hh>
 
@@ -79,6 +82,33 @@ namespace gazebo
 using namespace gazebo;
 using namespace sensors;
 
+//////////////////////////////////////////////////
+/// \brief Add Gaussian noise to a buffer of data values.
+/// \param[in,out] _data Data values.
+/// \param[in] _count Number of data values.
+/// \param[in] _samples Standard normal samples, one per data value.
+/// \param[in] _offset Mean of the noise plus the bias.
+/// \param[in] _stdDev Standard deviation of the noise.
+/// \param[in] _precision Precision to which the output is rounded, 0 to
+/// not round it.
+template<typename T>
+static void AddNoise(T *_data, const size_t _count, const double *_samples,
+    const double _offset, const double _stdDev, const double _precision)
+{
+  // Independent iterations without branches, which the compiler vectorizes.
+  for (size_t i = 0; i < _count; ++i)
+    _data[i] = static_cast<T>(_data[i] + _offset + _stdDev * _samples[i]);
+
+  if (_precision > 0)
+  {
+    for (size_t i = 0; i < _count; ++i)
+    {
+      _data[i] = static_cast<T>(
+          std::round(_data[i] / _precision) * _precision);
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 GaussianNoiseModel::GaussianNoiseModel()
   : Noise(Noise::GAUSSIAN),
@@ -119,6 +149,11 @@ void GaussianNoiseModel::Load(sdf::ElementPtr _sdf)
   }
   this->SampleBias();
 
+  // Draw the seed of the stream from the global generator, so that it is
+  // different for every model, and reproducible when the global seed is set.
+  this->SetSeed(static_cast<uint64_t>(ignition::math::Rand::IntUniform(0,
+          std::numeric_limits<int>::max())));
+
   /// \todo Remove this, and use Noise::Print. See ImuSensor for an example
   gzlog << "applying Gaussian noise model with mean " << this->mean
     << ", stddev " << this->stdDev
@@ -184,6 +219,67 @@ double GaussianNoiseModel::ApplyImpl(double _in, double _dt)
   return output;
 }
 
+//////////////////////////////////////////////////
+void GaussianNoiseModel::SampleBuffer(const size_t _count, const double _dt)
+{
+  // Box-Muller transform makes pairs of samples. One more sample drives the
+  // dynamic bias.
+  const size_t pairs = (_count + 2) / 2;
+  this->samples.resize(pairs * 2);
+  double *u = this->samples.data();
+
+  // Uniform values in (0, 1], from the upper 53 bits of the stream.
+  const double scale = 1.0 / 9007199254740992.0;
+  for (size_t i = 0; i < pairs * 2; ++i)
+    u[i] = static_cast<double>((this->generator() >> 11) + 1) * scale;
+
+  for (size_t i = 0; i < pairs; ++i)
+  {
+    const double r = std::sqrt(-2.0 * std::log(u[2 * i]));
+    const double theta = 2.0 * IGN_PI * u[2 * i + 1];
+    u[2 * i] = r * std::cos(theta);
+    u[2 * i + 1] = r * std::sin(theta);
+  }
+
+  // Same random walk as ApplyImpl(double, double)
+  if (this->dynamicBiasStdDev > 0 &&
+      this->dynamicBiasCorrTime > 0)
+  {
+    const double sigmaB = this->dynamicBiasStdDev;
+    const double tau = this->dynamicBiasCorrTime;
+
+    const double sigmaBD = sqrt(-sigmaB * sigmaB *
+        tau / 2 * expm1(-2 * _dt / tau));
+
+    const double phiD = exp(-_dt / tau);
+    this->bias = phiD * this->bias + sigmaBD * u[_count];
+  }
+}
+
+//////////////////////////////////////////////////
+void GaussianNoiseModel::ApplyImpl(double *_data, const size_t _count,
+    const double _dt)
+{
+  this->SampleBuffer(_count, _dt);
+  AddNoise(_data, _count, this->samples.data(), this->mean + this->bias,
+      this->stdDev, this->quantized ? this->precision : 0.0);
+}
+
+//////////////////////////////////////////////////
+void GaussianNoiseModel::ApplyImpl(float *_data, const size_t _count,
+    const double _dt)
+{
+  this->SampleBuffer(_count, _dt);
+  AddNoise(_data, _count, this->samples.data(), this->mean + this->bias,
+      this->stdDev, this->quantized ? this->precision : 0.0);
+}
+
+//////////////////////////////////////////////////
+void GaussianNoiseModel::SetSeed(const uint64_t _seed)
+{
+  this->generator.seed(_seed);
+}
+
 //////////////////////////////////////////////////
 double GaussianNoiseModel::GetMean() const
 {
@@ -18,6 +18,8 @@
 #ifndef _GAZEBO_GAUSSIAN_NOISE_MODEL_HH_
 #define _GAZEBO_GAUSSIAN_NOISE_MODEL_HH_
 
+#include <cstdint>
+#include <random>
 #include <vector>
 #include <string>
 
@@ -57,6 +59,27 @@ namespace gazebo
         // Documentation inherited.
         public: double ApplyImpl(double _in, double _dt);
 
+        /// \brief Apply noise to a buffer of data values. The samples are
+        /// drawn from a random number stream owned by this noise model, so
+        /// that sensors do not share the global generator. The stream is
+        /// seeded from ignition::math::Rand when the model is loaded, and is
+        /// reproducible when the global seed is set. A dynamic bias is
+        /// advanced once per call, by _dt.
+        /// \param[in,out] _data Data values.
+        /// \param[in] _count Number of data values.
+        /// \param[in] _dt Time elapsed since the previous call, in seconds.
+        public: virtual void ApplyImpl(double *_data, const size_t _count,
+                                       const double _dt);
+
+        // Documentation inherited.
+        public: virtual void ApplyImpl(float *_data, const size_t _count,
+                                       const double _dt);
+
+        /// \brief Seed the random number stream used by the buffer
+        /// overloads of Apply.
+        /// \param[in] _seed Seed of the stream.
+        public: void SetSeed(const uint64_t _seed);
+
         /// \brief Accessor for mean.
         /// \return Mean of Gaussian noise.
         public: double GetMean() const;
@@ -99,6 +122,12 @@ namespace gazebo
         /// \brief Sample the bias.
         private: void SampleBias();
 
+        /// \brief Fill the sample buffer with standard normal values drawn
+        /// from the random number stream, and advance the dynamic bias.
+        /// \param[in] _count Number of values.
+        /// \param[in] _dt Time elapsed since the previous call, in seconds.
+        private: void SampleBuffer(const size_t _count, const double _dt);
+
         /// \brief If type starts with GAUSSIAN, the mean of the distribution
         /// from which we sample when adding noise.
         protected: double mean;
@@ -132,6 +161,12 @@ namespace gazebo
         /// \biref If type starts with GAUSSIAN, the correlation time of the
         /// process from which the dynamic bias will be driven.
         private: double dynamicBiasCorrTime;
+
+        /// \brief Random number stream of the buffer overloads of Apply.
+        private: std::mt19937_64 generator;
+
+        /// \brief Standard normal samples, reused across calls.
+        private: std::vector<double> samples;
     };
 
     /// \class GaussianNoiseModel
@@ -705,12 +705,19 @@ bool GpuRaySensor::UpdateImpl(const bool /*_force*/)
   this->dataPtr->laserCam->PostRender();
   IGN_PROFILE_END();
 
+  // With latent readback the first scan is only delivered with the second
+  if (!this->dataPtr->laserCam->ImageReady())
+  {
+    this->dataPtr->rendered = false;
+    return false;
+  }
+
   IGN_PROFILE_BEGIN("fillarray");
 
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   msgs::Set(this->dataPtr->laserMsg.mutable_time(),
-      this->lastMeasurementTime);
+      this->dataPtr->laserCam->ImageSimTime());
 
   msgs::LaserScan *scan = this->dataPtr->laserMsg.mutable_scan();
 
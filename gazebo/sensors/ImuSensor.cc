@@ -388,40 +388,46 @@ bool ImuSensor::UpdateImpl(const bool /*_force*/)
 
     this->dataPtr->lastImuWorldLinearVel = imuWorldLinearVel;
 
-    // Apply noise models
+    // Apply noise models. The buffer overload of Apply draws from the random
+    // number stream of the model instead of the global generator.
+    auto applyNoise = [dt](const NoisePtr &_noise, double _in)
+    {
+      _noise->Apply(&_in, 1, dt);
+      return _in;
+    };
     for (auto const &keyNoise : this->noises)
     {
       switch (keyNoise.first)
       {
         case IMU_ANGVEL_X_NOISE_RADIANS_PER_S:
           this->dataPtr->imuMsg.mutable_angular_velocity()->set_x(
-            keyNoise.second->Apply(
-              this->dataPtr->imuMsg.angular_velocity().x(), dt));
+            applyNoise(keyNoise.second,
+              this->dataPtr->imuMsg.angular_velocity().x()));
           break;
         case IMU_ANGVEL_Y_NOISE_RADIANS_PER_S:
           this->dataPtr->imuMsg.mutable_angular_velocity()->set_y(
-            keyNoise.second->Apply(
-              this->dataPtr->imuMsg.angular_velocity().y(), dt));
+            applyNoise(keyNoise.second,
+              this->dataPtr->imuMsg.angular_velocity().y()));
           break;
         case IMU_ANGVEL_Z_NOISE_RADIANS_PER_S:
           this->dataPtr->imuMsg.mutable_angular_velocity()->set_z(
-            keyNoise.second->Apply(
-              this->dataPtr->imuMsg.angular_velocity().z(), dt));
+            applyNoise(keyNoise.second,
+              this->dataPtr->imuMsg.angular_velocity().z()));
           break;
         case IMU_LINACC_X_NOISE_METERS_PER_S_SQR:
           this->dataPtr->imuMsg.mutable_linear_acceleration()->set_x(
-            keyNoise.second->Apply(
-              this->dataPtr->imuMsg.linear_acceleration().x(), dt));
+            applyNoise(keyNoise.second,
+              this->dataPtr->imuMsg.linear_acceleration().x()));
           break;
         case IMU_LINACC_Y_NOISE_METERS_PER_S_SQR:
           this->dataPtr->imuMsg.mutable_linear_acceleration()->set_y(
-            keyNoise.second->Apply(
-              this->dataPtr->imuMsg.linear_acceleration().y(), dt));
+            applyNoise(keyNoise.second,
+              this->dataPtr->imuMsg.linear_acceleration().y()));
           break;
         case IMU_LINACC_Z_NOISE_METERS_PER_S_SQR:
           this->dataPtr->imuMsg.mutable_linear_acceleration()->set_z(
-            keyNoise.second->Apply(
-              this->dataPtr->imuMsg.linear_acceleration().z(), dt));
+            applyNoise(keyNoise.second,
+              this->dataPtr->imuMsg.linear_acceleration().z()));
           break;
         default:
           std::ostringstream out;
@@ -88,6 +88,42 @@ namespace gazebo
       /// \return Data with noise applied.
       public: virtual double ApplyImpl(double _in, double _dt = 0.0);
 
+      /// \brief Apply noise to a buffer of data values, in place. Noise
+      /// models which generate their samples in bulk, like
+      /// GaussianNoiseModel, are much faster this way than when Apply is
+      /// called for each value.
+      /// \param[in,out] _data Data values.
+      /// \param[in] _count Number of data values.
+      /// \param[in] _dt Time elapsed since the previous call, in seconds.
+      public: void Apply(double *_data, const size_t _count,
+                         const double _dt = 0.0);
+
+      /// \brief Apply noise to a buffer of data values, in place.
+      /// \param[in,out] _data Data values.
+      /// \param[in] _count Number of data values.
+      /// \param[in] _dt Time elapsed since the previous call, in seconds.
+      /// \sa Apply(double *, const size_t, const double)
+      public: void Apply(float *_data, const size_t _count,
+                         const double _dt = 0.0);
+
+      /// \brief Apply noise to a buffer of data values. This gets overriden
+      /// by derived classes, and called by Apply. The default implementation
+      /// calls ApplyImpl on each value.
+      /// \param[in,out] _data Data values.
+      /// \param[in] _count Number of data values.
+      /// \param[in] _dt Time elapsed since the previous call, in seconds.
+      public: virtual void ApplyImpl(double *_data, const size_t _count,
+                                     const double _dt);
+
+      /// \brief Apply noise to a buffer of data values. This gets overriden
+      /// by derived classes, and called by Apply. The default implementation
+      /// calls ApplyImpl on each value.
+      /// \param[in,out] _data Data values.
+      /// \param[in] _count Number of data values.
+      /// \param[in] _dt Time elapsed since the previous call, in seconds.
+      public: virtual void ApplyImpl(float *_data, const size_t _count,
+                                     const double _dt);
+
       /// \brief Finalize the noise model
       public: virtual void Fini();
 
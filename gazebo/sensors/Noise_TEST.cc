@@ -17,6 +17,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics/stats.hpp>
 #include <boost/accumulators/statistics/mean.hpp>
@@ -373,6 +375,88 @@ TEST_F(NoiseTest, OnApplyNoise)
   }
 }
 
+//////////////////////////////////////////////////
+TEST_F(NoiseTest, ApplyBuffer)
+{
+  const double mean = 10.0;
+  const double stddev = 5.0;
+  const size_t count = 10000;
+
+  // NONE leaves the values unchanged
+  {
+    sensors::NoisePtr noise = sensors::NoiseFactory::NewNoiseModel(
+        NoiseSdf("none", 0, 0, 0, 0, 0));
+    std::vector<double> values(count, 42.0);
+    noise->Apply(values.data(), values.size());
+    for (auto const value : values)
+      EXPECT_DOUBLE_EQ(value, 42.0);
+  }
+
+  // GAUSSIAN buffer samples have the expected mean and variance
+  {
+    sensors::NoisePtr noise = sensors::NoiseFactory::NewNoiseModel(
+        NoiseSdf("gaussian", mean, stddev, 0, 0, 0));
+    std::vector<double> values(count, 42.0);
+    noise->Apply(values.data(), values.size());
+
+    boost::accumulators::accumulator_set<double,
+      boost::accumulators::stats<boost::accumulators::tag::mean,
+                                 boost::accumulators::tag::variance > > acc;
+    for (auto const value : values)
+      acc(value);
+
+    // See comments in GaussianNoise function to explain these calculations.
+    double sampleStdDev = g_sigma * stddev / sqrt(count);
+    EXPECT_NEAR(boost::accumulators::mean(acc), 42.0 + mean, sampleStdDev);
+    double variance = stddev * stddev;
+    double sampleVariance2 = 2 * variance * variance / (count - 1);
+    EXPECT_NEAR(boost::accumulators::variance(acc),
+                variance, g_sigma * sqrt(sampleVariance2));
+  }
+
+  // Float buffers are quantized like doubles
+  {
+    sensors::NoisePtr noise = sensors::NoiseFactory::NewNoiseModel(
+        NoiseSdf("gaussian", 0, 0, 0, 0, 0.3));
+    std::vector<float> values = {0.32f, 0.31f, 0.30f, 0.29f, 0.28f};
+    noise->Apply(values.data(), values.size());
+    for (auto const value : values)
+      EXPECT_NEAR(value, 0.3, 1e-6);
+  }
+
+  // The same seed gives the same samples
+  {
+    sensors::NoisePtr noise = sensors::NoiseFactory::NewNoiseModel(
+        NoiseSdf("gaussian", mean, stddev, 0, 0, 0));
+    sensors::GaussianNoiseModelPtr gaussianNoise =
+      std::dynamic_pointer_cast<sensors::GaussianNoiseModel>(noise);
+    ASSERT_TRUE(gaussianNoise != nullptr);
+
+    std::vector<double> first(101, 0.0);
+    std::vector<double> second(101, 0.0);
+    gaussianNoise->SetSeed(1234);
+    noise->Apply(first.data(), first.size());
+    gaussianNoise->SetSeed(1234);
+    noise->Apply(second.data(), second.size());
+    EXPECT_EQ(first, second);
+
+    noise->Apply(second.data(), second.size());
+    EXPECT_NE(first, second);
+  }
+
+  // CUSTOM calls the callback for each value
+  {
+    sensors::NoisePtr noise(new sensors::Noise(sensors::Noise::CUSTOM));
+    noise->SetCustomNoiseCallback(
+      boost::bind(&OnApplyCustomNoise, _1));
+    std::vector<double> values = {1, 2, 3};
+    noise->Apply(values.data(), values.size());
+    EXPECT_DOUBLE_EQ(values[0], 2);
+    EXPECT_DOUBLE_EQ(values[1], 4);
+    EXPECT_DOUBLE_EQ(values[2], 6);
+  }
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -380,6 +380,13 @@ bool RaySensor::UpdateImpl(const bool /*_force*/)
   scan->clear_ranges();
   scan->clear_intensities();
 
+  // Noise is applied to all the valid ranges at once, after the loop.
+  NoisePtr noise;
+  if (this->noises.find(RAY_NOISE) != this->noises.end())
+    noise = this->noises[RAY_NOISE];
+  this->dataPtr->noisyRanges.clear();
+  this->dataPtr->noisyIndices.clear();
+
   unsigned int rayCount = this->RayCount();
   unsigned int rangeCount = this->RangeCount();
   unsigned int verticalRayCount = this->VerticalRayCount();
@@ -487,19 +494,29 @@ bool RaySensor::UpdateImpl(const bool /*_force*/)
       {
         range = -ignition::math::INF_D;
       }
-      else if (this->noises.find(RAY_NOISE) !=
-               this->noises.end())
+      else if (noise)
       {
-        // currently supports only one noise model per laser sensor
-        range = this->noises[RAY_NOISE]->Apply(range);
-        range = ignition::math::clamp(range,
-            this->RangeMin(), this->RangeMax());
+        this->dataPtr->noisyIndices.push_back(scan->ranges_size());
+        this->dataPtr->noisyRanges.push_back(range);
       }
 
       scan->add_ranges(range);
       scan->add_intensities(intensity);
     }
   }
+
+  if (noise && !this->dataPtr->noisyRanges.empty())
+  {
+    // currently supports only one noise model per laser sensor
+    noise->Apply(this->dataPtr->noisyRanges.data(),
+        this->dataPtr->noisyRanges.size());
+    for (size_t i = 0; i < this->dataPtr->noisyRanges.size(); ++i)
+    {
+      scan->set_ranges(this->dataPtr->noisyIndices[i],
+          ignition::math::clamp(this->dataPtr->noisyRanges[i],
+            this->RangeMin(), this->RangeMax()));
+    }
+  }
   IGN_PROFILE_END();
 
   IGN_PROFILE_BEGIN("Publish");
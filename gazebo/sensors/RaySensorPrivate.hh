@@ -18,6 +18,7 @@
 #define _GAZEBO_SENSORS_RAYSENSOR_PRIVATE_HH_
 
 #include <mutex>
+#include <vector>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
@@ -48,6 +49,12 @@ namespace gazebo
 
       /// \brief Laser message.
       public: msgs::LaserScanStamped laserMsg;
+
+      /// \brief Ranges to which noise is applied, reused across updates.
+      public: std::vector<double> noisyRanges;
+
+      /// \brief Indices in the scan of the noisy ranges.
+      public: std::vector<int> noisyIndices;
     };
   }
 }
@@ -49,6 +49,9 @@ sdf::ElementPtr SensorPrivate::sdfSensor;
 
 bool Sensor::useStrictRate = false;
 
+/// \brief Weight of the latest update in the averaged update statistics.
+const double g_updateStatsWeight = 0.1;
+
 //////////////////////////////////////////////////
 Sensor::Sensor(SensorCategory _cat)
 : dataPtr(new SensorPrivate)
@@ -249,6 +252,7 @@ void Sensor::Update(const bool _force)
       else
         simTime = this->world->SimTime();
 
+      common::Time lateness;
       {
         std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
 
@@ -268,6 +272,10 @@ void Sensor::Update(const bool _force)
         this->dataPtr->updateDelay = std::max(common::Time::Zero,
             adjustedElapsed - this->updatePeriod);
 
+        // The first update after a reset is never late.
+        if (this->lastUpdateTime > common::Time::Zero)
+          lateness = this->dataPtr->updateDelay;
+
         // if delay is more than a full update period, then give up trying
         // to catch up. This happens normally when the sensor just changed from
         // an inactive to an active state, or the sensor just cannot hit its
@@ -279,6 +287,24 @@ void Sensor::Update(const bool _force)
       if (this->UpdateImpl(_force))
       {
         std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
+        if (this->lastUpdateTime > common::Time::Zero)
+        {
+          const double interval = (simTime - this->lastUpdateTime).Double();
+          if (this->dataPtr->updateInterval > 0.0)
+          {
+            this->dataPtr->updateInterval +=
+              g_updateStatsWeight * (interval - this->dataPtr->updateInterval);
+            this->dataPtr->updateLateness += g_updateStatsWeight *
+              (lateness.Double() - this->dataPtr->updateLateness);
+          }
+          else
+          {
+            this->dataPtr->updateInterval = interval;
+            this->dataPtr->updateLateness = lateness.Double();
+          }
+          this->dataPtr->maxUpdateLateness =
+            std::max(this->dataPtr->maxUpdateLateness, lateness);
+        }
         this->lastUpdateTime = simTime;
         this->updated();
       }
@@ -520,6 +546,9 @@ void Sensor::ResetLastUpdateTime()
   this->lastUpdateTime = 0.0;
   this->lastMeasurementTime = 0.0;
   this->dataPtr->updateDelay = 0.0;
+  this->dataPtr->updateInterval = 0.0;
+  this->dataPtr->updateLateness = 0.0;
+  this->dataPtr->maxUpdateLateness = 0.0;
 }
 
 //////////////////////////////////////////////////
@@ -535,6 +564,37 @@ double Sensor::NextRequiredTimestamp() const
   return std::numeric_limits<double>::quiet_NaN();
 }
 
+//////////////////////////////////////////////////
+common::Time Sensor::NextUpdateTime() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
+  return this->lastUpdateTime + this->updatePeriod -
+    this->dataPtr->updateDelay;
+}
+
+//////////////////////////////////////////////////
+double Sensor::AchievedUpdateRate() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
+  if (this->dataPtr->updateInterval > 0.0)
+    return 1.0 / this->dataPtr->updateInterval;
+  return 0.0;
+}
+
+//////////////////////////////////////////////////
+common::Time Sensor::UpdateLateness() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
+  return common::Time(this->dataPtr->updateLateness);
+}
+
+//////////////////////////////////////////////////
+common::Time Sensor::MaxUpdateLateness() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
+  return this->dataPtr->maxUpdateLateness;
+}
+
 //////////////////////////////////////////////////
 bool Sensor::StrictRate() const
 {
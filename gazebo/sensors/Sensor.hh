@@ -185,6 +185,30 @@ namespace gazebo
       /// \return the timestamp
       public: virtual double NextRequiredTimestamp() const;
 
+      /// \brief Get the sim time at which the sensor is next due to update.
+      /// This includes the compensation for updates that ran late, and is
+      /// used by the SensorManager to order the sensors it updates.
+      /// \return Sim time of the next update.
+      public: common::Time NextUpdateTime() const;
+
+      /// \brief Get the rate at which the sensor is actually updated,
+      /// averaged over its recent updates in sim time.
+      /// \return Achieved update rate in Hz, 0 until the sensor has been
+      /// updated twice.
+      /// \sa UpdateRate()
+      public: double AchievedUpdateRate() const;
+
+      /// \brief Get how long after they were due the recent updates of
+      /// the sensor ran, averaged over its recent updates.
+      /// \return Average lateness, in sim time.
+      public: common::Time UpdateLateness() const;
+
+      /// \brief Get the largest lateness of an update since the last
+      /// update time was reset.
+      /// \return Largest lateness, in sim time.
+      /// \sa ResetLastUpdateTime()
+      public: common::Time MaxUpdateLateness() const;
+
       /// \brief Returns true if the sensor is to follow strict update rate
       /// \return True when sensor should follow strict update rate
       public: bool StrictRate() const;
@@ -15,8 +15,12 @@
  *
 */
 
+#include <algorithm>
 #include <functional>
+#include <string>
 #include <boost/bind.hpp>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Time.hh"
 
@@ -226,6 +230,28 @@ void SensorManager::ResetLastUpdateTimes()
   }
 }
 
+//////////////////////////////////////////////////
+void SensorManager::SetUpdateThreads(const unsigned int _threads)
+{
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  this->updateThreads = std::max(1u, _threads);
+
+  // The image sensors are updated in the rendering thread.
+  for (SensorContainer_V::iterator iter = ++this->sensorContainers.begin();
+       iter != this->sensorContainers.end(); ++iter)
+  {
+    GZ_ASSERT((*iter) != nullptr, "SensorContainer is null");
+    (*iter)->SetUpdateThreads(this->updateThreads);
+  }
+}
+
+//////////////////////////////////////////////////
+unsigned int SensorManager::UpdateThreads() const
+{
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  return this->updateThreads;
+}
+
 //////////////////////////////////////////////////
 double SensorManager::NextRequiredTimestamp()
 {
@@ -515,6 +541,8 @@ void SensorManager::SensorContainer::Fini()
 
   // Remove all the sensors from the current sensor vector.
   this->sensors.clear();
+  this->schedule.clear();
+  this->scheduleDirty = true;
 
   this->initialized = false;
 }
@@ -555,22 +583,6 @@ void SensorManager::SensorContainer::RunLoop()
 {
   this->stop = false;
 
-  physics::WorldPtr world = physics::get_world();
-  GZ_ASSERT(world != nullptr, "Pointer to World is null");
-
-  physics::PhysicsEnginePtr engine = world->Physics();
-  GZ_ASSERT(engine != nullptr, "Pointer to PhysicsEngine is null");
-
-  engine->InitForThread();
-
-  // The original value was hardcode to 1.0. Changed the value to
-  // 1000 * MaxStepSize in order to handle simulation with a
-  // large step size.
-  double maxSensorUpdate = engine->GetMaxStepSize() * 1000;
-
-  // Release engine pointer, we don't need it in the loop
-  engine.reset();
-
   common::Time sleepTime, startTime, eventTime, diffTime;
   double maxUpdateRate = 0;
 
@@ -586,6 +598,29 @@ void SensorManager::SensorContainer::RunLoop()
       return;
   }
 
+  // Follow the world of the sensors, which is not necessarily the first
+  // world of the process.
+  physics::WorldPtr world;
+  {
+    boost::recursive_mutex::scoped_lock lock(this->mutex);
+    if (!this->sensors.empty())
+      world = physics::get_world(this->sensors.front()->WorldName());
+  }
+  GZ_ASSERT(world != nullptr, "Pointer to World is null");
+
+  physics::PhysicsEnginePtr engine = world->Physics();
+  GZ_ASSERT(engine != nullptr, "Pointer to PhysicsEngine is null");
+
+  engine->InitForThread();
+
+  // The original value was hardcode to 1.0. Changed the value to
+  // 1000 * MaxStepSize in order to handle simulation with a
+  // large step size.
+  double maxSensorUpdate = engine->GetMaxStepSize() * 1000;
+
+  // Release engine pointer, we don't need it in the loop
+  engine.reset();
+
 
   auto computeMaxUpdateRate = [&]()
   {
@@ -636,7 +671,7 @@ void SensorManager::SensorContainer::RunLoop()
     startTime = world->SimTime();
 
     IGN_PROFILE_BEGIN("UpdateSensors");
-    this->Update(false);
+    common::Time nextTime = this->UpdateDue(startTime);
     IGN_PROFILE_END();
 
     // Compute the time it took to update the sensors.
@@ -644,8 +679,13 @@ void SensorManager::SensorContainer::RunLoop()
     // would case a negative diffTime. Instead, just use a event time of zero
     diffTime = std::max(common::Time::Zero, world->SimTime() - startTime);
 
-    // Set the default sleep time
-    eventTime = std::max(common::Time::Zero, sleepTime - diffTime);
+    // Sleep until the next sensor is due. If a sensor is due again
+    // right away, e.g. an unthrottled sensor, use the period of the fastest
+    // sensor instead.
+    if (nextTime > startTime)
+      eventTime = std::max(common::Time::Zero, nextTime - startTime - diffTime);
+    else
+      eventTime = std::max(common::Time::Zero, sleepTime - diffTime);
 
     // Make sure update time is reasonable.
     // During log playback, time can jump forward an arbitrary amount.
@@ -690,16 +730,132 @@ void SensorManager::SensorContainer::Update(bool _force)
     gzlog << "Updating a sensor container without any sensors.\n";
 
   // Update all the sensors in this container.
-  for (Sensor_V::iterator iter = this->sensors.begin();
-       iter != this->sensors.end(); ++iter)
+  this->UpdateSensors(this->sensors, _force);
+}
+
+//////////////////////////////////////////////////
+common::Time SensorManager::SensorContainer::UpdateDue(
+    const common::Time &_simTime)
+{
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+
+  // With a strict rate every sensor decides when it updates.
+  if (this->sensors.empty() || this->sensors.front()->StrictRate())
   {
-    GZ_ASSERT((*iter) != nullptr, "Sensor is null");
-    IGN_PROFILE_BEGIN((*iter)->Name().c_str());
-    (*iter)->Update(_force);
+    this->UpdateSensors(this->sensors, false);
+    return _simTime;
+  }
+
+  auto later = [](const std::pair<common::Time, SensorPtr> &_a,
+                  const std::pair<common::Time, SensorPtr> &_b)
+  {
+    return _a.first > _b.first;
+  };
+
+  // Rebuild the schedule when sensors are added or removed, and when
+  // time goes backwards, e.g. after a world reset.
+  if (this->scheduleDirty || _simTime < this->scheduleTime)
+  {
+    this->schedule.clear();
+    for (auto &sensor : this->sensors)
+    {
+      GZ_ASSERT(sensor != nullptr, "Sensor is null");
+      this->schedule.push_back(
+          std::make_pair(sensor->NextUpdateTime(), sensor));
+    }
+    std::make_heap(this->schedule.begin(), this->schedule.end(), later);
+    this->scheduleDirty = false;
+  }
+  this->scheduleTime = _simTime;
+
+  // Take the sensors which are due, earliest first.
+  this->dueSensors.clear();
+  while (!this->schedule.empty() && this->schedule.front().first <= _simTime)
+  {
+    std::pop_heap(this->schedule.begin(), this->schedule.end(), later);
+    this->dueSensors.push_back(this->schedule.back().second);
+    this->schedule.pop_back();
+  }
+
+  this->UpdateSensors(this->dueSensors, false);
+
+  // Put the sensors back in the schedule. A sensor which did not update,
+  // e.g. because it is inactive, is checked again one period later.
+  for (auto &sensor : this->dueSensors)
+  {
+    common::Time next = sensor->NextUpdateTime();
+    if (next <= _simTime && sensor->UpdateRate() > 0.0)
+      next = _simTime + common::Time(1.0 / sensor->UpdateRate());
+    this->schedule.push_back(std::make_pair(next, sensor));
+    std::push_heap(this->schedule.begin(), this->schedule.end(), later);
+  }
+  this->dueSensors.clear();
+
+  if (this->schedule.empty())
+    return _simTime;
+  return this->schedule.front().first;
+}
+
+//////////////////////////////////////////////////
+void SensorManager::SensorContainer::UpdateSensors(const Sensor_V &_sensors,
+    const bool _force)
+{
+  if (this->updateArena && _sensors.size() > 1)
+  {
+    this->updateArena->execute([&_sensors, _force]()
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, _sensors.size()),
+          [&_sensors, _force](const tbb::blocked_range<size_t> &_r)
+      {
+        // Sensors may query the physics engine, e.g. ray sensors, which
+        // needs to be initialized for each worker thread. Use the world of
+        // the sensors rather than the first one of the process.
+        std::string worldName;
+        for (size_t i = _r.begin(); i != _r.end(); ++i)
+        {
+          GZ_ASSERT(_sensors[i] != nullptr, "Sensor is null");
+          if (i == _r.begin() || _sensors[i]->WorldName() != worldName)
+          {
+            worldName = _sensors[i]->WorldName();
+            if (physics::has_world(worldName))
+            {
+              physics::WorldPtr world = physics::get_world(worldName);
+              if (world->Physics())
+                world->Physics()->InitForThread();
+            }
+          }
+          IGN_PROFILE_BEGIN(_sensors[i]->Name().c_str());
+          _sensors[i]->Update(_force);
+          IGN_PROFILE_END();
+        }
+      });
+    });
+    return;
+  }
+
+  for (auto &sensor : _sensors)
+  {
+    GZ_ASSERT(sensor != nullptr, "Sensor is null");
+    IGN_PROFILE_BEGIN(sensor->Name().c_str());
+    sensor->Update(_force);
     IGN_PROFILE_END();
   }
 }
 
+//////////////////////////////////////////////////
+void SensorManager::SensorContainer::SetUpdateThreads(
+    const unsigned int _threads)
+{
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  if (_threads > 1)
+  {
+    this->updateArena.reset(
+        new tbb::task_arena(static_cast<int>(_threads)));
+  }
+  else
+    this->updateArena.reset();
+}
+
 //////////////////////////////////////////////////
 SensorPtr SensorManager::SensorContainer::GetSensor(const std::string &_name,
                                                     bool _useLeafName) const
@@ -735,6 +891,7 @@ void SensorManager::SensorContainer::AddSensor(SensorPtr _sensor)
   {
     boost::recursive_mutex::scoped_lock lock(this->mutex);
     this->sensors.push_back(_sensor);
+    this->scheduleDirty = true;
     g_sensorsDirty = true;
   }
 
@@ -765,6 +922,8 @@ bool SensorManager::SensorContainer::RemoveSensor(const std::string &_name)
     }
   }
 
+  this->schedule.clear();
+  this->scheduleDirty = true;
   g_sensorsDirty = true;
 
   return removed;
@@ -783,6 +942,7 @@ void SensorManager::SensorContainer::ResetLastUpdateTimes()
     GZ_ASSERT((*iter) != nullptr, "Sensor is null");
     (*iter)->ResetLastUpdateTime();
   }
+  this->scheduleDirty = true;
 
   // Tell the run loop that world time has been reset.
   this->runCondition.notify_one();
@@ -802,6 +962,8 @@ void SensorManager::SensorContainer::RemoveSensors()
     (*iter)->Fini();
   }
 
+  this->schedule.clear();
+  this->scheduleDirty = true;
   g_sensorsDirty = true;
 
   this->sensors.clear();
@@ -22,8 +22,12 @@
 #include <vector>
 #include <list>
 #include <map>
+#include <memory>
+#include <utility>
 #include <condition_variable>
 
+#include <tbb/task_arena.h>
+
 #include <sdf/sdf.hh>
 
 #include "gazebo/physics/PhysicsTypes.hh"
@@ -179,6 +183,22 @@ namespace gazebo
       /// \brief Reset last update times in all sensors.
       public: void ResetLastUpdateTimes();
 
+      /// \brief Set the number of worker threads used to update the
+      /// sensors which do not render, for each of the ray and other sensor
+      /// categories. With more than one thread, the sensors that are due
+      /// at the same time are updated in parallel. Image sensors are always
+      /// updated in the rendering thread. gzserver sets it with the
+      /// --sensor_threads option.
+      /// \param[in] _threads Number of threads, 0 or 1 to update the
+      /// sensors sequentially.
+      /// \sa Sensor::AchievedUpdateRate()
+      public: void SetUpdateThreads(const unsigned int _threads);
+
+      /// \brief Get the number of worker threads used to update the
+      /// sensors which do not render.
+      /// \return Number of threads.
+      public: unsigned int UpdateThreads() const;
+
       /// \brief Block until all sensors do not need current world tick
       /// \param[in] _clk simulated clock of the world
       /// \param[in] _dt world time step
@@ -251,10 +271,29 @@ namespace gazebo
                  /// \brief Reset last update times in all sensors.
                  public: void ResetLastUpdateTimes();
 
+                 /// \brief Set the number of threads used to update the
+                 /// sensors.
+                 /// \param[in] _threads Number of threads, 0 or 1 to
+                 /// update the sensors sequentially.
+                 public: void SetUpdateThreads(const unsigned int _threads);
+
                  /// \brief A loop to update the sensor. Used by the
                  /// runThread.
                  private: void RunLoop();
 
+                 /// \brief Update the sensors which are due, in the order
+                 /// of their next update time.
+                 /// \param[in] _simTime Current sim time.
+                 /// \return Sim time at which the next sensor is due.
+                 private: common::Time UpdateDue(const common::Time &_simTime);
+
+                 /// \brief Update a list of sensors, on the worker threads
+                 /// if there are more than one.
+                 /// \param[in] _sensors Sensors to update.
+                 /// \param[in] _force True to force the sensors to update.
+                 private: void UpdateSensors(const Sensor_V &_sensors,
+                                             const bool _force);
+
                  /// \brief The set of sensors to maintain.
                  public: Sensor_V sensors;
 
@@ -274,6 +313,25 @@ namespace gazebo
                  /// \brief Condition used to block the RunLoop if no
                  /// sensors are present.
                  private: boost::condition_variable runCondition;
+
+                 /// \brief Min heap of the sensors, keyed by the sim time
+                 /// at which they are next due.
+                 private: std::vector<std::pair<common::Time, SensorPtr>>
+                          schedule;
+
+                 /// \brief True to rebuild the schedule before the next
+                 /// update.
+                 private: bool scheduleDirty = true;
+
+                 /// \brief Sim time of the previous scheduled update.
+                 private: common::Time scheduleTime;
+
+                 /// \brief Sensors which are due, reused between updates.
+                 private: Sensor_V dueSensors;
+
+                 /// \brief Arena of the worker threads, null to update the
+                 /// sensors sequentially.
+                 private: std::unique_ptr<tbb::task_arena> updateArena;
                };
       /// \endcond
 
@@ -319,6 +377,9 @@ namespace gazebo
       /// \brief The sensor manager's vector of sensor containers.
       private: SensorContainer_V sensorContainers;
 
+      /// \brief Number of worker threads for the non-image sensors.
+      private: unsigned int updateThreads = 1;
+
       /// \brief This is a singleton class.
       private: friend class SingletonT<SensorManager>;
 
@@ -159,6 +159,43 @@ TEST_F(SensorManager_TEST, InitRemove)
   printf("Done done\n");
 }
 
+/////////////////////////////////////////////////
+/// \brief Test updating sensors on worker threads, and their statistics.
+TEST_F(SensorManager_TEST, UpdateThreads)
+{
+  Load("worlds/test_camera_laser.world");
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+  EXPECT_EQ(mgr->UpdateThreads(), 1u);
+
+  mgr->SetUpdateThreads(4);
+  EXPECT_EQ(mgr->UpdateThreads(), 4u);
+
+  std::vector<sensors::SensorPtr> lasers;
+  lasers.push_back(mgr->GetSensor("default::laser_1::link::laser"));
+  lasers.push_back(mgr->GetSensor("default::laser_2::link::laser"));
+  for (auto &laser : lasers)
+    ASSERT_TRUE(laser != nullptr);
+
+  // Wait for 2 seconds
+  for (unsigned int i = 0; i < 20; ++i)
+    common::Time::MSleep(100);
+
+  for (auto &laser : lasers)
+  {
+    EXPECT_GT(laser->AchievedUpdateRate(), 0.0);
+    if (laser->UpdateRate() > 0.0)
+    {
+      EXPECT_NEAR(laser->AchievedUpdateRate(), laser->UpdateRate(),
+          laser->UpdateRate() * 0.5);
+    }
+    EXPECT_GE(laser->UpdateLateness(), common::Time::Zero);
+    EXPECT_GE(laser->MaxUpdateLateness(), laser->UpdateLateness());
+  }
+
+  mgr->SetUpdateThreads(0);
+  EXPECT_EQ(mgr->UpdateThreads(), 1u);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
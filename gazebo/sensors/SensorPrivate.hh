@@ -48,6 +48,16 @@ namespace gazebo
       /// \brief Keep track how much the update has been delayed.
       public: common::Time updateDelay;
 
+      /// \brief Exponential average of the sim time between updates.
+      public: double updateInterval = 0.0;
+
+      /// \brief Exponential average of the lateness of updates, in
+      /// seconds.
+      public: double updateLateness = 0.0;
+
+      /// \brief Largest lateness of an update.
+      public: common::Time maxUpdateLateness;
+
       /// \brief The sensors unique ID.
       public: uint32_t id;
 
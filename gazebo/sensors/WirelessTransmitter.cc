@@ -160,21 +160,27 @@ double WirelessTransmitter::SignalStrength(
     end.Z() += 0.00001;
   }
 
-  // Acquire the mutex for avoiding race condition with the physics engine
-  boost::recursive_mutex::scoped_lock lock(*(
-        this->world->Physics()->GetPhysicsUpdateMutex()));
-
   // Compute the value of n depending on the obstacles between Tx and Rx
   double n = WirelessTransmitterPrivate::NEmpty;
 
-  // Looking for obstacles between start and end points
-  this->dataPtr->testRay->SetPoints(start, end);
-  this->dataPtr->testRay->GetIntersection(dist, entityName);
-
-  // ToDo: The ray intersects with my own collision model. Fix it.
-  if (entityName != "")
+  // The ray is only cast if the segment crosses the bounding box of a
+  // collision.
+  physics::SpatialIndex &index = this->world->SpatialIndex();
+  if (!index.Enabled() || !index.QueryRay(start, end).empty())
   {
-    n = WirelessTransmitterPrivate::NObstacle;
+    // Acquire the mutex for avoiding race condition with the physics engine
+    boost::recursive_mutex::scoped_lock lock(*(
+          this->world->Physics()->GetPhysicsUpdateMutex()));
+
+    // Looking for obstacles between start and end points
+    this->dataPtr->testRay->SetPoints(start, end);
+    this->dataPtr->testRay->GetIntersection(dist, entityName);
+
+    // ToDo: The ray intersects with my own collision model. Fix it.
+    if (entityName != "")
+    {
+      n = WirelessTransmitterPrivate::NObstacle;
+    }
   }
 
   double distance = std::max(1.0,
@@ -39,6 +39,12 @@ std::string CallbackHelper::GetMsgType() const
   return std::string();
 }
 
+/////////////////////////////////////////////////
+bool CallbackHelper::ZeroCopy() const
+{
+  return false;
+}
+
 /////////////////////////////////////////////////
 bool CallbackHelper::GetLatching() const
 {
@@ -58,3 +64,15 @@ unsigned int CallbackHelper::GetId() const
 {
   return this->id;
 }
+
+/////////////////////////////////////////////////
+bool CallbackHelper::GetConflating() const
+{
+  return this->conflating;
+}
+
+/////////////////////////////////////////////////
+void CallbackHelper::SetConflating(bool _conflate)
+{
+  this->conflating = _conflate;
+}
@@ -74,6 +74,13 @@ namespace gazebo
       ///         is tied to a remote connection
       public: virtual bool IsLocal() const = 0;
 
+      /// \brief Can the callback take a message published in this process
+      /// through HandleMessage? Such callbacks share the published message
+      /// with the publisher and with each other, so neither the publication
+      /// nor the subscribing node serializes it for them.
+      /// \return True if HandleMessage does not serialize the message.
+      public: virtual bool ZeroCopy() const;
+
       /// \brief Is the callback latching?
       /// \return true if the callback is latching, false otherwise
       public: bool GetLatching() const;
@@ -87,6 +94,17 @@ namespace gazebo
       /// \return The unique ID of this callback.
       public: unsigned int GetId() const;
 
+      /// \brief Is the callback conflating? A conflating callback only
+      /// wants the latest message, messages which are superseded before
+      /// the callback gets to them are skipped.
+      /// \return true if the callback is conflating, false otherwise
+      public: bool GetConflating() const;
+
+      /// \brief Set whether this callback is conflating.
+      /// This function should only be used by the Transport library.
+      /// \param[in] _conflate True to only deliver the latest message.
+      public: void SetConflating(bool _conflate);
+
       /// \brief True means that the callback helper will get the last
       /// published message on the topic.
       protected: bool latching;
@@ -94,6 +112,9 @@ namespace gazebo
       /// \brief Mutex to protect the latching variable.
       protected: mutable std::mutex latchingMutex;
 
+      /// \brief True means that only the latest message is delivered.
+      protected: bool conflating = false;
+
       /// \brief A counter to generate the unique id of this callback.
       private: static unsigned int idCounter;
 
@@ -166,6 +187,12 @@ namespace gazebo
                 return true;
               }
 
+      // documentation inherited
+      public: virtual bool ZeroCopy() const
+              {
+                return true;
+              }
+
       private: boost::function<void (const boost::shared_ptr<M const> &)>
                callback;
     };
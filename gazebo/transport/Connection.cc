@@ -49,6 +49,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
 #include <boost/lexical_cast.hpp>
@@ -68,6 +72,34 @@ extern void dummy_callback_fn(uint32_t);
 unsigned int Connection::idCounter = 0;
 IOManager *Connection::iomanager = NULL;
 
+/// \brief First byte of a binary header. ASCII headers only contain hex
+/// digits, so the two formats can't be confused.
+static const unsigned char kBinaryHeaderMagic = 0xff;
+
+/// \brief Maximum number of messages sent by one gather write.
+static const std::size_t kMaxWriteBatch = 32;
+
+/// \brief Flag set in the second byte of a binary header when the packet
+/// is a shared memory reference.
+static const unsigned char kSharedMemoryFlag = 0x01;
+
+/// \brief Messages smaller than this are always written to the socket.
+static const std::size_t kSharedMemoryThreshold = 64 * 1024;
+
+/// \brief Default size of the shared memory ring, in MB.
+static const uint64_t kSharedMemoryDefaultSize = 64;
+
+/// \brief Prefix of the names of the shared memory segments. A reader only
+/// opens segments with this prefix.
+static const char kSharedMemoryPrefix[] = "gazebo_shm_";
+
+/// \brief Maximum number of buffers of handled messages kept by a
+/// connection for its next reads.
+static const std::size_t kMaxSpareInbound = 4;
+
+/// \brief Buffers of handled messages larger than this are released.
+static const std::size_t kMaxSpareInboundSize = 1024 * 1024;
+
 // Version 1.52 of boost has an address::is_unspecfied function, but
 // Version 1.46.1 (installed on ubuntu) does not. So this helper function
 // is stolen from adress::is_unspecified function in boost v1.52.
@@ -103,6 +135,10 @@ Connection::Connection()
   this->connectError = false;
   this->writeQueue.clear();
   this->writeCount = 0;
+  this->writeBatch = 0;
+  this->binaryFraming = false;
+  this->inboundShm = false;
+  this->shmFailed = false;
 
   this->localURI = std::string("http://") + this->GetLocalHostname() + ":" +
                    boost::lexical_cast<std::string>(this->GetLocalPort());
@@ -292,6 +328,13 @@ void Connection::EnqueueMsg(const std::string &_buffer, bool _force)
   this->EnqueueMsg(_buffer, boost::bind(&dummy_callback_fn, _1), 0, _force);
 }
 
+//////////////////////////////////////////////////
+void Connection::EnqueueMsg(std::string &&_buffer, bool _force)
+{
+  this->EnqueueMsg(std::move(_buffer), boost::bind(&dummy_callback_fn, _1), 0,
+      _force);
+}
+
 //////////////////////////////////////////////////
 void Connection::EnqueueMsg(const std::string &_buffer,
     boost::function<void(uint32_t)> _cb, uint32_t _id, bool _force)
@@ -302,28 +345,82 @@ void Connection::EnqueueMsg(const std::string &_buffer,
     return;
   }
 
-  char headerBuffer[HEADER_LENGTH + 1];
-  snprintf(headerBuffer, HEADER_LENGTH + 1, "%08x",
-      static_cast<unsigned int>(_buffer.size()));
+  {
+    boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+
+    // The buffer is shared with other subscribers, so it is copied unless
+    // it goes through shared memory.
+    if (!this->EnqueueSharedMemory(_buffer, _cb, _id))
+      this->EnqueuePayload(std::string(_buffer), _cb, _id);
+  }
+
+  this->StartWrite(_force);
+}
+
+//////////////////////////////////////////////////
+void Connection::EnqueueMsg(std::string &&_buffer,
+    boost::function<void(uint32_t)> _cb, uint32_t _id, bool _force)
+{
+  // Don't enqueue empty messages
+  if (_buffer.empty() || !this->IsOpen())
+  {
+    return;
+  }
 
   {
     boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+    if (!this->EnqueueSharedMemory(_buffer, _cb, _id))
+      this->EnqueuePayload(std::move(_buffer), _cb, _id);
+  }
 
-    if (this->writeQueue.empty() ||
-        (this->writeCount > 0 && this->writeQueue.size() == 1) ||
-        (this->writeQueue.back().size() + HEADER_LENGTH + _buffer.size() >
-         4096))
-    {
-      this->writeQueue.push_back(std::string(headerBuffer) + _buffer);
-      this->callbacks.push_back({std::make_pair(_cb, _id)});
-    }
-    else
-    {
-      this->writeQueue.back() += std::string(headerBuffer) + _buffer;
-      this->callbacks.back().push_back(std::make_pair(_cb, _id));
-    }
+  this->StartWrite(_force);
+}
+
+//////////////////////////////////////////////////
+bool Connection::EnqueueSharedMemory(const std::string &_buffer,
+    boost::function<void(uint32_t)> _cb, uint32_t _id)
+{
+  // Large messages go through shared memory when possible, the frame
+  // then holds the position, size and segment name of the payload.
+  uint64_t position;
+  if (!this->shmWriter || _buffer.size() < kSharedMemoryThreshold ||
+      !this->shmWriter->Write(_buffer.data(), _buffer.size(), position))
+  {
+    return false;
   }
 
+  this->writeQueue.emplace_back();
+  WriteFrame &frame = this->writeQueue.back();
+
+  const uint64_t size = _buffer.size();
+  const std::string name = this->shmWriter->Name();
+  frame.payload.resize(sizeof(position) + sizeof(size));
+  memcpy(&frame.payload[0], &position, sizeof(position));
+  memcpy(&frame.payload[sizeof(position)], &size, sizeof(size));
+  frame.payload += name;
+  this->WriteHeader(frame.payload.size(), true, frame.header);
+  frame.header[1] = static_cast<char>(kSharedMemoryFlag);
+  frame.callback = _cb;
+  frame.id = _id;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void Connection::EnqueuePayload(std::string &&_buffer,
+    boost::function<void(uint32_t)> _cb, uint32_t _id)
+{
+  this->writeQueue.emplace_back();
+  WriteFrame &frame = this->writeQueue.back();
+
+  this->WriteHeader(_buffer.size(), this->binaryFraming, frame.header);
+  frame.payload = std::move(_buffer);
+  frame.callback = _cb;
+  frame.id = _id;
+}
+
+//////////////////////////////////////////////////
+void Connection::StartWrite(bool _force)
+{
   if (_force)
   {
     this->ProcessWriteQueue();
@@ -355,13 +452,21 @@ void Connection::ProcessWriteQueue(bool _blocking)
   this->writeCount++;
 
   // Write the serialized data to the socket. We use
-  // "gather-write" to send both the head and the data in
-  // a single write operation
+  // "gather-write" to send the headers and the data of several messages
+  // in a single write operation
+  this->writeBatch = std::min(this->writeQueue.size(), kMaxWriteBatch);
+  std::vector<boost::asio::const_buffer> buffers;
+  buffers.reserve(this->writeBatch * 2);
+  for (std::size_t i = 0; i < this->writeBatch; ++i)
+  {
+    const WriteFrame &frame = this->writeQueue[i];
+    buffers.push_back(boost::asio::buffer(frame.header, HEADER_LENGTH));
+    buffers.push_back(boost::asio::buffer(frame.payload));
+  }
+
   if (!_blocking)
   {
-    boost::asio::async_write(*this->socket,
-        boost::asio::buffer(this->writeQueue.front().c_str(),
-          this->writeQueue.front().size()),
+    boost::asio::async_write(*this->socket, buffers,
           common::weakBind(&Connection::OnWrite, this->shared_from_this(),
             boost::asio::placeholders::error));
   }
@@ -369,9 +474,7 @@ void Connection::ProcessWriteQueue(bool _blocking)
   {
     try
     {
-      boost::asio::write(*this->socket,
-          boost::asio::buffer(this->writeQueue.front().c_str(),
-            this->writeQueue.front().size()));
+      boost::asio::write(*this->socket, buffers);
     }
     catch(...)
     {
@@ -397,17 +500,16 @@ std::string Connection::GetRemoteURI() const
 //////////////////////////////////////////////////
 void Connection::PostWrite()
 {
-  // Call the callbacks, if not NULL
-  if (!this->callbacks.empty())
+  // Call the callbacks of the written messages, if not NULL. The queue may
+  // have been cleared by Close in the meantime.
+  for (; this->writeBatch > 0 && !this->writeQueue.empty(); --this->writeBatch)
   {
-    for (auto const &callback : this->callbacks.front())
-      if (!callback.first.empty())
-        callback.first(callback.second);
-    this->callbacks.pop_front();
-  }
-
-  if (!this->writeQueue.empty())
+    const WriteFrame &frame = this->writeQueue.front();
+    if (!frame.callback.empty())
+      frame.callback(frame.id);
     this->writeQueue.pop_front();
+  }
+  this->writeBatch = 0;
   this->writeCount--;
 }
 
@@ -489,7 +591,6 @@ void Connection::Close()
 
   boost::recursive_mutex::scoped_lock lock2(this->writeMutex);
   this->writeQueue.clear();
-  this->callbacks.clear();
 }
 
 //////////////////////////////////////////////////
@@ -531,7 +632,6 @@ bool Connection::Read(std::string &data)
 {
   bool result = false;
   char header[HEADER_LENGTH];
-  std::vector<char> incoming;
 
   std::size_t incoming_size;
   boost::system::error_code error;
@@ -548,16 +648,18 @@ bool Connection::Read(std::string &data)
   }
 
   // Parse the header to get the size of the incoming data packet
-  incoming_size = this->ParseHeader(std::string(header, HEADER_LENGTH));
+  incoming_size = this->ParseHeader(header);
+  const bool isShm = this->IsSharedMemoryHeader(header);
   if (incoming_size > 0)
   {
-    incoming.resize(incoming_size);
+    // Read directly into the destination string
+    data.resize(incoming_size);
 
     std::size_t len = 0;
     do
     {
       // Read in the actual data
-      len += this->socket->read_some(boost::asio::buffer(&incoming[len],
+      len += this->socket->read_some(boost::asio::buffer(&data[len],
             incoming_size - len), error);
     } while (len < incoming_size && !error && !this->readQuit);
 
@@ -570,8 +672,7 @@ bool Connection::Read(std::string &data)
     if (error)
       throw boost::system::system_error(error);
 
-    data = std::string(&incoming[0], incoming.size());
-    result = true;
+    result = !isShm || this->ReadSharedMemory(data);
   }
 
   return result;
@@ -627,18 +728,245 @@ unsigned int Connection::GetRemotePort() const
 
 
 //////////////////////////////////////////////////
-std::size_t Connection::ParseHeader(const std::string &header)
+std::size_t Connection::ParseHeader(const char *_header)
+{
+  const unsigned char *header =
+    reinterpret_cast<const unsigned char *>(_header);
+  std::size_t dataSize = 0;
+
+  // Binary header: magic byte, three reserved bytes and a big endian size
+  if (header[0] == kBinaryHeaderMagic)
+  {
+    for (int i = 4; i < HEADER_LENGTH; ++i)
+      dataSize = (dataSize << 8) | header[i];
+    return dataSize;
+  }
+
+  // ASCII header: the size in hex digits
+  for (int i = 0; i < HEADER_LENGTH; ++i)
+  {
+    unsigned char c = header[i];
+    unsigned int digit;
+    if (c >= '0' && c <= '9')
+      digit = c - '0';
+    else if (c >= 'a' && c <= 'f')
+      digit = c - 'a' + 10;
+    else if (c >= 'A' && c <= 'F')
+      digit = c - 'A' + 10;
+    else
+    {
+      // Header doesn't seem to be valid. Inform the caller
+      return 0;
+    }
+    dataSize = (dataSize << 4) | digit;
+  }
+
+  return dataSize;
+}
+
+//////////////////////////////////////////////////
+bool Connection::IsSharedMemoryHeader(const char *_header)
 {
-  std::size_t data_size = 0;
-  std::istringstream is(header);
+  const unsigned char *header =
+    reinterpret_cast<const unsigned char *>(_header);
+  return header[0] == kBinaryHeaderMagic &&
+    (header[1] & kSharedMemoryFlag) != 0;
+}
 
-  if (!(is >> std::hex >> data_size))
+//////////////////////////////////////////////////
+bool Connection::ReadSharedMemory(std::string &_data)
+{
+  uint64_t position;
+  uint64_t size;
+  if (_data.size() <= sizeof(position) + sizeof(size))
   {
-    // Header doesn't seem to be valid. Inform the caller
-    boost::system::error_code error(boost::asio::error::invalid_argument);
+    gzerr << "Invalid shared memory reference\n";
+    return false;
   }
 
-  return data_size;
+  memcpy(&position, &_data[0], sizeof(position));
+  memcpy(&size, &_data[sizeof(position)], sizeof(size));
+  const std::string name = _data.substr(sizeof(position) + sizeof(size));
+
+  boost::recursive_mutex::scoped_lock lock(this->readMutex);
+
+  // Once a segment could not be opened, the remote side is asked to send
+  // through the socket, and the references it sent meanwhile are dropped.
+  if (this->shmFailed)
+    return false;
+
+  if (!this->shmReader || this->shmReader->Name() != name)
+  {
+    // Only open segments created by a Connection, the name comes from the
+    // remote side.
+    const std::string prefix(kSharedMemoryPrefix);
+    bool opened = false;
+    if (name.compare(0, prefix.size(), prefix) != 0 ||
+        name.find('/') != std::string::npos)
+    {
+      gzerr << "Invalid shared memory segment name[" << name << "]\n";
+    }
+    else
+    {
+      this->shmReader.reset(new SharedMemoryRing());
+      opened = this->shmReader->Open(name);
+    }
+
+    if (!opened)
+    {
+      gzerr << "Unable to read shared memory from connection[" << this->id
+        << "], falling back to the socket\n";
+      this->shmReader.reset();
+      this->shmFailed = true;
+      return false;
+    }
+  }
+
+  if (!this->shmReader->Read(position, size, _data))
+  {
+    gzerr << "Invalid shared memory reference to segment[" << name << "]\n";
+    return false;
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void Connection::ReuseInboundBuffer(const std::size_t _size)
+{
+  // The buffer of the previous message was handed over to its read task
+  if (this->inboundData.capacity() >= _size)
+    return;
+
+  boost::mutex::scoped_lock lock(this->spareInboundMutex);
+  if (!this->spareInbound.empty())
+  {
+    this->inboundData.swap(this->spareInbound.back());
+    this->spareInbound.pop_back();
+  }
+}
+
+//////////////////////////////////////////////////
+void Connection::RecycleInboundBuffer(std::string &_buffer)
+{
+  // Very large buffers are released, they would otherwise be kept for the
+  // lifetime of the connection.
+  if (_buffer.capacity() > kMaxSpareInboundSize)
+    return;
+
+  boost::mutex::scoped_lock lock(this->spareInboundMutex);
+  if (this->spareInbound.size() < kMaxSpareInbound)
+  {
+    _buffer.clear();
+    this->spareInbound.emplace_back();
+    this->spareInbound.back().swap(_buffer);
+  }
+}
+
+//////////////////////////////////////////////////
+bool Connection::EnableSharedMemory()
+{
+  uint64_t sizeMB = kSharedMemoryDefaultSize;
+  char *sizeEnv = getenv("GAZEBO_SHM_SIZE");
+  if (sizeEnv)
+  {
+    try
+    {
+      sizeMB = boost::lexical_cast<uint64_t>(sizeEnv);
+    }
+    catch(...)
+    {
+      gzwarn << "Invalid GAZEBO_SHM_SIZE[" << sizeEnv << "]\n";
+    }
+  }
+
+  if (sizeMB == 0 || !this->IsOpen())
+    return false;
+
+  // The pair of ports identifies the connection on this host
+  const std::string name = kSharedMemoryPrefix +
+    boost::lexical_cast<std::string>(this->GetLocalPort()) + "_" +
+    boost::lexical_cast<std::string>(this->GetRemotePort());
+
+  std::unique_ptr<SharedMemoryRing> ring(new SharedMemoryRing());
+  if (!ring->Create(name, sizeMB * 1024 * 1024))
+    return false;
+
+  boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+  this->shmWriter = std::move(ring);
+  this->binaryFraming = true;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void Connection::DisableSharedMemory()
+{
+  boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+  this->shmWriter.reset();
+}
+
+//////////////////////////////////////////////////
+bool Connection::SharedMemory() const
+{
+  boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+  return this->shmWriter != nullptr;
+}
+
+//////////////////////////////////////////////////
+bool Connection::SharedMemoryFailed()
+{
+  boost::recursive_mutex::scoped_lock lock(this->readMutex);
+  return this->shmFailed;
+}
+
+//////////////////////////////////////////////////
+bool Connection::IsSameHost() const
+{
+  boost::mutex::scoped_lock lock(this->socketMutex);
+  if (!this->socket || !this->socket->is_open())
+    return false;
+
+  boost::system::error_code localError, remoteError;
+  boost::asio::ip::address local =
+    this->socket->local_endpoint(localError).address();
+  boost::asio::ip::address remote =
+    this->socket->remote_endpoint(remoteError).address();
+
+  return !localError && !remoteError && local == remote;
+}
+
+//////////////////////////////////////////////////
+void Connection::WriteHeader(const std::size_t _size, const bool _binary,
+    char *_header)
+{
+  uint32_t size = static_cast<uint32_t>(_size);
+  if (_binary)
+  {
+    _header[0] = static_cast<char>(kBinaryHeaderMagic);
+    _header[1] = _header[2] = _header[3] = 0;
+    for (int i = HEADER_LENGTH - 1; i >= 4; --i, size >>= 8)
+      _header[i] = static_cast<char>(size & 0xff);
+  }
+  else
+  {
+    static const char digits[] = "0123456789abcdef";
+    for (int i = HEADER_LENGTH - 1; i >= 0; --i, size >>= 4)
+      _header[i] = digits[size & 0xf];
+  }
+}
+
+//////////////////////////////////////////////////
+void Connection::SetBinaryFraming(const bool _binary)
+{
+  boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+  this->binaryFraming = _binary;
+}
+
+//////////////////////////////////////////////////
+bool Connection::BinaryFraming() const
+{
+  boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+  return this->binaryFraming;
 }
 
 //////////////////////////////////////////////////
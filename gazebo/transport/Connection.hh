@@ -31,12 +31,14 @@
 #include <iostream>
 #include <iomanip>
 #include <deque>
+#include <memory>
 #include <utility>
 
 #include "gazebo/common/Event.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/WeakBind.hh"
+#include "gazebo/transport/SharedMemoryRing.hh"
 #include "gazebo/util/system.hh"
 
 #define HEADER_LENGTH 8
@@ -68,17 +70,52 @@ namespace gazebo
               {
               }
 
+      /// \brief Constructor that takes ownership of the data.
+      /// \param[_in] _func Boost function pointer, which is the function
+      /// that receives the data.
+      /// \param[in] _data Data to send to the boost function pointer.
+      public: ConnectionReadTask(
+                  boost::function<void (const std::string &)> _func,
+                  std::string &&_data) :
+                func(_func),
+                data(std::move(_data))
+              {
+              }
+
+      /// \brief Constructor that takes ownership of the data and gives the
+      /// buffer back once the data has been handled.
+      /// \param[_in] _func Boost function pointer, which is the function
+      /// that receives the data.
+      /// \param[in] _data Data to send to the boost function pointer.
+      /// \param[in] _recycle Function that receives the buffer after _func
+      /// returns.
+      public: ConnectionReadTask(
+                  boost::function<void (const std::string &)> _func,
+                  std::string &&_data,
+                  boost::function<void (std::string &)> _recycle) :
+                func(_func),
+                data(std::move(_data)),
+                recycle(_recycle)
+              {
+              }
+
       /// \bried Overridden function from tbb::task that exectues the data
       /// callback.
       public: tbb::task *execute()
               {
                 this->func(this->data);
+                if (!this->recycle.empty())
+                  this->recycle(this->data);
                 return NULL;
               }
 
       /// \brief The boost function pointer
       private: boost::function<void (const std::string &)> func;
 
+      /// \brief Function that receives the buffer after it was handled,
+      /// may be empty.
+      private: boost::function<void (std::string &)> recycle;
+
       /// \brief The data to send to the boost function pointer
       private: std::string data;
     };
@@ -95,6 +132,9 @@ namespace gazebo
     /// IP lookup.
     ///   - GAZEBO_HOSTNAME: Hostame to export. Setting this will override
     /// both GAZEBO_IP and the default IP lookup.
+    ///   - GAZEBO_SHM_SIZE: Size in MB of the shared memory ring used to
+    /// send large messages to subscribers on the same host. Defaults to 64,
+    /// 0 disables the shared memory transport.
     ///
     /// \class Connection Connection.hh transport/transport.hh
     /// \brief Single TCP/IP connection manager
@@ -162,12 +202,73 @@ namespace gazebo
                   boost::function<void(uint32_t)> _cb, uint32_t _id,
                   bool _force = false);
 
+      /// \brief Write data to the socket, without copying it.
+      /// \param[in] _buffer Data to write, moved into the write queue
+      /// \param[in] _force If true, block until the data has been written
+      /// to the socket, otherwise just enqueue the data for asynchronous write
+      /// \param[in] _cb If non-null, callback to be invoked after
+      /// transmission is complete.
+      /// \param[in] _id ID associated with the message data.
+      public: void EnqueueMsg(std::string &&_buffer,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id,
+                  bool _force = false);
+
       /// \brief Write data to the socket
       /// \param[in] _buffer Data to write
       /// \param[in] _force If true, block until the data has been written
       /// to the socket, otherwise just enqueue the data for asynchronous write
       public: void EnqueueMsg(const std::string &_buffer, bool _force = false);
 
+      /// \brief Write data to the socket, without copying it.
+      /// \param[in] _buffer Data to write, moved into the write queue
+      /// \param[in] _force If true, block until the data has been written
+      /// to the socket, otherwise just enqueue the data for asynchronous write
+      public: void EnqueueMsg(std::string &&_buffer, bool _force = false);
+
+      /// \brief Use binary message headers for the data written to this
+      /// connection. Binary headers hold the payload size as a big endian
+      /// integer instead of ASCII hex digits. Reads always accept both
+      /// formats, so binary framing must only be enabled once the remote
+      /// side is known to support it, see msgs::Subscribe::binary_framing.
+      /// \param[in] _binary True to write binary headers.
+      public: void SetBinaryFraming(const bool _binary);
+
+      /// \brief Get whether binary message headers are written.
+      /// \return True if binary framing is enabled.
+      /// \sa SetBinaryFraming
+      public: bool BinaryFraming() const;
+
+      /// \brief Send large messages through a shared memory ring instead
+      /// of the socket. The payload is copied into the ring once, and only
+      /// its position is written to the socket, the remote side reads the
+      /// payload from the ring. This also enables binary framing, and must
+      /// only be used once the remote side is known to run on the same
+      /// host and to support it, see msgs::Subscribe::shared_memory.
+      /// \return True if the shared memory ring was created.
+      /// \sa IsSameHost
+      public: bool EnableSharedMemory();
+
+      /// \brief Stop sending large messages through shared memory, e.g.
+      /// when the remote side could not open the ring. Messages already
+      /// queued as shared memory references are still sent.
+      public: void DisableSharedMemory();
+
+      /// \brief Get whether large messages are sent through shared memory.
+      /// \return True if the shared memory transport is enabled.
+      public: bool SharedMemory() const;
+
+      /// \brief Get whether a shared memory reference read from this
+      /// connection was rejected, because its segment name is invalid or
+      /// the segment could not be opened. The reference is then dropped,
+      /// as are all later ones, and the remote side should be asked to
+      /// disable shared memory, see DisableSharedMemory.
+      /// \return True if reading shared memory failed.
+      public: bool SharedMemoryFailed();
+
+      /// \brief Check if both ends of the connection run on the same host.
+      /// \return True if the local and remote addresses are the same.
+      public: bool IsSameHost() const;
+
       /// \brief Get the local URI
       /// \return The local URI
       public: std::string GetLocalURI() const;
@@ -215,7 +316,6 @@ namespace gazebo
                 void (Connection::*f)(const boost::system::error_code &,
                     boost::tuple<Handler>) = &Connection::OnReadHeader<Handler>;
 
-                this->inboundHeader.resize(HEADER_LENGTH);
                 boost::asio::async_read(*this->socket,
                     boost::asio::buffer(this->inboundHeader),
                     common::weakBind(f, this->shared_from_this(),
@@ -241,16 +341,16 @@ namespace gazebo
                 }
                 else
                 {
-                  std::size_t inboundData_size = 0;
-                  std::string header(&this->inboundHeader[0],
-                                      this->inboundHeader.size());
-                  this->inboundHeader.clear();
-
-                  inboundData_size = this->ParseHeader(header);
+                  std::size_t inboundData_size =
+                    this->ParseHeader(this->inboundHeader);
+                  this->inboundShm =
+                    this->IsSharedMemoryHeader(this->inboundHeader);
 
-                 if (inboundData_size > 0)
+                  if (inboundData_size > 0)
                   {
-                    // Start the asynchronous call to receive data
+                    // Start the asynchronous call to receive data, into
+                    // a buffer of a previous message if one is available
+                    this->ReuseInboundBuffer(inboundData_size);
                     this->inboundData.resize(inboundData_size);
 
                     void (Connection::*f)(const boost::system::error_code &e,
@@ -258,7 +358,8 @@ namespace gazebo
                       &Connection::OnReadData<Handler>;
 
                     boost::asio::async_read(*this->socket,
-                        boost::asio::buffer(this->inboundData),
+                        boost::asio::buffer(&this->inboundData[0],
+                          this->inboundData.size()),
                         common::weakBind(f, this->shared_from_this(),
                                     boost::asio::placeholders::error,
                                     _handler));
@@ -300,10 +401,15 @@ namespace gazebo
                     this->isOpen = false;
                 }
 
-                // Inform caller that data has been received
-                std::string data(&this->inboundData[0],
-                                  this->inboundData.size());
-                this->inboundData.clear();
+                // Inform caller that data has been received. The buffer is
+                // handed over to the read task, so the payload is not copied,
+                // and given back to this connection once it was handled.
+                std::string data;
+                data.swap(this->inboundData);
+
+                // Replace a shared memory reference with its payload
+                if (!_e && this->inboundShm && !this->ReadSharedMemory(data))
+                  data.clear();
 
                 if (data.empty())
                   gzerr << "OnReadData got empty data!!!\n";
@@ -311,7 +417,10 @@ namespace gazebo
                 if (!_e && !transport::is_stopped())
                 {
                   ConnectionReadTask *task = new(tbb::task::allocate_root())
-                        ConnectionReadTask(boost::get<0>(_handler), data);
+                        ConnectionReadTask(boost::get<0>(_handler),
+                            std::move(data),
+                            common::weakBind(&Connection::RecycleInboundBuffer,
+                              this->shared_from_this(), _1));
                   tbb::task::enqueue(*task);
 
                   // Non-tbb version:
@@ -357,8 +466,62 @@ namespace gazebo
       private: void OnAccept(const boost::system::error_code &_e);
 
       /// \brief Parse a header to get the size of a packet
-      /// \param[in] _header Header as a string
-      private: std::size_t ParseHeader(const std::string &_header);
+      /// \param[in] _header Header of HEADER_LENGTH bytes, in ASCII or
+      /// binary format.
+      /// \return Size of the packet, 0 if the header is invalid.
+      private: static std::size_t ParseHeader(const char *_header);
+
+      /// \brief Check if a header announces a shared memory reference
+      /// instead of a payload.
+      /// \param[in] _header Header of HEADER_LENGTH bytes.
+      /// \return True if the packet is a shared memory reference.
+      private: static bool IsSharedMemoryHeader(const char *_header);
+
+      /// \brief Replace a shared memory reference with the payload it
+      /// points to. The shared memory segment is opened on first use.
+      /// \param[in,out] _data Reference on input, payload on output.
+      /// \return False if the reference is invalid.
+      private: bool ReadSharedMemory(std::string &_data);
+
+      /// \brief Add a shared memory reference to the write queue, if the
+      /// shared memory transport is enabled and the message is large enough.
+      /// The write mutex must be locked.
+      /// \param[in] _buffer Message data.
+      /// \param[in] _cb Callback to invoke after transmission.
+      /// \param[in] _id ID associated with the message data.
+      /// \return True if the reference was queued.
+      private: bool EnqueueSharedMemory(const std::string &_buffer,
+                   boost::function<void(uint32_t)> _cb, uint32_t _id);
+
+      /// \brief Add a message to the write queue. The write mutex must be
+      /// locked.
+      /// \param[in] _buffer Message data, moved into the queue.
+      /// \param[in] _cb Callback to invoke after transmission.
+      /// \param[in] _id ID associated with the message data.
+      private: void EnqueuePayload(std::string &&_buffer,
+                   boost::function<void(uint32_t)> _cb, uint32_t _id);
+
+      /// \brief Write the queue now, or let the connection manager do it.
+      /// \param[in] _force True to write the queue now.
+      private: void StartWrite(bool _force);
+
+      /// \brief Replace inboundData with a spare buffer, if it is too small
+      /// for the next message and a spare buffer is available.
+      /// \param[in] _size Size of the next message.
+      private: void ReuseInboundBuffer(const std::size_t _size);
+
+      /// \brief Keep the buffer of a handled message to read a later
+      /// message into it.
+      /// \param[in,out] _buffer Buffer, left empty if it is kept.
+      private: void RecycleInboundBuffer(std::string &_buffer);
+
+      /// \brief Write a header for a packet.
+      /// \param[in] _size Size of the packet.
+      /// \param[in] _binary True to write a binary header, false to write
+      /// an ASCII one.
+      /// \param[out] _header Header of HEADER_LENGTH bytes to fill.
+      private: static void WriteHeader(const std::size_t _size,
+                   const bool _binary, char *_header);
 
       /// \brief the read thread
       private: void ReadLoop(const ReadCallback &_cb);
@@ -388,20 +551,55 @@ namespace gazebo
       /// \brief Accepts new connections.
       private: boost::asio::ip::tcp::acceptor *acceptor;
 
-      /// \brief Outgoing data queue
-      private: std::deque<std::string> writeQueue;
+      /// \brief One outgoing message. The header and the payload are
+      /// written with a single gather write, without being concatenated.
+      private: class WriteFrame
+      {
+        /// \brief Message header.
+        public: char header[HEADER_LENGTH];
 
-      /// \brief List of callbacks, paired with writeQueue. The callbacks
-      /// are used to notify a publisher when a message is successfully sent.
-      private: std::deque< std::vector<
-               std::pair<boost::function<void(uint32_t)>, uint32_t> > >
-                 callbacks;
+        /// \brief Message payload.
+        public: std::string payload;
+
+        /// \brief Callback used to notify a publisher when the message is
+        /// successfully sent.
+        public: boost::function<void(uint32_t)> callback;
+
+        /// \brief Id passed to the callback.
+        public: uint32_t id;
+      };
+
+      /// \brief Outgoing message queue. Elements are never moved while
+      /// they are being written, since a deque keeps references valid when
+      /// elements are added at its end.
+      private: std::deque<WriteFrame> writeQueue;
+
+      /// \brief Number of messages of writeQueue that are being written.
+      private: std::size_t writeBatch;
+
+      /// \brief True to write binary headers.
+      private: bool binaryFraming;
+
+      /// \brief Ring used to write large messages, null if the shared
+      /// memory transport is disabled.
+      private: std::unique_ptr<SharedMemoryRing> shmWriter;
+
+      /// \brief Ring the remote side writes large messages to, opened when
+      /// the first shared memory reference is read.
+      private: std::unique_ptr<SharedMemoryRing> shmReader;
+
+      /// \brief True if the message being read is a shared memory
+      /// reference.
+      private: bool inboundShm;
+
+      /// \brief True if a shared memory reference could not be read.
+      private: bool shmFailed;
 
       /// \brief Mutex to protect new connections.
       private: boost::mutex connectMutex;
 
       /// \brief Mutex to protect write.
-      private: boost::recursive_mutex writeMutex;
+      private: mutable boost::recursive_mutex writeMutex;
 
       /// \brief Mutex to protect reads.
       private: boost::recursive_mutex readMutex;
@@ -416,10 +614,16 @@ namespace gazebo
       private: AcceptCallback acceptCB;
 
       /// \brief Header data from a new message.
-      private: std::vector<char> inboundHeader;
+      private: char inboundHeader[HEADER_LENGTH];
 
       /// \brief Content data from a new message.
-      private: std::vector<char> inboundData;
+      private: std::string inboundData;
+
+      /// \brief Buffers of handled messages, reused by the next reads.
+      private: std::vector<std::string> spareInbound;
+
+      /// \brief Mutex to protect spareInbound.
+      private: boost::mutex spareInboundMutex;
 
       /// \brief Set to true to stop reading on the connection.
       private: bool readQuit;
@@ -478,13 +478,49 @@ void ConnectionManager::OnRead(ConnectionPtr _connection,
     msgs::Subscribe sub;
     sub.ParseFromString(packet.serialized_data());
 
+    // Older subscribers only understand ASCII headers
+    if (sub.binary_framing())
+      _connection->SetBinaryFraming(true);
+
+    // Large messages to a subscriber on this host are written once to
+    // shared memory instead of being copied through the loopback socket
+    if (sub.binary_framing() && sub.shared_memory() &&
+        _connection->IsSameHost() && !_connection->SharedMemory())
+    {
+      _connection->EnableSharedMemory();
+    }
+
     // Create a transport link for the publisher to the remote subscriber
     // via the connection
     SubscriptionTransportPtr subLink(new SubscriptionTransport());
-    subLink->Init(_connection, sub.latching());
+    subLink->Init(_connection, sub.latching(), sub.conflating());
 
     // Connect the publisher to this transport mechanism
     TopicManager::Instance()->ConnectPubToSub(sub.topic(), subLink);
+
+    // Keep reading, the subscriber may ask to disable shared memory or
+    // conflation
+    _connection->AsyncRead(
+        boost::bind(&ConnectionManager::OnRead, this, _connection, _1));
+  }
+  // The subscriber could not open the shared memory ring, e.g. because it
+  // runs in another container. Later messages go through the socket.
+  else if (packet.type() == "disable_shared_memory")
+  {
+    gzwarn << "Subscriber on connection[" << _connection->GetRemoteURI()
+      << "] could not read shared memory, falling back to the socket\n";
+    _connection->DisableSharedMemory();
+    _connection->AsyncRead(
+        boost::bind(&ConnectionManager::OnRead, this, _connection, _1));
+  }
+  // The subscriber added a callback which wants every message
+  else if (packet.type() == "disable_conflating")
+  {
+    msgs::Subscribe sub;
+    sub.ParseFromString(packet.serialized_data());
+    TopicManager::Instance()->DisableConflating(sub.topic(), _connection);
+    _connection->AsyncRead(
+        boost::bind(&ConnectionManager::OnRead, this, _connection, _1));
   }
   else
     gzerr << "Error est here\n";
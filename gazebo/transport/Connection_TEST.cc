@@ -17,8 +17,13 @@
 
 #include <gtest/gtest.h>
 #include <string>
+#include <vector>
 #include <stdlib.h>
 
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "gazebo/common/Time.hh"
 #include "gazebo/transport/Connection.hh"
 #include "test/util.hh"
 
@@ -64,6 +69,195 @@ TEST_F(Connection, IPWhiteList)
     setenv("GAZEBO_IP_WHITE_LIST", ipEnv, 1);
 }
 
+/////////////////////////////////////////////////
+/// \brief Collects the messages read from a connection.
+class FramingReader
+{
+  /// \brief Start reading from a connection.
+  /// \param[in] _conn Connection to read from.
+  public: void Read(const transport::ConnectionPtr &_conn)
+          {
+            this->conn = _conn;
+            this->conn->AsyncRead(
+                boost::bind(&FramingReader::OnRead, this, _1));
+          }
+
+  /// \brief Callback for each message.
+  /// \param[in] _data Message payload.
+  public: void OnRead(const std::string &_data)
+          {
+            {
+              boost::mutex::scoped_lock lock(this->mutex);
+              this->messages.push_back(_data);
+            }
+            this->conn->AsyncRead(
+                boost::bind(&FramingReader::OnRead, this, _1));
+          }
+
+  /// \brief Wait for a number of messages. The write queue of the
+  /// sender is processed meanwhile, like ConnectionManager does.
+  /// \param[in] _count Number of messages.
+  /// \param[in] _sender Connection the messages are sent from.
+  /// \return True if the messages were received in time.
+  public: bool Wait(const size_t _count,
+                    const transport::ConnectionPtr &_sender)
+          {
+            for (int i = 0; i < 500; ++i)
+            {
+              {
+                boost::mutex::scoped_lock lock(this->mutex);
+                if (this->messages.size() >= _count)
+                  return true;
+              }
+              _sender->ProcessWriteQueue();
+              gazebo::common::Time::MSleep(10);
+            }
+            return false;
+          }
+
+  /// \brief Connection being read.
+  public: transport::ConnectionPtr conn;
+
+  /// \brief Received messages.
+  public: std::vector<std::string> messages;
+
+  /// \brief Protects messages.
+  public: boost::mutex mutex;
+};
+
+/////////////////////////////////////////////////
+TEST_F(Connection, Framing)
+{
+  FramingReader reader;
+  transport::ConnectionPtr server(new transport::Connection());
+  server->Listen(0, boost::bind(&FramingReader::Read, &reader, _1));
+
+  transport::ConnectionPtr client(new transport::Connection());
+  ASSERT_TRUE(client->Connect("127.0.0.1", server->GetLocalPort()));
+  EXPECT_FALSE(client->BinaryFraming());
+
+  // ASCII headers, then binary headers on the same connection
+  std::string large(100000, 'x');
+  client->EnqueueMsg("ascii", true);
+  client->EnqueueMsg(large, true);
+  client->SetBinaryFraming(true);
+  EXPECT_TRUE(client->BinaryFraming());
+  for (int i = 0; i < 50; ++i)
+    client->EnqueueMsg("binary_" + std::to_string(i));
+  client->EnqueueMsg(large, true);
+
+  ASSERT_TRUE(reader.Wait(53, client));
+  boost::mutex::scoped_lock lock(reader.mutex);
+  ASSERT_EQ(reader.messages.size(), 53u);
+  EXPECT_EQ(reader.messages[0], "ascii");
+  EXPECT_EQ(reader.messages[1], large);
+  for (int i = 0; i < 50; ++i)
+    EXPECT_EQ(reader.messages[i + 2], "binary_" + std::to_string(i));
+  EXPECT_EQ(reader.messages[52], large);
+}
+
+/////////////////////////////////////////////////
+TEST_F(Connection, SharedMemory)
+{
+  FramingReader reader;
+  transport::ConnectionPtr server(new transport::Connection());
+  server->Listen(0, boost::bind(&FramingReader::Read, &reader, _1));
+
+  transport::ConnectionPtr client(new transport::Connection());
+  ASSERT_TRUE(client->Connect("127.0.0.1", server->GetLocalPort()));
+  EXPECT_TRUE(client->IsSameHost());
+  EXPECT_FALSE(client->SharedMemory());
+  ASSERT_TRUE(client->EnableSharedMemory());
+  EXPECT_TRUE(client->SharedMemory());
+  EXPECT_TRUE(client->BinaryFraming());
+
+  // Small messages still go through the socket, large ones through the
+  // ring, which wraps around several times.
+  std::string small("small");
+  for (int i = 0; i < 20; ++i)
+  {
+    client->EnqueueMsg(
+        std::string(10 * 1024 * 1024, static_cast<char>('a' + i)));
+    client->EnqueueMsg(small);
+    ASSERT_TRUE(reader.Wait(2 * (i + 1), client));
+  }
+
+  boost::mutex::scoped_lock lock(reader.mutex);
+  ASSERT_EQ(reader.messages.size(), 40u);
+  for (int i = 0; i < 20; ++i)
+  {
+    EXPECT_EQ(reader.messages[2 * i],
+        std::string(10 * 1024 * 1024, static_cast<char>('a' + i)));
+    EXPECT_EQ(reader.messages[2 * i + 1], small);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(Connection, SharedMemoryFallback)
+{
+  FramingReader reader;
+  transport::ConnectionPtr server(new transport::Connection());
+  server->Listen(0, boost::bind(&FramingReader::Read, &reader, _1));
+
+  transport::ConnectionPtr client(new transport::Connection());
+  ASSERT_TRUE(client->Connect("127.0.0.1", server->GetLocalPort()));
+  ASSERT_TRUE(client->EnableSharedMemory());
+
+  // Remove the name of the segment, so the reader can't open it
+  boost::interprocess::shared_memory_object::remove(
+      ("gazebo_shm_" + std::to_string(client->GetLocalPort()) + "_" +
+       std::to_string(client->GetRemotePort())).c_str());
+
+  const std::string large(100000, 'x');
+  client->EnqueueMsg(large, true);
+  ASSERT_TRUE(reader.Wait(1, client));
+  {
+    boost::mutex::scoped_lock lock(reader.mutex);
+    EXPECT_TRUE(reader.messages[0].empty());
+    EXPECT_TRUE(reader.conn->SharedMemoryFailed());
+  }
+
+  // Large messages go through the socket once the writer disables shared
+  // memory
+  client->DisableSharedMemory();
+  EXPECT_FALSE(client->SharedMemory());
+  EXPECT_TRUE(client->BinaryFraming());
+  client->EnqueueMsg(large, true);
+  ASSERT_TRUE(reader.Wait(2, client));
+  boost::mutex::scoped_lock lock(reader.mutex);
+  EXPECT_EQ(reader.messages[1], large);
+}
+
+/////////////////////////////////////////////////
+TEST_F(Connection, PayloadBuffers)
+{
+  FramingReader reader;
+  transport::ConnectionPtr server(new transport::Connection());
+  server->Listen(0, boost::bind(&FramingReader::Read, &reader, _1));
+
+  transport::ConnectionPtr client(new transport::Connection());
+  ASSERT_TRUE(client->Connect("127.0.0.1", server->GetLocalPort()));
+  client->SetBinaryFraming(true);
+
+  // Moved payloads, of growing then shrinking size, so the reader reads
+  // into buffers of earlier messages which are larger and smaller than the
+  // next message.
+  std::vector<std::string> sent;
+  for (int i = 0; i < 40; ++i)
+  {
+    const size_t size = 1000 * (i < 20 ? i + 1 : 40 - i);
+    sent.push_back(std::string(size, static_cast<char>('a' + i % 26)));
+
+    std::string payload = sent.back();
+    client->EnqueueMsg(std::move(payload), (i % 4) == 0);
+  }
+
+  ASSERT_TRUE(reader.Wait(sent.size(), client));
+  boost::mutex::scoped_lock lock(reader.mutex);
+  EXPECT_EQ(reader.messages, sent);
+}
+
+/////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -14,6 +14,9 @@
  * limitations under the License.
  *
 */
+#include <iterator>
+#include <string>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/bind.hpp>
 #include "gazebo/transport/TransportIface.hh"
@@ -246,10 +249,15 @@ void Node::ProcessIncoming()
         // For each message in the buffer
         for (msgIter = msgInIter; msgIter != msgEndIter; ++msgIter)
         {
+          // Conflating callbacks only get the latest message
+          const bool last = std::next(msgIter) == msgEndIter;
+
           // Send the message to all callbacks
           for (liter = cbIter->second.begin();
               liter != cbIter->second.end(); ++liter)
           {
+            if (!last && (*liter)->GetConflating())
+              continue;
             (*liter)->HandleData(*msgIter,
                 boost::bind(&dummy_callback_fn, _1), 0);
           }
@@ -284,11 +292,33 @@ void Node::ProcessIncoming()
         // For each message in the buffer
         for (msgIter = msgInIter; msgIter != msgEndIter; ++msgIter)
         {
+          // Conflating callbacks only get the latest message
+          const bool last = std::next(msgIter) == msgEndIter;
+
+          // Typed callbacks share the published message. It is only
+          // serialized, once, for raw callbacks.
+          std::string data;
+          bool serialized = false;
+
           // Send the message to all callbacks
           for (liter = cbIter->second.begin();
               liter != cbIter->second.end(); ++liter)
           {
-            (*liter)->HandleMessage(*msgIter);
+            if (!last && (*liter)->GetConflating())
+              continue;
+
+            if ((*liter)->ZeroCopy())
+              (*liter)->HandleMessage(*msgIter);
+            else
+            {
+              if (!serialized)
+              {
+                (*msgIter)->SerializeToString(&data);
+                serialized = true;
+              }
+              (*liter)->HandleData(data,
+                  boost::bind(&dummy_callback_fn, _1), 0);
+            }
           }
         }
       }
@@ -360,6 +390,23 @@ bool Node::HasLatchedSubscriber(const std::string &_topic) const
   return false;
 }
 
+/////////////////////////////////////////////////
+bool Node::HasOnlyConflatingSubscribers(const std::string &_topic) const
+{
+  boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
+  Callback_M::const_iterator iter = this->callbacks.find(_topic);
+  if (iter == this->callbacks.end() || iter->second.empty())
+    return false;
+
+  for (auto const &callback : iter->second)
+  {
+    if (!callback->GetConflating())
+      return false;
+  }
+
+  return true;
+}
+
 /////////////////////////////////////////////////
 void Node::RemoveCallback(const std::string &_topic, unsigned int _id)
 {
@@ -147,6 +147,13 @@ namespace gazebo
       /// \return True if a latched subscriber exists.
       public: bool HasLatchedSubscriber(const std::string &_topic) const;
 
+      /// \brief Check if all the callbacks on a topic are conflating.
+      /// \param[in] _topic Topic to check.
+      /// \return True if the node subscribes to the topic, and only with
+      /// conflating callbacks.
+      public: bool HasOnlyConflatingSubscribers(
+                  const std::string &_topic) const;
+
 
       /// \brief A convenience function for a one-time publication of
       /// a message. This is inefficient, compared to
@@ -236,20 +243,25 @@ namespace gazebo
       /// \param[in] _obj Class instance to be used on receipt of new message
       /// \param[in] _latching If true, latch latest incoming message;
       /// otherwise don't latch
+      /// \param[in] _conflating If true, only the latest message is
+      /// delivered when the subscriber can't keep up: messages which are
+      /// superseded before being sent or processed are skipped
       /// \return Pointer to new Subscriber object
       public: template<typename M, typename T>
       SubscriberPtr Subscribe(const std::string &_topic,
           void(T::*_fp)(const boost::shared_ptr<M const> &), T *_obj,
-          bool _latching = false)
+          bool _latching = false, bool _conflating = false)
       {
         SubscribeOptions ops;
         std::string decodedTopic = this->DecodeTopicName(_topic);
-        ops.template Init<M>(decodedTopic, shared_from_this(), _latching);
+        ops.template Init<M>(decodedTopic, shared_from_this(), _latching,
+            _conflating);
 
         {
           boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
           this->callbacks[decodedTopic].push_back(CallbackHelperPtr(
                 new CallbackHelperT<M>(boost::bind(_fp, _obj, _1), _latching)));
+          this->callbacks[decodedTopic].back()->SetConflating(_conflating);
         }
 
         SubscriberPtr result =
@@ -265,20 +277,25 @@ namespace gazebo
       /// \param[in] _fp Function to be called on receipt of new message
       /// \param[in] _latching If true, latch latest incoming message;
       /// otherwise don't latch
+      /// \param[in] _conflating If true, only the latest message is
+      /// delivered when the subscriber can't keep up: messages which are
+      /// superseded before being sent or processed are skipped
       /// \return Pointer to new Subscriber object
       public: template<typename M>
       SubscriberPtr Subscribe(const std::string &_topic,
           void(*_fp)(const boost::shared_ptr<M const> &),
-                     bool _latching = false)
+                     bool _latching = false, bool _conflating = false)
       {
         SubscribeOptions ops;
         std::string decodedTopic = this->DecodeTopicName(_topic);
-        ops.template Init<M>(decodedTopic, shared_from_this(), _latching);
+        ops.template Init<M>(decodedTopic, shared_from_this(), _latching,
+            _conflating);
 
         {
           boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
           this->callbacks[decodedTopic].push_back(
               CallbackHelperPtr(new CallbackHelperT<M>(_fp, _latching)));
+          this->callbacks[decodedTopic].back()->SetConflating(_conflating);
         }
 
         SubscriberPtr result =
@@ -295,20 +312,24 @@ namespace gazebo
       /// \param[in] _obj Class instance to be used on receipt of new message
       /// \param[in] _latching If true, latch latest incoming message;
       /// otherwise don't latch
+      /// \param[in] _conflating If true, only the latest message is
+      /// delivered when the subscriber can't keep up: messages which are
+      /// superseded before being sent or processed are skipped
       /// \return Pointer to new Subscriber object
       template<typename T>
       SubscriberPtr Subscribe(const std::string &_topic,
           void(T::*_fp)(const std::string &), T *_obj,
-          bool _latching = false)
+          bool _latching = false, bool _conflating = false)
       {
         SubscribeOptions ops;
         std::string decodedTopic = this->DecodeTopicName(_topic);
-        ops.Init(decodedTopic, shared_from_this(), _latching);
+        ops.Init(decodedTopic, shared_from_this(), _latching, _conflating);
 
         {
           boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
           this->callbacks[decodedTopic].push_back(CallbackHelperPtr(
                 new RawCallbackHelper(boost::bind(_fp, _obj, _1))));
+          this->callbacks[decodedTopic].back()->SetConflating(_conflating);
         }
 
         SubscriberPtr result =
@@ -325,18 +346,23 @@ namespace gazebo
       /// \param[in] _fp Function to be called on receipt of new message
       /// \param[in] _latching If true, latch latest incoming message;
       /// otherwise don't latch
+      /// \param[in] _conflating If true, only the latest message is
+      /// delivered when the subscriber can't keep up: messages which are
+      /// superseded before being sent or processed are skipped
       /// \return Pointer to new Subscriber object
       SubscriberPtr Subscribe(const std::string &_topic,
-          void(*_fp)(const std::string &), bool _latching = false)
+          void(*_fp)(const std::string &), bool _latching = false,
+          bool _conflating = false)
       {
         SubscribeOptions ops;
         std::string decodedTopic = this->DecodeTopicName(_topic);
-        ops.Init(decodedTopic, shared_from_this(), _latching);
+        ops.Init(decodedTopic, shared_from_this(), _latching, _conflating);
 
         {
           boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
           this->callbacks[decodedTopic].push_back(
               CallbackHelperPtr(new RawCallbackHelper(_fp)));
+          this->callbacks[decodedTopic].back()->SetConflating(_conflating);
         }
 
         SubscriberPtr result =
@@ -421,7 +447,7 @@ namespace gazebo
 
       private: boost::mutex publisherMutex;
       private: boost::mutex publisherDeleteMutex;
-      private: boost::recursive_mutex incomingMutex;
+      private: mutable boost::recursive_mutex incomingMutex;
 
       /// \brief make sure we don't call ProcessingIncoming simultaneously
       /// from separate threads.
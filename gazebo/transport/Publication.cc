@@ -244,6 +244,26 @@ void Publication::RemoveSubscription(const std::string &_host,
   }
 }
 
+//////////////////////////////////////////////////
+void Publication::DisableConflating(const ConnectionPtr &_conn)
+{
+  boost::mutex::scoped_lock lock(this->callbackMutex);
+  for (auto const &callback : this->callbacks)
+  {
+    SubscriptionTransportPtr subptr =
+      boost::dynamic_pointer_cast<SubscriptionTransport>(callback);
+    if (subptr && subptr->GetConnection() == _conn)
+      subptr->DisableConflating();
+  }
+}
+
+//////////////////////////////////////////////////
+void Publication::DisableTransportConflating()
+{
+  for (auto const &transport : this->transports)
+    transport->DisableConflating();
+}
+
 //////////////////////////////////////////////////
 void Publication::LocalPublish(const std::string &_data)
 {
@@ -319,14 +339,33 @@ int Publication::Publish(MessagePtr _msg, boost::function<void(uint32_t)> _cb,
 
     if (!this->callbacks.empty())
     {
+      // Callbacks living in this process share the message. It is only
+      // serialized, once, when a remote or raw callback needs the data.
       std::string data;
-      _msg->SerializeToString(&data);
+      bool serialized = false;
       std::list<CallbackHelperPtr>::iterator cbIter;
       cbIter = this->callbacks.begin();
 
       while (cbIter != this->callbacks.end())
       {
-        if ((*cbIter)->HandleData(data, _cb, _id))
+        bool handled;
+        if ((*cbIter)->ZeroCopy())
+        {
+          handled = (*cbIter)->HandleMessage(_msg);
+          if (handled && !_cb.empty())
+            _cb(_id);
+        }
+        else
+        {
+          if (!serialized)
+          {
+            _msg->SerializeToString(&data);
+            serialized = true;
+          }
+          handled = (*cbIter)->HandleData(data, _cb, _id);
+        }
+
+        if (handled)
         {
           ++result;
           ++cbIter;
@@ -116,8 +116,11 @@ namespace gazebo
       /// \param[in] _data The data to be published
       public: void LocalPublish(const std::string &_data);
 
-      /// \brief Publish data to remote subscribers
-      /// \param[in] _msg Message to be published
+      /// \brief Publish data to local and remote subscribers. Local
+      /// subscribers receive _msg itself, the message is serialized only
+      /// when a remote subscriber is connected.
+      /// \param[in] _msg Message to be published. It must not be modified
+      /// afterwards.
       /// \param[in] _cb Callback to be invoked after publishing
       /// is completed
       /// \return Number of remote subscribers that will receive the
@@ -149,6 +152,14 @@ namespace gazebo
       /// \brief Clear all previous messages for a publisher.
       public: void ClearPrevMsgs();
 
+      /// \brief Stop conflating the messages sent to a remote subscriber.
+      /// \param[in] _conn Connection to the remote subscriber.
+      public: void DisableConflating(const ConnectionPtr &_conn);
+
+      /// \brief Ask the remote publishers to send every message, because a
+      /// local callback which is not conflating subscribed to the topic.
+      public: void DisableTransportConflating();
+
       /// \brief Add a transport
       /// \param[in] _publink Pointer to publication transport object to
       /// be added
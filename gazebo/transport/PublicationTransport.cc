@@ -55,7 +55,8 @@ PublicationTransport::~PublicationTransport()
 }
 
 /////////////////////////////////////////////////
-void PublicationTransport::Init(const ConnectionPtr &_conn, bool _latched)
+void PublicationTransport::Init(const ConnectionPtr &_conn, bool _latched,
+    bool _conflating)
 {
   this->connection = _conn;
   msgs::Subscribe sub;
@@ -64,6 +65,10 @@ void PublicationTransport::Init(const ConnectionPtr &_conn, bool _latched)
   sub.set_host(this->connection->GetLocalAddress());
   sub.set_port(this->connection->GetLocalPort());
   sub.set_latching(_latched);
+  sub.set_binary_framing(true);
+  sub.set_shared_memory(true);
+  sub.set_conflating(_conflating);
+  this->conflating = _conflating;
 
   this->connection->EnqueueMsg(msgs::Package("sub", sub));
 
@@ -74,6 +79,22 @@ void PublicationTransport::Init(const ConnectionPtr &_conn, bool _latched)
 }
 
 
+/////////////////////////////////////////////////
+void PublicationTransport::DisableConflating()
+{
+  if (!this->conflating || !this->connection)
+    return;
+  this->conflating = false;
+
+  msgs::Subscribe sub;
+  sub.set_topic(this->topic);
+  sub.set_msg_type(this->msgType);
+  sub.set_host(this->connection->GetLocalAddress());
+  sub.set_port(this->connection->GetLocalPort());
+  sub.set_conflating(false);
+  this->connection->EnqueueMsg(msgs::Package("disable_conflating", sub));
+}
+
 /////////////////////////////////////////////////
 void PublicationTransport::AddCallback(
     const boost::function<void(const std::string &)> &cb_)
@@ -95,6 +116,21 @@ void PublicationTransport::OnPublish(const std::string &_data)
       if (this->callback)
         (this->callback)(_data);
     }
+    else if (!this->shmDisabled && this->connection->SharedMemoryFailed())
+    {
+      // A shared memory reference could not be read, ask the publisher to
+      // send through the socket instead.
+      this->shmDisabled = true;
+      msgs::Subscribe sub;
+      sub.set_topic(this->topic);
+      sub.set_msg_type(this->msgType);
+      sub.set_host(this->connection->GetLocalAddress());
+      sub.set_port(this->connection->GetLocalPort());
+      sub.set_binary_framing(true);
+      sub.set_shared_memory(false);
+      this->connection->EnqueueMsg(
+          msgs::Package("disable_shared_memory", sub));
+    }
   }
 }
 
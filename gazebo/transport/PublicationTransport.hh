@@ -53,11 +53,20 @@ namespace gazebo
       /// \param[in] _conn The underlying connection.
       /// \param[in] _latched True to grab the last message sent on the
       /// topic.
-      public: void Init(const ConnectionPtr &_conn, bool _latched);
+      /// \param[in] _conflating True to ask the publisher to only send the
+      /// latest message when this subscriber can't keep up.
+      public: void Init(const ConnectionPtr &_conn, bool _latched,
+                  bool _conflating = false);
 
       /// \brief Finalize the transport
       public: void Fini();
 
+      /// \brief Ask the remote publisher to send every message, if it was
+      /// asked to conflate them. Called when a local callback which is not
+      /// conflating subscribes to the topic, since the connection is shared
+      /// by all the local callbacks.
+      public: void DisableConflating();
+
       /// \brief Add a callback to the transport
       /// \param[in] _cb The callback to be added
       public: void AddCallback(
@@ -96,6 +105,13 @@ namespace gazebo
 
       /// \brief The unique id for the publication transport.
       private: int id;
+
+      /// \brief True while the publisher is asked to conflate messages.
+      private: bool conflating = false;
+
+      /// \brief True once the publisher was asked to stop sending through
+      /// shared memory.
+      private: bool shmDisabled = false;
     };
     /// \}
   }
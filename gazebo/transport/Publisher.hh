@@ -25,6 +25,7 @@
 #include <boost/thread.hpp>
 #include <boost/shared_ptr.hpp>
 #include <string>
+#include <type_traits>
 #include <list>
 #include <map>
 
@@ -101,6 +102,21 @@ namespace gazebo
               void Publish(M _message, bool _block = false)
               { this->PublishImpl(_message, _block); }
 
+      /// \brief Publish a shared message on the topic, without copying it.
+      /// Subscribers in this process receive the same message, so it must
+      /// not be modified once published.
+      /// \param[in] _message Message to be published
+      /// \param[in] _block Whether to block until the message is actually
+      /// written into the local message buffer, and SendMessage() is called.
+      /// \sa Publish(const google::protobuf::Message &, bool)
+      public: template<typename M>
+              void Publish(const boost::shared_ptr<M> &_message,
+                  bool _block = false)
+              {
+                this->PublishImpl(MessagePtr(boost::const_pointer_cast<
+                    typename std::remove_const<M>::type>(_message)), _block);
+              }
+
       /// \brief Get the number of outgoing messages
       /// \return The number of outgoing messages
       public: unsigned int GetOutgoingCount() const;
@@ -147,6 +163,24 @@ namespace gazebo
       private: void PublishImpl(const google::protobuf::Message &_message,
                                 bool _block);
 
+      /// \brief Implementation of Publish for shared messages.
+      /// \param[in] _message Message to be published, without copy.
+      /// \param[in] _block Whether to block until the message is actually
+      /// written out.
+      private: void PublishImpl(MessagePtr _message, bool _block);
+
+      /// \brief Check that a message can be published now, according to
+      /// its type and to the update rate of the publisher.
+      /// \param[in] _message Message to be published.
+      /// \return True if the message should be queued.
+      private: bool Accept(const google::protobuf::Message &_message);
+
+      /// \brief Queue a message and trigger its publication.
+      /// \param[in] _message Message to be published.
+      /// \param[in] _block Whether to block until the message is actually
+      /// written out.
+      private: void Enqueue(MessagePtr _message, bool _block);
+
       /// \brief Callback when a publish is completed
       /// \param[in] _id ID associated with the publication.
       private: void OnPublishComplete(uint32_t _id);
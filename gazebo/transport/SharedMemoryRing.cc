@@ -0,0 +1,251 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <atomic>
+#include <cstring>
+#include <new>
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/transport/SharedMemoryRing.hh"
+
+namespace gazebo
+{
+namespace transport
+{
+/// \brief Identifies a segment created by SharedMemoryRing.
+static const uint32_t kRingMagic = 0x475a5348;
+
+/// \brief Layout version of the segment.
+static const uint32_t kRingVersion = 1;
+
+/// \brief Header at the start of the segment, followed by the ring.
+struct SharedMemoryRingHeader
+{
+  /// \brief Must be kRingMagic.
+  uint32_t magic;
+
+  /// \brief Must be kRingVersion.
+  uint32_t version;
+
+  /// \brief Size of the ring, in bytes.
+  uint64_t capacity;
+
+  /// \brief Position up to which the reader has released the ring. Only
+  /// the reader writes it.
+  std::atomic<uint64_t> readPosition;
+};
+
+/// \brief Offset of the ring in the segment.
+static const uint64_t kRingOffset = 64;
+static_assert(sizeof(SharedMemoryRingHeader) <= kRingOffset,
+    "SharedMemoryRingHeader does not fit before the ring");
+
+/////////////////////////////////////////////////
+class SharedMemoryRingPrivate
+{
+  /// \brief Name of the segment.
+  public: std::string name;
+
+  /// \brief True if the segment was created by this object.
+  public: bool owner = false;
+
+  /// \brief Mapping of the segment.
+  public: boost::interprocess::mapped_region region;
+
+  /// \brief Header of the segment.
+  public: SharedMemoryRingHeader *header = nullptr;
+
+  /// \brief Start of the ring.
+  public: char *ring = nullptr;
+
+  /// \brief Size of the ring.
+  public: uint64_t capacity = 0;
+
+  /// \brief Position of the next write. Only used by the writer.
+  public: uint64_t writePosition = 0;
+};
+}
+}
+
+using namespace gazebo;
+using namespace transport;
+
+/////////////////////////////////////////////////
+SharedMemoryRing::SharedMemoryRing()
+  : dataPtr(new SharedMemoryRingPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+SharedMemoryRing::~SharedMemoryRing()
+{
+  if (this->dataPtr->owner)
+  {
+    boost::interprocess::shared_memory_object::remove(
+        this->dataPtr->name.c_str());
+  }
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryRing::Create(const std::string &_name,
+    const uint64_t _capacity)
+{
+  if (this->dataPtr->header || _capacity == 0)
+    return false;
+
+  try
+  {
+    boost::interprocess::shared_memory_object::remove(_name.c_str());
+    boost::interprocess::shared_memory_object shm(
+        boost::interprocess::create_only, _name.c_str(),
+        boost::interprocess::read_write);
+    this->dataPtr->owner = true;
+    this->dataPtr->name = _name;
+
+    shm.truncate(kRingOffset + _capacity);
+    this->dataPtr->region = boost::interprocess::mapped_region(shm,
+        boost::interprocess::read_write);
+  }
+  catch(const boost::interprocess::interprocess_exception &_e)
+  {
+    gzwarn << "Unable to create shared memory segment[" << _name << "]: "
+      << _e.what() << std::endl;
+    if (this->dataPtr->owner)
+      boost::interprocess::shared_memory_object::remove(_name.c_str());
+    this->dataPtr->owner = false;
+    return false;
+  }
+
+  char *addr = static_cast<char *>(this->dataPtr->region.get_address());
+  this->dataPtr->header = new (addr) SharedMemoryRingHeader;
+  this->dataPtr->header->magic = kRingMagic;
+  this->dataPtr->header->version = kRingVersion;
+  this->dataPtr->header->capacity = _capacity;
+  this->dataPtr->header->readPosition = 0;
+  this->dataPtr->ring = addr + kRingOffset;
+  this->dataPtr->capacity = _capacity;
+  this->dataPtr->writePosition = 0;
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryRing::Open(const std::string &_name)
+{
+  if (this->dataPtr->header)
+    return false;
+
+  try
+  {
+    boost::interprocess::shared_memory_object shm(
+        boost::interprocess::open_only, _name.c_str(),
+        boost::interprocess::read_write);
+    this->dataPtr->region = boost::interprocess::mapped_region(shm,
+        boost::interprocess::read_write);
+  }
+  catch(const boost::interprocess::interprocess_exception &_e)
+  {
+    gzwarn << "Unable to open shared memory segment[" << _name << "]: "
+      << _e.what() << std::endl;
+    return false;
+  }
+
+  char *addr = static_cast<char *>(this->dataPtr->region.get_address());
+  SharedMemoryRingHeader *header =
+    reinterpret_cast<SharedMemoryRingHeader *>(addr);
+  if (this->dataPtr->region.get_size() < kRingOffset ||
+      header->magic != kRingMagic || header->version != kRingVersion ||
+      this->dataPtr->region.get_size() < kRingOffset + header->capacity)
+  {
+    gzwarn << "Invalid shared memory segment[" << _name << "]\n";
+    this->dataPtr->region = boost::interprocess::mapped_region();
+    return false;
+  }
+
+  this->dataPtr->name = _name;
+  this->dataPtr->header = header;
+  this->dataPtr->ring = addr + kRingOffset;
+  this->dataPtr->capacity = header->capacity;
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryRing::Write(const char *_data, const uint64_t _size,
+    uint64_t &_position)
+{
+  if (!this->dataPtr->header || _size == 0 ||
+      _size > this->dataPtr->capacity)
+  {
+    return false;
+  }
+
+  // Payloads are contiguous, skip the end of the ring if needed.
+  uint64_t start = this->dataPtr->writePosition;
+  const uint64_t offset = start % this->dataPtr->capacity;
+  if (offset + _size > this->dataPtr->capacity)
+    start += this->dataPtr->capacity - offset;
+
+  const uint64_t readPosition =
+    this->dataPtr->header->readPosition.load(std::memory_order_acquire);
+  if (start + _size - readPosition > this->dataPtr->capacity)
+    return false;
+
+  std::memcpy(this->dataPtr->ring + start % this->dataPtr->capacity,
+      _data, _size);
+  this->dataPtr->writePosition = start + _size;
+  _position = start;
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryRing::Read(const uint64_t _position, const uint64_t _size,
+    std::string &_data)
+{
+  if (!this->dataPtr->header)
+    return false;
+
+  const uint64_t offset = _position % this->dataPtr->capacity;
+  const uint64_t readPosition =
+    this->dataPtr->header->readPosition.load(std::memory_order_relaxed);
+  if (_size == 0 || offset + _size > this->dataPtr->capacity ||
+      _position < readPosition)
+  {
+    return false;
+  }
+
+  _data.assign(this->dataPtr->ring + offset, _size);
+  this->dataPtr->header->readPosition.store(_position + _size,
+      std::memory_order_release);
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::string SharedMemoryRing::Name() const
+{
+  return this->dataPtr->name;
+}
+
+/////////////////////////////////////////////////
+uint64_t SharedMemoryRing::Capacity() const
+{
+  return this->dataPtr->capacity;
+}
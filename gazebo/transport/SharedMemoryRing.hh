@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_SHAREDMEMORYRING_HH_
+#define GAZEBO_TRANSPORT_SHAREDMEMORYRING_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    // Forward declare private data class
+    class SharedMemoryRingPrivate;
+
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    /// \class SharedMemoryRing SharedMemoryRing.hh transport/transport.hh
+    /// \brief A single producer, single consumer byte ring in a named
+    /// shared memory segment.
+    ///
+    /// The writer copies a payload into the ring once, and sends its
+    /// position to the reader over another channel, e.g. a
+    /// transport::Connection. The reader copies the payload out and
+    /// releases the space. Payloads are read in the order they were
+    /// written. Positions only increase, the offset in the ring is the
+    /// position modulo the capacity.
+    class GZ_TRANSPORT_VISIBLE SharedMemoryRing
+    {
+      /// \brief Constructor.
+      public: SharedMemoryRing();
+
+      /// \brief Destructor. The segment is removed if this ring created it.
+      public: virtual ~SharedMemoryRing();
+
+      /// \brief Create a new segment, as the writer.
+      /// \param[in] _name Name of the segment, unique on the host.
+      /// \param[in] _capacity Size of the ring in bytes.
+      /// \return True if the segment was created.
+      public: bool Create(const std::string &_name, const uint64_t _capacity);
+
+      /// \brief Open a segment created by another process, as the reader.
+      /// \param[in] _name Name of the segment. It is passed to
+      /// shm_open as is, callers must check it when it comes from another
+      /// process.
+      /// \return True if the segment exists and is valid.
+      public: bool Open(const std::string &_name);
+
+      /// \brief Copy a payload into the ring. This never blocks.
+      /// \param[in] _data Pointer to the payload.
+      /// \param[in] _size Size of the payload.
+      /// \param[out] _position Position of the payload, to pass to Read.
+      /// \return False if the ring does not have enough free space, in which
+      /// case the payload should be sent by other means.
+      public: bool Write(const char *_data, const uint64_t _size,
+                         uint64_t &_position);
+
+      /// \brief Copy a payload out of the ring, and release its space and
+      /// the space of all the payloads written before it. The payload is
+      /// copied because the writer reuses the space as soon as it is
+      /// released, so a message through the ring is copied twice, once in
+      /// and once out, and only saves the socket transfer.
+      /// \param[in] _position Position returned by Write.
+      /// \param[in] _size Size of the payload.
+      /// \param[out] _data Payload.
+      /// \return False if the position is invalid.
+      public: bool Read(const uint64_t _position, const uint64_t _size,
+                        std::string &_data);
+
+      /// \brief Get the name of the segment.
+      /// \return Name of the segment, empty if the ring is not open.
+      public: std::string Name() const;
+
+      /// \brief Get the size of the ring.
+      /// \return Size of the ring in bytes, 0 if the ring is not open.
+      public: uint64_t Capacity() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<SharedMemoryRingPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
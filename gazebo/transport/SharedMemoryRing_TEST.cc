@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include "gazebo/transport/SharedMemoryRing.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class SharedMemoryRing : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(SharedMemoryRing, WriteRead)
+{
+  const std::string name = "gazebo_shm_test_write_read";
+
+  transport::SharedMemoryRing reader;
+  EXPECT_FALSE(reader.Open(name));
+
+  transport::SharedMemoryRing writer;
+  ASSERT_TRUE(writer.Create(name, 1000));
+  EXPECT_EQ(writer.Name(), name);
+  EXPECT_EQ(writer.Capacity(), 1000u);
+  EXPECT_FALSE(writer.Create(name, 1000));
+
+  ASSERT_TRUE(reader.Open(name));
+  EXPECT_EQ(reader.Capacity(), 1000u);
+
+  // Too large, or empty
+  uint64_t position = 0;
+  std::string large(1001, 'x');
+  EXPECT_FALSE(writer.Write(large.data(), large.size(), position));
+  EXPECT_FALSE(writer.Write(large.data(), 0, position));
+
+  std::string a(400, 'a');
+  std::string b(400, 'b');
+  std::string c(400, 'c');
+  uint64_t posA, posB, posC;
+  ASSERT_TRUE(writer.Write(a.data(), a.size(), posA));
+  ASSERT_TRUE(writer.Write(b.data(), b.size(), posB));
+  EXPECT_EQ(posA, 0u);
+  EXPECT_EQ(posB, 400u);
+
+  // The ring is full until a is read
+  EXPECT_FALSE(writer.Write(c.data(), c.size(), posC));
+
+  std::string data;
+  ASSERT_TRUE(reader.Read(posA, a.size(), data));
+  EXPECT_EQ(data, a);
+
+  // c does not fit at the end of the ring, and wraps to the start
+  ASSERT_TRUE(writer.Write(c.data(), c.size(), posC));
+  EXPECT_EQ(posC, 1000u);
+
+  ASSERT_TRUE(reader.Read(posB, b.size(), data));
+  EXPECT_EQ(data, b);
+  ASSERT_TRUE(reader.Read(posC, c.size(), data));
+  EXPECT_EQ(data, c);
+
+  // Released positions can't be read again
+  EXPECT_FALSE(reader.Read(posB, b.size(), data));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -36,7 +36,7 @@ namespace gazebo
     {
       /// \brief Constructor
       public: SubscribeOptions()
-              : latching(false)
+              : latching(false), conflating(false)
               {}
 
       /// \brief Initialize the options
@@ -44,9 +44,11 @@ namespace gazebo
       /// \param[in,out] _node The associated node
       /// \param[in] _latching If true, latch the latest message; if false,
       /// don't latch
+      /// \param[in] _conflating If true, only deliver the latest message
+      /// when the subscriber can't keep up with the publisher
       public: template<class M>
               void Init(const std::string &_topic, NodePtr _node,
-                        bool _latching)
+                        bool _latching, bool _conflating = false)
               {
                 google::protobuf::Message *msg = NULL;
                 M msgtype;
@@ -58,6 +60,7 @@ namespace gazebo
                 this->topic = _topic;
                 this->msgType = msg->GetTypeName();
                 this->latching = _latching;
+                this->conflating = _conflating;
               }
 
       /// \brief Initialize the options. This version of init is only used
@@ -66,13 +69,16 @@ namespace gazebo
       /// \param[in,out] _node The associated node
       /// \param[in] _latching If true, latch the latest message; if false,
       /// don't latch
+      /// \param[in] _conflating If true, only deliver the latest message
+      /// when the subscriber can't keep up with the publisher
       public: void Init(const std::string &_topic, NodePtr _node,
-                        bool _latching)
+                        bool _latching, bool _conflating = false)
               {
                 this->node = _node;
                 this->topic = _topic;
                 this->msgType = "raw";
                 this->latching = _latching;
+                this->conflating = _conflating;
               }
 
       /// \brief Get the node we're subscribed to
@@ -103,10 +109,19 @@ namespace gazebo
                 return this->latching;
               }
 
+      /// \brief Are we conflating?
+      /// \return true if only the latest message is delivered to a slow
+      /// subscriber, false if every message is delivered
+      public: bool GetConflating() const
+              {
+                return this->conflating;
+              }
+
       private: std::string topic;
       private: std::string msgType;
       private: NodePtr node;
       private: bool latching;
+      private: bool conflating;
     };
     /// \}
   }
@@ -14,8 +14,12 @@
  * limitations under the License.
  *
 */
+#include <string>
+#include <utility>
+
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
+
 #include "gazebo/transport/ConnectionManager.hh"
 #include "gazebo/transport/SubscriptionTransport.hh"
 
@@ -37,15 +41,44 @@ SubscriptionTransport::~SubscriptionTransport()
 }
 
 //////////////////////////////////////////////////
-void SubscriptionTransport::Init(ConnectionPtr _conn, bool _latching)
+void SubscriptionTransport::Init(ConnectionPtr _conn, bool _latching,
+    bool _conflating)
 {
   this->connection = _conn;
   this->latching = _latching;
+  this->conflating = _conflating;
 }
 
 //////////////////////////////////////////////////
 bool SubscriptionTransport::HandleMessage(MessagePtr _newMsg)
 {
+  bool conflate = false;
+  {
+    boost::mutex::scoped_lock lock(this->pendingMutex);
+    if (this->conflating)
+    {
+      if (!this->connection || !this->connection->IsOpen())
+      {
+        this->connection.reset();
+        return false;
+      }
+
+      // Overwrite any message which has not been sent yet. It is only
+      // serialized once the previous one is out.
+      this->pendingMsg = _newMsg;
+      if (this->sending)
+        return true;
+      this->sending = true;
+      conflate = true;
+    }
+  }
+
+  if (conflate)
+  {
+    this->SendPending();
+    return true;
+  }
+
   std::string data;
   _newMsg->SerializeToString(&data);
   return this->HandleData(data, boost::bind(&dummy_callback_fn, _1), 0);
@@ -67,6 +100,64 @@ bool SubscriptionTransport::HandleData(const std::string &_newdata,
   return result;
 }
 
+//////////////////////////////////////////////////
+void SubscriptionTransport::SendPending()
+{
+  while (true)
+  {
+    MessagePtr msg;
+    {
+      boost::mutex::scoped_lock lock(this->pendingMutex);
+      msg.swap(this->pendingMsg);
+      if (!msg || !this->connection)
+      {
+        this->sending = false;
+        return;
+      }
+    }
+
+    // Empty messages are not sent by the connection, and OnSent would
+    // never be called
+    std::string data;
+    msg->SerializeToString(&data);
+    if (data.empty())
+      continue;
+
+    this->connection->EnqueueMsg(std::move(data), common::weakBind(
+          &SubscriptionTransport::OnSent, this->shared_from_this(), _1), 0);
+    return;
+  }
+}
+
+//////////////////////////////////////////////////
+void SubscriptionTransport::DisableConflating()
+{
+  MessagePtr msg;
+  {
+    boost::mutex::scoped_lock lock(this->pendingMutex);
+    if (!this->conflating)
+      return;
+    this->conflating = false;
+    msg.swap(this->pendingMsg);
+  }
+
+  // The pending message is older than the ones which are now sent
+  // directly, queue it first. The connection calls OnSent with its write
+  // mutex locked, so pendingMutex must not be held here.
+  if (msg && this->connection)
+  {
+    std::string data;
+    msg->SerializeToString(&data);
+    this->HandleData(data, boost::bind(&dummy_callback_fn, _1), 0);
+  }
+}
+
+//////////////////////////////////////////////////
+void SubscriptionTransport::OnSent(uint32_t /*_id*/)
+{
+  this->SendPending();
+}
+
 //////////////////////////////////////////////////
 const ConnectionPtr &SubscriptionTransport::GetConnection() const
 {
@@ -79,3 +170,10 @@ bool SubscriptionTransport::IsLocal() const
 {
   return false;
 }
+
+//////////////////////////////////////////////////
+bool SubscriptionTransport::ZeroCopy() const
+{
+  // Conflated messages are serialized when they are sent
+  return this->conflating;
+}
@@ -17,8 +17,10 @@
 #ifndef _SUBSCRIPTIONTRANSPORT_HH_
 #define _SUBSCRIPTIONTRANSPORT_HH_
 
+#include <boost/enable_shared_from_this.hpp>
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
 #include <string>
 
 #include "Connection.hh"
@@ -36,7 +38,8 @@ namespace gazebo
     /// transport/transport.hh
     /// \brief Handles sending data over the wire to
     /// remote subscribers
-    class GZ_TRANSPORT_VISIBLE SubscriptionTransport : public CallbackHelper
+    class GZ_TRANSPORT_VISIBLE SubscriptionTransport : public CallbackHelper,
+      public boost::enable_shared_from_this<SubscriptionTransport>
     {
       /// \brief Constructor
       public: SubscriptionTransport();
@@ -48,7 +51,11 @@ namespace gazebo
       /// \param[in] _conn The connection to use
       /// \param[in] _latching If true, latch the latest message; if false,
       /// don't latch
-      public: void Init(ConnectionPtr _conn, bool _latching);
+      /// \param[in] _conflating If true, only the latest message is kept
+      /// while the connection is busy, and it is serialized only once the
+      /// connection can send it.
+      public: void Init(ConnectionPtr _conn, bool _latching,
+                  bool _conflating = false);
 
       /// \brief Output a message to a connection
       /// \param[in] _newdata The message to be handled
@@ -71,7 +78,32 @@ namespace gazebo
       /// is tied to a  remote connection
       public: virtual bool IsLocal() const;
 
+      // Documentation inherited
+      public: virtual bool ZeroCopy() const;
+
+      /// \brief Send every message from now on, because the remote
+      /// subscriber added a callback which is not conflating. A message
+      /// waiting to be sent is queued first. Must not be called
+      /// concurrently with HandleMessage, Publication serializes both.
+      public: void DisableConflating();
+
+      /// \brief Serialize and send the pending message, if any.
+      private: void SendPending();
+
+      /// \brief Called when the connection has sent a conflated message.
+      /// \param[in] _id Unused.
+      private: void OnSent(uint32_t _id);
+
       private: ConnectionPtr connection;
+
+      /// \brief Latest message not sent yet, when conflating.
+      private: MessagePtr pendingMsg;
+
+      /// \brief True while a conflated message is being sent.
+      private: bool sending = false;
+
+      /// \brief Protects pendingMsg, sending and conflating.
+      private: boost::mutex pendingMutex;
     };
     /// \}
   }
@@ -241,8 +241,15 @@ SubscriberPtr TopicManager::Subscribe(const SubscribeOptions &_ops)
 
   // If the publication exits, just add the subscription to it
   if (pub)
+  {
     pub->AddSubscription(_ops.GetNode());
 
+    // The connections to remote publishers are shared by all the local
+    // callbacks, they can't skip messages anymore
+    if (!_ops.GetConflating())
+      pub->DisableTransportConflating();
+  }
+
   // Use this to find other remote publishers
   ConnectionManager::Instance()->Subscribe(_ops.GetTopic(), _ops.GetMsgType(),
                                            _ops.GetLatching());
@@ -282,6 +289,15 @@ void TopicManager::DisconnectPubFromSub(const std::string &topic,
   publication->RemoveSubscription(host, port);
 }
 
+//////////////////////////////////////////////////
+void TopicManager::DisableConflating(const std::string &_topic,
+                                     const ConnectionPtr &_conn)
+{
+  PublicationPtr publication = this->FindPublication(_topic);
+  if (publication)
+    publication->DisableConflating(_conn);
+}
+
 //////////////////////////////////////////////////
 void TopicManager::DisconnectSubFromPub(const std::string &topic,
     const std::string &host, unsigned int port)
@@ -339,6 +355,7 @@ void TopicManager::ConnectSubToPub(const msgs::Publish &_pub)
             _pub.msg_type()));
 
       bool latched = false;
+      bool conflating = false;
       boost::mutex::scoped_lock lock(this->subscriberMutex);
       SubNodeMap::iterator nodeIter = this->subscribedNodes.find(_pub.topic());
 
@@ -352,9 +369,18 @@ void TopicManager::ConnectSubToPub(const msgs::Publish &_pub)
         {
           latched = (*cbIter)->HasLatchedSubscriber(_pub.topic());
         }
+
+        // The connection is shared by all the local subscribers, so
+        // messages can only be skipped if none of them wants every message
+        conflating = !nodeIter->second.empty();
+        for (cbIter = nodeIter->second.begin();
+             cbIter != nodeIter->second.end() && conflating; ++cbIter)
+        {
+          conflating = (*cbIter)->HasOnlyConflatingSubscribers(_pub.topic());
+        }
       }
 
-      publink->Init(conn, latched);
+      publink->Init(conn, latched, conflating);
 
       publication->AddTransport(publink);
     }
@@ -201,6 +201,13 @@ namespace gazebo
                                          const std::string &_host,
                                          unsigned int _port);
 
+      /// \brief Stop conflating the messages sent to a remote subscriber,
+      /// because it added a callback which wants every message.
+      /// \param[in] _topic The topic
+      /// \param[in] _conn The connection to the remote subscriber
+      public: void DisableConflating(const std::string &_topic,
+                                     const ConnectionPtr &_conn);
+
       /// \brief Disconnect all local subscribers from a remote publisher
       /// \param[in] _topic The topic to be disconnected
       /// \param[in] _host The host to be disconnected
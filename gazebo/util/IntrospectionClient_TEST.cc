@@ -15,6 +15,7 @@
  *
 */
 
+#include <atomic>
 #include <set>
 #include <string>
 #include <ignition/transport.hh>
@@ -510,6 +511,48 @@ TEST_F(IntrospectionClientTest, Exception)
   EXPECT_TRUE(this->manager->Unregister("item4"));
 }
 
+/////////////////////////////////////////////////
+TEST_F(IntrospectionClientTest, PublishRate)
+{
+  EXPECT_DOUBLE_EQ(this->manager->PublishRate(), 0.0);
+  this->manager->SetPublishRate(-1.0);
+  EXPECT_DOUBLE_EQ(this->manager->PublishRate(), 0.0);
+  this->manager->SetPublishRate(2.0);
+  EXPECT_DOUBLE_EQ(this->manager->PublishRate(), 2.0);
+
+  std::set<std::string> items = {"item1", "item2"};
+  std::string filterId;
+  std::string topic;
+  EXPECT_TRUE(this->client.NewFilter(this->managerId, items, filterId, topic));
+
+  std::atomic<int> received(0);
+  std::function<void(const gazebo::msgs::Param_V &)> cb =
+    [&received](const gazebo::msgs::Param_V &_msg)
+    {
+      EXPECT_EQ(_msg.param_size(), 2);
+      ++received;
+    };
+  ignition::transport::Node node;
+  EXPECT_TRUE(node.Subscribe(topic, cb));
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  // The first update may be published, the next ones are buffered.
+  this->manager->Update();
+  this->manager->Update();
+  this->manager->Update();
+  std::this_thread::sleep_for(std::chrono::milliseconds(600));
+  EXPECT_LE(received, 1);
+
+  // All the buffered updates are published at once.
+  this->manager->Update();
+  for (int i = 0; i < 10 && received < 4; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(received, 4);
+
+  this->manager->SetPublishRate(0.0);
+  EXPECT_TRUE(this->client.RemoveFilter(this->managerId, filterId));
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
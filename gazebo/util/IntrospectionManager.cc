@@ -14,9 +14,13 @@
  * limitations under the License.
  *
  */
+#include <algorithm>
 #include <functional>
+#include <memory>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 #include <ignition/math/Rand.hh>
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
@@ -32,6 +36,76 @@
 using namespace gazebo;
 using namespace util;
 
+/// \brief Maximum number of updates buffered by a filter between two
+/// publications.
+static const size_t kMaxPendingUpdates = 100;
+
+//////////////////////////////////////////////////
+/// \brief Build a snapshot of the filters of a manager.
+/// \param[in] _data Private data of the manager, with its mutex locked.
+/// \param[in] _old Previous snapshot, whose pending updates are kept.
+/// \return The new snapshot.
+static std::unique_ptr<IntrospectionSnapshot> BuildSnapshot(
+    const IntrospectionManagerPrivate &_data,
+    std::unique_ptr<IntrospectionSnapshot> _old)
+{
+  std::unique_ptr<IntrospectionSnapshot> snapshot(new IntrospectionSnapshot);
+  snapshot->epoch = _data.epoch;
+
+  // Resolve the observed items that are registered to indices.
+  std::map<std::string, size_t> indices;
+  for (auto const &observedItem : _data.observedItems)
+  {
+    auto itemIter = _data.allItems.find(observedItem.first);
+    if (itemIter == _data.allItems.end())
+      continue;
+
+    indices[observedItem.first] = snapshot->names.size();
+    snapshot->names.push_back(observedItem.first);
+    snapshot->samplers.push_back(itemIter->second);
+  }
+  snapshot->samples.resize(snapshot->names.size());
+
+  std::map<std::string, IntrospectionSnapshotFilter *> oldFilters;
+  if (_old)
+  {
+    for (auto &filter : _old->filters)
+      oldFilters[filter.id] = &filter;
+  }
+
+  for (auto const &filter : _data.filters)
+  {
+    auto pubIter = _data.filterPubs.find(_data.prefix + "filter/" +
+        filter.first);
+    if (pubIter == _data.filterPubs.end())
+      continue;
+
+    IntrospectionSnapshotFilter next;
+    next.id = filter.first;
+    next.pub = pubIter->second;
+    for (auto const &item : filter.second.items)
+    {
+      auto indexIter = indices.find(item);
+      if (indexIter != indices.end())
+        next.items.push_back(indexIter->second);
+    }
+
+    // Keep the updates that were not published yet.
+    auto oldIter = oldFilters.find(filter.first);
+    if (oldIter != oldFilters.end())
+    {
+      next.ring = std::move(oldIter->second->ring);
+      next.head = oldIter->second->head;
+      next.count = oldIter->second->count;
+    }
+
+    if (!next.items.empty() || next.count > 0)
+      snapshot->filters.push_back(std::move(next));
+  }
+
+  return snapshot;
+}
+
 //////////////////////////////////////////////////
 IntrospectionManager::IntrospectionManager()
   : dataPtr(new IntrospectionManagerPrivate)
@@ -100,6 +174,18 @@ std::string IntrospectionManager::Id() const
 //////////////////////////////////////////////////
 bool IntrospectionManager::Register(const std::string &_item,
     const std::function <gazebo::msgs::Any ()> &_cb)
+{
+  auto func = [_cb](gazebo::msgs::Any &_value)
+  {
+    _value = _cb();
+  };
+
+  return this->Register(_item, func);
+}
+
+//////////////////////////////////////////////////
+bool IntrospectionManager::Register(const std::string &_item,
+    const std::function <void(gazebo::msgs::Any &)> &_cb)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
@@ -114,6 +200,7 @@ bool IntrospectionManager::Register(const std::string &_item,
   this->dataPtr->allItems[_item] = _cb;
 
   this->dataPtr->itemsUpdated = true;
+  ++this->dataPtr->epoch;
 
   return true;
 }
@@ -135,6 +222,7 @@ bool IntrospectionManager::Unregister(const std::string &_item)
   this->dataPtr->allItems.erase(_item);
 
   this->dataPtr->itemsUpdated = true;
+  ++this->dataPtr->epoch;
 
   return true;
 }
@@ -146,6 +234,7 @@ void IntrospectionManager::Clear()
   this->dataPtr->allItemsKeys.clear();
   this->dataPtr->allItems.clear();
   this->dataPtr->itemsUpdated = true;
+  ++this->dataPtr->epoch;
 }
 
 //////////////////////////////////////////////////
@@ -164,105 +253,109 @@ std::set<std::string> IntrospectionManager::Items() const
 //////////////////////////////////////////////////
 void IntrospectionManager::Update()
 {
-  std::map<std::string, IntrospectionFilter> filtersCopy;
-  std::map<std::string, ObservedItem> observedItemsCopy;
-  std::map<std::string, std::function <gazebo::msgs::Any ()>> usedItemsCopy;
+  std::lock_guard<std::mutex> updateLock(this->dataPtr->updateMutex);
 
+  double publishRate;
   {
     std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-    filtersCopy = this->dataPtr->filters;
-    observedItemsCopy = this->dataPtr->observedItems;
-
-    for (const auto &observedItem: this->dataPtr->observedItems)
+    // Rebuild the snapshot only if an item or a filter changed.
+    if (!this->dataPtr->snapshot ||
+        this->dataPtr->snapshot->epoch != this->dataPtr->epoch)
     {
-      auto &item = observedItem.first;
-      // Sanity check: Make sure that someone registered this item.
-      if (this->dataPtr->allItemsKeys.count(item) == 0)
-      {
-        continue;
-      }
-
-      usedItemsCopy[item] = this->dataPtr->allItems[item];
-    }
-
-    for (auto& filter: filtersCopy)
-    {
-      for (auto const &item : filter.second.items)
-      {
-        // Sanity check: Make sure that someone registered this item.
-        if (this->dataPtr->allItemsKeys.count(item) == 0)
-        {
-          continue;
-        }
-        usedItemsCopy[item] = this->dataPtr->allItems[item];
-      }
+      this->dataPtr->snapshot = BuildSnapshot(*this->dataPtr,
+          std::move(this->dataPtr->snapshot));
     }
+    publishRate = this->dataPtr->publishRate;
   }
 
-  for (auto &observedItem : observedItemsCopy)
-  {
-    auto &item = observedItem.first;
-    auto itemIter = usedItemsCopy.find(item);
-
-    // Sanity check: Make sure that we can update the item.
-    if (itemIter == usedItemsCopy.end())
-      continue;
+  auto &snapshot = *this->dataPtr->snapshot;
 
+  // Update the values of the items under observation.
+  for (size_t i = 0; i < snapshot.samplers.size(); ++i)
+  {
     try
     {
-      // Update the values of the items under observation.
-      gazebo::msgs::Any value = itemIter->second();
-      auto &lastValue = observedItem.second.lastValue;
-      lastValue.CopyFrom(value);
+      snapshot.samplers[i](snapshot.samples[i]);
     }
     catch(...)
     {
       gzerr << "Exception caught calling user callback" << std::endl;
-      continue;
+      snapshot.samples[i].Clear();
     }
   }
 
   // Prepare the next message to be sent in each filter.
-  for (auto &filter : filtersCopy)
+  for (auto &filter : snapshot.filters)
   {
-    // First of all, clear the old message.
-    auto &nextMsg = filter.second.msg;
-    nextMsg.Clear();
+    if (filter.items.empty())
+      continue;
 
-    // Insert the last value of each item under observation for this filter.
-    for (auto const &item : filter.second.items)
+    // Reuse the oldest message if the ring is full.
+    if (filter.count == filter.ring.size())
     {
-      // Sanity check: Make sure that someone registered this item.
-      if (usedItemsCopy.find(item) == usedItemsCopy.end())
-        continue;
+      if (filter.ring.size() < kMaxPendingUpdates)
+      {
+        filter.ring.insert(filter.ring.begin() + filter.head,
+            gazebo::msgs::Param_V());
+        filter.head = (filter.head + 1) % filter.ring.size();
+      }
+      else
+      {
+        filter.head = (filter.head + 1) % filter.ring.size();
+        --filter.count;
+      }
+    }
 
+    auto &nextMsg =
+      filter.ring[(filter.head + filter.count) % filter.ring.size()];
+    auto &params = *nextMsg.mutable_param();
+
+    // Insert the last value of each item under observation for this filter.
+    // The params of the previous update are overwritten in place.
+    int paramCount = 0;
+    for (auto const index : filter.items)
+    {
       // Sanity check: Make sure that the value was updated.
       // (e.g.: an exception was not raised).
-      auto &lastValue = observedItemsCopy[item].lastValue;
+      auto const &lastValue = snapshot.samples[index];
       if (lastValue.type() == gazebo::msgs::Any::NONE)
         continue;
 
-      auto nextParam = nextMsg.add_param();
-      nextParam->set_name(item);
+      auto nextParam = paramCount < params.size() ?
+        params.Mutable(paramCount) : params.Add();
+      ++paramCount;
+      nextParam->set_name(snapshot.names[index]);
       nextParam->mutable_value()->CopyFrom(lastValue);
     }
+    while (params.size() > paramCount)
+      params.RemoveLast();
 
     // Sanity check: Make sure that we have at least one item updated.
-    if (nextMsg.param_size() == 0)
+    if (paramCount == 0)
       continue;
 
-    // Publish the update for this filter.
-    std::string topicName = this->dataPtr->prefix + "filter/" + filter.first;
+    ++filter.count;
+  }
 
+  // Publish the pending updates, unless it is too early.
+  common::Time now = common::Time::GetWallTime();
+  if (publishRate <= 0 ||
+      (now - this->dataPtr->lastPublishTime).Double() >= 1.0 / publishRate)
+  {
+    this->dataPtr->lastPublishTime = now;
+
+    for (auto &filter : snapshot.filters)
     {
-      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-      if (this->dataPtr->filterPubs.find(topicName) ==
-          this->dataPtr->filterPubs.end() ||
-          !this->dataPtr->filterPubs[topicName].Publish(nextMsg))
+      for (; filter.count > 0; --filter.count)
       {
-        gzerr << "Error publishing update for topic [" << topicName << "]"
-          << std::endl;
+        if (!filter.pub.Publish(filter.ring[filter.head]))
+        {
+          gzerr << "Error publishing update for topic ["
+            << this->dataPtr->prefix << "filter/" << filter.id << "]"
+            << std::endl;
+        }
+        filter.head = (filter.head + 1) % filter.ring.size();
       }
     }
   }
@@ -296,6 +389,20 @@ void IntrospectionManager::NotifyUpdates()
   }
 }
 
+//////////////////////////////////////////////////
+void IntrospectionManager::SetPublishRate(const double _rate)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->publishRate = std::max(0.0, _rate);
+}
+
+//////////////////////////////////////////////////
+double IntrospectionManager::PublishRate() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->publishRate;
+}
+
 //////////////////////////////////////////////////
 bool IntrospectionManager::NewFilterImpl(const std::set<std::string> &_newItems,
     std::string &_filterId)
@@ -336,6 +443,8 @@ bool IntrospectionManager::NewFilterImpl(const std::set<std::string> &_newItems,
   for (auto const &item : _newItems)
     this->dataPtr->observedItems[item].filters.emplace(_filterId);
 
+  ++this->dataPtr->epoch;
+
   return true;
 }
 
@@ -393,6 +502,8 @@ bool IntrospectionManager::UpdateFilterImpl(const std::string &_filterId,
     }
   }
 
+  ++this->dataPtr->epoch;
+
   return true;
 }
 
@@ -441,6 +552,8 @@ bool IntrospectionManager::RemoveFilterImpl(const std::string &_filterId)
       this->dataPtr->observedItems.erase(oldItem);
   }
 
+  ++this->dataPtr->epoch;
+
   return true;
 }
 
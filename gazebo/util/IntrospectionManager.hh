@@ -62,9 +62,9 @@ namespace gazebo
       bool Register(const std::string &_item,
                     const std::function<T()> &_cb)
       {
-        auto func = [=]()
+        auto func = [=](gazebo::msgs::Any &_value)
         {
-          return msgs::ConvertAny(_cb());
+          msgs::Set(&_value, _cb());
         };
 
         return this->Register(_item, func);
@@ -87,6 +87,8 @@ namespace gazebo
       /// through all the topics. The message received in the update will
       /// contain the name and latest values of all the items specified
       /// in the filter.
+      /// When a publish rate is set, the updates are buffered and published
+      /// in batches, see SetPublishRate().
       /// If there are changes in the items list since the last update,
       /// a new message is published under the topic
       /// "/introspection/<manager_id>/items_update".
@@ -97,6 +99,20 @@ namespace gazebo
       /// "/introspection/<manager_id>/items_update".
       public: void NotifyUpdates();
 
+      /// \brief Set the rate at which the filter updates are published.
+      /// Update() still samples the items every time it's called, but the
+      /// updates are buffered and all the pending updates are published at
+      /// once, in order. When updates are produced faster than they are
+      /// published, the oldest ones are dropped.
+      /// \param[in] _rate Rate in Hz of wall time. Zero or a negative value
+      /// publishes on every update, which is the default.
+      public: void SetPublishRate(const double _rate);
+
+      /// \brief Get the rate at which the filter updates are published.
+      /// \return Rate in Hz of wall time, zero when the updates are
+      /// published on every update.
+      public: double PublishRate() const;
+
       /// \brief Constructor.
       private: IntrospectionManager();
 
@@ -111,6 +127,15 @@ namespace gazebo
       private: bool Register(const std::string &_item,
                              const std::function <gazebo::msgs::Any()> &_cb);
 
+      /// \brief Register a new item in the introspection manager.
+      /// \param[in] _item New item. E.g.: /default/world/model1/pose
+      /// \param[in] _cb Callback used to set the last update for this item
+      /// into an existing message.
+      /// \result True when the registration succeed or false otherwise
+      /// (item already existing).
+      private: bool Register(const std::string &_item,
+                   const std::function <void(gazebo::msgs::Any &)> &_cb);
+
       /// \brief Create a new filter for observing item updates. This function
       /// will create a new topic for sending periodic updates of the items
       /// specified in the filter.
@@ -17,12 +17,16 @@
 #ifndef GAZEBO_UTIL_INTROSPECTION_MANAGER_PRIVATE_HH_
 #define GAZEBO_UTIL_INTROSPECTION_MANAGER_PRIVATE_HH_
 
+#include <cstdint>
 #include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <string>
+#include <vector>
 #include <ignition/transport.hh>
+#include "gazebo/common/Time.hh"
 #include "gazebo/msgs/any.pb.h"
 #include "gazebo/msgs/param_v.pb.h"
 #include "gazebo/util/IntrospectionManager.hh"
@@ -36,22 +40,62 @@ namespace gazebo
     {
       /// \brief Items observed by this filter.
       std::set<std::string> items;
-
-      /// \brief Message containing the next update. A message is a collection
-      /// of items and values.
-      msgs::Param_V msg;
     };
 
-    /// \brief Todo.
+    /// \brief An item observed by at least one filter.
     struct ObservedItem
     {
-      /// \brief ToDo.
-      gazebo::msgs::Any lastValue;
-
-      /// \brief ToDo.
+      /// \brief IDs of the filters that contain the item.
       std::set<std::string> filters;
     };
 
+    /// \brief A filter as seen by IntrospectionManager::Update().
+    struct IntrospectionSnapshotFilter
+    {
+      /// \brief ID of the filter.
+      std::string id;
+
+      /// \brief Publisher of the filter updates.
+      ignition::transport::Node::Publisher pub;
+
+      /// \brief Indices of the registered items of the filter in the
+      /// snapshot.
+      std::vector<size_t> items;
+
+      /// \brief Ring of the updates waiting to be published. The messages
+      /// are reused from one update to the next.
+      std::vector<msgs::Param_V> ring;
+
+      /// \brief Index of the oldest update in the ring.
+      size_t head = 0;
+
+      /// \brief Number of updates in the ring.
+      size_t count = 0;
+    };
+
+    /// \brief The filters and the callbacks of their items, resolved to
+    /// flat arrays. A snapshot is rebuilt only when the epoch of the
+    /// manager changes, and only IntrospectionManager::Update() uses it,
+    /// so the callbacks and the filters are not copied on every update.
+    struct IntrospectionSnapshot
+    {
+      /// \brief Epoch of the manager when the snapshot was built.
+      uint64_t epoch = 0;
+
+      /// \brief Names of the observed items that are registered.
+      std::vector<std::string> names;
+
+      /// \brief Callbacks of the items, in the same order as names.
+      std::vector<std::function<void(gazebo::msgs::Any &)>> samplers;
+
+      /// \brief Last value of each item, in the same order as names. The
+      /// type is NONE when the callback failed.
+      std::vector<gazebo::msgs::Any> samples;
+
+      /// \brief Filters with at least one registered item.
+      std::vector<IntrospectionSnapshotFilter> filters;
+    };
+
     /// \brief Private data for the IntrospectionManager class.
     class IntrospectionManagerPrivate
     {
@@ -62,10 +106,8 @@ namespace gazebo
 
       /// \brief List of all registered items.
       /// The key contains the item name.
-      /// The value contains the string representation of the protobuf type
-      /// that stores the value.
-      /// E.g.: allItems["model1::pose"] = "gazebo::msgs::Pose"
-      public: std::map<std::string, std::function <gazebo::msgs::Any ()>>
+      /// The value contains the callback that sets the value of the item.
+      public: std::map<std::string, std::function<void(gazebo::msgs::Any &)>>
           allItems;
 
       /// \brief Set of all registered items names.
@@ -75,13 +117,31 @@ namespace gazebo
 
       /// \brief List of items that have at least one active observer.
       /// The key contains the item name.
-      /// The value contains the last value stored for this item, as well as a
-      /// list of all the filters that contain the item.
+      /// The value contains the list of all the filters that contain the
+      /// item.
       public: std::map<std::string, ObservedItem> observedItems;
 
       /// \brief Mutex to make this class thread-safe.
       public: mutable std::mutex mutex;
 
+      /// \brief Incremented every time an item or a filter changes.
+      /// Protected by mutex.
+      public: uint64_t epoch = 1;
+
+      /// \brief Serializes calls to Update(), and protects snapshot and
+      /// lastPublishTime.
+      public: std::mutex updateMutex;
+
+      /// \brief Snapshot used by Update().
+      public: std::unique_ptr<IntrospectionSnapshot> snapshot;
+
+      /// \brief Rate at which the filter updates are published, in Hz of
+      /// wall time. Zero publishes on every update. Protected by mutex.
+      public: double publishRate = 0;
+
+      /// \brief Wall time of the last publication of the filter updates.
+      public: common::Time lastPublishTime;
+
       /// \brief Node used for communications.
       public: ignition::transport::Node node;
 
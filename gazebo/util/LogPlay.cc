@@ -23,6 +23,10 @@
 #endif
 
 #include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <limits>
+#include <memory>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/iostreams/filter/bzip2.hpp>
@@ -52,7 +56,6 @@ using namespace util;
 LogPlay::LogPlay()
 : dataPtr(new LogPlayPrivate)
 {
-  this->dataPtr->logStartXml = NULL;
 }
 
 /////////////////////////////////////////////////
@@ -63,7 +66,9 @@ LogPlay::~LogPlay()
 /////////////////////////////////////////////////
 void LogPlay::Open(const std::string &_logFile)
 {
-  this->dataPtr->currentChunk.clear();
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  this->dataPtr->Close();
 
   boost::filesystem::path path(_logFile);
   if (!boost::filesystem::exists(path))
@@ -72,12 +77,24 @@ void LogPlay::Open(const std::string &_logFile)
   if (boost::filesystem::is_directory(path))
     gzthrow("Invalid logfile [" + _logFile + "]. This is a directory.");
 
-  // Flag use to indicate if a parser failure has occurred
-  bool xmlParserFail = this->dataPtr->xmlDoc.LoadFile(_logFile.c_str()) !=
-    tinyxml2::XML_SUCCESS;
+  // Binary logs start with a magic string, anything else is parsed as XML.
+  {
+    const size_t magicSize = std::strlen(GZ_LOG_BINARY_MAGIC);
+    std::string magic(magicSize, '\0');
+    std::ifstream inFile(_logFile, std::ios::binary);
+    inFile.read(&magic[0], magicSize);
+    this->dataPtr->binary = inFile && magic == GZ_LOG_BINARY_MAGIC;
+  }
 
-  // Parse the log file
-  if (xmlParserFail)
+  if (this->dataPtr->binary)
+  {
+    if (!this->dataPtr->OpenBinary(_logFile))
+    {
+      this->dataPtr->Close();
+      gzthrow("Error parsing binary log file");
+    }
+  }
+  else
   {
     std::string endTag = "</gazebo_log>";
     // Open the log file for reading, we will check if the end of the log
@@ -104,68 +121,44 @@ void LogPlay::Open(const std::string &_logFile)
           // Add the end tag
           fix << endTag << std::endl;
           fix.close();
-
-          // Retry loading the log file.
-          xmlParserFail = this->dataPtr->xmlDoc.LoadFile(_logFile.c_str()) !=
-            tinyxml2::XML_SUCCESS;
         }
       }
     }
-  }
 
-  // Output error and throw if the log file had a problem.
-  // \todo Remove throws in this class. A failure to open a log file is not
-  // a critical failure.
-  if (xmlParserFail)
-  {
-    gzerr << "Unable to load file[" << _logFile << "]. "
-      << "Check the Gazebo server log file for more information.\n";
-#ifdef TINYXML2_MAJOR_VERSION_GE_6
-    const char *errorStr1 = this->dataPtr->xmlDoc.ErrorStr();
-    const char *errorStr2 = nullptr;
-#else
-    const char *errorStr1 = this->dataPtr->xmlDoc.GetErrorStr1();
-    const char *errorStr2 = this->dataPtr->xmlDoc.GetErrorStr2();
-#endif
-    if (errorStr1)
-      gzlog << "Log Error 1:\n" << errorStr1 << std::endl;
-    if (errorStr2)
-      gzlog << "Log Error 2:\n" << errorStr2 << std::endl;
-    gzthrow("Error parsing log file");
+    // Only the header is parsed here. Chunks are located and decompressed
+    // when they are needed, so opening does not depend on the log size.
+    // \todo Remove throws in this class. A failure to open a log file is
+    // not a critical failure.
+    if (!this->dataPtr->OpenXml(_logFile))
+    {
+      gzerr << "Unable to load file[" << _logFile << "]. "
+        << "Check the Gazebo server log file for more information.\n";
+      this->dataPtr->Close();
+      gzthrow("Error parsing log file");
+    }
   }
 
-  // Get the gazebo_log element
-  this->dataPtr->logStartXml =
-    this->dataPtr->xmlDoc.FirstChildElement("gazebo_log");
-
-  if (!this->dataPtr->logStartXml)
-    gzthrow("Log file is missing the <gazebo_log> element");
-
   // Store the filename for future use.
   this->dataPtr->filename = _logFile;
 
-  // Read in the header.
-  this->ReadHeader();
-
-  this->dataPtr->logCurrXml = this->dataPtr->logStartXml;
-  this->dataPtr->encoding.clear();
-
-  // Extract the start/end log times from the log.
-  this->ReadLogTimes();
-
-  // Extract the initial "iterations" value from the log.
-  this->dataPtr->iterationsFound = this->ReadIterations();
+  try
+  {
+    // Read in the header.
+    this->ReadHeader();
 
-  this->dataPtr->logCurrXml =
-    this->dataPtr->logStartXml->FirstChildElement("chunk");
+    // Extract the start/end log times from the log.
+    this->ReadLogTimes();
 
-  if (!this->dataPtr->logCurrXml)
-    gzthrow("Unable to find the first chunk");
+    // Extract the initial "iterations" value from the log.
+    this->dataPtr->iterationsFound = this->ReadIterations();
 
-  if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
-                                this->dataPtr->currentChunk))
+    if (!this->Chunk(0, this->dataPtr->currentChunk))
+      gzthrow("Unable to decode log file");
+  }
+  catch(...)
   {
-    gzthrow("Unable to decode log file");
+    this->dataPtr->Close();
+    throw;
   }
 
   this->dataPtr->start = 0;
@@ -212,8 +205,31 @@ void LogPlay::ReadHeader()
   this->dataPtr->logVersion.clear();
   this->dataPtr->gazeboVersion.clear();
 
+  if (this->dataPtr->binary)
+  {
+    const msgs::LogIndex &header = this->dataPtr->binaryIndex;
+    this->dataPtr->logVersion = header.log_version();
+    if (this->dataPtr->logVersion != GZ_LOG_VERSION)
+    {
+      gzwarn << "Log version[" << this->dataPtr->logVersion << "] in file["
+             << this->dataPtr->filename
+             << "] does not match Gazebo's log version["
+             << GZ_LOG_VERSION << "]\n";
+      return;
+    }
+
+    this->dataPtr->gazeboVersion = header.gazebo_version();
+    if (header.has_rand_seed())
+      this->dataPtr->randSeed = header.rand_seed();
+    else
+      gzerr << "Log file header is missing the random number seed.\n";
+
+    ignition::math::Rand::Seed(this->dataPtr->randSeed);
+    return;
+  }
+
   // Get the header element
-  headerXml = this->dataPtr->logStartXml->FirstChildElement("header");
+  headerXml = this->dataPtr->xmlDoc.FirstChildElement("header");
   if (!headerXml)
     gzthrow("Log file has no header");
 
@@ -258,24 +274,50 @@ void LogPlay::ReadHeader()
 /////////////////////////////////////////////////
 void LogPlay::ReadLogTimes()
 {
+  // Binary logs have the times in their index, no chunk is decompressed.
+  if (this->dataPtr->binary)
+  {
+    const msgs::LogIndex &index = this->dataPtr->binaryIndex;
+    bool found = false;
+    for (int i = 0; i < index.entries_size() && !found; ++i)
+    {
+      if (index.entries(i).has_start_time())
+      {
+        this->dataPtr->logStartTime =
+            msgs::Convert(index.entries(i).start_time());
+        found = true;
+      }
+    }
+    if (!found)
+      gzwarn << "Unable to find <sim_time> tags in any chunk." << std::endl;
+
+    for (int i = index.entries_size() - 1; i >= 0; --i)
+    {
+      if (index.entries(i).has_end_time())
+      {
+        this->dataPtr->logEndTime = msgs::Convert(index.entries(i).end_time());
+        break;
+      }
+    }
+    return;
+  }
+
   std::string chunk;
   bool found = false;
-
-  auto chunkXml = this->dataPtr->logStartXml->FirstChildElement("chunk");
+  uint64_t begin = 0;
+  uint64_t end = 0;
 
   // Try to read the start time of the log.
-  auto numChunksToTry =
-    std::min(this->ChunkCount(), this->dataPtr->kNumChunksToTry);
-
-  for (unsigned int i = 0; i < numChunksToTry; ++i)
+  for (unsigned int i = 0; i < this->dataPtr->kNumChunksToTry; ++i)
   {
-    if (!chunkXml)
+    if (!this->dataPtr->XmlChunkExtent(i, begin, end))
     {
-      gzerr << "Unable to find the first chunk" << std::endl;
-      return;
+      if (i == 0)
+        gzerr << "Unable to find the first chunk" << std::endl;
+      break;
     }
 
-    if (!this->dataPtr->ChunkData(chunkXml, chunk))
+    if (!this->dataPtr->XmlChunkData(begin, end, chunk))
       return;
 
     // Find the first <sim_time> of the log.
@@ -292,22 +334,20 @@ void LogPlay::ReadLogTimes()
       found = true;
       break;
     }
-
-    chunkXml = chunkXml->NextSiblingElement("chunk");
   }
 
   if (!found)
     gzwarn << "Unable to find <sim_time> tags in any chunk." << std::endl;
 
-  // Jump to the last chunk for finding the last <sim_time>.
-  auto lastChunk = this->dataPtr->logStartXml->LastChildElement("chunk");
-  if (!lastChunk)
+  // Jump to the last chunk for finding the last <sim_time>. It is searched
+  // backwards from the end of the file, without scanning the other chunks.
+  if (!this->dataPtr->PrevXmlChunk(this->dataPtr->logFile.size(), begin, end))
   {
     gzerr << "Unable to jump to the last chunk of the log file\n";
     return;
   }
 
-  if (!this->dataPtr->ChunkData(lastChunk, chunk))
+  if (!this->dataPtr->XmlChunkData(begin, end, chunk))
     return;
 
   // Update the last <sim_time> of the log.
@@ -336,23 +376,32 @@ bool LogPlay::ReadIterations()
   const std::string kStartDelim = "<iterations>";
   const std::string kEndDelim = "</iterations>";
 
-  auto chunkXml = this->dataPtr->logStartXml->FirstChildElement("chunk");
-
   // Read the first "iterations" value of the log from the first chunk.
-  auto numChunksToTry =
-    std::min(this->ChunkCount(), this->dataPtr->kNumChunksToTry);
-
-  for (unsigned int i = 0; i < numChunksToTry; ++i)
+  for (unsigned int i = 0; i < this->dataPtr->kNumChunksToTry; ++i)
   {
-    if (!chunkXml)
+    std::string chunk;
+    if (this->dataPtr->binary)
     {
-      gzerr << "Unable to find the first chunk" << std::endl;
-      return false;
+      if (!this->dataPtr->BinaryChunkData(i, chunk))
+        break;
     }
+    else
+    {
+      uint64_t begin = 0;
+      uint64_t end = 0;
+      if (!this->dataPtr->XmlChunkExtent(i, begin, end))
+      {
+        if (i == 0)
+        {
+          gzerr << "Unable to find the first chunk" << std::endl;
+          return false;
+        }
+        break;
+      }
 
-    std::string chunk;
-    if (!this->dataPtr->ChunkData(chunkXml, chunk))
-      return false;
+      if (!this->dataPtr->XmlChunkData(begin, end, chunk))
+        return false;
+    }
 
     // Find the first <iterations> of the log.
     auto from = chunk.find(kStartDelim);
@@ -365,8 +414,6 @@ bool LogPlay::ReadIterations()
       ss >> this->dataPtr->initialIterations;
       return true;
     }
-
-    chunkXml = chunkXml->NextSiblingElement("chunk");
   }
 
   gzwarn << "Unable to find <iterations>...</iterations> tags in the first "
@@ -378,7 +425,7 @@ bool LogPlay::ReadIterations()
 /////////////////////////////////////////////////
 bool LogPlay::IsOpen() const
 {
-  return this->dataPtr->logStartXml != NULL;
+  return this->dataPtr->logFile.is_open();
 }
 
 /////////////////////////////////////////////////
@@ -536,21 +583,13 @@ bool LogPlay::Rewind()
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   this->dataPtr->currentChunk.clear();
-  this->dataPtr->logCurrXml =
-    this->dataPtr->logStartXml->FirstChildElement("chunk");
 
-  if (!this->dataPtr->logCurrXml)
+  if (!this->Chunk(0, this->dataPtr->currentChunk))
   {
     gzerr << "Unable to jump to the beginning of the log file\n";
     return false;
   }
 
-  if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
-                                this->dataPtr->currentChunk))
-  {
-    return false;
-  }
-
   // Skip first <sdf> block (it doesn't have a world state).
   this->dataPtr->end = this->dataPtr->currentChunk.find(
       this->dataPtr->kEndFrame);
@@ -576,19 +615,37 @@ bool LogPlay::Forward()
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   // Get the last chunk.
-  this->dataPtr->logCurrXml =
-    this->dataPtr->logStartXml->LastChildElement("chunk");
-
-  if (!this->dataPtr->logCurrXml)
+  if (this->dataPtr->binary)
   {
-    gzerr << "Unable to jump to the end of the log file\n";
-    return false;
-  }
+    if (this->dataPtr->binaryIndex.entries_size() == 0)
+    {
+      gzerr << "Unable to jump to the end of the log file\n";
+      return false;
+    }
 
-  if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
-                                this->dataPtr->currentChunk))
+    this->dataPtr->binaryChunk = this->dataPtr->binaryIndex.entries_size() - 1;
+    if (!this->dataPtr->BinaryChunkData(this->dataPtr->binaryChunk,
+                                        this->dataPtr->currentChunk))
+    {
+      return false;
+    }
+  }
+  else
   {
-    return false;
+    uint64_t begin = 0;
+    uint64_t end = 0;
+    if (!this->dataPtr->PrevXmlChunk(this->dataPtr->logFile.size(),
+          begin, end))
+    {
+      gzerr << "Unable to jump to the end of the log file\n";
+      return false;
+    }
+
+    if (!this->dataPtr->XmlChunkData(begin, end, this->dataPtr->currentChunk))
+      return false;
+
+    this->dataPtr->xmlChunkBegin = begin;
+    this->dataPtr->xmlChunkEnd = end;
   }
 
   this->dataPtr->start = this->dataPtr->currentChunk.size() - 1;
@@ -610,53 +667,69 @@ bool LogPlay::Seek(const common::Time &_time)
 
   common::Time logTime = this->dataPtr->logStartTime;
 
-  // 1st step: Locate the chunk: We're looking for the first chunk that has
-  // a time greater than the target time.
-  int64_t imin = 0;
-  int64_t imax = this->ChunkCount() - 1;
-  while (imin <= imax)
+  if (this->dataPtr->binary)
   {
-    int64_t imid = imin + ((imax - imin) / 2);
-    this->Chunk(imid, this->dataPtr->currentChunk);
-
-    this->dataPtr->start = 0;
-    this->dataPtr->end = -1 * this->dataPtr->kEndFrame.size();
+    // 1st step: The index gives the last chunk that starts before the
+    // target time, which is the only chunk that needs to be decompressed.
+    const auto &times = this->dataPtr->binaryStartTimes;
+    auto it = std::lower_bound(times.begin(), times.end(), _time);
+    unsigned int index = it == times.begin() ? 0 : (it - times.begin()) - 1;
+    if (!this->Chunk(index, this->dataPtr->currentChunk))
+      return false;
 
-    // We try a few times looking for <sim_time>.
-    for (unsigned int i = 0; i < 2; ++i)
+    this->dataPtr->start = this->dataPtr->currentChunk.size() - 1;
+    this->dataPtr->end = this->dataPtr->currentChunk.size() - 1;
+  }
+  else
+  {
+    // 1st step: Locate the chunk: We're looking for the first chunk that has
+    // a time greater than the target time.
+    int64_t imin = 0;
+    int64_t imax = this->ChunkCount() - 1;
+    while (imin <= imax)
     {
-      std::string frame;
-      if (!this->Step(frame))
-        return false;
+      int64_t imid = imin + ((imax - imin) / 2);
+      this->Chunk(imid, this->dataPtr->currentChunk);
+
+      this->dataPtr->start = 0;
+      this->dataPtr->end = -1 * this->dataPtr->kEndFrame.size();
 
-      // Search the <sim_time> in the first frame of the current chunk.
-      auto from = frame.find(this->dataPtr->kStartTime);
-      auto to = frame.find(
-          this->dataPtr->kEndTime, from + this->dataPtr->kStartTime.size());
-      if (from != std::string::npos && to != std::string::npos)
+      // We try a few times looking for <sim_time>.
+      for (unsigned int i = 0; i < 2; ++i)
       {
-        auto length = to - from - this->dataPtr->kStartTime.size();
-        auto logTimeStr = frame.substr(
-            from + this->dataPtr->kStartTime.size(), length);
-        std::stringstream ss(logTimeStr);
-        ss >> logTime;
-        break;
+        std::string frame;
+        if (!this->Step(frame))
+          return false;
+
+        // Search the <sim_time> in the first frame of the current chunk.
+        auto from = frame.find(this->dataPtr->kStartTime);
+        auto to = frame.find(
+            this->dataPtr->kEndTime, from + this->dataPtr->kStartTime.size());
+        if (from != std::string::npos && to != std::string::npos)
+        {
+          auto length = to - from - this->dataPtr->kStartTime.size();
+          auto logTimeStr = frame.substr(
+              from + this->dataPtr->kStartTime.size(), length);
+          std::stringstream ss(logTimeStr);
+          ss >> logTime;
+          break;
+        }
       }
-    }
 
-    // Chunk found.
-    if (logTime == _time)
-      break;
-    else if (logTime < _time)
-      imin = imid + 1;
-    else
-      imax = imid - 1;
-  }
+      // Chunk found.
+      if (logTime == _time)
+        break;
+      else if (logTime < _time)
+        imin = imid + 1;
+      else
+        imax = imid - 1;
+    }
 
-  if (logTime < _time)
-  {
-    if (!this->NextChunk())
-      this->Forward();
+    if (logTime < _time)
+    {
+      if (!this->NextChunk())
+        this->Forward();
+    }
   }
 
   // 2nd step: Locate the frame in the previous chunk.
@@ -690,21 +763,26 @@ bool LogPlay::Seek(const common::Time &_time)
 /////////////////////////////////////////////////
 bool LogPlay::Chunk(unsigned int _index, std::string &_data) const
 {
-  unsigned int count = 0;
-  this->dataPtr->logCurrXml =
-    this->dataPtr->logStartXml->FirstChildElement("chunk");
-
-  while (this->dataPtr->logCurrXml && count < _index)
+  if (this->dataPtr->binary)
   {
-    count++;
-    this->dataPtr->logCurrXml =
-      this->dataPtr->logCurrXml->NextSiblingElement("chunk");
+    if (!this->dataPtr->BinaryChunkData(_index, _data))
+      return false;
+
+    this->dataPtr->binaryChunk = _index;
+    return true;
   }
 
-  if (this->dataPtr->logCurrXml && count == _index)
-    return this->dataPtr->ChunkData(this->dataPtr->logCurrXml, _data);
-  else
+  uint64_t begin = 0;
+  uint64_t end = 0;
+  if (!this->dataPtr->XmlChunkExtent(_index, begin, end) ||
+      !this->dataPtr->XmlChunkData(begin, end, _data))
+  {
     return false;
+  }
+
+  this->dataPtr->xmlChunkBegin = begin;
+  this->dataPtr->xmlChunkEnd = end;
+  return true;
 }
 
 /////////////////////////////////////////////////
@@ -730,54 +808,462 @@ bool LogPlayPrivate::ChunkData(
 
   if (this->encoding == "txt")
     _data = _xml->GetText();
-  else if (this->encoding == "bz2")
+  else if (this->encoding == "bz2" || this->encoding == "zlib")
   {
-    std::string data = _xml->GetText();
-    std::string buffer;
-
     // Decode the base64 string
-    buffer = Base64Decode(data);
+    return this->Decompress(this->encoding, Base64Decode(_xml->GetText()),
+        _data);
+  }
+  else
+  {
+    gzerr << "Invalid encoding[" << this->encoding << "] in log file["
+      << this->filename << "]\n";
+    return false;
+  }
 
-    // Decompress the bz2 data
-    {
-      boost::iostreams::filtering_istream in;
-      in.push(boost::iostreams::bzip2_decompressor());
-      in.push(boost::make_iterator_range(buffer));
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool LogPlayPrivate::Decompress(const std::string &_encoding,
+    const std::string &_compressed, std::string &_data)
+{
+  if (_encoding == "txt")
+  {
+    _data = _compressed;
+    return true;
+  }
+
+  boost::iostreams::filtering_istream in;
+  if (_encoding == "bz2")
+    in.push(boost::iostreams::bzip2_decompressor());
+  else if (_encoding == "zlib")
+    in.push(boost::iostreams::zlib_decompressor());
+  else
+  {
+    gzerr << "Invalid encoding[" << _encoding << "] in log file["
+      << this->filename << "]\n";
+    return false;
+  }
+  in.push(boost::make_iterator_range(_compressed));
+
+  // Get the data
+  std::getline(in, _data, '\0');
+  _data += '\0';
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Map a log file in memory.
+/// \param[in] _logFile Path to the log file.
+/// \param[out] _mapped Mapped file.
+/// \return True if the file was mapped.
+static bool MapFile(const std::string &_logFile,
+    boost::iostreams::mapped_file_source &_mapped)
+{
+  try
+  {
+    _mapped.open(_logFile);
+  }
+  catch(std::exception &_e)
+  {
+    gzerr << "Unable to map log file[" << _logFile << "]: " << _e.what()
+          << std::endl;
+    return false;
+  }
+
+  return _mapped.is_open();
+}
+
+/////////////////////////////////////////////////
+/// \brief Search a token in a range of memory.
+/// \param[in] _data Start of the memory.
+/// \param[in] _from Offset to start searching from.
+/// \param[in] _to Offset to stop searching at.
+/// \param[in] _token Token to search.
+/// \return Offset of the token, or std::string::npos if not found.
+static uint64_t FindToken(const char *_data, uint64_t _from,
+    const uint64_t _to, const std::string &_token)
+{
+  while (_from + _token.size() <= _to)
+  {
+    const void *found = std::memchr(_data + _from, _token[0],
+        _to - _from - _token.size() + 1);
+    if (!found)
+      break;
 
-      // Get the data
-      std::getline(in, _data, '\0');
-      _data += '\0';
+    _from = static_cast<const char *>(found) - _data;
+    if (std::memcmp(_data + _from, _token.c_str(), _token.size()) == 0)
+      return _from;
+    ++_from;
+  }
+
+  return std::string::npos;
+}
+
+/////////////////////////////////////////////////
+/// \brief Search the last occurrence of a token in a range of memory.
+/// \param[in] _data Start of the memory.
+/// \param[in] _from Offset of the start of the range.
+/// \param[in] _to Offset of the end of the range. The token must end at or
+/// before this offset.
+/// \param[in] _token Token to search.
+/// \return Offset of the token, or std::string::npos if not found.
+static uint64_t RFindToken(const char *_data, const uint64_t _from,
+    const uint64_t _to, const std::string &_token)
+{
+  if (_to < _from + _token.size())
+    return std::string::npos;
+
+  for (uint64_t i = _to - _token.size() + 1; i-- > _from;)
+  {
+    if (_data[i] == _token[0] &&
+        std::memcmp(_data + i, _token.c_str(), _token.size()) == 0)
+    {
+      return i;
     }
   }
-  else if (this->encoding == "zlib")
+
+  return std::string::npos;
+}
+
+/////////////////////////////////////////////////
+void LogPlayPrivate::Close()
+{
+  if (this->logFile.is_open())
+    this->logFile.close();
+
+  this->binary = false;
+  this->binaryIndex.Clear();
+  this->binaryStartTimes.clear();
+  this->binaryChunk = 0;
+  this->xmlDoc.Clear();
+  this->xmlChunks.clear();
+  this->xmlScanDone = false;
+  this->xmlChunkBegin = 0;
+  this->xmlChunkEnd = 0;
+  this->chunkCache.clear();
+  this->currentChunk.clear();
+  this->encoding.clear();
+}
+
+/////////////////////////////////////////////////
+bool LogPlayPrivate::OpenXml(const std::string &_logFile)
+{
+  if (!MapFile(_logFile, this->logFile))
+    return false;
+
+  const char *data = this->logFile.data();
+  const uint64_t size = this->logFile.size();
+
+  // The root element must be <gazebo_log>, and the header is its first
+  // child. Chunks follow the header.
+  const std::string rootTag = "<gazebo_log";
+  uint64_t root = FindToken(data, 0, size, rootTag);
+  if (root == std::string::npos || root + rootTag.size() >= size ||
+      (data[root + rootTag.size()] != '>' &&
+       !std::isspace(static_cast<unsigned char>(
+         data[root + rootTag.size()]))))
+  {
+    gzerr << "Log file is missing the <gazebo_log> element\n";
+    return false;
+  }
+
+  const std::string headerEndTag = "</header>";
+  uint64_t headerBegin = FindToken(data, root, size, "<header>");
+  uint64_t headerEnd = headerBegin == std::string::npos ? std::string::npos :
+      FindToken(data, headerBegin, size, headerEndTag);
+  if (headerEnd == std::string::npos)
   {
-    std::string data = _xml->GetText();
-    std::string buffer;
+    gzerr << "Log file has no header\n";
+    return false;
+  }
+  headerEnd += headerEndTag.size();
 
-    // Decode the base64 string
-    buffer = Base64Decode(data);
+  if (this->xmlDoc.Parse(data + headerBegin, headerEnd - headerBegin) !=
+      tinyxml2::XML_SUCCESS)
+  {
+#ifdef TINYXML2_MAJOR_VERSION_GE_6
+    const char *errorStr1 = this->xmlDoc.ErrorStr();
+    const char *errorStr2 = nullptr;
+#else
+    const char *errorStr1 = this->xmlDoc.GetErrorStr1();
+    const char *errorStr2 = this->xmlDoc.GetErrorStr2();
+#endif
+    if (errorStr1)
+      gzlog << "Log Error 1:\n" << errorStr1 << std::endl;
+    if (errorStr2)
+      gzlog << "Log Error 2:\n" << errorStr2 << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool LogPlayPrivate::NextXmlChunk(const uint64_t _from,
+    uint64_t &_begin, uint64_t &_end) const
+{
+  const std::string startTag = "<chunk";
+  const std::string endTag = "</chunk>";
+  const char *data = this->logFile.data();
+  const uint64_t size = this->logFile.size();
+
+  _begin = FindToken(data, _from, size, startTag);
+  if (_begin == std::string::npos)
+    return false;
+
+  // A chunk that was not completely written is ignored.
+  _end = FindToken(data, _begin + startTag.size(), size, endTag);
+  if (_end == std::string::npos)
+    return false;
+
+  _end += endTag.size();
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool LogPlayPrivate::PrevXmlChunk(const uint64_t _to,
+    uint64_t &_begin, uint64_t &_end) const
+{
+  const std::string startTag = "<chunk";
+  const std::string endTag = "</chunk>";
+  const char *data = this->logFile.data();
+
+  _end = RFindToken(data, 0, _to, endTag);
+  if (_end == std::string::npos)
+    return false;
+
+  _begin = RFindToken(data, 0, _end, startTag);
+  if (_begin == std::string::npos)
+    return false;
+
+  _end += endTag.size();
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool LogPlayPrivate::XmlChunkExtent(const unsigned int _index,
+    uint64_t &_begin, uint64_t &_end)
+{
+  while (this->xmlChunks.size() <= _index && !this->xmlScanDone)
+  {
+    uint64_t from = this->xmlChunks.empty() ?
+        0 : this->xmlChunks.back().second;
+    if (this->NextXmlChunk(from, _begin, _end))
+      this->xmlChunks.push_back(std::make_pair(_begin, _end));
+    else
+      this->xmlScanDone = true;
+  }
+
+  if (_index >= this->xmlChunks.size())
+    return false;
+
+  _begin = this->xmlChunks[_index].first;
+  _end = this->xmlChunks[_index].second;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool LogPlayPrivate::XmlChunkData(const uint64_t _begin, const uint64_t _end,
+    std::string &_data)
+{
+  if (this->CachedChunkData(_begin, _data))
+    return true;
+
+  // Parse only this chunk. The base64 text is released as soon as the
+  // chunk is decompressed.
+  tinyxml2::XMLDocument chunkDoc;
+  if (chunkDoc.Parse(this->logFile.data() + _begin, _end - _begin) !=
+      tinyxml2::XML_SUCCESS)
+  {
+    gzerr << "Unable to parse chunk at offset[" << _begin << "] of log file["
+          << this->filename << "]\n";
+    return false;
+  }
+
+  if (!this->ChunkData(chunkDoc.FirstChildElement("chunk"), _data))
+    return false;
+
+  this->CacheChunk(_begin, _data);
+  return true;
+}
 
-    // Decompress the zlib data
+/////////////////////////////////////////////////
+bool LogPlayPrivate::OpenBinary(const std::string &_logFile)
+{
+  if (!MapFile(_logFile, this->logFile))
+    return false;
+
+  const uint64_t fileSize = this->logFile.size();
+  this->binaryIndex.Clear();
+  this->binaryStartTimes.clear();
+
+  // The header record follows the magic string.
+  const size_t magicSize = std::strlen(GZ_LOG_BINARY_MAGIC);
+  msgs::LogIndex header;
+  uint64_t offset = magicSize;
+  if (!this->ReadRecord(magicSize, header, &offset))
+  {
+    gzerr << "Binary log file[" << _logFile << "] has no header\n";
+    return false;
+  }
+
+  // The footer is the offset of the index followed by the index magic.
+  bool indexFound = false;
+  if (fileSize >= offset + 8 + magicSize)
+  {
+    const char *footer = this->logFile.data() + fileSize - 8 - magicSize;
+    if (std::memcmp(footer + 8, GZ_LOG_INDEX_MAGIC, magicSize) == 0)
     {
-      boost::iostreams::filtering_istream in;
-      in.push(boost::iostreams::zlib_decompressor());
-      in.push(boost::make_iterator_range(buffer));
+      uint64_t indexOffset = 0;
+      for (int i = 0; i < 8; ++i)
+      {
+        indexOffset |= static_cast<uint64_t>(
+            static_cast<unsigned char>(footer[i])) << (8 * i);
+      }
+      indexFound = this->ReadRecord(indexOffset, this->binaryIndex, nullptr);
+    }
+  }
+
+  // A log that was not stopped cleanly has no footer, scan its chunks.
+  if (!indexFound)
+  {
+    gzwarn << "Binary log file[" << _logFile << "] has no index. "
+           << "Rebuilding it, this may take a while.\n";
 
-      // Get the data
-      std::getline(in, _data, '\0');
-      _data += '\0';
+    this->binaryIndex.CopyFrom(header);
+    this->binaryIndex.clear_entries();
+
+    msgs::LogChunk chunk;
+    uint64_t next = offset;
+    while (offset < fileSize &&
+           this->ReadRecord(offset, chunk, &next) &&
+           chunk.has_encoding() && chunk.has_data())
+    {
+      msgs::LogIndex::Entry *entry = this->binaryIndex.add_entries();
+      entry->set_offset(offset);
+      if (chunk.has_start_time())
+        entry->mutable_start_time()->CopyFrom(chunk.start_time());
+      if (chunk.has_end_time())
+        entry->mutable_end_time()->CopyFrom(chunk.end_time());
+      entry->set_frame_count(chunk.frame_count());
+      offset = next;
     }
   }
-  else
+
+  if (this->binaryIndex.entries_size() == 0)
+  {
+    gzerr << "Binary log file[" << _logFile << "] has no chunks\n";
+    return false;
+  }
+
+  common::Time startTime;
+  for (auto const &entry : this->binaryIndex.entries())
+  {
+    if (entry.has_start_time())
+      startTime = msgs::Convert(entry.start_time());
+    this->binaryStartTimes.push_back(startTime);
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool LogPlayPrivate::ReadRecord(const uint64_t _offset,
+    google::protobuf::Message &_msg, uint64_t *_next) const
+{
+  const uint64_t fileSize = this->logFile.size();
+  if (_offset + 8 > fileSize)
+    return false;
+
+  // Records are parsed in place from the mapped file.
+  const unsigned char *sizeBytes =
+      reinterpret_cast<const unsigned char *>(this->logFile.data() + _offset);
+  uint64_t size = 0;
+  for (int i = 0; i < 8; ++i)
+    size |= static_cast<uint64_t>(sizeBytes[i]) << (8 * i);
+
+  if (size > fileSize - _offset - 8 ||
+      size > static_cast<uint64_t>(std::numeric_limits<int>::max()) ||
+      !_msg.ParseFromArray(this->logFile.data() + _offset + 8,
+        static_cast<int>(size)))
   {
-    gzerr << "Invalid encoding[" << this->encoding << "] in log file["
-      << this->filename << "]\n";
     return false;
   }
 
+  if (_next)
+    *_next = _offset + 8 + size;
+
   return true;
 }
 
+/////////////////////////////////////////////////
+bool LogPlayPrivate::BinaryChunkData(const unsigned int _index,
+    std::string &_data)
+{
+  if (_index >= static_cast<unsigned int>(this->binaryIndex.entries_size()))
+    return false;
+
+  const uint64_t offset = this->binaryIndex.entries(_index).offset();
+  if (this->CachedChunkData(offset, _data))
+    return true;
+
+  msgs::LogChunk chunk;
+  if (!this->ReadRecord(offset, chunk, nullptr))
+  {
+    gzerr << "Unable to read chunk[" << _index << "] of log file["
+          << this->filename << "]\n";
+    return false;
+  }
+
+  this->encoding = chunk.encoding();
+  if (!this->Decompress(this->encoding, chunk.data(), _data))
+    return false;
+
+  this->CacheChunk(offset, _data);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool LogPlayPrivate::CachedChunkData(const uint64_t _offset,
+    std::string &_data)
+{
+  for (auto it = this->chunkCache.begin(); it != this->chunkCache.end(); ++it)
+  {
+    if (it->offset == _offset)
+    {
+      this->chunkCache.splice(this->chunkCache.begin(), this->chunkCache, it);
+      this->encoding = it->encoding;
+      _data = *it->data;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/////////////////////////////////////////////////
+void LogPlayPrivate::CacheChunk(const uint64_t _offset,
+    const std::string &_data)
+{
+  CachedChunk cached;
+  cached.offset = _offset;
+  cached.encoding = this->encoding;
+  cached.data = std::make_shared<const std::string>(_data);
+  this->chunkCache.push_front(cached);
+
+  while (this->chunkCache.size() > this->kChunkCacheSize)
+    this->chunkCache.pop_back();
+}
+
+/////////////////////////////////////////////////
+std::string LogPlay::Format() const
+{
+  return this->dataPtr->binary ? "binary" : "xml";
+}
+
 /////////////////////////////////////////////////
 std::string LogPlay::Encoding() const
 {
@@ -787,32 +1273,51 @@ std::string LogPlay::Encoding() const
 /////////////////////////////////////////////////
 unsigned int LogPlay::ChunkCount() const
 {
-  unsigned int count = 0;
-  auto xml = this->dataPtr->logStartXml->FirstChildElement("chunk");
-
-  while (xml)
+  if (this->dataPtr->binary)
+    return this->dataPtr->binaryIndex.entries_size();
+
+  // Scan the remaining chunk boundaries. This only searches the mapped
+  // file for tags, chunks are not parsed.
+  uint64_t begin = 0;
+  uint64_t end = 0;
+  while (!this->dataPtr->xmlScanDone)
   {
-    count++;
-    xml = xml->NextSiblingElement("chunk");
+    this->dataPtr->XmlChunkExtent(this->dataPtr->xmlChunks.size(),
+        begin, end);
   }
 
-  return count;
+  return this->dataPtr->xmlChunks.size();
 }
 
 /////////////////////////////////////////////////
 bool LogPlay::NextChunk()
 {
-  auto next = this->dataPtr->logCurrXml->NextSiblingElement("chunk");
-  if (!next)
-    return false;
+  if (this->dataPtr->binary)
+  {
+    if (this->dataPtr->binaryChunk + 1 >= this->ChunkCount() ||
+        !this->dataPtr->BinaryChunkData(this->dataPtr->binaryChunk + 1,
+          this->dataPtr->currentChunk))
+    {
+      return false;
+    }
+
+    this->dataPtr->binaryChunk++;
+    this->dataPtr->start = 0;
+    this->dataPtr->end = -1 * this->dataPtr->kEndFrame.size();
+    return true;
+  }
 
-  this->dataPtr->logCurrXml = next;
-  if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
-                                this->dataPtr->currentChunk))
+  uint64_t begin = 0;
+  uint64_t end = 0;
+  if (!this->dataPtr->NextXmlChunk(this->dataPtr->xmlChunkEnd, begin, end) ||
+      !this->dataPtr->XmlChunkData(begin, end, this->dataPtr->currentChunk))
   {
     return false;
   }
 
+  this->dataPtr->xmlChunkBegin = begin;
+  this->dataPtr->xmlChunkEnd = end;
+
   this->dataPtr->start = 0;
   this->dataPtr->end = -1 * this->dataPtr->kEndFrame.size();
 
@@ -822,17 +1327,33 @@ bool LogPlay::NextChunk()
 /////////////////////////////////////////////////
 bool LogPlay::PrevChunk()
 {
-  auto prev = this->dataPtr->logCurrXml->PreviousSiblingElement("chunk");
-  if (!prev)
-    return false;
+  if (this->dataPtr->binary)
+  {
+    if (this->dataPtr->binaryChunk == 0 ||
+        !this->dataPtr->BinaryChunkData(this->dataPtr->binaryChunk - 1,
+          this->dataPtr->currentChunk))
+    {
+      return false;
+    }
 
-  this->dataPtr->logCurrXml = prev;
-  if (!this->dataPtr->ChunkData(this->dataPtr->logCurrXml,
-                                this->dataPtr->currentChunk))
+    this->dataPtr->binaryChunk--;
+    this->dataPtr->start = this->dataPtr->currentChunk.size() - 1;
+    this->dataPtr->end = this->dataPtr->currentChunk.size() - 1;
+    return true;
+  }
+
+  uint64_t begin = 0;
+  uint64_t end = 0;
+  if (!this->dataPtr->PrevXmlChunk(this->dataPtr->xmlChunkBegin,
+        begin, end) ||
+      !this->dataPtr->XmlChunkData(begin, end, this->dataPtr->currentChunk))
   {
     return false;
   }
 
+  this->dataPtr->xmlChunkBegin = begin;
+  this->dataPtr->xmlChunkEnd = end;
+
   this->dataPtr->start = this->dataPtr->currentChunk.size() - 1;
   this->dataPtr->end = this->dataPtr->currentChunk.size() - 1;
 
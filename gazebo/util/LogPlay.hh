@@ -146,6 +146,10 @@ namespace gazebo
       /// LogPlay::Step has not been called at least once.
       public: std::string Encoding() const;
 
+      /// \brief Get the format of the open log file.
+      /// \return Either xml or binary.
+      public: std::string Format() const;
+
       /// \brief Get the header that was read from a log file. Should call
       /// LogPlay::Open first.
       /// \return Header of the open log file.
@@ -25,10 +25,17 @@
 #include <tinyxml2.h>
 #endif
 
+#include <list>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/iostreams/device/mapped_file.hpp>
 
 #include "gazebo/common/Time.hh"
+#include "gazebo/msgs/msgs.hh"
 #include "gazebo/util/system.hh"
 
 namespace gazebo
@@ -39,6 +46,22 @@ namespace gazebo
     /// \brief Private data for log play
     class LogPlayPrivate
     {
+      /// \brief A decompressed chunk kept in the chunk cache.
+      public: class CachedChunk
+      {
+        /// \brief Offset of the chunk in the log file.
+        public: uint64_t offset = 0;
+
+        /// \brief Encoding of the chunk.
+        public: std::string encoding;
+
+        /// \brief Decompressed chunk data.
+        public: std::shared_ptr<const std::string> data;
+      };
+
+      /// \brief Unmap the log file and reset the state of the open log.
+      public: void Close();
+
       /// \brief Helper function to get chunk data from XML.
       /// \param[in] _xml Pointer to an xml block that has state data.
       /// \param[out] _data Storage for the chunk's data.
@@ -47,6 +70,91 @@ namespace gazebo
                   tinyxml2::XMLElement *_xml,
                   std::string &_data);
 
+      /// \brief Decompress chunk data.
+      /// \param[in] _encoding Encoding of the chunk: txt, zlib or bz2.
+      /// \param[in] _compressed Compressed data, without base64 encoding.
+      /// \param[out] _data Storage for the chunk's data.
+      /// \return True if the data was successfully decompressed.
+      public: bool Decompress(const std::string &_encoding,
+                  const std::string &_compressed,
+                  std::string &_data);
+
+      /// \brief Map an XML log file and parse its header. Chunks are not
+      /// parsed until they are needed.
+      /// \param[in] _logFile Path to the log file.
+      /// \return True if the file was successfully opened.
+      public: bool OpenXml(const std::string &_logFile);
+
+      /// \brief Find the first <chunk> element of an XML log that starts at
+      /// or after an offset.
+      /// \param[in] _from Offset to start searching from.
+      /// \param[out] _begin Offset of the start of the element.
+      /// \param[out] _end Offset just past the end of the element.
+      /// \return True if a complete element was found.
+      public: bool NextXmlChunk(const uint64_t _from,
+                  uint64_t &_begin, uint64_t &_end) const;
+
+      /// \brief Find the last <chunk> element of an XML log that ends at or
+      /// before an offset.
+      /// \param[in] _to Offset to search backwards from.
+      /// \param[out] _begin Offset of the start of the element.
+      /// \param[out] _end Offset just past the end of the element.
+      /// \return True if a complete element was found.
+      public: bool PrevXmlChunk(const uint64_t _to,
+                  uint64_t &_begin, uint64_t &_end) const;
+
+      /// \brief Get the extent of a chunk of an XML log. Chunk boundaries
+      /// are scanned lazily, only up to the requested chunk.
+      /// \param[in] _index Index of the chunk.
+      /// \param[out] _begin Offset of the start of the chunk element.
+      /// \param[out] _end Offset just past the end of the chunk element.
+      /// \return True if the chunk exists.
+      public: bool XmlChunkExtent(const unsigned int _index,
+                  uint64_t &_begin, uint64_t &_end);
+
+      /// \brief Helper function to get the data of an XML chunk.
+      /// \param[in] _begin Offset of the start of the chunk element.
+      /// \param[in] _end Offset just past the end of the chunk element.
+      /// \param[out] _data Storage for the chunk's data.
+      /// \return True if the chunk was successfully parsed.
+      public: bool XmlChunkData(const uint64_t _begin, const uint64_t _end,
+                  std::string &_data);
+
+      /// \brief Open a binary log file and load its index. The index is
+      /// rebuilt by scanning the chunks if the log was not closed properly.
+      /// \param[in] _logFile Path to the log file.
+      /// \return True if the file was successfully opened.
+      public: bool OpenBinary(const std::string &_logFile);
+
+      /// \brief Read a length prefixed message from the binary log file.
+      /// \param[in] _offset Offset of the record in the file.
+      /// \param[out] _msg Message to parse the record into.
+      /// \param[out] _next Offset of the next record, can be nullptr.
+      /// \return True if a complete record was read and parsed.
+      public: bool ReadRecord(const uint64_t _offset,
+                  google::protobuf::Message &_msg,
+                  uint64_t *_next) const;
+
+      /// \brief Helper function to get chunk data from a binary log.
+      /// \param[in] _index Index of the chunk.
+      /// \param[out] _data Storage for the chunk's data.
+      /// \return True if the chunk was successfully read.
+      public: bool BinaryChunkData(const unsigned int _index,
+                  std::string &_data);
+
+      /// \brief Look up a decompressed chunk in the cache, and mark it as
+      /// the most recently used one.
+      /// \param[in] _offset Offset of the chunk in the log file.
+      /// \param[out] _data Storage for the chunk's data.
+      /// \return True if the chunk was in the cache.
+      public: bool CachedChunkData(const uint64_t _offset, std::string &_data);
+
+      /// \brief Add a decompressed chunk to the cache, evicting the least
+      /// recently used chunk if the cache is full.
+      /// \param[in] _offset Offset of the chunk in the log file.
+      /// \param[in] _data Decompressed chunk data.
+      public: void CacheChunk(const uint64_t _offset, const std::string &_data);
+
       /// \brief Max number of chunks to inspect when looking for XML elements.
       public: const unsigned int kNumChunksToTry = 2u;
 
@@ -62,14 +170,32 @@ namespace gazebo
       /// \brief XML tag delimiting the end of a simulation time element.
       public: const std::string kEndTime = "</sim_time>";
 
-      /// \brief The XML document of the log file.
+      /// \brief Number of decompressed chunks kept in the chunk cache.
+      public: const size_t kChunkCacheSize = 4u;
+
+      /// \brief The memory mapped log file.
+      public: boost::iostreams::mapped_file_source logFile;
+
+      /// \brief The XML document holding the header of an XML log file.
+      /// Chunks are parsed one at a time, straight from the mapped file.
       public: tinyxml2::XMLDocument xmlDoc;
 
-      /// \brief Start of the log.
-      public: tinyxml2::XMLElement *logStartXml = nullptr;
+      /// \brief Extents of the chunks of an XML log that have been scanned
+      /// so far.
+      public: std::vector<std::pair<uint64_t, uint64_t>> xmlChunks;
+
+      /// \brief True when all the chunks of an XML log have been scanned.
+      public: bool xmlScanDone = false;
+
+      /// \brief Offset of the start of the current chunk of an XML log.
+      public: uint64_t xmlChunkBegin = 0;
+
+      /// \brief Offset just past the end of the current chunk of an XML
+      /// log.
+      public: uint64_t xmlChunkEnd = 0;
 
-      /// \brief Current position in the log file.
-      public: tinyxml2::XMLElement *logCurrXml = nullptr;
+      /// \brief Recently decompressed chunks, most recently used first.
+      public: std::list<CachedChunk> chunkCache;
 
       /// \brief Name of the log file.
       public: std::string filename;
@@ -111,6 +237,20 @@ namespace gazebo
       /// may not include this tag in the log files.
       public: bool iterationsFound = false;
 
+      /// \brief True if the open log file uses the binary format.
+      public: bool binary = false;
+
+      /// \brief Header and chunk index of the open binary log file.
+      public: msgs::LogIndex binaryIndex;
+
+      /// \brief Simulation time at which each binary chunk starts. Chunks
+      /// without states get the time of the previous chunk, so the vector
+      /// is sorted and can be used to seek.
+      public: std::vector<common::Time> binaryStartTimes;
+
+      /// \brief Index of the current chunk in a binary log file.
+      public: unsigned int binaryChunk = 0;
+
       /// \brief A mutex to avoid race conditions.
       public: std::mutex mutex;
     };
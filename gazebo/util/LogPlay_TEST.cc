@@ -17,11 +17,16 @@
 
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
+#include <fstream>
+#include <iterator>
+#include <sstream>
 #include <string>
 #include <thread>
+#include <vector>
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/util/LogPlay.hh"
+#include "gazebo/util/LogRecord.hh"
 #include "test_config.h"
 #include "test/util.hh"
 
@@ -146,6 +151,47 @@ TEST_F(LogPlay_TEST, Chunks)
   EXPECT_FALSE(player->Chunk(player->ChunkCount(), chunk));
 }
 
+/////////////////////////////////////////////////
+/// \brief Chunks read in any order, and through the chunk cache, match the
+/// chunks read sequentially.
+TEST_F(LogPlay_TEST, RandomAccessChunks)
+{
+  gazebo::util::LogPlay *player = gazebo::util::LogPlay::Instance();
+
+  boost::filesystem::path logFilePath(TEST_PATH);
+  logFilePath /= boost::filesystem::path("logs");
+  logFilePath /= boost::filesystem::path("insertion_deletion.log");
+
+  EXPECT_NO_THROW(player->Open(logFilePath.string()));
+  ASSERT_GT(player->ChunkCount(), 4u);
+
+  std::vector<std::string> chunks(player->ChunkCount());
+  for (unsigned int i = 0; i < chunks.size(); ++i)
+    EXPECT_TRUE(player->Chunk(i, chunks[i]));
+
+  for (unsigned int i = chunks.size(); i-- > 0;)
+  {
+    std::string chunk;
+    EXPECT_TRUE(player->Chunk(i, chunk));
+    EXPECT_EQ(chunk, chunks[i]);
+    EXPECT_EQ(player->Encoding(), "txt");
+  }
+
+  // Stepping backwards from the end crosses every chunk boundary.
+  EXPECT_TRUE(player->Forward());
+  std::string frame;
+  unsigned int frames = 0;
+  while (player->StepBack(frame))
+    ++frames;
+  EXPECT_GT(frames, chunks.size());
+
+  // A failed open leaves no log open.
+  logFilePath = TEST_PATH / boost::filesystem::path("logs");
+  logFilePath /= boost::filesystem::path("invalidHeader.log");
+  EXPECT_ANY_THROW(player->Open(logFilePath.string()));
+  EXPECT_FALSE(player->IsOpen());
+}
+
 /////////////////////////////////////////////////
 /// \brief Test Rewind().
 TEST_F(LogPlay_TEST, Rewind)
@@ -457,6 +503,100 @@ TEST_F(LogPlay_TEST, NoEndTag)
 #endif
 }
 
+/////////////////////////////////////////////////
+/// \brief Record a binary log, then read it back with and without its
+/// index.
+TEST_F(LogPlay_TEST, Binary)
+{
+  // \todo Make temporary files work in windows.
+#ifndef _WIN32
+  gazebo::util::LogRecord *recorder = gazebo::util::LogRecord::Instance();
+  gazebo::util::LogPlay *player = gazebo::util::LogPlay::Instance();
+
+  std::ostringstream stream;
+  stream << "/tmp/__gz_binary_log_test" << std::this_thread::get_id();
+  const std::string logDir = stream.str();
+
+  // Each update outputs 10 frames, one per second of simulation time.
+  int updates = 0;
+  recorder->Init("test");
+  recorder->Add("binary_test", "state.log",
+      [&updates](std::ostringstream &_stream)
+      {
+        for (int i = 0; i < 10; ++i)
+        {
+          _stream << "<sdf version='1.6'><state world_name='default'>"
+                  << "<sim_time>" << updates * 10 + i << " 0</sim_time>"
+                  << "</state></sdf>";
+        }
+        ++updates;
+        return true;
+      });
+
+  gazebo::util::LogRecordParams params;
+  params.format = "binary";
+  params.path = logDir;
+  ASSERT_TRUE(recorder->Start(params));
+  EXPECT_EQ(recorder->Format(), "binary");
+  const std::string logFile = recorder->Filename("binary_test");
+
+  int tries = 0;
+  while (updates < 5 && tries++ < 500)
+  {
+    recorder->Notify();
+    gazebo::common::Time::MSleep(10);
+  }
+  recorder->Stop();
+  while (!recorder->IsReadyToStart())
+    gazebo::common::Time::MSleep(100);
+  recorder->Remove("binary_test");
+  ASSERT_GE(updates, 5);
+
+  EXPECT_NO_THROW(player->Open(logFile));
+  EXPECT_TRUE(player->IsOpen());
+  EXPECT_EQ(player->Format(), "binary");
+  EXPECT_EQ(player->LogVersion(), GZ_LOG_VERSION);
+  const unsigned int chunks = player->ChunkCount();
+  EXPECT_GE(chunks, 5u);
+  EXPECT_EQ(player->LogStartTime(), gazebo::common::Time(0, 0));
+  EXPECT_EQ(player->LogEndTime(), gazebo::common::Time(chunks * 10 - 1, 0));
+
+  std::string frame;
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_NE(frame.find("<sim_time>0 0</sim_time>"), std::string::npos);
+
+  // Seeking lands right before the first frame at or after the target.
+  EXPECT_TRUE(player->Seek(gazebo::common::Time(23.5)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_NE(frame.find("<sim_time>24 0</sim_time>"), std::string::npos);
+
+  EXPECT_TRUE(player->Seek(gazebo::common::Time(9.5)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_NE(frame.find("<sim_time>10 0</sim_time>"), std::string::npos);
+  EXPECT_TRUE(player->StepBack(frame));
+  EXPECT_NE(frame.find("<sim_time>9 0</sim_time>"), std::string::npos);
+
+  // Drop the footer, as if recording had been interrupted. The index is
+  // rebuilt from the chunks.
+  const std::string truncatedFile = logDir + "/truncated.log";
+  {
+    std::ifstream in(logFile, std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(in)),
+        std::istreambuf_iterator<char>());
+    std::ofstream out(truncatedFile, std::ios::binary);
+    out.write(data.c_str(), data.size() - 16);
+  }
+
+  EXPECT_NO_THROW(player->Open(truncatedFile));
+  EXPECT_EQ(player->ChunkCount(), chunks);
+  EXPECT_TRUE(player->Seek(gazebo::common::Time(41.5)));
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_NE(frame.find("<sim_time>42 0</sim_time>"), std::string::npos);
+
+  boost::filesystem::remove_all(logDir);
+#endif
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
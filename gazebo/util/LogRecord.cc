@@ -58,6 +58,81 @@
 using namespace gazebo;
 using namespace util;
 
+//////////////////////////////////////////////////
+/// \brief Compress log data.
+/// \param[in] _encoding Log encoding: txt, zlib or bz2.
+/// \param[in] _data Data to compress.
+/// \param[out] _out Compressed data is appended to this string.
+/// \return False if the encoding is unknown.
+static bool Compress(const std::string &_encoding, const std::string &_data,
+    std::string &_out)
+{
+  if (_encoding == "bz2")
+  {
+    boost::iostreams::filtering_ostream out;
+    out.push(boost::iostreams::bzip2_compressor());
+    out.push(std::back_inserter(_out));
+    boost::iostreams::copy(boost::make_iterator_range(_data), out);
+  }
+  else if (_encoding == "zlib")
+  {
+    boost::iostreams::filtering_ostream out;
+    out.push(boost::iostreams::zlib_compressor());
+    out.push(std::back_inserter(_out));
+    boost::iostreams::copy(boost::make_iterator_range(_data), out);
+  }
+  else if (_encoding == "txt")
+    _out.append(_data);
+  else
+    return false;
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Append a length prefixed message to a binary log buffer.
+/// \param[in] _msg Message to append.
+/// \param[in,out] _buffer Log buffer.
+static void AppendRecord(const google::protobuf::Message &_msg,
+    std::string &_buffer)
+{
+  std::string data;
+  _msg.SerializeToString(&data);
+
+  // Little endian size, so that logs are portable.
+  uint64_t size = data.size();
+  for (int i = 0; i < 8; ++i)
+    _buffer.push_back(static_cast<char>((size >> (8 * i)) & 0xff));
+
+  _buffer.append(data);
+}
+
+//////////////////////////////////////////////////
+/// \brief Find the first or last <sim_time> in log data.
+/// \param[in] _data Uncompressed log data.
+/// \param[in] _last True to find the last time instead of the first one.
+/// \param[out] _time The simulation time.
+/// \return True if a time was found.
+static bool FindSimTime(const std::string &_data, const bool _last,
+    common::Time &_time)
+{
+  const std::string startTag = "<sim_time>";
+  const std::string endTag = "</sim_time>";
+
+  size_t from = _last ? _data.rfind(startTag) : _data.find(startTag);
+  if (from == std::string::npos)
+    return false;
+
+  from += startTag.size();
+  size_t to = _data.find(endTag, from);
+  if (to == std::string::npos)
+    return false;
+
+  std::stringstream ss(_data.substr(from, to - from));
+  ss >> _time;
+  return true;
+}
+
 //////////////////////////////////////////////////
 LogRecord::LogRecord()
 : dataPtr(new LogRecordPrivate)
@@ -139,6 +214,7 @@ bool LogRecord::Start(const LogRecordParams &_params)
 {
   this->dataPtr->period = _params.period;
   this->dataPtr->filter = _params.filter;
+  this->dataPtr->format = _params.format;
   this->dataPtr->recordResources = _params.recordResources;
   return this->Start(_params.encoding, _params.path);
 }
@@ -190,6 +266,10 @@ bool LogRecord::Start(const std::string &_encoding, const std::string &_path)
     gzthrow("Invalid log encoding[" + _encoding +
             "]. Must be one of [bz2, zlib, txt]");
 
+  if (this->dataPtr->format != "xml" && this->dataPtr->format != "binary")
+    gzthrow("Invalid log format[" + this->dataPtr->format +
+            "]. Must be one of [xml, binary]");
+
   this->dataPtr->encoding = _encoding;
 
   {
@@ -244,6 +324,12 @@ const std::string &LogRecord::Encoding() const
   return this->dataPtr->encoding;
 }
 
+//////////////////////////////////////////////////
+const std::string &LogRecord::Format() const
+{
+  return this->dataPtr->format;
+}
+
 //////////////////////////////////////////////////
 void LogRecord::Fini()
 {
@@ -792,7 +878,42 @@ unsigned int LogRecordPrivate::Log::Update()
   if (this->logCB(stream))
   {
     std::string data = stream.str();
-    if (!data.empty())
+    if (!data.empty() && this->parent->Format() == "binary")
+    {
+      const std::string &encodingLocal = this->parent->Encoding();
+
+      msgs::LogChunk chunk;
+      chunk.set_encoding(encodingLocal);
+      if (!Compress(encodingLocal, data, *chunk.mutable_data()))
+        gzerr << "Unknown log file encoding[" << encodingLocal << "]\n";
+
+      // Chunks without states, such as the initial world description, have
+      // no time.
+      common::Time simTime;
+      if (FindSimTime(data, false, simTime))
+        msgs::Set(chunk.mutable_start_time(), simTime);
+      if (FindSimTime(data, true, simTime))
+        msgs::Set(chunk.mutable_end_time(), simTime);
+
+      unsigned int frameCount = 0;
+      for (size_t pos = data.find("<sdf "); pos != std::string::npos;
+           pos = data.find("<sdf ", pos + 1))
+      {
+        ++frameCount;
+      }
+      chunk.set_frame_count(frameCount);
+
+      msgs::LogIndex::Entry *entry = this->index.add_entries();
+      entry->set_offset(this->bytesWritten + this->buffer.size());
+      if (chunk.has_start_time())
+        entry->mutable_start_time()->CopyFrom(chunk.start_time());
+      if (chunk.has_end_time())
+        entry->mutable_end_time()->CopyFrom(chunk.end_time());
+      entry->set_frame_count(frameCount);
+
+      AppendRecord(chunk, this->buffer);
+    }
+    else if (!data.empty())
     {
       const std::string &encodingLocal = this->parent->Encoding();
 
@@ -802,40 +923,19 @@ unsigned int LogRecordPrivate::Log::Update()
 
       this->buffer.append("<![CDATA[");
       // Compress the data.
-      if (encodingLocal == "bz2")
-      {
-        std::string str;
-
-        // Compress to bzip2
-        {
-          boost::iostreams::filtering_ostream out;
-          out.push(boost::iostreams::bzip2_compressor());
-          out.push(std::back_inserter(str));
-          boost::iostreams::copy(boost::make_iterator_range(data), out);
-        }
-
-        // Encode in base64.
-        Base64Encode(str.c_str(), str.size(), this->buffer);
-      }
-      else if (encodingLocal == "zlib")
+      if (encodingLocal == "txt")
+        this->buffer.append(data);
+      else
       {
         std::string str;
-
-        // Compress to zlib
+        if (Compress(encodingLocal, data, str))
         {
-          boost::iostreams::filtering_ostream out;
-          out.push(boost::iostreams::zlib_compressor());
-          out.push(std::back_inserter(str));
-          boost::iostreams::copy(boost::make_iterator_range(data), out);
+          // Encode in base64.
+          Base64Encode(str.c_str(), str.size(), this->buffer);
         }
-
-        // Encode in base64.
-        Base64Encode(str.c_str(), str.size(), this->buffer);
+        else
+          gzerr << "Unknown log file encoding[" << encodingLocal << "]\n";
       }
-      else if (encodingLocal == "txt")
-        this->buffer.append(data);
-      else
-        gzerr << "Unknown log file encoding[" << encodingLocal << "]\n";
       this->buffer.append("]]>\n");
 
       this->buffer.append("</chunk>\n");
@@ -877,8 +977,22 @@ void LogRecordPrivate::Log::Stop()
     this->Update();
     this->Write();
 
-    std::string xmlEnd = "</gazebo_log>";
-    this->logFile.write(xmlEnd.c_str(), xmlEnd.size());
+    if (this->parent->Format() == "binary")
+    {
+      // Footer: the chunk index, its offset and the index magic.
+      std::string footer;
+      const uint64_t indexOffset = this->bytesWritten;
+      AppendRecord(this->index, footer);
+      for (int i = 0; i < 8; ++i)
+        footer.push_back(static_cast<char>((indexOffset >> (8 * i)) & 0xff));
+      footer.append(GZ_LOG_INDEX_MAGIC);
+      this->logFile.write(footer.c_str(), footer.size());
+    }
+    else
+    {
+      std::string xmlEnd = "</gazebo_log>";
+      this->logFile.write(xmlEnd.c_str(), xmlEnd.size());
+    }
 
     this->logFile.close();
   }
@@ -897,6 +1011,21 @@ void LogRecordPrivate::Log::Start(const boost::filesystem::path &_path)
     gzlog << "Filename [" + this->completePath.string() + "], already exists."
           << " The log file will be overwritten.\n";
 
+  this->bytesWritten = 0;
+  this->index.Clear();
+  this->index.set_log_version(GZ_LOG_VERSION);
+  this->index.set_gazebo_version(GAZEBO_VERSION_FULL);
+  this->index.set_rand_seed(ignition::math::Rand::Seed());
+
+  if (this->parent->Format() == "binary")
+  {
+    // The header is a LogIndex without entries. The full index is
+    // appended when the log stops.
+    this->buffer.append(GZ_LOG_BINARY_MAGIC);
+    AppendRecord(this->index, this->buffer);
+    return;
+  }
+
   std::ostringstream stream;
   stream << "<?xml version='1.0'?>\n"
          << "<gazebo_log>\n"
@@ -940,6 +1069,7 @@ void LogRecordPrivate::Log::Write()
   // Write out the contents of the buffer.
   this->logFile.write(this->buffer.c_str(), this->buffer.size());
   this->logFile.flush();
+  this->bytesWritten += this->buffer.size();
 
   // Clear the buffer.
   this->buffer.clear();
@@ -955,6 +1085,9 @@ void LogRecord::OnLogControl(ConstLogControlPtr &_data)
   if (_data->has_encoding())
     msgEncoding = _data->encoding();
 
+  if (_data->has_format() && !this->dataPtr->running)
+    this->dataPtr->format = _data->format();
+
   if (_data->has_start() && _data->start())
   {
     this->Start(msgEncoding);
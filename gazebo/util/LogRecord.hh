@@ -27,6 +27,13 @@
 
 #define GZ_LOG_VERSION "1.0"
 
+/// \brief Magic bytes at the start of a binary log file.
+#define GZ_LOG_BINARY_MAGIC "GZLOGBIN"
+
+/// \brief Magic bytes at the end of a binary log file, right after the
+/// offset of the chunk index.
+#define GZ_LOG_INDEX_MAGIC "GZLOGIDX"
+
 /// \brief Explicit instantiation for typed SingletonT.
 GZ_SINGLETON_DECLARE(GZ_UTIL_VISIBLE, gazebo, util, LogRecord)
 
@@ -41,6 +48,11 @@ namespace gazebo
       /// \brief The type of encoding (txt, zlib, or bz2).
       public: std::string encoding = "zlib";
 
+      /// \brief The log file format (xml or binary). Binary logs store
+      /// compressed chunks without base64 encoding, followed by an index of
+      /// simulation times that LogPlay uses to seek.
+      public: std::string format = "xml";
+
       /// \brief Path in which to store log files.
       public: std::string path;
 
@@ -186,6 +198,10 @@ namespace gazebo
       /// and zlib are compressed data with Base64 encoding.
       public: const std::string &Encoding() const;
 
+      /// \brief Get the log file format.
+      /// \return Either xml or binary.
+      public: const std::string &Format() const;
+
       /// \brief Get the filename for a log object.
       /// \param[in] _name Name of the log object.
       /// \return Filename, empty string if not found.
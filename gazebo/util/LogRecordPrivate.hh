@@ -26,6 +26,8 @@
 #include <condition_variable>
 #include <boost/filesystem.hpp>
 
+#include "gazebo/msgs/msgs.hh"
+
 namespace gazebo
 {
   namespace util
@@ -101,6 +103,13 @@ namespace gazebo
 
         /// \brief Complete file path.
         public: boost::filesystem::path completePath;
+
+        /// \brief Number of bytes written to the log file, used to compute
+        /// chunk offsets of binary logs.
+        public: uint64_t bytesWritten = 0;
+
+        /// \brief Chunk index of a binary log, written when the log stops.
+        public: msgs::LogIndex index;
       };
 
       /// \def Log_M
@@ -166,6 +175,9 @@ namespace gazebo
       /// \brief Encoding format for each chunk.
       public: std::string encoding;
 
+      /// \brief Log file format, xml or binary.
+      public: std::string format = "xml";
+
       /// \brief True if initialized.
       public: bool initialized;
 
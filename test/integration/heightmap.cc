@@ -16,6 +16,7 @@
 */
 
 #include <string.h>
+#include <algorithm>
 #include <ignition/math/Vector3.hh>
 
 // required for HAVE_DART_BULLET define
@@ -79,6 +80,9 @@ class HeightmapTest : public ServerFixture,
 /// \brief Test loading a heightmap and verify cache files are created
   public: void HeightmapCache();
 
+  /// \brief Test dropping a sphere on a heightmap paged in tiles
+  public: void TiledTerrainCollision();
+
   public: void NotSquareImage();
   public: void InvalidSizeImage();
   // public: void Heights(const std::string &_physicsEngine);
@@ -884,6 +888,81 @@ void HeightmapTest::TerrainCollision(const std::string &_physicsEngine,
   EXPECT_GE(spherePose.Pos().Z(), (minHeight + radius*0.99));
 }
 
+/////////////////////////////////////////////////
+void HeightmapTest::TiledTerrainCollision()
+{
+  Load("worlds/heightmap_tiled_with_sphere.world", true, "ode");
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_NE(world, nullptr);
+
+  physics::ModelPtr heightmap = GetModel("heightmap");
+  ASSERT_NE(heightmap, nullptr);
+
+  physics::HeightmapShapePtr heightmapShape =
+    boost::dynamic_pointer_cast<physics::HeightmapShape>(
+      heightmap->GetLink("link")->GetCollision("collision")->GetShape());
+  ASSERT_NE(heightmapShape, nullptr);
+  ASSERT_TRUE(heightmapShape->Tiled());
+  EXPECT_EQ(32u, heightmapShape->TileSize());
+
+  // The heights served by the tiles match the full lookup table
+  std::vector<float> expected;
+  heightmapShape->FillHeightfield(expected);
+  const ignition::math::Vector2i count = heightmapShape->VertexCount();
+  ASSERT_EQ(static_cast<size_t>(count.X() * count.Y()), expected.size());
+  auto range = std::minmax_element(expected.begin(), expected.end());
+  EXPECT_LE(heightmapShape->GetMinHeight(), *range.first);
+  EXPECT_GE(heightmapShape->GetMaxHeight(), *range.second);
+
+  // step the world, only the tiles around the sphere stay loaded
+  world->Step(5000);
+  EXPECT_GT(heightmapShape->LoadedTileCount(), 0u);
+  EXPECT_LE(heightmapShape->LoadedTileCount(), 4u);
+
+  physics::ModelPtr sphere = GetModel("test_sphere");
+  ASSERT_NE(sphere, nullptr);
+  physics::SphereShapePtr sphereShape =
+    boost::dynamic_pointer_cast<physics::SphereShape>(
+      sphere->GetLink("link")->GetCollision("collision")->GetShape());
+  ASSERT_NE(sphereShape, nullptr);
+  double radius = sphereShape->GetRadius();
+
+  // verify that the sphere has rolled into the valley without falling
+  // through the terrain
+  ignition::math::Pose3d spherePose = sphere->WorldPose();
+  EXPECT_LE(spherePose.Pos().Z(), (*range.first + radius*1.01));
+  EXPECT_GE(spherePose.Pos().Z(), (*range.first + radius*0.99));
+
+  // GetHeight loads the tiles it needs, and evicts the least recently used
+  // ones beyond <gz:max_tiles> without a step.
+  for (int y = 0; y < count.Y(); ++y)
+  {
+    for (int x = 0; x < count.X(); ++x)
+    {
+      ASSERT_FLOAT_EQ(expected[y * count.X() + x],
+          heightmapShape->GetHeight(x, y));
+    }
+  }
+  EXPECT_LE(heightmapShape->LoadedTileCount(), 4u);
+
+  // Reads of the whole terrain don't go through the tiles
+  const unsigned int loaded = heightmapShape->LoadedTileCount();
+  msgs::Geometry msg;
+  heightmapShape->FillHeights(msg);
+  ASSERT_EQ(static_cast<int>(expected.size()), msg.heightmap().heights_size());
+  for (int y = 0; y < count.Y(); ++y)
+  {
+    for (int x = 0; x < count.X(); ++x)
+    {
+      ASSERT_FLOAT_EQ(expected[(count.Y() - y - 1) * count.X() + x],
+          msg.heightmap().heights(y * count.X() + x));
+    }
+  }
+  heightmapShape->GetImage();
+  EXPECT_EQ(loaded, heightmapShape->LoadedTileCount());
+}
+
 /////////////////////////////////////////////////
 TEST_F(HeightmapTest, NotSquareImage)
 {
@@ -1101,6 +1180,12 @@ TEST_F(HeightmapTest, HeightmapCache)
   HeightmapCache();
 }
 
+/////////////////////////////////////////////////
+TEST_F(HeightmapTest, TiledTerrainCollision)
+{
+  TiledTerrainCollision();
+}
+
 INSTANTIATE_TEST_CASE_P(PhysicsEngines, HeightmapTest, PHYSICS_ENGINE_VALUES,);  // NOLINT
 
 /////////////////////////////////////////////////
@@ -141,6 +141,51 @@ TEST_F(LogicalCameraSensor, Box)
   ASSERT_EQ(cam->Image().model_size(), 1);
 }
 
+/////////////////////////////////////////////////
+// A model is seen when its bounding box intersects the frustum, even if
+// none of its collisions does.
+TEST_F(LogicalCameraSensor, ModelBoundingBox)
+{
+  Load("worlds/logical_camera.world");
+
+  // Wait until the sensors have been initialized
+  while (!sensors::SensorManager::Instance()->SensorsInitialized())
+    common::Time::MSleep(1000);
+
+  sensors::LogicalCameraSensorPtr cam = std::dynamic_pointer_cast<
+    sensors::LogicalCameraSensor>(sensors::get_sensor("logical_camera"));
+  ASSERT_TRUE(cam != NULL);
+
+  // Two boxes on each side of the frustum, which is about 2.3m wide at 2m
+  std::ostringstream sdfStream;
+  sdfStream << "<sdf version='" << SDF_VERSION << "'>"
+    << "<model name ='two_boxes'>"
+    << "  <static>true</static>"
+    << "  <pose>2 0 0.5 0 0 0</pose>"
+    << "  <link name ='link'>"
+    << "    <collision name ='left'>"
+    << "      <pose>0 2.5 0 0 0 0</pose>"
+    << "      <geometry>"
+    << "        <box><size>0.5 0.5 0.5</size></box>"
+    << "      </geometry>"
+    << "    </collision>"
+    << "    <collision name ='right'>"
+    << "      <pose>0 -2.5 0 0 0 0</pose>"
+    << "      <geometry>"
+    << "        <box><size>0.5 0.5 0.5</size></box>"
+    << "      </geometry>"
+    << "    </collision>"
+    << "  </link>"
+    << "</model>"
+    << "</sdf>";
+  SpawnSDF(sdfStream.str());
+  cam->Update(true);
+
+  ASSERT_EQ(cam->Image().model_size(), 2);
+  EXPECT_EQ(cam->Image().model(0).name(), "ground_plane");
+  EXPECT_EQ(cam->Image().model(1).name(), "two_boxes");
+}
+
 /////////////////////////////////////////////////
 TEST_F(LogicalCameraSensor, NestedModels)
 {
@@ -186,6 +186,303 @@ TEST_F(TransportTest, DirectPublish)
   ASSERT_GT(timeout, 0) << "Not received a message in 10 seconds";
 }
 
+/////////////////////////////////////////////////
+const google::protobuf::Message *g_sharedMsg = nullptr;
+int g_sharedMsgCount = 0;
+std::string g_sharedRawMsg;
+
+void ReceiveSharedMsg(ConstGzStringPtr &_msg)
+{
+  g_sharedMsg = _msg.get();
+  g_sharedMsgCount++;
+}
+
+void ReceiveSharedRawMsg(const std::string &_data)
+{
+  g_sharedRawMsg = _data;
+}
+
+/////////////////////////////////////////////////
+// A shared message reaches local subscribers without being copied, raw
+// subscribers still get the serialized data.
+TEST_F(TransportTest, SharedPublish)
+{
+  Load("worlds/empty.world");
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+
+  transport::PublisherPtr pub =
+    node->Advertise<msgs::GzString>("~/test/shared_publish");
+  transport::SubscriberPtr sub = node->Subscribe("~/test/shared_publish",
+      &ReceiveSharedMsg);
+  transport::SubscriberPtr rawSub = node->Subscribe("~/test/shared_publish",
+      &ReceiveSharedRawMsg);
+
+  boost::shared_ptr<msgs::GzString> msg(new msgs::GzString);
+  msg->set_data("shared");
+  pub->Publish(msg);
+
+  int timeout = 1000;
+  while ((g_sharedMsgCount < 1 || g_sharedRawMsg.empty()) && --timeout > 0)
+    common::Time::MSleep(10);
+  ASSERT_GT(timeout, 0) << "Not received a message in 10 seconds";
+
+  EXPECT_EQ(g_sharedMsg, msg.get());
+  msgs::GzString rawMsg;
+  EXPECT_TRUE(rawMsg.ParseFromString(g_sharedRawMsg));
+  EXPECT_EQ(rawMsg.data(), "shared");
+
+  // A message published by reference is still copied.
+  msgs::GzString copied;
+  copied.set_data("copied");
+  pub->Publish(copied);
+
+  timeout = 1000;
+  while (g_sharedMsgCount < 2 && --timeout > 0)
+    common::Time::MSleep(10);
+  ASSERT_GT(timeout, 0) << "Not received a message in 10 seconds";
+  EXPECT_NE(g_sharedMsg, &copied);
+}
+
+/////////////////////////////////////////////////
+boost::mutex g_conflatingMutex;
+std::vector<int> g_conflatingMsgs;
+std::vector<int> g_allMsgs;
+
+void ReceiveConflatingMsg(ConstIntPtr &_msg)
+{
+  bool first;
+  {
+    boost::mutex::scoped_lock lock(g_conflatingMutex);
+    first = g_conflatingMsgs.empty();
+    g_conflatingMsgs.push_back(_msg->data());
+  }
+
+  // Be slow on the first message, so the next ones pile up and are skipped
+  if (first)
+    common::Time::MSleep(100);
+}
+
+void ReceiveAllMsg(ConstIntPtr &_msg)
+{
+  boost::mutex::scoped_lock lock(g_conflatingMutex);
+  g_allMsgs.push_back(_msg->data());
+}
+
+/////////////////////////////////////////////////
+// A conflating subscriber may skip messages but always gets the latest one,
+// other subscribers on the same topic still get every message.
+TEST_F(TransportTest, Conflating)
+{
+  Load("worlds/empty.world");
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+
+  const int msgCount = 1000;
+  transport::PublisherPtr pub =
+    node->Advertise<msgs::Int>("~/test/conflating", msgCount);
+  const std::string topic = node->DecodeTopicName("~/test/conflating");
+  EXPECT_FALSE(node->HasOnlyConflatingSubscribers(topic));
+  transport::SubscriberPtr conflatingSub = node->Subscribe(
+      "~/test/conflating", &ReceiveConflatingMsg, false, true);
+  EXPECT_TRUE(node->HasOnlyConflatingSubscribers(topic));
+  transport::SubscriberPtr allSub = node->Subscribe(
+      "~/test/conflating", &ReceiveAllMsg);
+  EXPECT_FALSE(node->HasOnlyConflatingSubscribers(topic));
+
+  msgs::Int msg;
+  for (int i = 0; i < msgCount; ++i)
+  {
+    msg.set_data(i);
+    pub->Publish(msg);
+  }
+
+  int timeout = 1000;
+  while (--timeout > 0)
+  {
+    {
+      boost::mutex::scoped_lock lock(g_conflatingMutex);
+      if (static_cast<int>(g_allMsgs.size()) >= msgCount &&
+          !g_conflatingMsgs.empty() && g_conflatingMsgs.back() == msgCount - 1)
+      {
+        break;
+      }
+    }
+    common::Time::MSleep(10);
+  }
+  ASSERT_GT(timeout, 0) << "Not received all messages in 10 seconds";
+
+  boost::mutex::scoped_lock lock(g_conflatingMutex);
+  EXPECT_EQ(static_cast<int>(g_allMsgs.size()), msgCount);
+  EXPECT_LT(static_cast<int>(g_conflatingMsgs.size()), msgCount);
+  EXPECT_EQ(g_conflatingMsgs.back(), msgCount - 1);
+
+  // Skipped messages are never delivered out of order
+  for (size_t i = 1; i < g_conflatingMsgs.size(); ++i)
+    EXPECT_LT(g_conflatingMsgs[i - 1], g_conflatingMsgs[i]);
+}
+
+/////////////////////////////////////////////////
+/// \brief Messages read by a remote subscriber.
+std::vector<std::string> g_remoteMsgs;
+
+void ReceiveRemoteMsg(transport::ConnectionPtr _conn,
+    const std::string &_data)
+{
+  {
+    boost::mutex::scoped_lock lock(g_conflatingMutex);
+    g_remoteMsgs.push_back(_data);
+  }
+  _conn->AsyncRead(boost::bind(&ReceiveRemoteMsg, _conn, _1));
+}
+
+void AcceptRemote(const transport::ConnectionPtr &_conn)
+{
+  _conn->AsyncRead(boost::bind(&ReceiveRemoteMsg, _conn, _1));
+}
+
+/// \brief Wait for a number of remote messages, and process the write
+/// queue of the sender meanwhile, like ConnectionManager does.
+/// \param[in] _count Number of messages.
+/// \param[in] _sender Connection the messages are sent from.
+/// \return True if the messages were received in time.
+bool WaitRemote(const size_t _count, const transport::ConnectionPtr &_sender)
+{
+  for (int i = 0; i < 500; ++i)
+  {
+    {
+      boost::mutex::scoped_lock lock(g_conflatingMutex);
+      if (g_remoteMsgs.size() >= _count)
+        return true;
+    }
+    _sender->ProcessWriteQueue();
+    common::Time::MSleep(10);
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+// The link of a publisher to a remote conflating subscriber only sends the
+// latest message once the previous one is out, and sends every message
+// once the subscriber asks for it.
+TEST_F(TransportTest, ConflatingRemote)
+{
+  Load("worlds/empty.world");
+  g_remoteMsgs.clear();
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::PublisherPtr pub =
+    node->Advertise<msgs::Int>("~/test/conflating_remote");
+  const std::string topic = node->DecodeTopicName("~/test/conflating_remote");
+
+  transport::ConnectionPtr server(new transport::Connection());
+  server->Listen(0, boost::bind(&AcceptRemote, _1));
+  transport::ConnectionPtr client(new transport::Connection());
+  ASSERT_TRUE(client->Connect("127.0.0.1", server->GetLocalPort()));
+
+  transport::SubscriptionTransportPtr subLink(
+      new transport::SubscriptionTransport());
+  subLink->Init(client, false, true);
+  EXPECT_TRUE(subLink->ZeroCopy());
+  transport::TopicManager::Instance()->ConnectPubToSub(topic, subLink);
+
+  // Nothing is written until the write queue is processed, so the
+  // messages after the first one replace each other.
+  int data = 0;
+  auto handle = [&subLink, &data]()
+  {
+    boost::shared_ptr<msgs::Int> msg(new msgs::Int);
+    msg->set_data(data++);
+    return subLink->HandleMessage(msg);
+  };
+  const int msgCount = 100;
+  for (int i = 0; i < msgCount; ++i)
+    EXPECT_TRUE(handle());
+
+  ASSERT_TRUE(WaitRemote(2, client));
+  for (int i = 0; i < 10; ++i)
+  {
+    client->ProcessWriteQueue();
+    common::Time::MSleep(10);
+  }
+  {
+    boost::mutex::scoped_lock lock(g_conflatingMutex);
+    ASSERT_EQ(g_remoteMsgs.size(), 2u);
+    msgs::Int msg;
+    ASSERT_TRUE(msg.ParseFromString(g_remoteMsgs[0]));
+    EXPECT_EQ(msg.data(), 0);
+    ASSERT_TRUE(msg.ParseFromString(g_remoteMsgs[1]));
+    EXPECT_EQ(msg.data(), msgCount - 1);
+  }
+
+  // One message being sent, one pending. The pending message is sent
+  // before the next ones once the subscriber asks for every message.
+  EXPECT_TRUE(handle());
+  EXPECT_TRUE(handle());
+  transport::TopicManager::Instance()->DisableConflating(topic, client);
+  EXPECT_FALSE(subLink->ZeroCopy());
+  for (int i = 0; i < 10; ++i)
+    EXPECT_TRUE(handle());
+
+  ASSERT_TRUE(WaitRemote(14, client));
+  boost::mutex::scoped_lock lock(g_conflatingMutex);
+  ASSERT_EQ(g_remoteMsgs.size(), 14u);
+  for (int i = 2; i < 14; ++i)
+  {
+    msgs::Int msg;
+    ASSERT_TRUE(msg.ParseFromString(g_remoteMsgs[i]));
+    EXPECT_EQ(msg.data(), msgCount + i - 2);
+  }
+}
+
+/////////////////////////////////////////////////
+// The link of a subscriber to a remote publisher asks it to stop
+// conflating once a local callback wants every message.
+TEST_F(TransportTest, ConflatingRemoteFallback)
+{
+  Load("worlds/empty.world");
+  g_remoteMsgs.clear();
+
+  transport::ConnectionPtr server(new transport::Connection());
+  server->Listen(0, boost::bind(&AcceptRemote, _1));
+  transport::ConnectionPtr client(new transport::Connection());
+  ASSERT_TRUE(client->Connect("127.0.0.1", server->GetLocalPort()));
+
+  transport::PublicationTransportPtr publink(
+      new transport::PublicationTransport("/test/conflating_fallback",
+        "gazebo.msgs.Int"));
+  publink->Init(client, false, true);
+  publink->DisableConflating();
+  publink->DisableConflating();
+
+  ASSERT_TRUE(WaitRemote(2, client));
+  for (int i = 0; i < 10; ++i)
+  {
+    client->ProcessWriteQueue();
+    common::Time::MSleep(10);
+  }
+
+  boost::mutex::scoped_lock lock(g_conflatingMutex);
+  ASSERT_EQ(g_remoteMsgs.size(), 2u);
+  msgs::Packet packet;
+  msgs::Subscribe sub;
+  ASSERT_TRUE(packet.ParseFromString(g_remoteMsgs[0]));
+  EXPECT_EQ(packet.type(), "sub");
+  ASSERT_TRUE(sub.ParseFromString(packet.serialized_data()));
+  EXPECT_TRUE(sub.conflating());
+
+  ASSERT_TRUE(packet.ParseFromString(g_remoteMsgs[1]));
+  EXPECT_EQ(packet.type(), "disable_conflating");
+  ASSERT_TRUE(sub.ParseFromString(packet.serialized_data()));
+  EXPECT_EQ(sub.topic(), "/test/conflating_fallback");
+  EXPECT_FALSE(sub.conflating());
+
+  publink->Fini();
+}
+
 /////////////////////////////////////////////////
 void SinglePub()
 {
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+/// \brief Number of links of each spawned model.
+static const unsigned int kLinksPerModel = 5;
+
+class EntityLookupStressTest : public ServerFixture,
+                               public testing::WithParamInterface<unsigned int>
+{
+  /// \brief Spawn models with a few links each.
+  /// \param[in] _world World to spawn into.
+  /// \param[in] _count Number of models to spawn.
+  public: void SpawnModels(physics::WorldPtr _world,
+                           const unsigned int _count);
+
+  /// \brief Search the tree of entities depth first, as Base::GetByName
+  /// did before the index of the world.
+  /// \param[in] _base Entity to search from.
+  /// \param[in] _name Scoped name or name to find.
+  /// \return The first entity which matches, or NULL.
+  public: physics::BasePtr Walk(const physics::BasePtr &_base,
+                                const std::string &_name);
+
+  /// \brief Call a function repeatedly and return the average wall time of
+  /// one call.
+  /// \param[in] _func Function to time.
+  /// \param[in] _reps Number of calls.
+  /// \return Average wall time of one call.
+  public: common::Time Time(const std::function<void()> &_func,
+                            const unsigned int _reps);
+};
+
+/////////////////////////////////////////////////
+void EntityLookupStressTest::SpawnModels(physics::WorldPtr _world,
+    const unsigned int _count)
+{
+  const unsigned int initialCount = _world->ModelCount();
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    std::ostringstream sdfStr;
+    sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='model_" << i << "'>"
+      << "  <static>true</static>"
+      << "  <pose>" << (i % 64) * 2.0 << " " << (i / 64) * 2.0 << " 1 0 0 0"
+      << "  </pose>";
+    for (unsigned int j = 0; j < kLinksPerModel; ++j)
+    {
+      sdfStr << "  <link name='link_" << j << "'>"
+        << "    <pose>0 0 " << j * 0.1 << " 0 0 0</pose>"
+        << "  </link>";
+    }
+    sdfStr << "</model>"
+      << "</sdf>";
+    _world->InsertModelString(sdfStr.str());
+  }
+
+  // Factory messages are processed by the world thread.
+  int sleep = 0;
+  while (_world->ModelCount() < initialCount + _count && sleep++ < 1200)
+    common::Time::MSleep(100);
+  ASSERT_EQ(_world->ModelCount(), initialCount + _count);
+}
+
+/////////////////////////////////////////////////
+physics::BasePtr EntityLookupStressTest::Walk(const physics::BasePtr &_base,
+    const std::string &_name)
+{
+  if (_base->GetScopedName() == _name || _base->GetName() == _name)
+    return _base;
+
+  for (unsigned int i = 0; i < _base->GetChildCount(); ++i)
+  {
+    physics::BasePtr result = this->Walk(_base->GetChild(i), _name);
+    if (result)
+      return result;
+  }
+
+  return physics::BasePtr();
+}
+
+/////////////////////////////////////////////////
+common::Time EntityLookupStressTest::Time(const std::function<void()> &_func,
+    const unsigned int _reps)
+{
+  common::Time startTime = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < _reps; ++i)
+    _func();
+  common::Time elapsed = common::Time::GetWallTime() - startTime;
+
+  return elapsed.Double() / _reps;
+}
+
+/////////////////////////////////////////////////
+TEST_P(EntityLookupStressTest, ByNameById)
+{
+  const unsigned int modelCount = GetParam();
+  const unsigned int reps = 1000;
+
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  world->SetPaused(false);
+  this->SpawnModels(world, modelCount);
+  world->SetPaused(true);
+
+  // The last model is the worst case of the depth first search.
+  std::ostringstream modelStr;
+  modelStr << "model_" << modelCount - 1;
+  const std::string modelName = modelStr.str();
+  const std::string linkName = modelName + "::link_0";
+
+  physics::ModelPtr model = world->ModelByName(modelName);
+  ASSERT_TRUE(model != nullptr);
+  physics::BasePtr root = model->GetParent();
+  ASSERT_TRUE(root != nullptr);
+  EXPECT_EQ(this->Walk(root, linkName), world->BaseByName(linkName));
+
+  common::Time walkHit = this->Time([&]()
+      {
+        this->Walk(root, linkName);
+      }, reps);
+  common::Time walkMiss = this->Time([&]()
+      {
+        this->Walk(root, "not_an_entity");
+      }, reps);
+
+  physics::ModelPtr found;
+  common::Time modelByName = this->Time([&]()
+      {
+        found = world->ModelByName(modelName);
+      }, reps);
+  EXPECT_EQ(found, model);
+
+  physics::EntityPtr entity;
+  common::Time entityByName = this->Time([&]()
+      {
+        entity = world->EntityByName(linkName);
+      }, reps);
+  ASSERT_TRUE(entity != nullptr);
+  EXPECT_EQ(entity->GetParent(), model);
+
+  common::Time miss = this->Time([&]()
+      {
+        found = world->ModelByName("not_an_entity");
+      }, reps);
+  EXPECT_TRUE(found == nullptr);
+
+  physics::BasePtr child;
+  common::Time getChild = this->Time([&]()
+      {
+        child = model->GetChild("link_0");
+      }, reps);
+  EXPECT_EQ(child, entity);
+
+  const unsigned int modelId = model->GetId();
+  common::Time modelById = this->Time([&]()
+      {
+        found = world->ModelById(modelId);
+      }, reps);
+  EXPECT_EQ(found, model);
+
+  // Results are printed for comparison, a strict speed-up is not required
+  // since it depends on the host.
+  std::cout << "Models [" << modelCount << "] links per model ["
+            << kLinksPerModel << "]\n"
+            << "  walk:         hit [" << walkHit.Double() * 1e6
+            << " us] miss [" << walkMiss.Double() * 1e6 << " us]\n"
+            << "  ModelByName:  hit [" << modelByName.Double() * 1e6
+            << " us] miss [" << miss.Double() * 1e6 << " us]\n"
+            << "  EntityByName: [" << entityByName.Double() * 1e6 << " us]\n"
+            << "  GetChild:     [" << getChild.Double() * 1e6 << " us]\n"
+            << "  ModelById:    [" << modelById.Double() * 1e6 << " us]"
+            << std::endl;
+}
+
+INSTANTIATE_TEST_CASE_P(ModelCounts, EntityLookupStressTest,
+    ::testing::Values(100u, 1000u, 2000u));
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <iostream>
+#include <string>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class HeadlessThroughputTest
+  : public ServerFixture, public testing::WithParamInterface<const char*>
+{
+  /// \brief Measure the steps taken per second of wall clock.
+  /// \param[in] _name Name to print.
+  /// \param[in] _world World to run, paused.
+  /// \return Steps per second.
+  public: double StepRate(const std::string &_name,
+                          physics::WorldPtr _world);
+};
+
+/////////////////////////////////////////////////
+/// \brief Subscriber callback doing nothing with world statistics.
+/// \param[in] _msg Message.
+void OnStats(ConstWorldStatisticsPtr &/*_msg*/)
+{
+}
+
+/////////////////////////////////////////////////
+/// \brief Subscriber callback doing nothing with poses.
+/// \param[in] _msg Message.
+void OnPoses(ConstPosesStampedPtr &/*_msg*/)
+{
+}
+
+/////////////////////////////////////////////////
+double HeadlessThroughputTest::StepRate(const std::string &_name,
+    physics::WorldPtr _world)
+{
+  const uint32_t startIterations = _world->Iterations();
+  const common::Time startTime = common::Time::GetWallTime();
+
+  _world->SetPaused(false);
+  common::Time::Sleep(common::Time(2.0));
+  _world->SetPaused(true);
+
+  const double elapsed =
+    (common::Time::GetWallTime() - startTime).Double();
+  const double rate = (_world->Iterations() - startIterations) / elapsed;
+
+  std::cout << _name << " [" << rate << " steps/s]" << std::endl;
+  return rate;
+}
+
+/////////////////////////////////////////////////
+TEST_P(HeadlessThroughputTest, Publishing)
+{
+  const std::string worldFile = GetParam();
+
+  Load(worldFile, true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // As fast as possible
+  world->Physics()->SetRealTimeUpdateRate(0);
+
+  std::cout << "World [" << worldFile << "] models [" << world->ModelCount()
+            << "]" << std::endl;
+
+  // The fixture listens to statistics and local poses, stop it.
+  this->statsSub.reset();
+  this->poseSub.reset();
+  const double quietRate = this->StepRate("No subscribers", world);
+
+  // A client listening to statistics and poses, as gzclient or gz stats do
+  transport::SubscriberPtr clientStatsSub =
+    this->node->Subscribe("~/world_stats", &OnStats);
+  transport::SubscriberPtr clientPosesSub =
+    this->node->Subscribe("~/pose/info", &OnPoses);
+
+  // Publish after every step
+  world->SetStatsPublishRate(0);
+  world->SetPosePublishSteps(1);
+  const double everyStepRate = this->StepRate("Every step", world);
+
+  // Statistics at 10 Hz of wall clock and poses every 100 steps
+  world->SetStatsPublishRate(10);
+  world->SetPosePublishSteps(100);
+  const double decimatedRate = this->StepRate("Decimated", world);
+
+  // Results are printed for comparison, the gains depend on the host and
+  // the world.
+  std::cout << "Gain of decimation [" << decimatedRate / everyStepRate
+            << "] cost of subscribers ["
+            << quietRate / decimatedRate << "]" << std::endl;
+
+  EXPECT_GT(quietRate, 0.0);
+  EXPECT_GT(everyStepRate, 0.0);
+  EXPECT_GT(decimatedRate, 0.0);
+}
+
+INSTANTIATE_TEST_CASE_P(ShippedWorlds, HeadlessThroughputTest,
+    ::testing::Values("worlds/empty.world", "worlds/shapes.world",
+                      "worlds/friction_pyramid.world"),);  // NOLINT
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
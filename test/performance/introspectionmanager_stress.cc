@@ -16,6 +16,14 @@
 */
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gazebo/util/IntrospectionClient.hh"
 #include "gazebo/util/IntrospectionManager.hh"
 #include "gazebo/test/ServerFixture.hh"
 
@@ -25,7 +33,7 @@
 using namespace gazebo;
 
 /// \brief A test fixture class.
-class IntrospectionManagerTest : public ::testing::Test
+class IntrospectionManagerTest : public ::testing::TestWithParam<size_t>
 {
   /// \brief Constructor
   public: IntrospectionManagerTest()
@@ -45,16 +53,47 @@ class IntrospectionManagerTest : public ::testing::Test
     EXPECT_TRUE(this->manager->Items().empty());
   }
 
+  /// \brief Call Update() repeatedly and print statistics of its duration.
+  /// \param[in] _label Description of the measurement.
+  /// \param[in] _itemCount Number of registered items.
+  public: void TimeUpdates(const std::string &_label, const size_t _itemCount)
+  {
+    std::vector<double> times;
+    for (size_t ii = 0; ii < 1000; ++ii)
+    {
+      common::Time startTime = common::Time::GetWallTime();
+      this->manager->Update();
+      common::Time endTime = common::Time::GetWallTime();
+      times.push_back((endTime - startTime).Double());
+    }
+
+    auto n = times.size();
+    std::sort(times.begin(), times.end());
+    auto sum = std::accumulate(times.begin(), times.end(), 0.0);
+
+    std::cerr << "Items: " << _itemCount << " (" << _label << ")"
+              << std::endl;
+    std::cerr << "  Samples: " << n << std::endl;
+    std::cerr << "  Max: " << times.back() << std::endl;
+    std::cerr << "  Min: " << times.front() << std::endl;
+    // Not exactly median, but really close.
+    std::cerr << "  Median: " << times[n/2] << std::endl;
+    std::cerr << "  Mean: " << sum / static_cast<double>(n) << std::endl;
+    std::cerr << "  Mean per item: " << sum / static_cast<double>(n) /
+      static_cast<double>(_itemCount) << std::endl;
+  }
+
   /// \brief Pointer to the introspection manager.
   protected: util::IntrospectionManager *manager;
 };
 
 
-TEST_F(IntrospectionManagerTest, IntrospectionManagerStressTest)
+TEST_P(IntrospectionManagerTest, IntrospectionManagerStressTest)
 {
   // Each model registers 5 items (pos, linvel, angvel, linaccel, angaccel)
-  // This would be the equivalent of adding 2000 models.
-  for (size_t ii = 0; ii < 10000; ii++)
+  // E.g. 10000 items would be the equivalent of adding 2000 models.
+  const size_t itemCount = GetParam();
+  for (size_t ii = 0; ii < itemCount; ii++)
   {
     // A callback for updating items.
     // This arbitrarily captures something large enough to not
@@ -73,23 +112,34 @@ TEST_F(IntrospectionManagerTest, IntrospectionManagerStressTest)
     EXPECT_TRUE(this->manager->Register<std::string>(ss.str(), func));
   }
 
-  std::vector<double> times;
-  for (size_t ii = 0; ii < 1000; ++ii)
-  {
-    common::Time startTime = common::Time::GetWallTime();
-    this->manager->Update();
-    common::Time endTime = common::Time::GetWallTime();
-    times.push_back((endTime - startTime).Double());
-  }
+  // Nobody observes the items.
+  this->TimeUpdates("no filter", itemCount);
 
-  auto n = times.size();
-  std::sort(times.begin(), times.end());
-  auto sum = std::accumulate(times.begin(), times.end(), 0.0);
+  // One plot is open, with a single pose.
+  EXPECT_TRUE(this->manager->Register<ignition::math::Pose3d>("pose",
+      []()
+      {
+        return ignition::math::Pose3d(1, 2, 3, 0, 0, 0);
+      }));
+  util::IntrospectionClient client;
+  std::string filterId;
+  std::string topic;
+  EXPECT_TRUE(client.NewFilter(this->manager->Id(), {"pose"}, filterId,
+      topic));
+  this->TimeUpdates("one item observed", itemCount);
 
-  std::cerr << "Samples: " << n << std::endl;
-  std::cerr << "Max: " << times.back() << std::endl;
-  std::cerr << "Min: " << times.front() << std::endl;
-  // Not exactly median, but really close.
-  std::cerr << "Median: " << times[n/2] << std::endl;
-  std::cerr << "Mean: " << sum / static_cast<double>(n) << std::endl;
+  // All the items are observed.
+  std::set<std::string> items = this->manager->Items();
+  EXPECT_TRUE(client.UpdateFilter(this->manager->Id(), filterId, items));
+  this->TimeUpdates("all items observed", itemCount);
+
+  // Same, with the updates published in batches.
+  this->manager->SetPublishRate(10);
+  this->TimeUpdates("all items observed, published at 10 Hz", itemCount);
+  this->manager->SetPublishRate(0);
+
+  EXPECT_TRUE(client.RemoveFilter(this->manager->Id(), filterId));
 }
+
+INSTANTIATE_TEST_CASE_P(ItemCounts, IntrospectionManagerTest,
+    ::testing::Values(100u, 1000u, 10000u));
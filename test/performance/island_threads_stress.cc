@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/physics/ode/ODEPhysics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class IslandThreadsStressTest : public ServerFixture,
+                                public testing::WithParamInterface<unsigned int>
+{
+  /// \brief Spawn robots made of a chain of links, each of which is an
+  /// independent island.
+  /// \param[in] _world World to spawn into.
+  /// \param[in] _count Number of robots to spawn.
+  public: void SpawnRobots(physics::WorldPtr _world,
+                           const unsigned int _count);
+
+  /// \brief Step the world and return the average wall time per step.
+  /// \param[in] _world World to step.
+  /// \param[in] _threads Number of island threads.
+  /// \param[in] _steps Number of steps to take.
+  /// \return Average wall time of one step.
+  public: common::Time TimeSteps(physics::WorldPtr _world,
+                                 const unsigned int _threads,
+                                 const unsigned int _steps);
+};
+
+/////////////////////////////////////////////////
+void IslandThreadsStressTest::SpawnRobots(physics::WorldPtr _world,
+    const unsigned int _count)
+{
+  const unsigned int linkCount = 8;
+  const unsigned int initialCount = _world->ModelCount();
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    std::ostringstream sdfStr;
+    sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='robot_" << i << "'>"
+      << "  <pose>" << (i % 8) * 3.0 << " " << (i / 8) * 3.0 << " "
+      << linkCount * 0.3 + 0.5 << " 0 0 0</pose>"
+      << "  <link name='base'>"
+      << "    <collision name='c'><geometry><box><size>0.2 0.2 0.2</size>"
+      << "    </box></geometry></collision>"
+      << "  </link>"
+      << "  <joint name='world_joint' type='fixed'>"
+      << "    <parent>world</parent><child>base</child>"
+      << "  </joint>";
+
+    // A chain of links swinging around alternating axes.
+    std::string parent = "base";
+    for (unsigned int j = 0; j < linkCount; ++j)
+    {
+      std::ostringstream name;
+      name << "link_" << j;
+      sdfStr
+        << "  <link name='" << name.str() << "'>"
+        << "    <pose>0 0 " << -0.3 * (j + 1) << " 0.2 0 0</pose>"
+        << "    <collision name='c'><geometry><box><size>0.1 0.1 0.25"
+        << "    </size></box></geometry></collision>"
+        << "  </link>"
+        << "  <joint name='joint_" << j << "' type='revolute'>"
+        << "    <pose>0 0 0.15 0 0 0</pose>"
+        << "    <parent>" << parent << "</parent>"
+        << "    <child>" << name.str() << "</child>"
+        << "    <axis><xyz>" << (j % 2) << " " << 1 - (j % 2) << " 0</xyz>"
+        << "    </axis>"
+        << "  </joint>";
+      parent = name.str();
+    }
+    sdfStr << "</model>"
+      << "</sdf>";
+    _world->InsertModelString(sdfStr.str());
+  }
+
+  // Factory messages are processed by the world thread.
+  int sleep = 0;
+  while (_world->ModelCount() < initialCount + _count && sleep++ < 600)
+    common::Time::MSleep(100);
+  ASSERT_EQ(_world->ModelCount(), initialCount + _count);
+}
+
+/////////////////////////////////////////////////
+common::Time IslandThreadsStressTest::TimeSteps(physics::WorldPtr _world,
+    const unsigned int _threads, const unsigned int _steps)
+{
+  physics::ODEPhysicsPtr odePhysics =
+      boost::static_pointer_cast<physics::ODEPhysics>(_world->Physics());
+  odePhysics->SetIslandThreads(_threads);
+  EXPECT_EQ(odePhysics->IslandThreads(), _threads);
+
+  // Start every run from the same state, so that all runs do the same work.
+  _world->Reset();
+
+  // Warm up
+  _world->Step(10);
+
+  common::Time startTime = common::Time::GetWallTime();
+  _world->Step(_steps);
+  common::Time elapsed = common::Time::GetWallTime() - startTime;
+
+  return elapsed.Double() / _steps;
+}
+
+/////////////////////////////////////////////////
+TEST_P(IslandThreadsStressTest, Scaling)
+{
+  const unsigned int robotCount = GetParam();
+  const unsigned int steps = 1000;
+
+  Load("worlds/empty.world", true, "ode");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // Use the quick step solver, like most worlds do.
+  world->Physics()->SetParam("solver_type", std::string("quick"));
+
+  // Run the world until the factory messages are processed.
+  world->SetPaused(false);
+  this->SpawnRobots(world, robotCount);
+  world->SetPaused(true);
+
+  std::vector<unsigned int> threadCounts = {0u, 1u, 2u};
+  const unsigned int hwThreads =
+      std::max(2u, std::thread::hardware_concurrency());
+  for (unsigned int threads = 4; threads <= hwThreads; threads *= 2)
+    threadCounts.push_back(threads);
+
+  common::Time serial = this->TimeSteps(world, 0, steps);
+
+  // Results are printed for comparison, a strict speed-up is not required
+  // since it depends on the host.
+  for (auto const threads : threadCounts)
+  {
+    common::Time stepTime = this->TimeSteps(world, threads, steps);
+    std::cout << "Robots [" << robotCount << "] "
+              << "island threads [" << threads << "] "
+              << "step [" << stepTime.Double() * 1e6 << " us] "
+              << "speed-up [" << serial.Double() / stepTime.Double() << "]"
+              << std::endl;
+  }
+
+  // Switching back to sequential islands must be supported at runtime.
+  physics::ODEPhysicsPtr odePhysics =
+      boost::static_pointer_cast<physics::ODEPhysics>(world->Physics());
+  odePhysics->SetIslandThreads(0);
+  world->Step(10);
+  EXPECT_EQ(odePhysics->IslandThreads(), 0u);
+}
+
+INSTANTIATE_TEST_CASE_P(RobotCounts, IslandThreadsStressTest,
+    ::testing::Values(1u, 4u, 16u, 64u));
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
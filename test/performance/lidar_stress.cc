@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/physics/MultiRayShape.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/RayShape.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class LidarStressTest : public ServerFixture,
+                        public testing::WithParamInterface<unsigned int>
+{
+  /// \brief Spawn static boxes, spheres and cylinders on a grid around the
+  /// origin.
+  /// \param[in] _world World to spawn into.
+  /// \param[in] _count Number of models to spawn.
+  public: void SpawnObstacles(physics::WorldPtr _world,
+                              const unsigned int _count);
+};
+
+/////////////////////////////////////////////////
+void LidarStressTest::SpawnObstacles(physics::WorldPtr _world,
+    const unsigned int _count)
+{
+  const char *geometries[] = {
+    "<box><size>0.5 0.5 0.5</size></box>",
+    "<sphere><radius>0.25</radius></sphere>",
+    "<cylinder><radius>0.25</radius><length>0.5</length></cylinder>"};
+
+  const unsigned int initialCount = _world->ModelCount();
+  // Cells are centered 0.75 m away from the axes, so no obstacle overlaps
+  // the lidar at the origin.
+  const int side = static_cast<int>(std::sqrt(_count)) + 1;
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    const double x = (static_cast<int>(i) % side - side / 2) * 1.5 + 0.75;
+    const double y = (static_cast<int>(i) / side - side / 2) * 1.5 + 0.75;
+
+    std::ostringstream sdfStr;
+    sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='obstacle_" << i << "'>"
+      << "  <static>true</static>"
+      << "  <pose>" << x << " " << y << " 0.25 0 0 0</pose>"
+      << "  <link name='link'>"
+      << "    <collision name='collision'>"
+      << "      <geometry>" << geometries[i % 3] << "</geometry>"
+      << "    </collision>"
+      << "  </link>"
+      << "</model>"
+      << "</sdf>";
+    _world->InsertModelString(sdfStr.str());
+  }
+
+  // Factory messages are processed by the world thread.
+  int sleep = 0;
+  while (_world->ModelCount() < initialCount + _count && sleep++ < 1200)
+    common::Time::MSleep(100);
+  ASSERT_EQ(_world->ModelCount(), initialCount + _count);
+}
+
+/////////////////////////////////////////////////
+// Measure the time of one scan of a 3D lidar, with the rays cast in a batch
+// by the physics engine and with the ray space of the laser.
+TEST_P(LidarStressTest, Scan)
+{
+  const unsigned int obstacles = GetParam();
+  const unsigned int scans = 20;
+
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  world->SetPaused(false);
+  this->SpawnObstacles(world, obstacles);
+  world->SetPaused(true);
+
+  // 1024 x 16 rays
+  SpawnRaySensor("lidar_model", "lidar", ignition::math::Vector3d(0, 0, 0.3),
+      ignition::math::Vector3d::Zero, -IGN_PI, IGN_PI, -0.26, 0.26, 0.1, 30,
+      0.01, 1024, 16);
+  sensors::RaySensorPtr sensor = std::dynamic_pointer_cast<sensors::RaySensor>(
+      sensors::get_sensor("lidar"));
+  ASSERT_TRUE(sensor != nullptr);
+  sensor->SetActive(false);
+  physics::MultiRayShapePtr shape = sensor->LaserShape();
+  ASSERT_TRUE(shape != nullptr);
+
+  // Batched, see ODEPhysics::CastRays
+  common::Time startTime = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < scans; ++i)
+    shape->Update();
+  const common::Time batched =
+    (common::Time::GetWallTime() - startTime).Double() / scans;
+
+  // Ray space, reset like MultiRayShape::Update
+  const double fullRange = shape->GetMaxRange() - shape->GetMinRange();
+  startTime = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < scans; ++i)
+  {
+    for (unsigned int j = 0; j < shape->RayCount(); ++j)
+    {
+      physics::RayShapePtr ray = shape->Ray(j);
+      ray->SetLength(fullRange);
+      ray->SetRetro(0.0);
+      ray->Update();
+    }
+    shape->UpdateRays();
+  }
+  const common::Time raySpace =
+    (common::Time::GetWallTime() - startTime).Double() / scans;
+
+  // Results are printed for comparison, the cost depends on the host.
+  std::cout << "Obstacles [" << obstacles << "] rays ["
+            << shape->RayCount() << "]\n"
+            << "  scan batched: [" << batched.Double() * 1e3
+            << " ms] ray space [" << raySpace.Double() * 1e3 << " ms]"
+            << std::endl;
+}
+
+INSTANTIATE_TEST_CASE_P(ObstacleCounts, LidarStressTest,
+    ::testing::Values(10u, 100u, 1000u),);  // NOLINT
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class ModelUpdateStressTest : public ServerFixture,
+                              public testing::WithParamInterface<unsigned int>
+{
+  /// \brief Spawn pendulum models whose joints are driven by a position PID,
+  /// so that every Model::Update call does some work.
+  /// \param[in] _world World to spawn into.
+  /// \param[in] _count Number of models to spawn.
+  public: void SpawnPendulums(physics::WorldPtr _world,
+                              const unsigned int _count);
+
+  /// \brief Step the world and return the average wall time per step.
+  /// \param[in] _world World to step.
+  /// \param[in] _threads Number of model update threads.
+  /// \param[in] _steps Number of steps to take.
+  /// \return Average wall time of one step.
+  public: common::Time TimeSteps(physics::WorldPtr _world,
+                                 const unsigned int _threads,
+                                 const unsigned int _steps);
+};
+
+/////////////////////////////////////////////////
+void ModelUpdateStressTest::SpawnPendulums(physics::WorldPtr _world,
+    const unsigned int _count)
+{
+  const unsigned int initialCount = _world->ModelCount();
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    std::ostringstream sdfStr;
+    sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='pendulum_" << i << "'>"
+      << "  <pose>" << (i % 32) * 2.0 << " " << (i / 32) * 2.0 << " 1 0 0 0"
+      << "  </pose>"
+      << "  <link name='base'>"
+      << "    <collision name='c'><geometry><box><size>0.2 0.2 0.2</size>"
+      << "    </box></geometry></collision>"
+      << "  </link>"
+      << "  <link name='arm'>"
+      << "    <pose>0 0 -0.5 0 0 0</pose>"
+      << "    <collision name='c'><geometry><sphere><radius>0.1</radius>"
+      << "    </sphere></geometry></collision>"
+      << "  </link>"
+      << "  <joint name='world_joint' type='fixed'>"
+      << "    <parent>world</parent><child>base</child>"
+      << "  </joint>"
+      << "  <joint name='hinge' type='revolute'>"
+      << "    <parent>base</parent><child>arm</child>"
+      << "    <axis><xyz>1 0 0</xyz></axis>"
+      << "  </joint>"
+      << "</model>"
+      << "</sdf>";
+    _world->InsertModelString(sdfStr.str());
+  }
+
+  // Factory messages are processed by the world thread.
+  int sleep = 0;
+  while (_world->ModelCount() < initialCount + _count && sleep++ < 600)
+    common::Time::MSleep(100);
+  ASSERT_EQ(_world->ModelCount(), initialCount + _count);
+
+  for (auto const &model : _world->Models())
+  {
+    physics::JointPtr joint = model->GetJoint("hinge");
+    if (!joint)
+      continue;
+    model->GetJointController()->SetPositionPID(
+        joint->GetScopedName(), common::PID(10, 0.1, 1));
+    model->GetJointController()->SetPositionTarget(
+        joint->GetScopedName(), 0.5);
+  }
+}
+
+/////////////////////////////////////////////////
+common::Time ModelUpdateStressTest::TimeSteps(physics::WorldPtr _world,
+    const unsigned int _threads, const unsigned int _steps)
+{
+  _world->SetModelUpdateThreads(_threads);
+  EXPECT_EQ(_world->ModelUpdateThreads(), _threads);
+
+  // Warm up
+  _world->Step(10);
+
+  common::Time startTime = common::Time::GetWallTime();
+  _world->Step(_steps);
+  common::Time elapsed = common::Time::GetWallTime() - startTime;
+
+  return elapsed.Double() / _steps;
+}
+
+/////////////////////////////////////////////////
+TEST_P(ModelUpdateStressTest, SerialVsParallel)
+{
+  const unsigned int modelCount = GetParam();
+  const unsigned int steps = 1000;
+
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // Run the world until the factory messages are processed.
+  world->SetPaused(false);
+  this->SpawnPendulums(world, modelCount);
+  world->SetPaused(true);
+
+  common::Time serial = this->TimeSteps(world, 0, steps);
+
+  const unsigned int hwThreads =
+      std::max(2u, std::thread::hardware_concurrency());
+  common::Time parallel = this->TimeSteps(world, hwThreads, steps);
+
+  // Results are printed for comparison, a strict speed-up is not required
+  // since it depends on the host.
+  std::cout << "Models [" << modelCount << "] "
+            << "serial step [" << serial.Double() * 1e6 << " us] "
+            << "parallel step (" << hwThreads << " threads) ["
+            << parallel.Double() * 1e6 << " us] "
+            << "speed-up [" << serial.Double() / parallel.Double() << "]"
+            << std::endl;
+
+  // Switching back to serial must be supported at runtime.
+  world->SetModelUpdateThreads(0);
+  world->Step(10);
+  EXPECT_EQ(world->ModelUpdateThreads(), 0u);
+}
+
+INSTANTIATE_TEST_CASE_P(ModelCounts, ModelUpdateStressTest,
+    ::testing::Values(10u, 100u, 1000u));
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <atomic>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+/// \brief Number of links of each spawned model.
+static const unsigned int kLinksPerModel = 3;
+
+/// \brief One model out of this many is dynamic, the others are static.
+static const unsigned int kDynamicEvery = 10;
+
+/// \brief Number of poses received.
+static std::atomic<unsigned int> g_poseCount(0);
+
+class PosePublishStressTest : public ServerFixture,
+                              public testing::WithParamInterface<unsigned int>
+{
+  /// \brief Spawn models floating without gravity, some of them static.
+  /// \param[in] _world World to spawn into.
+  /// \param[in] _count Number of models to spawn.
+  public: void SpawnModels(physics::WorldPtr _world,
+                           const unsigned int _count);
+
+  /// \brief Step the world and return the average wall time of one step.
+  /// \param[in] _world World to step, paused.
+  /// \param[in] _steps Number of steps.
+  /// \return Average wall time of one step.
+  public: common::Time StepTime(physics::WorldPtr _world,
+                                const unsigned int _steps);
+};
+
+/////////////////////////////////////////////////
+/// \brief Subscriber callback counting the poses received.
+/// \param[in] _msg Message.
+void OnPoses(ConstPosesStampedPtr &_msg)
+{
+  g_poseCount += _msg->pose_size();
+}
+
+/////////////////////////////////////////////////
+void PosePublishStressTest::SpawnModels(physics::WorldPtr _world,
+    const unsigned int _count)
+{
+  const unsigned int initialCount = _world->ModelCount();
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    std::ostringstream sdfStr;
+    sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='model_" << i << "'>"
+      << "  <static>" << (i % kDynamicEvery != 0) << "</static>"
+      << "  <pose>" << (i % 64) * 2.0 << " " << (i / 64) * 2.0 << " 1 0 0 0"
+      << "  </pose>";
+    for (unsigned int j = 0; j < kLinksPerModel; ++j)
+    {
+      sdfStr << "  <link name='link_" << j << "'>"
+        << "    <pose>0 0 " << j * 0.5 << " 0 0 0</pose>"
+        << "  </link>";
+    }
+    sdfStr << "</model>"
+      << "</sdf>";
+    _world->InsertModelString(sdfStr.str());
+  }
+
+  // Factory messages are processed by the world thread.
+  int sleep = 0;
+  while (_world->ModelCount() < initialCount + _count && sleep++ < 1200)
+    common::Time::MSleep(100);
+  ASSERT_EQ(_world->ModelCount(), initialCount + _count);
+}
+
+/////////////////////////////////////////////////
+common::Time PosePublishStressTest::StepTime(physics::WorldPtr _world,
+    const unsigned int _steps)
+{
+  common::Time startTime = common::Time::GetWallTime();
+  _world->Step(_steps);
+  common::Time elapsed = common::Time::GetWallTime() - startTime;
+
+  return elapsed.Double() / _steps;
+}
+
+/////////////////////////////////////////////////
+TEST_P(PosePublishStressTest, DirtyPoses)
+{
+  const unsigned int modelCount = GetParam();
+  const unsigned int steps = 1000;
+
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // As fast as possible, with the dynamic links floating in place
+  world->Physics()->SetRealTimeUpdateRate(0);
+  world->SetGravity(ignition::math::Vector3d::Zero);
+
+  world->SetPaused(false);
+  this->SpawnModels(world, modelCount);
+  world->SetPaused(true);
+
+  // The fixture listens to local poses, use our own subscriber instead.
+  this->poseSub.reset();
+  transport::SubscriberPtr sub =
+    this->node->Subscribe("~/pose/local/info", &OnPoses);
+
+  // Let the poses of the inserted models go out
+  world->Step(10);
+  common::Time::MSleep(500);
+
+  // Poses after every step
+  world->SetPosePublishSteps(1);
+  g_poseCount = 0;
+  const common::Time publishing = this->StepTime(world, steps);
+
+  // Wait for the messages in flight
+  common::Time::MSleep(500);
+  const double posesPerStep = static_cast<double>(g_poseCount) / steps;
+
+  // Same world without pose messages
+  world->SetPosePublishSteps(std::numeric_limits<unsigned int>::max());
+  const common::Time quiet = this->StepTime(world, steps);
+
+  // Only the dynamic models and their links change pose, the static ones
+  // are not published again.
+  const unsigned int dynamicCount =
+    (modelCount + kDynamicEvery - 1) / kDynamicEvery;
+  EXPECT_LE(posesPerStep, dynamicCount * (kLinksPerModel + 1));
+
+  // Results are printed for comparison, the cost depends on the host.
+  std::cout << "Models [" << modelCount << "] dynamic [" << dynamicCount
+            << "] links per model [" << kLinksPerModel << "]\n"
+            << "  poses per step: [" << posesPerStep << "]\n"
+            << "  step publishing: [" << publishing.Double() * 1e6
+            << " us] quiet [" << quiet.Double() * 1e6 << " us]\n"
+            << "  pose publish cost: ["
+            << (publishing - quiet).Double() * 1e6 << " us]"
+            << std::endl;
+}
+
+INSTANTIATE_TEST_CASE_P(ModelCounts, PosePublishStressTest,
+    ::testing::Values(10u, 100u, 500u, 2000u),);  // NOLINT
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -15,8 +15,13 @@
  *
 */
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include <boost/thread.hpp>
 #include "gazebo/test/ServerFixture.hh"
+#include "gazebo/transport/Connection.hh"
 #include "RAMLibrary.hh"
 
 using namespace gazebo;
@@ -236,6 +241,212 @@ TEST_F(TransportStressTest, ManyNodes)
   delete [] fakeData;
 }
 
+/////////////////////////////////////////////////
+/// \brief Receive times of the messages of PublishPaths.
+std::vector<common::Time> g_pathReceiveTimes;
+
+void PathSharedCB(ConstImagePtr & /*_msg*/)
+{
+  boost::mutex::scoped_lock lock(g_mutex);
+  g_pathReceiveTimes.push_back(common::Time::GetWallTime());
+}
+
+void PathSerializedCB(const std::string &_data)
+{
+  // Parse the data like a subscriber in another process would.
+  msgs::Image msg;
+  msg.ParseFromString(_data);
+
+  boost::mutex::scoped_lock lock(g_mutex);
+  g_pathReceiveTimes.push_back(common::Time::GetWallTime());
+}
+
+/////////////////////////////////////////////////
+// Compare the throughput and latency of the intra-process paths: a shared
+// message handed as is to a local subscriber, a message copied on publish,
+// and a message serialized for each subscriber.
+TEST_F(TransportStressTest, PublishPaths)
+{
+  Load("worlds/empty.world");
+
+  const unsigned int msgCount = 1000;
+  const unsigned int width = 1024;
+  const unsigned int height = 1024;
+  std::string fakeData(width * height, 'x');
+
+  transport::NodePtr testNode(new transport::Node());
+  testNode->Init("default");
+
+  enum Path {SHARED, COPIED, SERIALIZED};
+  const char *names[] = {"shared", "copied", "serialized"};
+
+  for (int path = SHARED; path <= SERIALIZED; ++path)
+  {
+    const std::string topic = std::string("~/test/publish_path_") +
+      names[path];
+    transport::PublisherPtr pub =
+      testNode->Advertise<msgs::Image>(topic, msgCount);
+
+    transport::SubscriberPtr sub;
+    if (path == SERIALIZED)
+      sub = testNode->Subscribe(topic, &PathSerializedCB);
+    else
+      sub = testNode->Subscribe(topic, &PathSharedCB);
+
+    {
+      boost::mutex::scoped_lock lock(g_mutex);
+      g_pathReceiveTimes.clear();
+      g_pathReceiveTimes.reserve(msgCount);
+    }
+
+    std::vector<common::Time> sendTimes;
+    sendTimes.reserve(msgCount);
+
+    common::Time startTime = common::Time::GetWallTime();
+    for (unsigned int i = 0; i < msgCount; ++i)
+    {
+      boost::shared_ptr<msgs::Image> msg(new msgs::Image);
+      msg->set_width(width);
+      msg->set_height(height);
+      msg->set_pixel_format(0);
+      msg->set_step(width);
+      msg->set_data(fakeData);
+
+      sendTimes.push_back(common::Time::GetWallTime());
+      if (path == SHARED)
+        pub->Publish(msg, true);
+      else
+        pub->Publish(*msg, true);
+    }
+
+    // Wait for all the messages
+    int waitCount = 0;
+    while (waitCount++ < 3000)
+    {
+      {
+        boost::mutex::scoped_lock lock(g_mutex);
+        if (g_pathReceiveTimes.size() >= msgCount)
+          break;
+      }
+      common::Time::MSleep(10);
+    }
+
+    boost::mutex::scoped_lock lock(g_mutex);
+    ASSERT_EQ(g_pathReceiveTimes.size(), msgCount) << names[path];
+
+    // Messages are received in order.
+    common::Time duration = g_pathReceiveTimes.back() - startTime;
+    double latencySum = 0;
+    double latencyMax = 0;
+    for (unsigned int i = 0; i < msgCount; ++i)
+    {
+      double latency = (g_pathReceiveTimes[i] - sendTimes[i]).Double();
+      latencySum += latency;
+      latencyMax = std::max(latencyMax, latency);
+    }
+
+    // Output for human testing purposes
+    gzmsg << "Path [" << names[path] << "] "
+      << msgCount / duration.Double() << " msgs/s, latency mean ["
+      << latencySum / msgCount * 1e6 << " us] max ["
+      << latencyMax * 1e6 << " us]" << std::endl;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Number of messages read by ConnectionRead.
+unsigned int g_connectionReadCount = 0;
+
+void ConnectionRead(transport::ConnectionPtr _conn,
+    const std::string & /*_data*/)
+{
+  {
+    boost::mutex::scoped_lock lock(g_mutex);
+    g_connectionReadCount++;
+  }
+  _conn->AsyncRead(boost::bind(&ConnectionRead, _conn, _1));
+}
+
+void ConnectionAccept(std::vector<transport::ConnectionPtr> *_conns,
+    const transport::ConnectionPtr &_conn)
+{
+  boost::mutex::scoped_lock lock(g_mutex);
+  _conns->push_back(_conn);
+  _conn->AsyncRead(boost::bind(&ConnectionRead, _conn, _1));
+}
+
+/////////////////////////////////////////////////
+// Measure the throughput of a TCP connection with ASCII and binary
+// message headers, and with the shared memory ring, for small pose-sized
+// and large image-sized messages.
+TEST_F(TransportStressTest, ConnectionFraming)
+{
+  std::vector<transport::ConnectionPtr> accepted;
+  transport::ConnectionPtr server(new transport::Connection());
+  server->Listen(0, boost::bind(&ConnectionAccept, &accepted, _1));
+
+  struct Case {unsigned int size; unsigned int count;};
+  const Case cases[] = {{100, 100000}, {1024 * 1024, 500}};
+
+  for (const auto &c : cases)
+  {
+    const std::string payload(c.size, 'x');
+    for (int mode = 0; mode < 3; ++mode)
+    {
+      transport::ConnectionPtr client(new transport::Connection());
+      ASSERT_TRUE(client->Connect("127.0.0.1", server->GetLocalPort()));
+      client->SetBinaryFraming(mode > 0);
+      if (mode == 2)
+        ASSERT_TRUE(client->EnableSharedMemory());
+
+      {
+        boost::mutex::scoped_lock lock(g_mutex);
+        g_connectionReadCount = 0;
+      }
+
+      common::Time startTime = common::Time::GetWallTime();
+      for (unsigned int i = 0; i < c.count; ++i)
+      {
+        client->EnqueueMsg(payload);
+        client->ProcessWriteQueue();
+      }
+
+      // Flush the queue like ConnectionManager does, and wait for all the
+      // messages.
+      int waitCount = 0;
+      while (waitCount++ < 30000)
+      {
+        {
+          boost::mutex::scoped_lock lock(g_mutex);
+          if (g_connectionReadCount >= c.count)
+            break;
+        }
+        client->ProcessWriteQueue();
+        common::Time::MSleep(1);
+      }
+      common::Time duration = common::Time::GetWallTime() - startTime;
+
+      {
+        boost::mutex::scoped_lock lock(g_mutex);
+        EXPECT_EQ(g_connectionReadCount, c.count);
+      }
+
+      // Output for human testing purposes
+      // The shared memory mode copies each payload into the ring and out
+      // of it, see SharedMemoryRing::Read.
+      const char *modes[] = {"ASCII framing", "Binary framing",
+        "Shared memory (copied in and out)"};
+      gzmsg << modes[mode] << ", " << c.count
+        << " messages of " << c.size << " bytes: "
+        << c.count / duration.Double() << " msgs/s, "
+        << c.count * c.size / duration.Double() / (1024 * 1024)
+        << " MB/s" << std::endl;
+
+      client->Shutdown();
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 // Main function
 int main(int argc, char **argv)
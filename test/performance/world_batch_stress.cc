@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class WorldBatchStressTest : public ServerFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Time the steps of a batch.
+/// \param[in] _batch Batch to step.
+/// \param[in] _steps Number of steps of each world.
+/// \return Steps per second, over all the worlds.
+static double StepRate(physics::WorldBatch &_batch, const unsigned int _steps)
+{
+  common::Time startTime = common::Time::GetWallTime();
+  _batch.Step(_steps);
+  common::Time elapsed = common::Time::GetWallTime() - startTime;
+  return _batch.Worlds().size() * _steps / elapsed.Double();
+}
+
+/////////////////////////////////////////////////
+TEST_F(WorldBatchStressTest, StepManyWorlds)
+{
+  const unsigned int worldCount = 48;
+  const unsigned int boxCount = 8;
+  const unsigned int steps = 500;
+
+  Load("worlds/empty.world", true);
+
+  // A small world of boxes dropped on a ground plane
+  std::ostringstream sdfStr;
+  sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+    << "<world name='batch'>"
+    << "  <model name='ground'><static>true</static>"
+    << "    <link name='link'><collision name='c'><geometry><plane>"
+    << "      <normal>0 0 1</normal><size>100 100</size>"
+    << "    </plane></geometry></collision></link>"
+    << "  </model>";
+  for (unsigned int i = 0; i < boxCount; ++i)
+  {
+    sdfStr
+      << "  <model name='box_" << i << "'>"
+      << "    <pose>" << (i % 4) * 1.5 << " " << (i / 4) * 1.5 << " "
+      << 0.5 + i * 0.2 << " 0 0.1 0</pose>"
+      << "    <link name='link'><collision name='c'><geometry><box>"
+      << "      <size>0.5 0.5 0.5</size>"
+      << "    </box></geometry></collision></link>"
+      << "  </model>";
+  }
+  sdfStr << "</world>"
+    << "</sdf>";
+
+  sdf::SDFPtr sdf(new sdf::SDF);
+  sdf::init(sdf);
+  ASSERT_TRUE(sdf::readString(sdfStr.str(), sdf));
+
+  physics::WorldBatch batch;
+  ASSERT_TRUE(batch.Load(sdf->Root()->GetElement("world"), worldCount));
+
+  // Warm up, also loads the plugins of the worlds
+  batch.SetThreadCount(1);
+  batch.Step(10);
+
+  const double sequentialRate = StepRate(batch, steps);
+  std::cout << "Worlds [" << worldCount << "] threads [1] steps/s ["
+            << sequentialRate << "]" << std::endl;
+
+  batch.SetThreadCount(0);
+  const double parallelRate = StepRate(batch, steps);
+  std::cout << "Worlds [" << worldCount << "] threads [default] steps/s ["
+            << parallelRate << "]" << std::endl;
+
+  // Results are printed for comparison, the speed-up depends on the host.
+  std::cout << "Speed-up [" << parallelRate / sequentialRate << "]"
+            << std::endl;
+
+  for (auto const &world : batch.Worlds())
+    EXPECT_EQ(world->Iterations(), 10 + 2 * steps);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
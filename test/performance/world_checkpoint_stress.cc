@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/helper_physics_generator.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class WorldCheckpointStressTest
+  : public ServerFixture, public testing::WithParamInterface<const char*>
+{
+  /// \brief Spawn robots made of a chain of links.
+  /// \param[in] _world World to spawn into.
+  /// \param[in] _count Number of robots to spawn.
+  public: void SpawnRobots(physics::WorldPtr _world,
+                           const unsigned int _count);
+
+  /// \brief Time a way of resetting the world.
+  /// \param[in] _name Name to print.
+  /// \param[in] _world World to reset.
+  /// \param[in] _reset Function that resets the world.
+  /// \param[in] _count Number of resets.
+  /// \return Average wall time of one reset.
+  public: common::Time TimeResets(const std::string &_name,
+                                  physics::WorldPtr _world,
+                                  std::function<void()> _reset,
+                                  const unsigned int _count);
+};
+
+/////////////////////////////////////////////////
+void WorldCheckpointStressTest::SpawnRobots(physics::WorldPtr _world,
+    const unsigned int _count)
+{
+  const unsigned int linkCount = 8;
+  const unsigned int initialCount = _world->ModelCount();
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    std::ostringstream sdfStr;
+    sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='robot_" << i << "'>"
+      << "  <pose>" << (i % 8) * 3.0 << " " << (i / 8) * 3.0 << " "
+      << linkCount * 0.3 + 0.5 << " 0 0 0</pose>"
+      << "  <link name='base'>"
+      << "    <collision name='c'><geometry><box><size>0.2 0.2 0.2</size>"
+      << "    </box></geometry></collision>"
+      << "  </link>"
+      << "  <joint name='world_joint' type='fixed'>"
+      << "    <parent>world</parent><child>base</child>"
+      << "  </joint>";
+
+    std::string parent = "base";
+    for (unsigned int j = 0; j < linkCount; ++j)
+    {
+      std::ostringstream name;
+      name << "link_" << j;
+      sdfStr
+        << "  <link name='" << name.str() << "'>"
+        << "    <pose>0 0 " << -0.3 * (j + 1) << " 0.2 0 0</pose>"
+        << "    <collision name='c'><geometry><box><size>0.1 0.1 0.25"
+        << "    </size></box></geometry></collision>"
+        << "  </link>"
+        << "  <joint name='joint_" << j << "' type='revolute'>"
+        << "    <pose>0 0 0.15 0 0 0</pose>"
+        << "    <parent>" << parent << "</parent>"
+        << "    <child>" << name.str() << "</child>"
+        << "    <axis><xyz>" << (j % 2) << " " << 1 - (j % 2) << " 0</xyz>"
+        << "    </axis>"
+        << "  </joint>";
+      parent = name.str();
+    }
+    sdfStr << "</model>"
+      << "</sdf>";
+    _world->InsertModelString(sdfStr.str());
+  }
+
+  // Factory messages are processed by the world thread.
+  int sleep = 0;
+  while (_world->ModelCount() < initialCount + _count && sleep++ < 600)
+    common::Time::MSleep(100);
+  ASSERT_EQ(_world->ModelCount(), initialCount + _count);
+}
+
+/////////////////////////////////////////////////
+common::Time WorldCheckpointStressTest::TimeResets(const std::string &_name,
+    physics::WorldPtr _world, std::function<void()> _reset,
+    const unsigned int _count)
+{
+  common::Time total;
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    // Move away from the state to restore
+    _world->Step(10);
+
+    common::Time startTime = common::Time::GetWallTime();
+    _reset();
+    total += common::Time::GetWallTime() - startTime;
+  }
+
+  common::Time average = total.Double() / _count;
+  std::cout << _name << " [" << average.Double() * 1e6 << " us]"
+            << std::endl;
+  return average;
+}
+
+/////////////////////////////////////////////////
+TEST_P(WorldCheckpointStressTest, CompareResets)
+{
+  const std::string physicsEngine = GetParam();
+  const unsigned int robotCount = 16;
+  const unsigned int resetCount = 100;
+
+  Load("worlds/empty.world", true, physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // Run the world until the factory messages are processed.
+  world->SetPaused(false);
+  this->SpawnRobots(world, robotCount);
+  world->SetPaused(true);
+
+  // Branch from the middle of an episode
+  world->Step(100);
+  physics::WorldCheckpoint checkpoint;
+  world->SaveCheckpoint(checkpoint);
+  physics::WorldState state(world);
+  const common::Time checkpointTime = world->SimTime();
+
+  std::cout << "Engine [" << physicsEngine << "] robots [" << robotCount
+            << "] links [" << checkpoint.Snapshot().LinkCount() << "]"
+            << std::endl;
+
+  common::Time restoreTime = this->TimeResets("RestoreCheckpoint", world,
+      [&]() { EXPECT_TRUE(world->RestoreCheckpoint(checkpoint)); },
+      resetCount);
+  EXPECT_EQ(world->SimTime(), checkpointTime);
+
+  common::Time saveTime = this->TimeResets("SaveCheckpoint", world,
+      [&]() { world->SaveCheckpoint(checkpoint); }, resetCount);
+
+  common::Time setStateTime = this->TimeResets("SetState(WorldState)",
+      world, [&]() { world->SetState(state); }, resetCount);
+
+  common::Time resetTime = this->TimeResets("Reset", world,
+      [&]() { world->Reset(); }, resetCount);
+
+  // Results are printed for comparison, strict ratios are not required
+  // since they depend on the host.
+  std::cout << "Speed-up over SetState [" << setStateTime.Double() /
+               restoreTime.Double() << "] over Reset ["
+            << resetTime.Double() / restoreTime.Double() << "]"
+            << std::endl;
+  EXPECT_GT(saveTime, common::Time::Zero);
+}
+
+INSTANTIATE_TEST_CASE_P(PhysicsEngines, WorldCheckpointStressTest,
+                        PHYSICS_ENGINE_VALUES,);  // NOLINT
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+/// \brief Number of links of each spawned model.
+static const unsigned int kLinksPerModel = 10;
+
+class WorldSnapshotStressTest : public ServerFixture,
+                                public testing::WithParamInterface<unsigned int>
+{
+  /// \brief Spawn chains of links connected by revolute joints.
+  /// \param[in] _world World to spawn into.
+  /// \param[in] _count Number of models to spawn.
+  public: void SpawnChains(physics::WorldPtr _world,
+                           const unsigned int _count);
+
+  /// \brief Move every model of a world.
+  /// \param[in] _world World whose models to move.
+  /// \param[in] _offset Offset added to the position of each model.
+  public: void MoveModels(physics::WorldPtr _world, const double _offset);
+
+  /// \brief Call a function repeatedly and return the average wall time of
+  /// one call.
+  /// \param[in] _func Function to time.
+  /// \param[in] _reps Number of calls.
+  /// \return Average wall time of one call.
+  public: common::Time Time(const std::function<void()> &_func,
+                            const unsigned int _reps);
+};
+
+/////////////////////////////////////////////////
+void WorldSnapshotStressTest::SpawnChains(physics::WorldPtr _world,
+    const unsigned int _count)
+{
+  const unsigned int initialCount = _world->ModelCount();
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    std::ostringstream sdfStr;
+    sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='chain_" << i << "'>"
+      << "  <pose>" << (i % 32) * 2.0 << " " << (i / 32) * 2.0 << " 1 0 0 0"
+      << "  </pose>"
+      << "  <gravity>false</gravity>";
+    for (unsigned int j = 0; j < kLinksPerModel; ++j)
+    {
+      sdfStr << "  <link name='link_" << j << "'>"
+        << "    <pose>0 0 " << j * 0.1 << " 0 0 0</pose>"
+        << "  </link>";
+      if (j > 0)
+      {
+        sdfStr << "  <joint name='joint_" << j << "' type='revolute'>"
+          << "    <parent>link_" << j - 1 << "</parent>"
+          << "    <child>link_" << j << "</child>"
+          << "    <axis><xyz>1 0 0</xyz></axis>"
+          << "  </joint>";
+      }
+    }
+    sdfStr << "</model>"
+      << "</sdf>";
+    _world->InsertModelString(sdfStr.str());
+  }
+
+  // Factory messages are processed by the world thread.
+  int sleep = 0;
+  while (_world->ModelCount() < initialCount + _count && sleep++ < 1200)
+    common::Time::MSleep(100);
+  ASSERT_EQ(_world->ModelCount(), initialCount + _count);
+}
+
+/////////////////////////////////////////////////
+void WorldSnapshotStressTest::MoveModels(physics::WorldPtr _world,
+    const double _offset)
+{
+  for (auto const &model : _world->Models())
+  {
+    if (model->IsStatic())
+      continue;
+    ignition::math::Pose3d pose = model->WorldPose();
+    pose.Pos().Z() += _offset;
+    model->SetWorldPose(pose);
+  }
+}
+
+/////////////////////////////////////////////////
+common::Time WorldSnapshotStressTest::Time(const std::function<void()> &_func,
+    const unsigned int _reps)
+{
+  common::Time startTime = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < _reps; ++i)
+    _func();
+  common::Time elapsed = common::Time::GetWallTime() - startTime;
+
+  return elapsed.Double() / _reps;
+}
+
+/////////////////////////////////////////////////
+TEST_P(WorldSnapshotStressTest, LoadDiffSetState)
+{
+  const unsigned int linkCount = GetParam();
+  const unsigned int reps = std::max(10u, 100000u / linkCount);
+
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // Run the world until the factory messages are processed.
+  world->SetPaused(false);
+  this->SpawnChains(world, linkCount / kLinksPerModel);
+  world->SetPaused(true);
+
+  // Load
+  physics::WorldState stateA(world);
+  physics::WorldSnapshot snapshotA;
+  snapshotA.Capture(*world, nullptr);
+  ASSERT_GE(snapshotA.LinkCount(), linkCount);
+
+  common::Time stateLoad = this->Time([&]()
+      {
+        physics::WorldState state(world);
+      }, reps);
+  physics::WorldSnapshot snapshot;
+  common::Time snapshotLoad = this->Time([&]()
+      {
+        snapshot.Capture(*world, &snapshotA);
+      }, reps);
+
+  // Diff
+  this->MoveModels(world, 0.5);
+  physics::WorldState stateB(world);
+  physics::WorldSnapshot snapshotB;
+  snapshotB.Capture(*world, &snapshotA);
+
+  bool stateChanged = false;
+  common::Time stateDiff = this->Time([&]()
+      {
+        stateChanged = !(stateB - stateA).IsZero();
+      }, reps);
+  bool snapshotChanged = false;
+  common::Time snapshotDiff = this->Time([&]()
+      {
+        snapshotChanged = snapshotB.Diff(snapshotA);
+      }, reps);
+  EXPECT_TRUE(stateChanged);
+  EXPECT_TRUE(snapshotChanged);
+
+  // SetState
+  common::Time stateSet = this->Time([&]()
+      {
+        world->SetState(stateA);
+      }, reps);
+  common::Time snapshotSet = this->Time([&]()
+      {
+        world->SetState(snapshotA);
+      }, reps);
+
+  physics::WorldSnapshot restored;
+  restored.Capture(*world, &snapshotA);
+  EXPECT_FALSE(restored.Diff(snapshotA));
+
+  // Results are printed for comparison, a strict speed-up is not required
+  // since it depends on the host.
+  std::cout << "Links [" << snapshotA.LinkCount() << "] "
+            << "joints [" << snapshotA.JointCount() << "]\n"
+            << "  load:     state [" << stateLoad.Double() * 1e6
+            << " us] snapshot [" << snapshotLoad.Double() * 1e6 << " us]\n"
+            << "  diff:     state [" << stateDiff.Double() * 1e6
+            << " us] snapshot [" << snapshotDiff.Double() * 1e6 << " us]\n"
+            << "  setstate: state [" << stateSet.Double() * 1e6
+            << " us] snapshot [" << snapshotSet.Double() * 1e6 << " us]"
+            << std::endl;
+}
+
+INSTANTIATE_TEST_CASE_P(LinkCounts, WorldSnapshotStressTest,
+    ::testing::Values(100u, 1000u, 10000u));
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -955,6 +955,10 @@ void StatsCommand::CB(ConstWorldStatisticsPtr &_msg)
   if (this->realTimes.size() > 20)
     this->realTimes.pop_front();
 
+  this->iterations.push_back(_msg->iterations());
+  if (this->iterations.size() > 20)
+    this->iterations.pop_front();
+
   common::Time simAvg, realAvg;
   std::list<common::Time>::iterator simIter, realIter;
   simIter = ++(this->simTimes.begin());
@@ -973,6 +977,16 @@ void StatsCommand::CB(ConstWorldStatisticsPtr &_msg)
 
   simAvg = simAvg / realAvg;
 
+  // Steps per second of wall clock over the buffered messages
+  double stepRate = 0;
+  const common::Time realSpan = this->realTimes.back() -
+    this->realTimes.front();
+  if (realSpan > 0 && this->iterations.back() >= this->iterations.front())
+  {
+    stepRate = (this->iterations.back() - this->iterations.front()) /
+      realSpan.Double();
+  }
+
   if (simAvg > 0)
     percent = simAvg.Double();
   else
@@ -990,16 +1004,19 @@ void StatsCommand::CB(ConstWorldStatisticsPtr &_msg)
     if (first)
     {
       std::cout << "# real-time factor (percent), simtime (sec), "
-        << "realtime (sec), paused (T or F)\n";
+        << "realtime (sec), paused (T or F), step rate (steps/sec)\n";
       first = false;
     }
-    printf("%4.2f, %16.6f, %16.6f, %c\n",
-        percent, simTime.Double(), realTime.Double(), paused);
+    printf("%4.2f, %16.6f, %16.6f, %c, %10.1f\n",
+        percent, simTime.Double(), realTime.Double(), paused, stepRate);
     fflush(stdout);
   }
   else
-    printf("Factor[%4.2f] SimTime[%4.2f] RealTime[%4.2f] Paused[%c]\n",
-        percent, simTime.Double(), realTime.Double(), paused);
+  {
+    printf("Factor[%4.2f] SimTime[%4.2f] RealTime[%4.2f] Paused[%c] "
+        "StepRate[%4.1f]\n",
+        percent, simTime.Double(), realTime.Double(), paused, stepRate);
+  }
 }
 
 /////////////////////////////////////////////////
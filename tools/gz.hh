@@ -200,6 +200,9 @@ namespace gazebo
 
     /// \brief Real time buffer
     private: std::list<common::Time> realTimes;
+
+    /// \brief Iterations buffer, used to compute the step rate
+    private: std::list<uint64_t> iterations;
   };
 
   /// \brief SDF command
@@ -660,6 +660,7 @@ TEST_F(gzTest, Stats)
   // Basic output
   std::string output = custom_exec_str("gz stats -d 1");
   EXPECT_NE(output.find("Factor["), std::string::npos);
+  EXPECT_NE(output.find("StepRate["), std::string::npos);
 
   // Plot option
   output = custom_exec_str("gz stats -d 1 -p");
@@ -604,6 +604,9 @@ LogCommand::LogCommand()
     ("record,d", po::value<bool>(),
      "Start/stop recording a log file from an active Gazebo server."
      "O=stop record, 1=start recording.")
+    ("format", po::value<std::string>(), "Log file format (xml or binary) "
+     "used when starting to record. Binary logs are indexed for fast "
+     "seeking.")
     ("world-name,w", po::value<std::string>(), "World name, used when "
      "starting or stopping recording.")
     ("raw,r", "Output the data from echo and step without XML formatting."
@@ -705,7 +708,8 @@ bool LogCommand::RunImpl()
   else if (this->vm.count("step"))
     this->Step(filter, raw, stamp, hz);
   else if (this->vm.count("record"))
-    this->Record(this->vm["record"].as<bool>());
+    this->Record(this->vm["record"].as<bool>(),
+        this->vm.count("format") ? this->vm["format"].as<std::string>() : "");
   else if (this->vm.count("info"))
     this->Info(filename);
   else
@@ -812,6 +816,7 @@ void LogCommand::Info(const std::string &_filename)
     //                       << deltaTime.nsec << "\n"
     // << "Steps:          " << play->GetChunkCount() << "\n"
     << "Size:           " << this->GetFileSizeStr(_filename) << "\n"
+    << "Format:         " << play->Format() << "\n"
     << "Encoding:       " << play->Encoding() << "\n"
     // << "Model Count:    " << modelCount << "\n"
     << "\n";
@@ -981,7 +986,7 @@ void LogCommand::Step(const std::string &_filter, bool _raw,
 }
 
 /////////////////////////////////////////////////
-void LogCommand::Record(bool _start)
+void LogCommand::Record(bool _start, const std::string &_format)
 {
   gazebo::transport::PublisherPtr pub =
     this->node->Advertise<gazebo::msgs::LogControl>("~/log/control");
@@ -994,6 +999,8 @@ void LogCommand::Record(bool _start)
 
   gazebo::msgs::LogControl msg;
   _start ? msg.set_start(true) : msg.set_stop(true);
+  if (_start && !_format.empty())
+    msg.set_format(_format);
   pub->Publish<gazebo::msgs::LogControl>(msg, true);
 }
 
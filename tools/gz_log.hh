@@ -242,7 +242,9 @@ namespace gazebo
 
     /// \brief Start or stop logging
     /// \param[in] _start True to start logging
-    private: void Record(bool _start);
+    /// \param[in] _format Log file format when starting, xml or binary.
+    /// Empty to keep the server's format.
+    private: void Record(bool _start, const std::string &_format);
 
     /// \brief Get a character from the terminal.
     /// This bypasses the need to wait for the 'enter' key.